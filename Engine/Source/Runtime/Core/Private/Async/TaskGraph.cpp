@@ -3,6 +3,7 @@
 
 #include "CorePrivatePCH.h"
 #include "TaskGraphInterfaces.h"
+#include "ParallelFor.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogTaskGraph, Log, All);
 
@@ -211,6 +212,133 @@ private:
 
 };
 
+/**
+ *	FWorkStealingTaskDeque
+ *	Fixed size Chase-Lev work stealing deque for the unnamed threads.
+ *	Only the owning worker may Push and Pop (LIFO, at the bottom), any thread may Steal (FIFO, at the top).
+**/
+class FWorkStealingTaskDeque
+{
+public:
+	/** Constructor, sets the deque to the empty state. **/
+	FWorkStealingTaskDeque()
+		: Top(0)
+		, Bottom(0)
+	{
+		FMemory::Memzero(Tasks, sizeof(Tasks));
+	}
+
+	/** Returns the (unsafe) number of tasks in the deque. This is only a "guess" unless called from the owning thread. **/
+	int32 Num() const
+	{
+		int64 LocalTop = Top;
+		int64 LocalBottom = Bottom;
+		return LocalBottom > LocalTop ? int32(LocalBottom - LocalTop) : 0;
+	}
+
+	/**
+	 *	Adds a task to the bottom of the deque. Must be called from the owning thread.
+	 *	@param Task; the task to add
+	 *	@return false if the deque is full, in which case the caller must queue the task elsewhere
+	**/
+	bool Push(FBaseGraphTask* Task)
+	{
+		int64 LocalBottom = Bottom;
+		int64 LocalTop = Top;
+		if (LocalBottom - LocalTop >= CAPACITY)
+		{
+			return false;
+		}
+		Tasks[LocalBottom & (CAPACITY - 1)] = Task;
+		FPlatformMisc::MemoryBarrier(); // the task must be visible before the new bottom is
+		Bottom = LocalBottom + 1;
+		return true;
+	}
+
+	/**
+	 *	Removes the most recently pushed task. Must be called from the owning thread.
+	 *	@return The newest task in the deque or NULL if the deque is empty or the last task was lost to a thief
+	**/
+	FBaseGraphTask* Pop()
+	{
+		// the interlocked operation is a full barrier, the new bottom must be visible to thieves before we read top
+		int64 LocalBottom = FPlatformAtomics::InterlockedDecrement(&Bottom);
+		int64 LocalTop = Top;
+		if (LocalTop > LocalBottom)
+		{
+			// empty, restore the canonical empty state
+			Bottom = LocalBottom + 1;
+			return NULL;
+		}
+		FBaseGraphTask* Task = Tasks[LocalBottom & (CAPACITY - 1)];
+		if (LocalTop == LocalBottom)
+		{
+			// this is the last task, race any thieves for it
+			if (FPlatformAtomics::InterlockedCompareExchange(&Top, LocalTop + 1, LocalTop) != LocalTop)
+			{
+				Task = NULL;
+			}
+			Bottom = LocalTop + 1;
+		}
+		return Task;
+	}
+
+	/**
+	 *	Attempt to take the oldest task. Can be called from any thread.
+	 *	@return The oldest task in the deque or NULL if the deque is empty or another thread won the race for it
+	**/
+	FBaseGraphTask* Steal()
+	{
+		int64 LocalTop = Top;
+		FPlatformMisc::MemoryBarrier();
+		int64 LocalBottom = Bottom;
+		if (LocalTop >= LocalBottom)
+		{
+			return NULL;
+		}
+		FBaseGraphTask* Task = Tasks[LocalTop & (CAPACITY - 1)];
+		if (FPlatformAtomics::InterlockedCompareExchange(&Top, LocalTop + 1, LocalTop) != LocalTop)
+		{
+			return NULL;
+		}
+		return Task;
+	}
+
+private:
+	enum
+	{
+		/** Number of tasks the deque can hold, must be a power of two. Overflow goes to the shared queue. **/
+		CAPACITY=1024
+	};
+
+	/** Index of the oldest task; advanced by thieves and by the owner when it takes the last task. **/
+	volatile int64 Top;
+	/** Keeps Top and Bottom on separate cache lines. **/
+	uint8 Padding[64 - sizeof(int64)];
+	/** Index one past the newest task; only written by the owning thread. **/
+	volatile int64 Bottom;
+	/** Ring of tasks, only the [Top,Bottom) range is valid. **/
+	FBaseGraphTask* Tasks[CAPACITY];
+};
+
+/** If non-zero, tasks queued from worker threads go to a per-worker deque and idle workers steal from random victims. **/
+static int32 GTaskGraphUseWorkStealing = 1;
+static FAutoConsoleVariableRef CVarTaskGraphUseWorkStealing(
+	TEXT("TaskGraph.UseWorkStealing"),
+	GTaskGraphUseWorkStealing,
+	TEXT("If non-zero, AnyThread tasks queued from a worker thread go to that worker's local deque and idle workers steal from random victims.\n")
+	TEXT("If zero, all AnyThread tasks go through the shared incoming queue."),
+	ECVF_Default
+	);
+
+CORE_API int32 GTaskGraphParallelForBatchSize = 1;
+static FAutoConsoleVariableRef CVarTaskGraphParallelForBatchSize(
+	TEXT("TaskGraph.ParallelForBatchSize"),
+	GTaskGraphParallelForBatchSize,
+	TEXT("Number of consecutive indices a ParallelFor worker claims at once. Larger values reduce contention for very small bodies."),
+	ECVF_Default
+	);
+
 // this is used to signify a task that is just a call to wake up
 // It is generally bad to reuse pointers for non-pointer data, but efficiency is important here
 static FBaseGraphTask* WakeUpBaseGraphTask = (FBaseGraphTask*)0x3;
@@ -729,11 +857,16 @@ class FTaskGraphImplementation : public FTaskGraphInterface
 		FRunnableThread*	RunnableThread;
 		/** For external threads, this determines if they have been "attached" yet. Attachment is mostly setting up TLS for this individual thread. **/
 		bool				bAttached;
+		/** For unnamed threads, seed used to pick random victims to steal from. Only touched by this thread. **/
+		uint32				StealSeed;
+		/** For unnamed threads, tasks queued from this thread. Popped LIFO by this thread, stolen FIFO by the others. **/
+		FWorkStealingTaskDeque	LocalTasks;
 
 		/** Constructor to set reasonable defaults. **/
 		FWorkerThread()
 			: RunnableThread(NULL)
 			, bAttached(false)
+			, StealSeed(0)
 		{
 		}
 	};
@@ -791,6 +924,7 @@ public:
 			bool bAllowsStealsFromMe = ThreadIndex >= NumNamedThreads;
 			bool bStealsFromOthers = ThreadIndex >= NumNamedThreads;
 			WorkerThreads[ThreadIndex].TaskGraphWorker.Setup(ENamedThreads::Type(ThreadIndex), PerThreadIDTLSSlot, bAllowsStealsFromMe, bStealsFromOthers);
+			WorkerThreads[ThreadIndex].StealSeed = 0x9E3779B9u * uint32(ThreadIndex + 1);
 		}
 
 		TaskGraphImplementationSingleton = this; // now reentrancy is ok
@@ -856,7 +990,13 @@ public:
 		{
 			if (FPlatformProcess::SupportsMultithreading())
 			{
-				IncomingAnyThreadTasks.Push(Task);
+				// tasks queued from a worker (typically subsequents or ParallelFor fan out) stay local to that worker unless stolen
+				bool bQueuedLocally = GTaskGraphUseWorkStealing && CurrentThreadIfKnown >= NumNamedThreads && CurrentThreadIfKnown < NumThreads
+					&& WorkerThreads[CurrentThreadIfKnown].LocalTasks.Push(Task);
+				if (!bQueuedLocally)
+				{
+					IncomingAnyThreadTasks.Push(Task);
+				}
 				FTaskThread* TempTarget = StalledUnnamedThreads.Pop(); //@todo it is possible that a thread is in the process of stalling and we just missed it, non-fatal, but we could lose a whole task of potential parallelism.
 				if (TempTarget)
 				{
@@ -1027,6 +1167,15 @@ public:
 	FBaseGraphTask* FindWork(ENamedThreads::Type ThreadInNeed)
 	{
 		TestRandomizedThreads();
+		if (ThreadInNeed >= NumNamedThreads)
+		{
+			// local first, the most recently queued task is the one most likely to be in cache
+			FBaseGraphTask* Task = WorkerThreads[ThreadInNeed].LocalTasks.Pop();
+			if (Task)
+			{
+				return Task;
+			}
+		}
 		{
 			FBaseGraphTask* Task = SortedAnyThreadTasks.Pop();
 			if (Task)
@@ -1063,6 +1212,13 @@ public:
 				}
 			}
 		} while (!IncomingAnyThreadTasks.IsEmpty() || !SortedAnyThreadTasks.IsEmpty());
+		{
+			FBaseGraphTask* Task = StealFromRandomVictim(ThreadInNeed);
+			if (Task)
+			{
+				return Task;
+			}
+		}
 		// this can be called before my constructor is finished
 		for (int32 Pass = 0; Pass < 2; Pass++)
 		{
@@ -1092,6 +1248,51 @@ public:
 		return NULL;
 	}
 
+	/** 
+	 *	Attempt to steal from the local deques of the unnamed threads, starting at a random victim.
+	 *	A failed steal due to a race is retried so that a thread does not stall while there is stealable work.
+	 *	@param	ThreadInNeed; Id of the thread requesting work.
+	 *	@return Task that was stolen if any was found.
+	**/
+	FBaseGraphTask* StealFromRandomVictim(ENamedThreads::Type ThreadInNeed)
+	{
+		int32 NumUnnamedThreads = NumThreads - NumNamedThreads;
+		if (NumUnnamedThreads <= 0)
+		{
+			return NULL;
+		}
+		int32 FirstVictim = 0;
+		if (ThreadInNeed >= NumNamedThreads && ThreadInNeed < NumThreads)
+		{
+			// xorshift, the seed is private to the thread in need
+			uint32& Seed = WorkerThreads[ThreadInNeed].StealSeed;
+			Seed ^= Seed << 13;
+			Seed ^= Seed >> 17;
+			Seed ^= Seed << 5;
+			FirstVictim = int32(Seed % uint32(NumUnnamedThreads));
+		}
+		bool bSawWork = true;
+		while (bSawWork)
+		{
+			bSawWork = false;
+			for (int32 Offset = 0; Offset < NumUnnamedThreads; Offset++)
+			{
+				int32 Victim = NumNamedThreads + (FirstVictim + Offset) % NumUnnamedThreads;
+				FWorkStealingTaskDeque& VictimTasks = WorkerThreads[Victim].LocalTasks;
+				if (VictimTasks.Num())
+				{
+					FBaseGraphTask* Task = (Victim == ThreadInNeed) ? VictimTasks.Pop() : VictimTasks.Steal();
+					if (Task)
+					{
+						return Task;
+					}
+					bSawWork = true;
+				}
+			}
+		}
+		return NULL;
+	}
+
 	/** 
 	 *	Hint from a worker thread that it is stalling.
 	 *	@param	StallingThread; Id of the thread that is stalling.
@@ -1291,8 +1492,6 @@ FGraphEvent::~FGraphEvent()
 
 //---
 
-#include "ParallelFor.h"
-
 static void TestParallelFor(const TArray<FString>& Args)
 {
 
@@ -1370,3 +1569,154 @@ static FAutoConsoleCommand TestParallelForCmd(
 	);
 
 
+
+
+/** Small fixed amount of work used as the body of the benchmark tasks. **/
+static uint32 TaskGraphBenchmarkWork(uint32 Seed, int32 WorkSize)
+{
+	uint8 Buffer[256];
+	FMemory::Memset(Buffer, uint8(Seed), sizeof(Buffer));
+	uint32 Crc = Seed;
+	for (int32 Pass = 0; Pass < WorkSize; Pass++)
+	{
+		Crc = FCrc::MemCrc32(Buffer, sizeof(Buffer), Crc);
+	}
+	return Crc;
+}
+
+/** Task that fans out a number of children from a worker thread and does not complete until they all do. **/
+class FTaskGraphBenchmarkFanOutTask
+{
+	int32 NumChildren;
+	int32 WorkSize;
+	FThreadSafeCounter& Checksum;
+public:
+	FTaskGraphBenchmarkFanOutTask(int32 InNumChildren, int32 InWorkSize, FThreadSafeCounter& InChecksum)
+		: NumChildren(InNumChildren)
+		, WorkSize(InWorkSize)
+		, Checksum(InChecksum)
+	{
+	}
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FTaskGraphBenchmarkFanOutTask, STATGROUP_TaskGraphTasks);
+	}
+	static FORCEINLINE ENamedThreads::Type GetDesiredThread()
+	{
+		return ENamedThreads::AnyThread;
+	}
+	static FORCEINLINE ESubsequentsMode::Type GetSubsequentsMode()
+	{
+		return ESubsequentsMode::TrackSubsequents;
+	}
+	void DoTask(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+	{
+		for (int32 Child = 0; Child < NumChildren; Child++)
+		{
+			int32 LocalWorkSize = WorkSize;
+			FThreadSafeCounter* LocalChecksum = &Checksum;
+			MyCompletionGraphEvent->DontCompleteUntil(FFunctionGraphTask::CreateAndDispatchWhenReady([Child, LocalWorkSize, LocalChecksum]()
+				{
+					LocalChecksum->Add(int32(TaskGraphBenchmarkWork(uint32(Child), LocalWorkSize) & 1));
+				}, TStatId()));
+		}
+	}
+};
+
+/**
+ *	Runs the task graph micro benchmarks: fan out / fan in, nested ParallelFor and dependency chains.
+ *	Each benchmark is run with the shared queue only and then with the work stealing deques so the schedulers can be compared.
+ *	Usage: TaskGraph.Benchmark [Iterations] [WorkSize]
+**/
+static void TaskGraphBenchmark(const TArray<FString>& Args)
+{
+	check(IsInGameThread());
+	const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10;
+	const int32 WorkSize = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 0) : 4;
+	const int32 SavedUseWorkStealing = GTaskGraphUseWorkStealing;
+
+	UE_LOG(LogConsoleResponse, Display, TEXT("Task graph benchmark: %d worker threads, %d iterations, work size %d, ParallelFor batch size %d"), FTaskGraphInterface::Get().GetNumWorkerThreads(), Iterations, WorkSize, GTaskGraphParallelForBatchSize);
+
+	for (int32 Mode = 0; Mode < 2; Mode++)
+	{
+		GTaskGraphUseWorkStealing = Mode;
+		const TCHAR* ModeName = Mode ? TEXT("work stealing") : TEXT("shared queue");
+
+		// fan out / fan in: roots on worker threads each spawn children and complete when the children do
+		{
+			const int32 NumRoots = 16;
+			const int32 NumChildren = 256;
+			FThreadSafeCounter Checksum;
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+			{
+				FGraphEventArray Roots;
+				for (int32 Root = 0; Root < NumRoots; Root++)
+				{
+					Roots.Add(TGraphTask<FTaskGraphBenchmarkFanOutTask>::CreateTask().ConstructAndDispatchWhenReady(NumChildren, WorkSize, Checksum));
+				}
+				FTaskGraphInterface::Get().WaitUntilTasksComplete(Roots, ENamedThreads::GameThread);
+			}
+			UE_LOG(LogConsoleResponse, Display, TEXT("  [%s] fan out/fan in (%d x %d tasks): %7.3fms per iteration"), ModeName, NumRoots, NumChildren, float(FPlatformTime::Seconds() - StartTime) * 1000.0f / Iterations);
+		}
+
+		// nested ParallelFor
+		{
+			const int32 NumOuter = 64;
+			const int32 NumInner = 64;
+			FThreadSafeCounter Checksum;
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+			{
+				ParallelFor(NumOuter, [&Checksum, WorkSize, NumInner](int32 Outer)
+				{
+					ParallelFor(NumInner, [&Checksum, WorkSize, NumInner, Outer](int32 Inner)
+					{
+						Checksum.Add(int32(TaskGraphBenchmarkWork(uint32(Outer * NumInner + Inner), WorkSize) & 1));
+					});
+				});
+			}
+			UE_LOG(LogConsoleResponse, Display, TEXT("  [%s] nested ParallelFor (%d x %d): %7.3fms per iteration"), ModeName, NumOuter, NumInner, float(FPlatformTime::Seconds() - StartTime) * 1000.0f / Iterations);
+		}
+
+		// dependency chains: each link is queued by its prerequisite as it completes
+		{
+			const int32 NumChains = 32;
+			const int32 ChainLength = 64;
+			FThreadSafeCounter Checksum;
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+			{
+				FGraphEventArray Tails;
+				for (int32 Chain = 0; Chain < NumChains; Chain++)
+				{
+					FGraphEventRef Previous;
+					for (int32 Link = 0; Link < ChainLength; Link++)
+					{
+						FGraphEventArray Prerequisites;
+						if (Previous.GetReference())
+						{
+							Prerequisites.Add(Previous);
+						}
+						FThreadSafeCounter* LocalChecksum = &Checksum;
+						Previous = FFunctionGraphTask::CreateAndDispatchWhenReady([Link, WorkSize, LocalChecksum]()
+							{
+								LocalChecksum->Add(int32(TaskGraphBenchmarkWork(uint32(Link), WorkSize) & 1));
+							}, TStatId(), &Prerequisites);
+					}
+					Tails.Add(Previous);
+				}
+				FTaskGraphInterface::Get().WaitUntilTasksComplete(Tails, ENamedThreads::GameThread);
+			}
+			UE_LOG(LogConsoleResponse, Display, TEXT("  [%s] dependency chains (%d x %d): %7.3fms per iteration"), ModeName, NumChains, ChainLength, float(FPlatformTime::Seconds() - StartTime) * 1000.0f / Iterations);
+		}
+	}
+
+	GTaskGraphUseWorkStealing = SavedUseWorkStealing;
+}
+
+static FAutoConsoleCommand TaskGraphBenchmarkCmd(
+	TEXT("TaskGraph.Benchmark"),
+	TEXT("Runs fan out/fan in, nested ParallelFor and dependency chain benchmarks with and without the work stealing deques. Args: [Iterations] [WorkSize]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&TaskGraphBenchmark)
+	);
@@ -83,6 +83,16 @@ SIZE_T FMemory::GetAllocSize( void* Original )
 	return GMalloc->GetAllocationSize( Original, Size ) ? Size : 0;
 }
 
+void FMemory::Trim()
+{
+	if( !GMalloc )
+	{
+		GCreateMalloc();	
+		CA_ASSUME( GMalloc != NULL );	// Don't want to assert, but suppress static analysis warnings about potentially NULL GMalloc
+	}
+	GMalloc->Trim();
+}
+
 void FMemory::TestMemory()
 {
 #if !UE_BUILD_SHIPPING
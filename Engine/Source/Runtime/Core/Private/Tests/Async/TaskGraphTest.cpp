@@ -0,0 +1,87 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+#include "TaskGraphInterfaces.h"
+#include "ParallelFor.h"
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTaskGraphWorkStealingTest, "System.Core.Async.TaskGraph", EAutomationTestFlags::ATF_Editor)
+
+
+bool FTaskGraphWorkStealingTest::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* UseWorkStealing = IConsoleManager::Get().FindConsoleVariable(TEXT("TaskGraph.UseWorkStealing"));
+	if (!TestNotNull(TEXT("TaskGraph.UseWorkStealing must exist"), UseWorkStealing))
+	{
+		return false;
+	}
+	const int32 SavedUseWorkStealing = UseWorkStealing->GetInt();
+
+	for (int32 Mode = 0; Mode < 2; Mode++)
+	{
+		UseWorkStealing->Set(Mode);
+
+		// every index must be visited exactly once, regardless of the batch size
+		for (int32 BatchSize = 1; BatchSize <= 64; BatchSize *= 4)
+		{
+			TArray<int32> Visits;
+			Visits.AddZeroed(10007);
+			ParallelFor(Visits.Num(), [&Visits](int32 Index)
+			{
+				FPlatformAtomics::InterlockedIncrement(&Visits[Index]);
+			}, false, BatchSize);
+
+			bool bAllVisitedOnce = true;
+			for (int32 Index = 0; Index < Visits.Num(); Index++)
+			{
+				bAllVisitedOnce = bAllVisitedOnce && Visits[Index] == 1;
+			}
+			TestTrue(FString::Printf(TEXT("ParallelFor with batch size %d must visit every index once (work stealing %d)"), BatchSize, Mode), bAllVisitedOnce);
+		}
+
+		// nested ParallelFor queues from worker threads
+		{
+			FThreadSafeCounter Count;
+			ParallelFor(32, [&Count](int32 Outer)
+			{
+				ParallelFor(32, [&Count](int32 Inner)
+				{
+					Count.Increment();
+				});
+			});
+			TestEqual(FString::Printf(TEXT("Nested ParallelFor must run every body (work stealing %d)"), Mode), Count.GetValue(), 32 * 32);
+		}
+
+		// a dependency chain must run in order even though each link is queued locally by its prerequisite
+		{
+			TArray<int32> Order;
+			FGraphEventRef Previous;
+			for (int32 Link = 0; Link < 256; Link++)
+			{
+				FGraphEventArray Prerequisites;
+				if (Previous.GetReference())
+				{
+					Prerequisites.Add(Previous);
+				}
+				Previous = FFunctionGraphTask::CreateAndDispatchWhenReady([&Order, Link]()
+				{
+					Order.Add(Link);
+				}, TStatId(), &Prerequisites);
+			}
+			FGraphEventArray Tail;
+			Tail.Add(Previous);
+			FTaskGraphInterface::Get().WaitUntilTasksComplete(Tail, ENamedThreads::GameThread);
+
+			bool bInOrder = Order.Num() == 256;
+			for (int32 Index = 0; bInOrder && Index < Order.Num(); Index++)
+			{
+				bInOrder = Order[Index] == Index;
+			}
+			TestTrue(FString::Printf(TEXT("Dependency chain must run in order (work stealing %d)"), Mode), bInOrder);
+		}
+	}
+
+	UseWorkStealing->Set(SavedUseWorkStealing);
+	return true;
+}
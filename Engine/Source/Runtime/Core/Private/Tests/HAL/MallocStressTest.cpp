@@ -0,0 +1,216 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "CorePrivatePCH.h"
+#include "AutomationTest.h"
+#include "MallocAnsi.h"
+#include "MallocBinned.h"
+#include "MallocTBB.h"
+#include "MallocJemalloc.h"
+
+
+/** One block of a stress test batch, with its size so the whole block can be checked before it is freed. */
+struct FMallocStressBlock
+{
+	uint8* Ptr;
+	SIZE_T Size;
+};
+
+/**
+ * Worker for the allocator stress test. Every round each thread allocates a batch of mixed size blocks, then
+ * frees the batch its neighbour allocated, so a good part of the frees happen on a different thread than the allocation.
+ * Every block is filled with a pattern that depends on the owning thread, round and index, and the whole block is checked
+ * before it is freed, so blocks that overlap or were handed out twice are counted as errors.
+ */
+class FMallocStressRunnable : public FRunnable
+{
+public:
+	FMallocStressRunnable(FMalloc* InMalloc, int32 InThreadIndex, int32 InNumThreads, int32 InNumRounds, TArray<TArray<FMallocStressBlock>>& InBatches, FThreadSafeCounter& InRoundBarrier, FThreadSafeCounter& InNumErrors)
+		: Malloc(InMalloc)
+		, ThreadIndex(InThreadIndex)
+		, NumThreads(InNumThreads)
+		, NumRounds(InNumRounds)
+		, Batches(InBatches)
+		, RoundBarrier(InRoundBarrier)
+		, NumErrors(InNumErrors)
+		, Random(InThreadIndex * 7919 + 1)
+	{
+	}
+
+	virtual uint32 Run() override
+	{
+		for (int32 Round = 0; Round < NumRounds; Round++)
+		{
+			TArray<FMallocStressBlock>& MyBatch = Batches[ThreadIndex];
+			for (int32 Index = 0; Index < MyBatch.Num(); Index++)
+			{
+				SIZE_T Size = PickSize();
+				uint8* Ptr = (uint8*)Malloc->Malloc(Size, DEFAULT_ALIGNMENT);
+				FMemory::Memset(Ptr, GetPattern(ThreadIndex, Round, Index), Size);
+				MyBatch[Index].Ptr = Ptr;
+				MyBatch[Index].Size = Size;
+			}
+
+			WaitForOtherThreads(Round * 2 + 1);
+
+			const int32 NeighbourIndex = (ThreadIndex + 1) % NumThreads;
+			TArray<FMallocStressBlock>& NeighbourBatch = Batches[NeighbourIndex];
+			for (int32 Index = 0; Index < NeighbourBatch.Num(); Index++)
+			{
+				FMallocStressBlock& Block = NeighbourBatch[Index];
+				const uint8 Pattern = GetPattern(NeighbourIndex, Round, Index);
+				for (SIZE_T Offset = 0; Offset < Block.Size; Offset++)
+				{
+					if (Block.Ptr[Offset] != Pattern)
+					{
+						NumErrors.Increment();
+						break;
+					}
+				}
+				Malloc->Free(Block.Ptr);
+				Block.Ptr = nullptr;
+				Block.Size = 0;
+			}
+
+			WaitForOtherThreads(Round * 2 + 2);
+		}
+		return 0;
+	}
+
+private:
+	/** Mostly small blocks, some medium ones and the occasional large one, roughly what gameplay code does. */
+	SIZE_T PickSize()
+	{
+		float Selector = Random.GetFraction();
+		if (Selector < 0.85f)
+		{
+			return 2 + Random.RandHelper(255);
+		}
+		if (Selector < 0.99f)
+		{
+			return 257 + Random.RandHelper(8 * 1024);
+		}
+		return 32 * 1024 + Random.RandHelper(96 * 1024);
+	}
+
+	/** Neighbouring blocks and the same block in the next round get different patterns. */
+	static uint8 GetPattern(int32 OwnerIndex, int32 Round, int32 Index)
+	{
+		return uint8(OwnerIndex * 37 + Round * 11 + Index * 13 + 1);
+	}
+
+	void WaitForOtherThreads(int32 Phase)
+	{
+		RoundBarrier.Increment();
+		while (RoundBarrier.GetValue() < Phase * NumThreads)
+		{
+			FPlatformProcess::Sleep(0.0f);
+		}
+	}
+
+	FMalloc* Malloc;
+	int32 ThreadIndex;
+	int32 NumThreads;
+	int32 NumRounds;
+	TArray<TArray<FMallocStressBlock>>& Batches;
+	FThreadSafeCounter& RoundBarrier;
+	FThreadSafeCounter& NumErrors;
+	FRandomStream Random;
+};
+
+/**
+ * Runs the stress test against one allocator.
+ * @return seconds taken by all threads
+ */
+static double RunMallocStress(FMalloc* Malloc, int32 NumThreads, int32 NumRounds, int32 BatchSize, FThreadSafeCounter& NumErrors)
+{
+	TArray<TArray<FMallocStressBlock>> Batches;
+	Batches.SetNum(NumThreads);
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+	{
+		Batches[ThreadIndex].AddZeroed(BatchSize);
+	}
+	FThreadSafeCounter RoundBarrier;
+
+	TArray<FMallocStressRunnable*> Runnables;
+	TArray<FRunnableThread*> Threads;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+	{
+		Runnables.Add(new FMallocStressRunnable(Malloc, ThreadIndex, NumThreads, NumRounds, Batches, RoundBarrier, NumErrors));
+		Threads.Add(FRunnableThread::Create(Runnables.Last(), *FString::Printf(TEXT("MallocStress %d"), ThreadIndex)));
+	}
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+	{
+		Threads[ThreadIndex]->WaitForCompletion();
+	}
+	double Seconds = FPlatformTime::Seconds() - StartTime;
+	for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ThreadIndex++)
+	{
+		delete Threads[ThreadIndex];
+		delete Runnables[ThreadIndex];
+	}
+	Malloc->Trim();
+	return Seconds;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMallocStressTest, "System.Core.HAL.Malloc Stress", EAutomationTestFlags::ATF_Editor | EAutomationTestFlags::ATF_Commandlet)
+
+bool FMallocStressTest::RunTest(const FString& Parameters)
+{
+	const int32 NumThreads = FMath::Clamp(FPlatformMisc::NumberOfCores(), 2, 16);
+	const int32 NumRounds = 50;
+	const int32 BatchSize = 4096;
+
+	// the allocators are never destroyed, same as GMalloc
+	static FMallocBinned* BinnedCached = new FMallocBinned(FPlatformMemory::GetConstants().PageSize & MAX_uint32, 0x100000000);
+	static FMallocBinned* BinnedUncached = nullptr;
+	if (!BinnedUncached)
+	{
+		BinnedUncached = new FMallocBinned(FPlatformMemory::GetConstants().PageSize & MAX_uint32, 0x100000000);
+		BinnedUncached->SetUseThreadCache(false);
+	}
+	static FMallocAnsi* Ansi = new FMallocAnsi();
+
+	struct FAllocatorToTest
+	{
+		const TCHAR* Name;
+		FMalloc* Malloc;
+		FAllocatorToTest(const TCHAR* InName, FMalloc* InMalloc)
+			: Name(InName)
+			, Malloc(InMalloc)
+		{
+		}
+	};
+	TArray<FAllocatorToTest> Allocators;
+	Allocators.Add(FAllocatorToTest(TEXT("binned (thread cache)"), BinnedCached));
+	Allocators.Add(FAllocatorToTest(TEXT("binned (no thread cache)"), BinnedUncached));
+	Allocators.Add(FAllocatorToTest(TEXT("ansi"), Ansi));
+#if PLATFORM_SUPPORTS_TBB && TBB_ALLOCATOR_ALLOWED
+	static FMallocTBB* TBB = new FMallocTBB();
+	Allocators.Add(FAllocatorToTest(TEXT("TBB"), TBB));
+#endif
+#if PLATFORM_SUPPORTS_JEMALLOC
+	static FMallocJemalloc* Jemalloc = new FMallocJemalloc();
+	Allocators.Add(FAllocatorToTest(TEXT("jemalloc"), Jemalloc));
+#endif
+
+	AddLogItem(FString::Printf(TEXT("%d threads, %d rounds of %d allocations per thread, every block freed on another thread"), NumThreads, NumRounds, BatchSize));
+	for (const FAllocatorToTest& Allocator : Allocators)
+	{
+		FThreadSafeCounter NumErrors;
+		double Seconds = RunMallocStress(Allocator.Malloc, NumThreads, NumRounds, BatchSize, NumErrors);
+		double NumOps = 2.0 * NumThreads * NumRounds * BatchSize;
+		AddLogItem(FString::Printf(TEXT("%-26s %8.2fms  %6.1f ns/op"), Allocator.Name, Seconds * 1000.0, Seconds * 1e9 / NumOps));
+		TestEqual(FString::Printf(TEXT("%s blocks must keep their contents until freed"), Allocator.Name), NumErrors.GetValue(), 0);
+		TestTrue(FString::Printf(TEXT("%s heap must be valid"), Allocator.Name), Allocator.Malloc->ValidateHeap());
+	}
+
+	// every run uses new threads, their caches must be released when they exit instead of piling up
+	const int32 NumThreadCaches = (int32)BinnedCached->GetNumThreadCaches();
+	FThreadSafeCounter NumErrors;
+	RunMallocStress(BinnedCached, NumThreads, 2, BatchSize, NumErrors);
+	TestEqual(TEXT("binned (thread cache) blocks must keep their contents until freed with new threads"), NumErrors.GetValue(), 0);
+	TestEqual(TEXT("Thread caches left by exited threads"), (int32)BinnedCached->GetNumThreadCaches(), NumThreadCaches);
+	return true;
+}
@@ -8,25 +8,31 @@
 #include "TaskGraphInterfaces.h"
 #include "Function.h"
 
+/** Number of consecutive indices a ParallelFor worker claims at once, see TaskGraph.ParallelForBatchSize. **/
+extern CORE_API int32 GTaskGraphParallelForBatchSize;
+
 /** 
 	*	General purpose parallel for that uses the taskgraph
 	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
 	*	@param Body; Function to call from multiple threads
 	*	@param bForceSingleThread; Mostly used for testing, if true, run single threaded instead.
+	*	@param BatchSize; Number of consecutive indices claimed by a thread at once, 0 to use TaskGraph.ParallelForBatchSize.
 	*	Notes: Please add stats around to calls to parallel for and within your lambda as appropriate. Do not clog the task graph with long running tasks or tasks that block.
 **/
-void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, bool bForceSingleThread = false)
+inline void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, bool bForceSingleThread = false, int32 BatchSize = 0)
 {
 	// struct to hold the working data; this outlives the ParallelFor call; lifetime is controlled by a shared pointer
 	struct FParallelForData
 	{
 		int32 Num;
+		int32 BatchSize;
 		TFunctionRef<void(int32)> Body;
 		FScopedEvent& DoneEvent;
 		FThreadSafeCounter IndexToDo;
 		FThreadSafeCounter NumCompleted;
-		FParallelForData(int32 InNum, TFunctionRef<void(int32)> InBody, FScopedEvent& InDoneEvent)
+		FParallelForData(int32 InNum, int32 InBatchSize, TFunctionRef<void(int32)> InBody, FScopedEvent& InDoneEvent)
 			: Num(InNum)
+			, BatchSize(InBatchSize)
 			, Body(InBody)
 			, DoneEvent(InDoneEvent)
 		{
@@ -35,11 +41,15 @@ void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, bool bForceSingleThr
 		{
 			while (true)
 			{
-				int32 MyIndex = IndexToDo.Increment() - 1;
+				int32 MyIndex = IndexToDo.Add(BatchSize);
 				if (MyIndex < Num)
 				{
-					Body(MyIndex);
-					if (NumCompleted.Increment() == Num)
+					int32 MyNum = FMath::Min<int32>(BatchSize, Num - MyIndex);
+					for (int32 Index = MyIndex; Index < MyIndex + MyNum; Index++)
+					{
+						Body(Index);
+					}
+					if (NumCompleted.Add(MyNum) + MyNum == Num)
 					{
 						DoneEvent.Trigger(); // I was the last one; let parallelfor exit
 					}
@@ -80,10 +90,16 @@ void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, bool bForceSingleThr
 	SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
 	check(Num >= 0);
 
+	if (BatchSize <= 0)
+	{
+		BatchSize = FMath::Max<int32>(GTaskGraphParallelForBatchSize, 1);
+	}
+	int32 NumBatches = (Num + BatchSize - 1) / BatchSize;
+
 	int32 AnyThreadTasks = 0;
-	if (Num > 1 && !bForceSingleThread && FApp::ShouldUseThreadingForPerformance())
+	if (NumBatches > 1 && !bForceSingleThread && FApp::ShouldUseThreadingForPerformance())
 	{
-		AnyThreadTasks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), Num - 1);
+		AnyThreadTasks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), NumBatches - 1);
 	}
 	if (!AnyThreadTasks)
 	{
@@ -96,7 +112,7 @@ void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, bool bForceSingleThr
 	}
 
 	FScopedEvent DoneEvent;
-	TSharedRef<FParallelForData, ESPMode::ThreadSafe> Data = MakeShareable(new FParallelForData(Num, Body, DoneEvent));
+	TSharedRef<FParallelForData, ESPMode::ThreadSafe> Data = MakeShareable(new FParallelForData(Num, BatchSize, Body, DoneEvent));
 	for (int32 Task = 0; Task < AnyThreadTasks; Task++)
 	{
 		TGraphTask<FParallelForTask>::CreateTask().ConstructAndDispatchWhenReady(Data);		
@@ -31,6 +31,19 @@
 #	define USE_FINE_GRAIN_LOCKS
 #endif
 
+// Per thread caches of free small blocks, refilled from and flushed to the pools in batches so most allocations don't take a pool lock
+#if defined USE_FINE_GRAIN_LOCKS && !defined USE_LOCKFREE_DELETE
+#	define USE_THREAD_CACHE
+#endif
+
+#if defined USE_THREAD_CACHE
+	/** Only pools with blocks up to this size are cached per thread */
+	#define THREAD_CACHE_MAX_BLOCK_SIZE (4096)
+	/** Upper bound of the bytes a thread keeps cached per pool, the block count is also clamped to [4,THREAD_CACHE_MAX_BLOCKS_PER_BIN] */
+	#define THREAD_CACHE_MAX_BYTES_PER_BIN (32*1024)
+	#define THREAD_CACHE_MAX_BLOCKS_PER_BIN (64)
+#endif
+
 #include "LockFreeList.h"
 #include "Array.h"
 
@@ -255,6 +268,57 @@ private:
 		}
 	};
 
+#ifdef USE_THREAD_CACHE
+	/**
+	 * Free small blocks owned by a single thread. Allocated from the OS, never from the pools.
+	 * Registered for TLS cleanup, so when an FRunnableThread exits its blocks go back to the pools and the cache is kept for the next new thread.
+	 */
+	struct FThreadCache : public FTlsAutoCleanup
+	{
+		struct FBin
+		{
+			/** Number of valid entries in Blocks */
+			uint32	Num;
+			/** Capacity of this bin, 0 if the pool is not cached */
+			uint32	MaxNum;
+			void*	Blocks[THREAD_CACHE_MAX_BLOCKS_PER_BIN];
+		};
+
+		FBin			Bins[POOL_COUNT];
+		/** Trim epoch this cache was last flushed at, see Trim() */
+		int32			TrimEpoch;
+		/** Link in the list of live thread caches, or of released ones waiting to be reused */
+		FThreadCache*	Next;
+		/** Allocator this cache belongs to */
+		FMallocBinned*	Allocator;
+
+		FThreadCache( FMallocBinned* InAllocator )
+			:	TrimEpoch(0)
+			,	Next(nullptr)
+			,	Allocator(InAllocator)
+		{
+			FMemory::Memzero(Bins);
+		}
+
+		/** Called by FRunnableThread::FreeTls() when the owning thread exits. */
+		virtual ~FThreadCache()
+		{
+			Allocator->ReleaseThreadCache(this);
+		}
+
+		/** The memory comes from the OS and is kept by the allocator for reuse, it is never freed through FMemory. */
+		void operator delete( void* )
+		{
+		}
+	};
+
+	/** TLS value of threads whose cache was released, they use the pools directly from then on. */
+	static FORCEINLINE FThreadCache* GetReleasedThreadCacheMarker()
+	{
+		return (FThreadCache*)(UPTRINT)1;
+	}
+#endif
+
 	uint64 TableAddressLimit;
 
 #ifdef USE_LOCKFREE_DELETE
@@ -271,6 +335,19 @@ private:
 
 	FCriticalSection	AccessGuard;
 
+#ifdef USE_THREAD_CACHE
+	/** TLS slot holding this allocator's FThreadCache for the current thread */
+	uint32				ThreadCacheTlsSlot;
+	/** Incremented by Trim(), threads flush their cache the next time they see a new value */
+	volatile int32		ThreadCacheTrimEpoch;
+	/** Thread caches of live threads, protected by AccessGuard */
+	FThreadCache*		FirstThreadCache;
+	/** Caches released by exited threads, reused before allocating new ones. Protected by AccessGuard */
+	FThreadCache*		FirstFreeThreadCache;
+	/** When false all allocations go straight to the pools */
+	bool				bUseThreadCache;
+#endif
+
 	// PageSize dependent constants
 	uint64 MaxHashBuckets; 
 	uint64 MaxHashBucketBits;
@@ -327,12 +404,20 @@ private:
 
 	FORCEINLINE void TrackStats(FPoolTable* Table, SIZE_T Size)
 	{
+#if STATS
+		TrackRequestStats(Table, Size);
+		Table->ActiveRequests++;
+		Table->MaxActiveRequests = FMath::Max(Table->MaxActiveRequests, Table->ActiveRequests);
+#endif
+	}
+
+	/** Stats of a single request, without the active request count (blocks held in thread caches already count as active). */
+	FORCEINLINE void TrackRequestStats(FPoolTable* Table, SIZE_T Size)
+	{
 #if STATS
 		// keep track of memory lost to padding
 		Table->TotalWaste += Table->BlockSize - Size;
 		Table->TotalRequests++;
-		Table->ActiveRequests++;
-		Table->MaxActiveRequests = FMath::Max(Table->MaxActiveRequests, Table->ActiveRequests);
 		Table->MaxRequest = Size > Table->MaxRequest ? Size : Table->MaxRequest;
 		Table->MinRequest = Size < Table->MinRequest ? Size : Table->MinRequest;
 #endif
@@ -597,52 +682,279 @@ private:
 #ifdef USE_FINE_GRAIN_LOCKS
 			FScopeLock TableLock(&Table->CriticalSection);
 #endif
+			FreeBlockToPool(Table, Pool, Ptr, BasePtr);
+		}
+		else
+		{
+			// Free an OS allocation.
+			checkSlow(!((UPTRINT)Ptr & (PageSize-1)));
+			SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
+			STAT(UsedCurrent -= Pool->GetBytes());
+			STAT(OsCurrent -= OsBytes);
+			STAT(WasteCurrent -= OsBytes - Pool->GetBytes());
+			OSFree(Ptr, OsBytes);
+		}
+
+		MEM_TIME(MemTime += FPlatformTime::Seconds());
+	}
+
+	/**
+	* Returns a pooled block to its pool, releasing the pool to the OS when it becomes empty. It's the callers
+	* responsibility to lock the table before calling this.
+	*/
+	FORCEINLINE void FreeBlockToPool( FPoolTable* Table, FPoolInfo* Pool, void* Ptr, UPTRINT BasePtr )
+	{
+#if STATS
+		Table->ActiveRequests--;
+#endif
+		// If this pool was exhausted, move to available list.
+		if( !Pool->FirstMem )
+		{
+			Pool->Unlink();
+			Pool->Link( Table->FirstPool );
+		}
+
+		// Free a pooled allocation.
+		FFreeMem* Free		= (FFreeMem*)Ptr;
+		Free->NumFreeBlocks	= 1;
+		Free->Next			= Pool->FirstMem;
+		Pool->FirstMem		= Free;
+		STAT(UsedCurrent -= Table->BlockSize);
+
+		// Free this pool.
+		checkSlow(Pool->Taken >= 1);
+		if( --Pool->Taken == 0 )
+		{
 #if STATS
-			Table->ActiveRequests--;
+			Table->NumActivePools--;
 #endif
-			// If this pool was exhausted, move to available list.
-			if( !Pool->FirstMem )
+			// Free the OS memory.
+			SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
+			STAT(OsCurrent -= OsBytes);
+			STAT(WasteCurrent -= OsBytes - Pool->GetBytes());
+			Pool->Unlink();
+			Pool->SetAllocationSizes(0, 0, 0, BinnedOSTableIndex);
+			OSFree((void*)BasePtr, OsBytes);
+		}
+	}
+
+#ifdef USE_THREAD_CACHE
+	/**
+	 * Returns the thread cache of the calling thread, creating it on first use. Flushes the cache if
+	 * Trim() was called since the last time this thread looked.
+	 * @return nullptr if the thread is exiting and already released its cache
+	 */
+	FORCEINLINE FThreadCache* GetThreadCache()
+	{
+		FThreadCache* Cache = (FThreadCache*)FPlatformTLS::GetTlsValue(ThreadCacheTlsSlot);
+		if( !Cache )
+		{
+			Cache = CreateThreadCache();
+		}
+		else if( Cache == GetReleasedThreadCacheMarker() )
+		{
+			return nullptr;
+		}
+		else if( Cache->TrimEpoch != ThreadCacheTrimEpoch )
+		{
+			FlushThreadCache(Cache);
+		}
+		return Cache;
+	}
+
+	FThreadCache* CreateThreadCache()
+	{
+		void* CacheMemory = nullptr;
+		{
+			FScopeLock MainLock(&AccessGuard);
+			if( FirstFreeThreadCache )
 			{
-				Pool->Unlink();
-				Pool->Link( Table->FirstPool );
+				CacheMemory = FirstFreeThreadCache;
+				FirstFreeThreadCache = FirstFreeThreadCache->Next;
 			}
+		}
+		if( !CacheMemory )
+		{
+			// The cache must not come from the pools it is caching
+			SIZE_T CacheBytes = Align(sizeof(FThreadCache), PageSize);
+			CacheMemory = FPlatformMemory::BinnedAllocFromOS(CacheBytes);
+			if( !CacheMemory )
+			{
+				OutOfMemory(CacheBytes);
+			}
+			FScopeLock MainLock(&AccessGuard);
+			STAT(OsPeak = FMath::Max(OsPeak, OsCurrent += CacheBytes));
+			STAT(WastePeak = FMath::Max(WastePeak, WasteCurrent += CacheBytes));
+		}
+		FThreadCache* Cache = new(CacheMemory) FThreadCache(this);
+		for( uint32 i = 0; i < POOL_COUNT; i++ )
+		{
+			uint32 BlockSize = PoolTable[i].BlockSize;
+			Cache->Bins[i].MaxNum = BlockSize <= THREAD_CACHE_MAX_BLOCK_SIZE ? FMath::Clamp<uint32>(THREAD_CACHE_MAX_BYTES_PER_BIN / BlockSize, 4, THREAD_CACHE_MAX_BLOCKS_PER_BIN) : 0;
+		}
+		Cache->TrimEpoch = ThreadCacheTrimEpoch;
+		{
+			FScopeLock MainLock(&AccessGuard);
+			Cache->Next = FirstThreadCache;
+			FirstThreadCache = Cache;
+		}
+		// Set before registering, registering allocates and may come back here when this is GMalloc.
+		// Threads that aren't FRunnableThreads (e.g. the main thread) are not registered and keep their cache.
+		FPlatformTLS::SetTlsValue(ThreadCacheTlsSlot, Cache);
+		Cache->Register();
+		return Cache;
+	}
 
-			// Free a pooled allocation.
-			FFreeMem* Free		= (FFreeMem*)Ptr;
-			Free->NumFreeBlocks	= 1;
-			Free->Next			= Pool->FirstMem;
-			Pool->FirstMem		= Free;
-			STAT(UsedCurrent -= Table->BlockSize);
+	/**
+	 * Returns the blocks of an exiting thread's cache to the pools and keeps the cache for reuse. Called from the owning thread.
+	 * Frees made afterwards, while the rest of the thread's TLS is cleaned up, go straight to the pools.
+	 */
+	void ReleaseThreadCache( FThreadCache* Cache )
+	{
+		FPlatformTLS::SetTlsValue(ThreadCacheTlsSlot, GetReleasedThreadCacheMarker());
+		FlushThreadCache(Cache);
+
+		FScopeLock MainLock(&AccessGuard);
+		for( FThreadCache** Link = &FirstThreadCache; *Link; Link = &(*Link)->Next )
+		{
+			if( *Link == Cache )
+			{
+				*Link = Cache->Next;
+				break;
+			}
+		}
+		Cache->Next = FirstFreeThreadCache;
+		FirstFreeThreadCache = Cache;
+	}
 
-			// Free this pool.
-			checkSlow(Pool->Taken >= 1);
-			if( --Pool->Taken == 0 )
+	/**
+	 * Takes a batch of blocks from a pool into an empty bin of the calling thread's cache.
+	 * @return one block for the caller, which is not added to the bin
+	 */
+	FFreeMem* RefillThreadCacheBin( FThreadCache::FBin& Bin, FPoolTable* Table )
+	{
+		checkSlow(Bin.Num == 0);
+		uint32 RefillNum = FMath::Max<uint32>(Bin.MaxNum / 2, 1);
+		FScopeLock TableLock(&Table->CriticalSection);
+		for( uint32 i = 0; i < RefillNum; i++ )
+		{
+			FPoolInfo* Pool = Table->FirstPool;
+			if( !Pool )
 			{
+				Pool = AllocatePoolMemory(Table, BINNED_ALLOC_POOL_SIZE, Table->BlockSize);
+			}
+			// blocks held in thread caches count as active requests of their pool
 #if STATS
-				Table->NumActivePools--;
+			Table->ActiveRequests++;
+			Table->MaxActiveRequests = FMath::Max(Table->MaxActiveRequests, Table->ActiveRequests);
 #endif
-				// Free the OS memory.
-				SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
-				STAT(OsCurrent -= OsBytes);
-				STAT(WasteCurrent -= OsBytes - Pool->GetBytes());
-				Pool->Unlink();
-				Pool->SetAllocationSizes(0, 0, 0, BinnedOSTableIndex);
-				OSFree((void*)BasePtr, OsBytes);
+			Bin.Blocks[Bin.Num++] = AllocateBlockFromPool(Table, Pool);
+			// UsedCurrent only counts blocks handed out to callers, see AllocateFromThreadCache()
+			STAT(UsedCurrent -= Table->BlockSize);
+		}
+		return (FFreeMem*)Bin.Blocks[--Bin.Num];
+	}
+
+	/** Returns the oldest NumToFlush blocks of a bin to their pool under a single lock. */
+	void FlushThreadCacheBin( FThreadCache::FBin& Bin, FPoolTable* Table, uint32 NumToFlush )
+	{
+		checkSlow(NumToFlush <= Bin.Num);
+		if( !NumToFlush )
+		{
+			return;
+		}
+		{
+			FScopeLock TableLock(&Table->CriticalSection);
+			for( uint32 i = 0; i < NumToFlush; i++ )
+			{
+				UPTRINT BasePtr;
+				FPoolInfo* Pool = FindPoolInfo((UPTRINT)Bin.Blocks[i], BasePtr);
+				checkSlow(Pool && MemSizeToPoolTable[Pool->TableIndex] == Table);
+				// cached blocks were already taken out of UsedCurrent when they were freed to the cache
+				STAT(UsedCurrent += Table->BlockSize);
+				FreeBlockToPool(Table, Pool, Bin.Blocks[i], BasePtr);
 			}
 		}
-		else
+		Bin.Num -= NumToFlush;
+		if( Bin.Num )
 		{
-			// Free an OS allocation.
-			checkSlow(!((UPTRINT)Ptr & (PageSize-1)));
-			SIZE_T OsBytes = Pool->GetOsBytes(PageSize, BinnedOSTableIndex);
-			STAT(UsedCurrent -= Pool->GetBytes());
-			STAT(OsCurrent -= OsBytes);
-			STAT(WasteCurrent -= OsBytes - Pool->GetBytes());
-			OSFree(Ptr, OsBytes);
+			FMemory::Memmove(&Bin.Blocks[0], &Bin.Blocks[NumToFlush], Bin.Num * sizeof(void*));
 		}
+	}
 
-		MEM_TIME(MemTime += FPlatformTime::Seconds());
+	/** Returns every block of a thread cache to the pools. Must be called from the owning thread. */
+	void FlushThreadCache( FThreadCache* Cache )
+	{
+		Cache->TrimEpoch = ThreadCacheTrimEpoch;
+		for( uint32 i = 0; i < POOL_COUNT; i++ )
+		{
+			FlushThreadCacheBin(Cache->Bins[i], &PoolTable[i], Cache->Bins[i].Num);
+		}
+	}
+
+	/**
+	 * Pushes a freed block into the calling thread's cache if it belongs to a cached pool.
+	 * @return false if the block was not cached and must be freed normally
+	 */
+	FORCEINLINE bool FreeToThreadCache( void* Ptr )
+	{
+		UPTRINT BasePtr;
+		FPoolInfo* Pool = FindPoolInfo((UPTRINT)Ptr, BasePtr);
+		if( !Pool || Pool->TableIndex >= BinnedSizeLimit )
+		{
+			return false;
+		}
+		FPoolTable* Table = MemSizeToPoolTable[Pool->TableIndex];
+		uint32 BinIndex = (uint32)(Table - PoolTable);
+		FThreadCache* Cache = GetThreadCache();
+		if( !Cache || !Cache->Bins[BinIndex].MaxNum )
+		{
+			return false;
+		}
+		FThreadCache::FBin& Bin = Cache->Bins[BinIndex];
+		if( Bin.Num == Bin.MaxNum )
+		{
+			FlushThreadCacheBin(Bin, Table, Bin.MaxNum / 2);
+		}
+		Bin.Blocks[Bin.Num++] = Ptr;
+		STAT(CurrentAllocs--);
+		STAT(UsedCurrent -= Table->BlockSize);
+		return true;
+	}
+
+	/**
+	 * Allocates from the calling thread's cache, refilling the bin from the pool if it is empty.
+	 * The stats are kept like the locked path does, except they are updated without the table lock so they are
+	 * approximate while several threads allocate, same as CurrentAllocs always was. Blocks sitting in a cache count
+	 * as active requests of their pool table but not as used memory.
+	 * @return nullptr if the pool is not cached for this thread
+	 */
+	FORCEINLINE FFreeMem* AllocateFromThreadCache( FPoolTable* Table, SIZE_T Size )
+	{
+		FThreadCache* Cache = GetThreadCache();
+		if( !Cache )
+		{
+			return nullptr;
+		}
+		FThreadCache::FBin& Bin = Cache->Bins[(uint32)(Table - PoolTable)];
+		FFreeMem* Free;
+		if( Bin.Num )
+		{
+			Free = (FFreeMem*)Bin.Blocks[--Bin.Num];
+		}
+		else if( Bin.MaxNum )
+		{
+			Free = RefillThreadCacheBin(Bin, Table);
+		}
+		else
+		{
+			return nullptr;
+		}
+		TrackRequestStats(Table, Size);
+		STAT(UsedPeak = FMath::Max(UsedPeak, UsedCurrent += Table->BlockSize));
+		return Free;
 	}
+#endif
 
 	void PushFreeLockless(void* Ptr)
 	{
@@ -805,6 +1117,13 @@ public:
 		,	PendingFreeList(nullptr)
 		,	bFlushingFrees(false)
 		,	bDoneFreeListInit(false)
+#endif
+#ifdef USE_THREAD_CACHE
+		,	ThreadCacheTlsSlot(FPlatformTLS::AllocTlsSlot())
+		,	ThreadCacheTrimEpoch(0)
+		,	FirstThreadCache(nullptr)
+		,	FirstFreeThreadCache(nullptr)
+		,	bUseThreadCache(true)
 #endif
 		,	HashBuckets(nullptr)
 		,	HashBucketFreeList(nullptr)
@@ -950,6 +1269,17 @@ public:
 		{
 			// Allocate from pool.
 			FPoolTable* Table = MemSizeToPoolTable[Size];
+#ifdef USE_THREAD_CACHE
+			if( bUseThreadCache )
+			{
+				Free = AllocateFromThreadCache(Table, Size);
+				if( Free )
+				{
+					MEM_TIME(MemTime += FPlatformTime::Seconds());
+					return Free;
+				}
+			}
+#endif
 #ifdef USE_FINE_GRAIN_LOCKS
 			FScopeLock TableLock(&Table->CriticalSection);
 #endif
@@ -1098,9 +1428,55 @@ public:
 			return;
 		}
 
+#ifdef USE_THREAD_CACHE
+		if( bUseThreadCache && FreeToThreadCache(Ptr) )
+		{
+			return;
+		}
+#endif
 		PushFreeLockless(Ptr);
 	}
 
+	/**
+	 * Flushes the calling thread's cache and asks every other thread to flush its own the next time it allocates or frees.
+	 */
+	virtual void Trim() override
+	{
+#ifdef USE_THREAD_CACHE
+		FPlatformAtomics::InterlockedIncrement(&ThreadCacheTrimEpoch);
+		FThreadCache* Cache = (FThreadCache*)FPlatformTLS::GetTlsValue(ThreadCacheTlsSlot);
+		if( Cache && Cache != GetReleasedThreadCacheMarker() )
+		{
+			FlushThreadCache(Cache);
+		}
+#endif
+	}
+
+	/**
+	 * Enables or disables the per thread caches. Blocks already cached stay cached until the next Trim().
+	 * Meant to be called before the allocator is used, e.g. to compare against the uncached path.
+	 */
+	void SetUseThreadCache( bool bInUseThreadCache )
+	{
+#ifdef USE_THREAD_CACHE
+		bUseThreadCache = bInUseThreadCache;
+#endif
+	}
+
+	/** @return the number of thread caches owned by live threads, caches of exited threads are not counted */
+	uint32 GetNumThreadCaches()
+	{
+		uint32 NumThreadCaches = 0;
+#ifdef USE_THREAD_CACHE
+		FScopeLock MainLock(&AccessGuard);
+		for( FThreadCache* Cache = FirstThreadCache; Cache; Cache = Cache->Next )
+		{
+			NumThreadCaches++;
+		}
+#endif
+		return NumThreadCaches;
+	}
+
 	/**
 	 * If possible determine the size of the memory allocated at the given address
 	 *
@@ -1295,6 +1671,23 @@ public:
 			BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "" ) );
 			BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "%iK allocated in pools (with %iK slack and %iK waste). Efficiency %.2f%%" ), TotalMemory, TotalSlack, TotalWaste, TotalMemory ? 100.0f * (TotalMemory - TotalWaste) / TotalMemory : 100.0f );
 			BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "Allocations %i Current / %i Total (in %i pools)" ), TotalActiveRequests, TotalTotalRequests, TotalPools );
+#ifdef USE_THREAD_CACHE
+			{
+				// The counts of other threads' caches are read without synchronization, this is only an estimate
+				uint32 NumThreadCaches = 0;
+				SIZE_T ThreadCachedBytes = 0;
+				FScopeLock MainLock(&AccessGuard);
+				for( FThreadCache* Cache = FirstThreadCache; Cache; Cache = Cache->Next )
+				{
+					NumThreadCaches++;
+					for( uint32 i = 0; i < POOL_COUNT; i++ )
+					{
+						ThreadCachedBytes += Cache->Bins[i].Num * PoolTable[i].BlockSize;
+					}
+				}
+				BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "%iK held in %i thread caches (%s)" ), (uint32)(ThreadCachedBytes / 1024), NumThreadCaches, bUseThreadCache ? TEXT("enabled") : TEXT("disabled") );
+			}
+#endif
 			BufferedOutput.CategorizedLogf( LogMemory.GetCategoryName(), ELogVerbosity::Log, TEXT( "" ) );
 #endif
 #endif
@@ -93,6 +93,12 @@ public:
 		return( UsedMalloc->ValidateHeap() );
 	}
 
+	virtual void Trim() override
+	{
+		FScopeLock ScopeLock( &SynchronizationObject );
+		UsedMalloc->Trim();
+	}
+
 	virtual bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) override
 	{
 		FScopeLock ScopeLock( &SynchronizationObject );
@@ -133,6 +133,13 @@ public:
 		return( true );
 	}
 
+	/**
+	 * Releases memory held in allocator side caches, for example after a garbage collection.
+	 */
+	virtual void Trim()
+	{
+	}
+
 	/**
 	* If possible determine the size of the memory allocated at the given address
 	*
@@ -481,6 +481,12 @@ public:
 		return( UsedMalloc->ValidateHeap() );
 	}
 
+	virtual void Trim() override
+	{
+		FScopeLock Lock( &CriticalSection );
+		UsedMalloc->Trim();
+	}
+
 	/**
 	* If possible determine the size of the memory allocated at the given address
 	*
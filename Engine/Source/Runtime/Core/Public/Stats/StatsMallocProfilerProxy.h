@@ -95,6 +95,11 @@ public:
 		return UsedMalloc->ValidateHeap();
 	}
 
+	virtual void Trim() override
+	{
+		UsedMalloc->Trim();
+	}
+
 	virtual bool Exec( UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar ) override
 	{
 		return UsedMalloc->Exec( InWorld, Cmd, Ar);
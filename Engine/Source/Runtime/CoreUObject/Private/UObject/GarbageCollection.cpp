@@ -1315,6 +1315,9 @@ void CollectGarbageInternal(EObjectFlags KeepFlags, bool bPerformFullPurge)
 		IncrementalPurgeGarbage( false );	
 	}
 
+	// Give memory cached by the allocator (e.g. per thread free lists) back to the shared pools
+	FMemory::Trim();
+
 	// Route callbacks to verify GC assumptions
 	FCoreUObjectDelegates::PostGarbageCollect.Broadcast();
 }
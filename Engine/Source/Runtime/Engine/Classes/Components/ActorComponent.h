@@ -387,6 +387,14 @@ public:
 	 * @param ThisTickFunction - Internal tick function struct that caused this to run
 	 */
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction);
+	/**
+	 * Read-only part of the tick, only called if PrimaryComponentTick.bRunInParallelBatch is set. Runs on a task graph worker
+	 * before the component's tick group, in parallel with other components, so it may only read the world and write to this
+	 * component; anything else has to go through FTickTaskManagerInterface::DeferToGameThread. TickComponent still runs afterwards.
+	 *
+	 * @param DeltaTime - The time since the last tick.
+	 */
+	virtual void ParallelTickComponent(float DeltaTime) {}
 	/** 
 	 * Set up a tick function for a component in the standard way. 
 	 * Tick after the actor. Don't tick if the actor is static, or if the actor is a template or if this is a "NeverTick" component.
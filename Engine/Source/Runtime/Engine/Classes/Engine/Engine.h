@@ -278,6 +278,12 @@ struct FWorldContext
 
 	FString PIERemapPrefix;
 
+	/**
+	 * Set for additional game worlds hosted next to the main one in the same process (e.g. several small matches on one dedicated server).
+	 * Maps loaded into such a context go into their own renamed packages, the same way PIE instances get theirs, so each context has its own copy.
+	 */
+	int32	HostedWorldIndex;
+
 	bool	RunAsDedicated;
 
 	/** Is this world context waiting for an online login to complete (for PIE) */
@@ -326,6 +332,7 @@ struct FWorldContext
 		, GameViewport(nullptr)
 		, OwningGameInstance(nullptr)
 		, PIEInstance(INDEX_NONE)
+		, HostedWorldIndex(INDEX_NONE)
 		, RunAsDedicated(false)
 		, bWaitingOnOnlineSubsystem(false)
 		, AudioDeviceHandle(INDEX_NONE)
@@ -165,6 +165,13 @@ public:
 	/** If false, this tick will run on the game thread, otherwise it will run on any thread in parallel with the game thread and in parallel with other "async ticks" **/
 	uint32 bRunOnAnyThread:1;
 
+	/**
+	 * If true, ExecuteParallelTick is called for this tick function from a parallel batch on the task graph workers before its
+	 * tick group runs. Only the parallel half runs off the game thread; ExecuteTick still runs on the game thread as usual.
+	 * Not used for functions ticking during the physics simulation.
+	 **/
+	uint32 bRunInParallelBatch:1;
+
 private:
 	/** If true, means that this tick function is in the master array of tick functions **/
 	uint32 bRegistered:1;
@@ -217,6 +224,26 @@ public:
 	/** Returns whether the tick function is currently enabled */
 	bool IsTickFunctionEnabled() const { return bTickEnabled; }
 
+	/**
+	 * Runs this tick from inside another tick function's task, for tick functions that tick a group of others themselves.
+	 * This tick function should not be registered; work it holds back with its completion handle holds back the outer task instead.
+	 * @param DeltaTime - frame time to advance, in seconds
+	 * @param TickType - kind of tick for this frame
+	 * @param CurrentThread - thread we are executing on
+	 * @param OuterCompletionGraphEvent - completion event of the task we are running in
+	 **/
+	void ExecuteNestedTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& OuterCompletionGraphEvent)
+	{
+		CompletionHandle = OuterCompletionGraphEvent;
+		ExecuteTick(DeltaTime, TickType, CurrentThread, OuterCompletionGraphEvent);
+		CompletionHandle = NULL;
+	}
+	/** Runs the parallel part of this tick from inside another tick function's ExecuteParallelTick, see ExecuteNestedTick */
+	void ExecuteNestedParallelTick(float DeltaTime, ELevelTick TickType)
+	{
+		ExecuteParallelTick(DeltaTime, TickType);
+	}
+
 	/**
 	* Gets the current completion handle of this tick function, so it can be delayed until a later point when some additional
 	* tasks have been completed.  Only valid after TG_PreAsyncWork has started and then only until the TickFunction itself has
@@ -282,6 +309,16 @@ private:
 	{
 		check(0); // you cannot make this pure virtual in script because it wants to create constructors.
 	}
+	/**
+	 * Read-only half of the tick for functions with bRunInParallelBatch, called on a task graph worker before the tick group
+	 * is released, in parallel with the other batched functions of the group. It must not modify anything but the target itself;
+	 * any other change has to go through FTickTaskManagerInterface::DeferToGameThread and is applied before the group's ticks run.
+	 * @param DeltaTime - frame time to advance, in seconds
+	 * @param TickType - kind of tick for this frame
+	 **/
+	virtual void ExecuteParallelTick(float DeltaTime, ELevelTick TickType)
+	{
+	}
 	/** Abstract function to describe this tick. Used to print messages about illegal cycles in the dependency graph **/
 	virtual FString DiagnosticMessage()
 	{
@@ -322,6 +359,7 @@ struct FActorTickFunction : public FTickFunction
 		* @param MyCompletionGraphEvent - completion event for this task. Useful for holding the completetion of this task until certain child tasks are complete.
 	**/
 	ENGINE_API virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	ENGINE_API virtual void ExecuteParallelTick(float DeltaTime, ELevelTick TickType) override;
 	/** Abstract function to describe this tick. Used to print messages about illegal cycles in the dependency graph **/
 	ENGINE_API virtual FString DiagnosticMessage() override;
 };
@@ -354,6 +392,7 @@ struct FActorComponentTickFunction : public FTickFunction
 		* @param MyCompletionGraphEvent - completion event for this task. Useful for holding the completetion of this task until certain child tasks are complete.
 	**/
 	ENGINE_API virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	ENGINE_API virtual void ExecuteParallelTick(float DeltaTime, ELevelTick TickType) override;
 	/** Abstract function to describe this tick. Used to print messages about illegal cycles in the dependency graph **/
 	ENGINE_API virtual FString DiagnosticMessage() override;
 };
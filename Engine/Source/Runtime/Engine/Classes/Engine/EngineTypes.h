@@ -1796,6 +1796,20 @@ public:
 	/** The delta time of the last tick */
 	float ThisTickDelta;
 
+	/** MaxDistanceFactor (size on screen, as used by LODs) thresholds picking the evaluation rate of visible meshes.
+	 * The mesh is evaluated every frame above the first one, every 2 frames above the second one, and so on.
+	 * Owners can change them at runtime, e.g. to budget how many meshes are evaluated every frame. */
+	UPROPERTY()
+	TArray<float> BaseVisibleDistanceFactorThresholds;
+
+	/** Update and evaluation rate of meshes that are not rendered, if not human controlled. */
+	UPROPERTY()
+	int32 BaseNonRenderedUpdateRate;
+
+	/** Highest evaluation rate skipped frames are interpolated at, beyond it they are frozen. */
+	UPROPERTY()
+	int32 MaxEvalRateForInterpolation;
+
 public:
 
 	/** Default constructor. */
@@ -1808,7 +1822,12 @@ public:
 		, TickedPoseOffestTime(0.f)
 		, AdditionalTime(0.f)
 		, ThisTickDelta(0.f)
-	{ }
+		, BaseNonRenderedUpdateRate(4)
+		, MaxEvalRateForInterpolation(4)
+	{
+		BaseVisibleDistanceFactorThresholds.Add(0.4f);
+		BaseVisibleDistanceFactorThresholds.Add(0.2f);
+	}
 
 	/** Set parameters and verify inputs for Trail Mode (original behaviour - skip frames, track skipped time and then catch up afterwards).
 	 * @param : UpdateShiftRate. Shift our update frames so that updates across all skinned components are staggered
@@ -99,6 +99,8 @@ public:
 	virtual float GetMaxTickRate( float DeltaTime, bool bAllowFrameRateSmoothing = true ) const override;
 	virtual void ProcessToggleFreezeCommand( UWorld* InWorld ) override;
 	virtual void ProcessToggleFreezeStreamingCommand( UWorld* InWorld ) override;
+	virtual bool NetworkRemapPath( UWorld* InWorld, FString& Str, bool reading=true ) override;
+	virtual bool NetworkRemapPath( UPendingNetGame* PendingNetGame, FString& Str, bool reading=true ) override;
 
 public:
 
@@ -1697,6 +1697,15 @@ public:
 	 */
 	virtual void Tick( float DeltaSeconds );
 
+	/**
+	 *	Read-only part of the tick, only called if PrimaryActorTick.bRunInParallelBatch is set. Runs on a task graph worker before
+	 *	the actor's tick group, in parallel with other actors, so it may only read the world and write to this actor; anything
+	 *	else has to go through FTickTaskManagerInterface::DeferToGameThread. Tick still runs on the game thread afterwards.
+	 *
+	 *	@param	DeltaSeconds	Game time elapsed since last call to Tick
+	 */
+	virtual void ParallelTick( float DeltaSeconds ) {}
+
 	/** If true, actor is ticked even if TickType==LEVELTICK_ViewportsOnly	 */
 	virtual bool ShouldTickIfViewportsOnly() const;
 
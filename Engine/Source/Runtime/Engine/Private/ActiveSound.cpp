@@ -8,6 +8,11 @@
 #include "Sound/SoundNodeAttenuation.h"
 #include "SubtitleManager.h"
 
+static TAutoConsoleVariable<int32> CVarVirtualizeInaudibleSounds(
+	TEXT("au.VirtualizeInaudibleSounds"),
+	1,
+	TEXT("If set, sounds attenuated to silence at every listener keep their place in playback but don't evaluate their sound nodes until they come back in range."));
+
 FActiveSound::FActiveSound()
 	: Sound(NULL)
 	, World(NULL)
@@ -162,6 +167,34 @@ void FActiveSound::UpdateWaveInstances( FAudioDevice* AudioDevice, TArray<FWaveI
 
 	const FListener& ClosestListener = AudioDevice->Listeners[ ClosestListenerIndex ];
 
+	// Out of range sounds only keep time (and fades) going so they resume at the right point and still stop on time.
+	// Evaluating their nodes would only give wave instances too quiet to be added to InWaveInstances.
+	if (IsInaudible(AudioDevice, ClosestListener.Transform.GetTranslation()))
+	{
+		UpdateAdjustVolumeMultiplier(DeltaTime);
+		if (DeltaTime > 0.f)
+		{
+			LastLocation = Transform.GetTranslation();
+		}
+
+		// Parsing is what notices one shots have finished; without it they are done once all their wave instances are (looping ones never are).
+		bFinished = true;
+		for (auto WaveInstanceIt(WaveInstances.CreateConstIterator()); WaveInstanceIt; ++WaveInstanceIt)
+		{
+			const FWaveInstance* WaveInstance = WaveInstanceIt.Value();
+			if (!WaveInstance->bIsFinished || WaveInstance->LoopingMode == LOOP_Forever)
+			{
+				bFinished = false;
+				break;
+			}
+		}
+		if (bFinished || (bFadingOut && PlaybackTime > TargetAdjustVolumeStopTime))
+		{
+			Stop(AudioDevice);
+		}
+		return;
+	}
+
 	// Process occlusion before shifting the sounds position
 	if (OcclusionCheckInterval > 0.f)
 	{
@@ -226,6 +259,44 @@ void FActiveSound::UpdateWaveInstances( FAudioDevice* AudioDevice, TArray<FWaveI
 	}
 }
 
+/** @return distance from the sound beyond which Settings always attenuate it to silence, whichever way it faces */
+static float GetSilentDistance(const FAttenuationSettings& Settings)
+{
+	switch (Settings.AttenuationShape)
+	{
+	case EAttenuationShape::Box:
+		// GetMaxDimension() goes by the longest extent but the corners reach further
+		return Settings.FalloffDistance + Settings.AttenuationShapeExtents.Size();
+
+	case EAttenuationShape::Cone:
+		// the cone's origin is behind the sound
+		return Settings.GetMaxDimension() + FMath::Abs(Settings.ConeOffset);
+
+	default:
+		return Settings.GetMaxDimension();
+	}
+}
+
+bool FActiveSound::IsInaudible( FAudioDevice* AudioDevice, const FVector& ListenerLocation )
+{
+	if (!bHasAttenuationSettings || !AttenuationSettings.bAttenuate || bAlwaysPlay || WaveInstances.Num() == 0 || CVarVirtualizeInaudibleSounds.GetValueOnGameThread() == 0)
+	{
+		return false;
+	}
+
+	// Sound classes can make silent wave instances play anyway
+	if (USoundClass* SoundClass = GetSoundClass())
+	{
+		const FSoundClassProperties* SoundClassProperties = AudioDevice->GetSoundClassCurrentProperties(SoundClass);
+		if (SoundClassProperties == NULL || SoundClassProperties->bAlwaysPlay || SoundClassProperties->RadioFilterVolume > 0.f)
+		{
+			return false;
+		}
+	}
+
+	return FVector::DistSquared(Transform.GetTranslation(), ListenerLocation) > FMath::Square(GetSilentDistance(AttenuationSettings));
+}
+
 void FActiveSound::Stop(FAudioDevice* AudioDevice)
 {
 	check(AudioDevice);
@@ -106,6 +106,14 @@ void FActorTickFunction::ExecuteTick(float DeltaTime, enum ELevelTick TickType,
 	}
 }
 
+void FActorTickFunction::ExecuteParallelTick(float DeltaTime, enum ELevelTick TickType)
+{
+	if (Target && !Target->HasAnyFlags(RF_PendingKill | RF_Unreachable) && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->ParallelTick(DeltaTime*Target->CustomTimeDilation);
+	}
+}
+
 FString FActorTickFunction::DiagnosticMessage()
 {
 	return Target->GetFullName() + TEXT("[TickActor]");
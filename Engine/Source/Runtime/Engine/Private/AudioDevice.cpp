@@ -1660,6 +1660,58 @@ void FAudioDevice::HandlePause( bool bGameTicking, bool bGlobalPause )
 }
 
 
+static TAutoConsoleVariable<int32> CVarPartialWaveInstanceSort(
+	TEXT("au.PartialWaveInstanceSort"),
+	1,
+	TEXT("If set, only the wave instances with the highest priorities, that can get a source, are sorted each update."));
+
+/** Helper function for "Sort" (higher priority sorts last). */
+struct FCompareFWaveInstanceByPlayPriority
+{
+	FORCEINLINE bool operator()( const FWaveInstance& A, const FWaveInstance& B) const
+	{
+		return A.PlayPriority < B.PlayPriority;
+	}
+};
+
+/**
+ * Moves the NumToSort highest priority wave instances to the end of the array, lowest priority first, as sorting all of them would.
+ * The ones before them are left in no particular order.
+ */
+static void SortHighestPriorityWaveInstances( TArray<FWaveInstance*>& WaveInstances, int32 NumToSort )
+{
+	const FCompareFWaveInstanceByPlayPriority Compare;
+
+	// The highest priorities so far, in a heap with the lowest of them on top to be replaced.
+	// Whatever doesn't make it is packed at the start of WaveInstances, which never passes the element being read.
+	TArray<FWaveInstance*> Highest;
+	Highest.Reserve(NumToSort);
+	int32 NumDropped = 0;
+	for (int32 InstanceIndex = 0; InstanceIndex < WaveInstances.Num(); InstanceIndex++)
+	{
+		FWaveInstance* WaveInstance = WaveInstances[InstanceIndex];
+		if (Highest.Num() < NumToSort)
+		{
+			Highest.HeapPush(WaveInstance, Compare);
+		}
+		else if (Compare(*Highest.HeapTop(), *WaveInstance))
+		{
+			FWaveInstance* Dropped = NULL;
+			Highest.HeapPop(Dropped, Compare);
+			WaveInstances[NumDropped++] = Dropped;
+			Highest.HeapPush(WaveInstance, Compare);
+		}
+		else
+		{
+			WaveInstances[NumDropped++] = WaveInstance;
+		}
+	}
+
+	Highest.Sort(Compare);
+	check(NumDropped + Highest.Num() == WaveInstances.Num());
+	FMemory::Memcpy(WaveInstances.GetData() + NumDropped, Highest.GetData(), Highest.Num() * sizeof(FWaveInstance*));
+}
+
 int32 FAudioDevice::GetSortedActiveWaveInstances(TArray<FWaveInstance*>& WaveInstances, const ESortedActiveWaveGetType::Type GetType)
 {
 	SCOPE_CYCLE_COUNTER( STAT_AudioGatherWaveInstances );
@@ -1704,17 +1756,16 @@ int32 FAudioDevice::GetSortedActiveWaveInstances(TArray<FWaveInstance*>& WaveIns
 		}
 	}
 
-	// Helper function for "Sort" (higher priority sorts last).
-	struct FCompareFWaveInstanceByPlayPriority
+	if (GetType != ESortedActiveWaveGetType::QueryOnly && MaxChannels > 0 && WaveInstances.Num() > MaxChannels && CVarPartialWaveInstanceSort.GetValueOnGameThread() != 0)
 	{
-		FORCEINLINE bool operator()( const FWaveInstance& A, const FWaveInstance& B) const
-		{
-			return A.PlayPriority < B.PlayPriority;
-		}
-	};
-
-	// Sort by priority (lowest priority first).
-	WaveInstances.Sort( FCompareFWaveInstanceByPlayPriority() );
+		// Only the highest priorities can get a source, the order of the rest doesn't matter
+		SortHighestPriorityWaveInstances( WaveInstances, MaxChannels );
+	}
+	else
+	{
+		// Sort by priority (lowest priority first).
+		WaveInstances.Sort( FCompareFWaveInstanceByPlayPriority() );
+	}
 
 	// Return the first audible waveinstance
 	int32 FirstActiveIndex = FMath::Max( WaveInstances.Num() - MaxChannels, 0 );
@@ -154,6 +154,7 @@ FCollisionQueryParams::FCollisionQueryParams(FName InTraceTag, bool bInTraceComp
 	bFindInitialOverlaps = true;
 	bReturnFaceIndex = false;
 	bReturnPhysicalMaterial = false;
+	MobilityType = EQueryMobilityType::Any;
 
 	AddIgnoredActor(InIgnoreActor);
 	if (InIgnoreActor != NULL)
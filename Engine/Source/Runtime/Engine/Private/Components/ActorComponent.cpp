@@ -657,6 +657,15 @@ void FActorComponentTickFunction::ExecuteTick(float DeltaTime, enum ELevelTick T
 	}
 }
 
+void FActorComponentTickFunction::ExecuteParallelTick(float DeltaTime, enum ELevelTick TickType)
+{
+	if (Target && !Target->HasAnyFlags(RF_PendingKill | RF_Unreachable) && Target->IsRegistered() && TickType != LEVELTICK_ViewportsOnly)
+	{
+		AActor* MyOwner = Target->GetOwner();
+		Target->ParallelTickComponent(DeltaTime * (MyOwner ? MyOwner->CustomTimeDilation : 1.f));
+	}
+}
+
 FString FActorComponentTickFunction::DiagnosticMessage()
 {
 	return Target->GetFullName() + TEXT("[TickComponent]");
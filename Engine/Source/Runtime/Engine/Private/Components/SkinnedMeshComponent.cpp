@@ -15,6 +15,7 @@
 #include "ComponentReregisterContext.h"
 #include "Engine/SkeletalMeshSocket.h"
 #include "PhysicsEngine/PhysicsAsset.h"
+#include "ServerFrameTelemetry.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogSkinnedMeshComp, Log, All);
 
@@ -126,7 +127,8 @@ namespace FAnimUpdateRateManager
 		// Not rendered, including dedicated servers. we can skip the Evaluation part.
 		if (!bRecentlyRendered)
 		{
-			Tracker->UpdateRateParameters.SetTrailMode(DeltaTime, Tracker->GetAnimUpdateRateShiftTag(), (bHumanControlled ? 1 : 4), 4, false);
+			const int32 NonRenderedUpdateRate = Tracker->UpdateRateParameters.BaseNonRenderedUpdateRate;
+			Tracker->UpdateRateParameters.SetTrailMode(DeltaTime, Tracker->GetAnimUpdateRateShiftTag(), (bHumanControlled ? 1 : NonRenderedUpdateRate), NonRenderedUpdateRate, false);
 		}
 		// Visible controlled characters or playing root motion. Need evaluation and ticking done every frame.
 		else  if (bHumanControlled || bNeedsEveryFrame)
@@ -137,18 +139,14 @@ namespace FAnimUpdateRateManager
 		{
 			// For visible meshes, figure out how often bones should be evaluated VS interpolated to previous evaluation.
 			// This is based on screen size and makes sense for a 3D FPS game, different games or Actors can implement different rules.
-			int32 DesiredEvaluationRate;
-			if (MaxDistanceFactor > 0.4f)
+			int32 DesiredEvaluationRate = 1;
+			for (float Threshold : Tracker->UpdateRateParameters.BaseVisibleDistanceFactorThresholds)
 			{
-				DesiredEvaluationRate = 1;
-			}
-			else if (MaxDistanceFactor > .2f)
-			{
-				DesiredEvaluationRate = 2;
-			}
-			else
-			{
-				DesiredEvaluationRate = 3;
+				if (MaxDistanceFactor > Threshold)
+				{
+					break;
+				}
+				DesiredEvaluationRate++;
 			}
 
 			if (bUsingRootMotionFromEverything && DesiredEvaluationRate > 1)
@@ -158,7 +156,8 @@ namespace FAnimUpdateRateManager
 			}
 			else
 			{
-				Tracker->UpdateRateParameters.SetTrailMode(DeltaTime, Tracker->GetAnimUpdateRateShiftTag(), DesiredEvaluationRate, DesiredEvaluationRate, true);
+				const bool bInterpolate = (DesiredEvaluationRate <= Tracker->UpdateRateParameters.MaxEvalRateForInterpolation);
+				Tracker->UpdateRateParameters.SetTrailMode(DeltaTime, Tracker->GetAnimUpdateRateShiftTag(), DesiredEvaluationRate, DesiredEvaluationRate, bInterpolate);
 			}
 		}
 	}
@@ -430,6 +429,7 @@ void USkinnedMeshComponent::TickUpdateRate(float DeltaTime, bool bNeedsValidRoot
 void USkinnedMeshComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
 	SCOPE_CYCLE_COUNTER(STAT_SkinnedMeshCompTick);
+	SCOPE_SERVER_FRAME_TIMER(Animation);
 
 	// Tick ActorComponent first.
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
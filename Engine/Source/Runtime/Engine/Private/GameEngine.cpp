@@ -38,6 +38,7 @@
 #include "GameFramework/GameUserSettings.h"
 #include "GameFramework/GameMode.h"
 #include "GameDelegates.h"
+#include "ServerFrameTelemetry.h"
 
 ENGINE_API bool GDisallowNetworkTravel = false;
 
@@ -797,6 +798,7 @@ void UGameEngine::Tick( float DeltaSeconds, bool bIdleMode )
 {
 	SCOPE_CYCLE_COUNTER(STAT_GameEngineTick);
 	NETWORK_PROFILER(GNetworkProfiler.TrackFrameBegin());
+	FScopedServerFrame ServerFrame;
 
 	int32 LocalTickCycles=0;
 	CLOCK_CYCLES(LocalTickCycles);
@@ -899,6 +901,7 @@ void UGameEngine::Tick( float DeltaSeconds, bool bIdleMode )
 			// Tick the world.
 			GameCycles=0;
 			CLOCK_CYCLES(GameCycles);
+			SCOPE_SERVER_FRAME_TIMER(WorldTick);
 			Context.World()->Tick( LEVELTICK_All, DeltaSeconds );
 			UNCLOCK_CYCLES(GameCycles);
 		}
@@ -1074,6 +1077,50 @@ void UGameEngine::ProcessToggleFreezeStreamingCommand(UWorld* InWorld)
 }
 
 
+bool UGameEngine::NetworkRemapPath(UWorld* InWorld, FString& Str, bool reading)
+{
+	const FWorldContext* Context = GetWorldContextFromWorld(InWorld);
+	if (Context == NULL || Context->HostedWorldIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// hosted worlds load their maps into renamed packages, clients only know the real names
+	const FString HostedPrefix = UWorld::BuildPIEPackagePrefix(Context->HostedWorldIndex);
+	if (!reading)
+	{
+		return (Str.ReplaceInline(*HostedPrefix, TEXT(""), ESearchCase::IgnoreCase) > 0);
+	}
+
+	FString PackageName = Str;
+	FString ObjectPath;
+	int32 DotIndex = INDEX_NONE;
+	if (Str.FindChar(TEXT('.'), DotIndex))
+	{
+		PackageName = Str.Left(DotIndex);
+		ObjectPath = Str.Mid(DotIndex);
+	}
+	if (FPackageName::IsShortPackageName(PackageName))
+	{
+		return false;
+	}
+	// only packages this world has its own copy of are remapped, everything else is shared
+	const FString HostedPackageName = UWorld::ConvertToPIEPackageName(PackageName, Context->HostedWorldIndex);
+	if (HostedPackageName != PackageName && FindObjectFast<UPackage>(NULL, FName(*HostedPackageName)) != NULL)
+	{
+		Str = HostedPackageName + ObjectPath;
+		return true;
+	}
+	return false;
+}
+
+bool UGameEngine::NetworkRemapPath(UPendingNetGame* PendingNetGame, FString& Str, bool reading)
+{
+	// pending net games are only used to connect to a server, which doesn't need any remapping
+	return false;
+}
+
+
 UWorld* UGameEngine::GetGameWorld()
 {
 	for (auto It = WorldList.CreateConstIterator(); It; ++It)
@@ -21,6 +21,7 @@
 #include "GameFramework/GameMode.h"
 #include "Engine/ChildConnection.h"
 #include "Engine/GameInstance.h"
+#include "ServerFrameTelemetry.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogGameMode, Log, All);
 
@@ -235,6 +236,7 @@ void AGameMode::PostLogin( APlayerController* NewPlayer )
 	{
 		NumTravellingPlayers++;
 	}
+	FServerFrameTelemetry::Get().AddEvent(FString::Printf(TEXT("Login %d players %d spectators"), NumPlayers, NumSpectators));
 
 	// save network address for re-associating with reconnecting player, after stripping out port number
 	FString Address = NewPlayer->GetPlayerNetworkAddress();
@@ -326,6 +328,7 @@ void AGameMode::Logout( AController* Exiting )
 		K2_OnLogout(Exiting);
 
 		RemovePlayerControllerFromPlayerCount(PC);
+		FServerFrameTelemetry::Get().AddEvent(FString::Printf(TEXT("Logout %d players %d spectators"), NumPlayers, NumSpectators));
 
 		if (GameSession)
 		{
@@ -729,6 +732,7 @@ void AGameMode::SetMatchState(FName NewState)
 	}
 
 	MatchState = NewState;
+	FServerFrameTelemetry::Get().AddEvent(FString::Printf(TEXT("MatchState %s %s"), *MatchState.ToString(), *GetWorld()->GetMapName()));
 
 	// Call change callbacks
 
@@ -19,6 +19,7 @@
 #include "FXSystem.h"
 #include "TickTaskManagerInterface.h"
 #include "IPlatformFileProfilerWrapper.h"
+#include "ServerFrameTelemetry.h"
 #if WITH_PHYSX
 #include "PhysicsEngine/PhysXSupport.h"
 #endif
@@ -693,6 +694,7 @@ void UWorld::ProcessLevelStreamingVolumes(FVector* OverrideViewLocation)
 void UWorld::RunTickGroup(ETickingGroup Group, bool bBlockTillComplete = true)
 {
 	check(TickGroup == Group); // this should already be at the correct value, but we want to make sure things are happening in the right order
+	FScopedServerFrameTimer ServerFrameTimer(EServerFrameStat::Type(EServerFrameStat::TickGroupFirst + Group));
 	FTickTaskManagerInterface::Get().RunTickGroup(Group, bBlockTillComplete);
 	TickGroup = ETickingGroup(TickGroup + 1); // new actors go into the next tick group because this one is already gone
 }
@@ -1089,7 +1091,10 @@ void UWorld::Tick( ELevelTick TickType, float DeltaSeconds )
 	{
 		SCOPE_CYCLE_COUNTER(STAT_NetWorldTickTime);
 		// Update the net code and fetch all incoming packets.
-		BroadcastTickDispatch(DeltaSeconds);
+		{
+			SCOPE_SERVER_FRAME_TIMER(TickDispatch);
+			BroadcastTickDispatch(DeltaSeconds);
+		}
 
 		if( NetDriver && NetDriver->ServerConnection )
 		{
@@ -1356,6 +1361,7 @@ void UWorld::Tick( ELevelTick TickType, float DeltaSeconds )
 #endif
 	if (FullPurgeTriggered)
 	{
+		SCOPE_SERVER_FRAME_TIMER(GarbageCollection);
 		if (TryCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true))
 		{
 			CleanupActors();
@@ -1382,11 +1388,13 @@ void UWorld::Tick( ELevelTick TickType, float DeltaSeconds )
 		&&	(TimeSinceLastPendingKillPurge > TimeBetweenPurgingPendingKillObjects) && TimeBetweenPurgingPendingKillObjects > 0 )
 		{
 			SCOPE_CYCLE_COUNTER(STAT_GCMarkTime);
+			SCOPE_SERVER_FRAME_TIMER(GarbageCollection);
 			PerformGarbageCollectionAndCleanupActors();
 		}
 		else
 		{
 			SCOPE_CYCLE_COUNTER(STAT_GCSweepTime);
+			SCOPE_SERVER_FRAME_TIMER(GarbageCollection);
 			IncrementalPurgeGarbage( true );
 		}
 	}
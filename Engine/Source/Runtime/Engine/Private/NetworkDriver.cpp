@@ -18,6 +18,7 @@
 #include "Engine/PackageMapClient.h"
 #include "GameFramework/PlayerState.h"
 #include "GameFramework/GameMode.h"
+#include "ServerFrameTelemetry.h"
 
 #if UE_SERVER
 #include "PerfCountersModule.h"
@@ -160,6 +161,7 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 	{
 		// Update all clients.
 #if WITH_SERVER_CODE
+		SCOPE_SERVER_FRAME_TIMER(ServerReplicateActors);
 		int32 Updated = ServerReplicateActors( DeltaSeconds );
 		static int32 LastUpdateCount = 0;
 		// Only log the zero replicated actors once after replicating an actor
@@ -0,0 +1,372 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/**
+ * ServerFrameTelemetry
+ *
+ */
+#include "EnginePrivate.h"
+#include "ServerFrameTelemetry.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogServerTelemetry, Log, All);
+
+static int32 GServerTelemetryEnable = 1;
+static FAutoConsoleVariableRef CVarServerTelemetryEnable(
+	TEXT("ServerTelemetry.Enable"),
+	GServerTelemetryEnable,
+	TEXT("Frame time telemetry written to ServerTelemetry.csv in the log directory.\n")
+	TEXT(" 0: off\n")
+	TEXT(" 1: dedicated servers only (default)\n")
+	TEXT(" 2: always"),
+	ECVF_Default
+	);
+
+static float GServerTelemetryWindowSeconds = 60.0f;
+static FAutoConsoleVariableRef CVarServerTelemetryWindowSeconds(
+	TEXT("ServerTelemetry.WindowSeconds"),
+	GServerTelemetryWindowSeconds,
+	TEXT("Length in seconds of each telemetry window; percentiles are computed and written once per window."),
+	ECVF_Default
+	);
+
+static float GServerTelemetryHitchMs = 100.0f;
+static FAutoConsoleVariableRef CVarServerTelemetryHitchMs(
+	TEXT("ServerTelemetry.HitchMs"),
+	GServerTelemetryHitchMs,
+	TEXT("Frames taking longer than this many milliseconds are written to the telemetry file individually. 0 disables."),
+	ECVF_Default
+	);
+
+static int32 GServerTelemetryMaxFileSizeKB = 4096;
+static FAutoConsoleVariableRef CVarServerTelemetryMaxFileSizeKB(
+	TEXT("ServerTelemetry.MaxFileSizeKB"),
+	GServerTelemetryMaxFileSizeKB,
+	TEXT("Size at which the telemetry file is moved to ServerTelemetry-backup.csv and a new one is started."),
+	ECVF_Default
+	);
+
+/** upper bound of the first histogram bucket, in milliseconds */
+static const float MinBucketMs = 0.01f;
+/** ratio between the upper bounds of two consecutive buckets; 128 buckets cover up to about two seconds */
+static const float BucketGrowth = 1.1f;
+
+bool FServerFrameTelemetry::bActive = false;
+
+void FServerFrameTelemetry::FHistogram::Reset()
+{
+	FMemory::Memzero(Buckets);
+	Count = 0;
+	MaxMs = 0.0f;
+	TotalMs = 0.0;
+}
+
+void FServerFrameTelemetry::FHistogram::Add(float Ms)
+{
+	int32 Bucket = 0;
+	if (Ms > MinBucketMs)
+	{
+		Bucket = FMath::Min<int32>(FMath::CeilToInt(FMath::Loge(Ms / MinBucketMs) / FMath::Loge(BucketGrowth)), NumBuckets - 1);
+	}
+	Buckets[Bucket]++;
+	Count++;
+	MaxMs = FMath::Max(MaxMs, Ms);
+	TotalMs += Ms;
+}
+
+float FServerFrameTelemetry::FHistogram::GetPercentile(float Percentile) const
+{
+	const uint32 Target = FMath::Max<uint32>(1, FMath::CeilToInt(Percentile * Count));
+	uint32 Seen = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+	{
+		Seen += Buckets[Bucket];
+		if (Seen >= Target)
+		{
+			return FMath::Min(MinBucketMs * FMath::Pow(BucketGrowth, Bucket), MaxMs);
+		}
+	}
+	return MaxMs;
+}
+
+FServerFrameTelemetry& FServerFrameTelemetry::Get()
+{
+	static FServerFrameTelemetry Singleton;
+	return Singleton;
+}
+
+FServerFrameTelemetry::FServerFrameTelemetry()
+	: bHasLastWindow(false)
+	, File(NULL)
+{
+	FMemory::Memzero(FrameCycles);
+	if (!FParse::Value(FCommandLine::Get(), TEXT("ServerTelemetryFile="), Filename))
+	{
+		Filename = FPaths::GameLogDir() / TEXT("ServerTelemetry.csv");
+	}
+	FCoreDelegates::OnPreExit.AddRaw(this, &FServerFrameTelemetry::Shutdown);
+}
+
+const TCHAR* FServerFrameTelemetry::GetStatName(EServerFrameStat::Type Stat)
+{
+	static const TCHAR* TickGroupNames[] =
+	{
+		TEXT("TG_PrePhysics"),
+		TEXT("TG_StartPhysics"),
+		TEXT("TG_DuringPhysics"),
+		TEXT("TG_EndPhysics"),
+		TEXT("TG_PreCloth"),
+		TEXT("TG_StartCloth"),
+		TEXT("TG_EndCloth"),
+		TEXT("TG_PostPhysics"),
+		TEXT("TG_PostUpdateWork"),
+		TEXT("TG_NewlySpawned"),
+	};
+	static_assert(ARRAY_COUNT(TickGroupNames) == TG_MAX, "TickGroupNames must match ETickingGroup.");
+
+	if (Stat >= EServerFrameStat::TickGroupFirst && Stat <= EServerFrameStat::TickGroupLast)
+	{
+		return TickGroupNames[Stat - EServerFrameStat::TickGroupFirst];
+	}
+	switch (Stat)
+	{
+		case EServerFrameStat::Frame:					return TEXT("Frame");
+		case EServerFrameStat::WorldTick:				return TEXT("WorldTick");
+		case EServerFrameStat::TickDispatch:			return TEXT("TickDispatch");
+		case EServerFrameStat::ServerReplicateActors:	return TEXT("ServerReplicateActors");
+		case EServerFrameStat::GarbageCollection:		return TEXT("GarbageCollection");
+		case EServerFrameStat::BotAI:					return TEXT("BotAI");
+		case EServerFrameStat::CharacterMovement:		return TEXT("CharacterMovement");
+		case EServerFrameStat::Projectiles:				return TEXT("Projectiles");
+		case EServerFrameStat::Animation:				return TEXT("Animation");
+		default:										return TEXT("Unknown");
+	}
+}
+
+void FServerFrameTelemetry::EndFrame()
+{
+	check(IsInGameThread());
+
+	const bool bWasActive = bActive;
+	bActive = GServerTelemetryEnable > 1 || (GServerTelemetryEnable == 1 && IsRunningDedicatedServer());
+	if (!bWasActive)
+	{
+		if (bActive)
+		{
+			CurrentWindow = FWindow();
+			CurrentWindow.StartTime = FPlatformTime::Seconds();
+			CurrentWindow.StartDate = FDateTime::UtcNow();
+		}
+		FMemory::Memzero(FrameCycles);
+		return;
+	}
+
+	const double MsPerCycle = FPlatformTime::GetSecondsPerCycle() * 1000.0;
+	for (int32 Stat = 0; Stat < EServerFrameStat::Num; Stat++)
+	{
+		CurrentWindow.Stats[Stat].Add(float(FrameCycles[Stat] * MsPerCycle));
+	}
+	const float FrameMs = float(FrameCycles[EServerFrameStat::Frame] * MsPerCycle);
+	if (GServerTelemetryHitchMs > 0.0f && FrameMs >= GServerTelemetryHitchMs)
+	{
+		CurrentWindow.NumHitches++;
+		WriteHitch(FrameMs);
+	}
+	FMemory::Memzero(FrameCycles);
+
+	if (!bActive)
+	{
+		// turned off, write out what we have and let go of the file
+		Shutdown();
+	}
+	else if (FPlatformTime::Seconds() - CurrentWindow.StartTime >= GServerTelemetryWindowSeconds)
+	{
+		FlushWindow();
+	}
+}
+
+void FServerFrameTelemetry::FlushWindow()
+{
+	if (CurrentWindow.Stats[EServerFrameStat::Frame].Count == 0)
+	{
+		return;
+	}
+	WriteWindow(CurrentWindow);
+	LastWindow = CurrentWindow;
+	bHasLastWindow = true;
+
+	CurrentWindow = FWindow();
+	CurrentWindow.StartTime = FPlatformTime::Seconds();
+	CurrentWindow.StartDate = FDateTime::UtcNow();
+}
+
+void FServerFrameTelemetry::Shutdown()
+{
+	FlushWindow();
+	if (File != NULL)
+	{
+		delete File;
+		File = NULL;
+	}
+}
+
+void FServerFrameTelemetry::AddEvent(const FString& Event)
+{
+	if (bActive)
+	{
+		WriteLine(FString::Printf(TEXT("%s,E,%s"), *FDateTime::UtcNow().ToString(), *Event.Replace(TEXT(","), TEXT(" "))));
+		if (File != NULL)
+		{
+			File->Flush();
+		}
+	}
+}
+
+void FServerFrameTelemetry::WriteWindow(const FWindow& Window)
+{
+	const FString Date = Window.StartDate.ToString();
+	for (int32 Stat = 0; Stat < EServerFrameStat::Num; Stat++)
+	{
+		const FHistogram& Histogram = Window.Stats[Stat];
+		// stats that never ran (unused tick groups, bot AI on a lobby server) are left out to keep the file small
+		if (Histogram.MaxMs > 0.0f)
+		{
+			WriteLine(FString::Printf(TEXT("%s,W,%s,%u,%.2f,%.2f,%.2f,%.2f,%.2f"), *Date, GetStatName(EServerFrameStat::Type(Stat)), Histogram.Count,
+				float(Histogram.TotalMs / Histogram.Count), Histogram.GetPercentile(0.5f), Histogram.GetPercentile(0.95f), Histogram.GetPercentile(0.99f), Histogram.MaxMs));
+		}
+	}
+	if (Window.NumHitches > 0)
+	{
+		WriteLine(FString::Printf(TEXT("%s,W,Hitches,%d"), *Date, Window.NumHitches));
+	}
+	if (File != NULL)
+	{
+		File->Flush();
+	}
+	RollFileIfNeeded();
+}
+
+void FServerFrameTelemetry::WriteHitch(float FrameMs)
+{
+	const double MsPerCycle = FPlatformTime::GetSecondsPerCycle() * 1000.0;
+	FString Line = FString::Printf(TEXT("%s,H,%.2f"), *FDateTime::UtcNow().ToString(), FrameMs);
+	for (int32 Stat = EServerFrameStat::Frame + 1; Stat < EServerFrameStat::Num; Stat++)
+	{
+		const float StatMs = float(FrameCycles[Stat] * MsPerCycle);
+		if (StatMs >= 0.1f)
+		{
+			Line += FString::Printf(TEXT(",%s=%.2f"), GetStatName(EServerFrameStat::Type(Stat)), StatMs);
+		}
+	}
+	WriteLine(Line);
+}
+
+void FServerFrameTelemetry::WriteLine(const FString& Line)
+{
+	if (File == NULL)
+	{
+		File = IFileManager::Get().CreateFileWriter(*Filename, FILEWRITE_Append | FILEWRITE_AllowRead);
+		if (File == NULL)
+		{
+			// most likely another server instance sharing the log directory has it open
+			Filename = FPaths::GetPath(Filename) / FString::Printf(TEXT("%s-%u.csv"), *FPaths::GetBaseFilename(Filename), FPlatformProcess::GetCurrentProcessId());
+			File = IFileManager::Get().CreateFileWriter(*Filename, FILEWRITE_Append | FILEWRITE_AllowRead);
+			if (File == NULL)
+			{
+				UE_LOG(LogServerTelemetry, Warning, TEXT("Failed to open %s, disabling server telemetry"), *Filename);
+				GServerTelemetryEnable = 0;
+				return;
+			}
+		}
+		if (File->TotalSize() == 0)
+		{
+			const ANSICHAR* Header =
+				"# W: UtcWindowStart,W,Stat,Frames,AvgMs,P50Ms,P95Ms,P99Ms,MaxMs" LINE_TERMINATOR_ANSI
+				"# H: UtcTime,H,FrameMs,Stat=Ms..." LINE_TERMINATOR_ANSI
+				"# E: UtcTime,E,Event" LINE_TERMINATOR_ANSI;
+			File->Serialize((void*)Header, FCStringAnsi::Strlen(Header));
+		}
+	}
+	FTCHARToUTF8 Converted(*(Line + LINE_TERMINATOR));
+	File->Serialize((void*)Converted.Get(), Converted.Length());
+}
+
+void FServerFrameTelemetry::RollFileIfNeeded()
+{
+	if (File != NULL && File->TotalSize() >= int64(GServerTelemetryMaxFileSizeKB) * 1024)
+	{
+		delete File;
+		File = NULL;
+		const FString BackupFilename = FPaths::GetPath(Filename) / FPaths::GetBaseFilename(Filename) + TEXT("-backup.csv");
+		IFileManager::Get().Move(*BackupFilename, *Filename, true);
+	}
+}
+
+void FServerFrameTelemetry::DumpWindow(const FWindow& Window, const TCHAR* Title, FOutputDevice& Ar)
+{
+	Ar.Logf(TEXT("%s: started %s, %u frames, %d hitches"), Title, *Window.StartDate.ToString(), Window.Stats[EServerFrameStat::Frame].Count, Window.NumHitches);
+	Ar.Logf(TEXT("  %-24s %8s %8s %8s %8s %8s"), TEXT("Stat"), TEXT("Avg"), TEXT("P50"), TEXT("P95"), TEXT("P99"), TEXT("Max"));
+	for (int32 Stat = 0; Stat < EServerFrameStat::Num; Stat++)
+	{
+		const FHistogram& Histogram = Window.Stats[Stat];
+		if (Histogram.MaxMs > 0.0f)
+		{
+			Ar.Logf(TEXT("  %-24s %8.2f %8.2f %8.2f %8.2f %8.2f"), GetStatName(EServerFrameStat::Type(Stat)), float(Histogram.TotalMs / Histogram.Count),
+				Histogram.GetPercentile(0.5f), Histogram.GetPercentile(0.95f), Histogram.GetPercentile(0.99f), Histogram.MaxMs);
+		}
+	}
+}
+
+void FServerFrameTelemetry::Dump(FOutputDevice& Ar) const
+{
+	if (!bActive)
+	{
+		Ar.Logf(TEXT("Server telemetry is off, see ServerTelemetry.Enable"));
+		return;
+	}
+	if (bHasLastWindow)
+	{
+		DumpWindow(LastWindow, TEXT("Last window"), Ar);
+	}
+	DumpWindow(CurrentWindow, TEXT("Current window"), Ar);
+	Ar.Logf(TEXT("Writing to %s"), *Filename);
+}
+
+void FServerFrameTelemetry::GetSummary(TArray<FString>& OutLines) const
+{
+	const FWindow& Window = bHasLastWindow ? LastWindow : CurrentWindow;
+	OutLines.Add(FString::Printf(TEXT("%u frames, %d hitches (ms avg/p50/p95/p99/max)"), Window.Stats[EServerFrameStat::Frame].Count, Window.NumHitches));
+	for (int32 Stat = 0; Stat < EServerFrameStat::Num; Stat++)
+	{
+		const FHistogram& Histogram = Window.Stats[Stat];
+		if (Histogram.MaxMs > 0.0f)
+		{
+			OutLines.Add(FString::Printf(TEXT("%s %.2f/%.2f/%.2f/%.2f/%.2f"), GetStatName(EServerFrameStat::Type(Stat)), float(Histogram.TotalMs / Histogram.Count),
+				Histogram.GetPercentile(0.5f), Histogram.GetPercentile(0.95f), Histogram.GetPercentile(0.99f), Histogram.MaxMs));
+		}
+	}
+}
+
+static class FServerFrameTelemetryExec : private FSelfRegisteringExec
+{
+public:
+	/** Console commands, see embeded usage statement **/
+	virtual bool Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar) override
+	{
+		if (FParse::Command(&Cmd, TEXT("ServerTelemetry")))
+		{
+			if (FParse::Command(&Cmd, TEXT("FLUSH")))
+			{
+				FServerFrameTelemetry::Get().FlushWindow();
+			}
+			else if (FParse::Command(&Cmd, TEXT("EVENT")))
+			{
+				FServerFrameTelemetry::Get().AddEvent(Cmd);
+			}
+			else
+			{
+				FServerFrameTelemetry::Get().Dump(Ar);
+			}
+			return true;
+		}
+		return false;
+	}
+} ServerFrameTelemetryExec;
@@ -0,0 +1,136 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "EnginePrivate.h"
+#include "AudioDevice.h"
+#include "ActiveSound.h"
+#include "Sound/SoundWave.h"
+
+namespace AudioUpdateTest
+{
+	/** Audio device with no hardware behind it, only the platform independent update runs. */
+	class FNullAudioDevice : public FAudioDevice
+	{
+	public:
+		FNullAudioDevice(int32 InMaxChannels)
+		{
+			MaxChannels = InMaxChannels;
+			Listeners.AddDefaulted();
+		}
+
+		virtual FName GetRuntimeFormat(USoundWave* SoundWave) override
+		{
+			return NAME_None;
+		}
+
+		virtual FSoundSource* CreateSoundSource() override
+		{
+			return NULL;
+		}
+	};
+
+	/** Plays NumSounds long one shots scattered around the listener, most of them beyond their falloff like far away fights. */
+	static void PlaySounds(FAudioDevice* AudioDevice, USoundWave* SoundWave, int32 NumSounds)
+	{
+		FRandomStream RandomStream(0x4321);
+		for (int32 Index = 0; Index < NumSounds; Index++)
+		{
+			FActiveSound NewActiveSound;
+			NewActiveSound.Sound = SoundWave;
+			NewActiveSound.bLocationDefined = true;
+			NewActiveSound.Transform.SetTranslation(RandomStream.GetUnitVector() * RandomStream.FRandRange(0.0f, 20000.0f));
+			NewActiveSound.bHasAttenuationSettings = true;
+			NewActiveSound.AttenuationSettings.bAttenuate = true;
+			NewActiveSound.AttenuationSettings.AttenuationShape = EAttenuationShape::Sphere;
+			// no inner radius, so there are no ties at full volume
+			NewActiveSound.AttenuationSettings.AttenuationShapeExtents = FVector::ZeroVector;
+			NewActiveSound.AttenuationSettings.FalloffDistance = 5000.0f;
+			AudioDevice->AddNewActiveSound(NewActiveSound);
+		}
+	}
+
+	/** @return the priorities of the wave instances that would get a source, lowest first */
+	static TArray<float> GetPlayingPriorities(FAudioDevice* AudioDevice)
+	{
+		TArray<FWaveInstance*> WaveInstances;
+		const int32 FirstActiveIndex = AudioDevice->GetSortedActiveWaveInstances(WaveInstances, ESortedActiveWaveGetType::FullUpdate);
+		TArray<float> Priorities;
+		for (int32 Index = FirstActiveIndex; Index < WaveInstances.Num(); Index++)
+		{
+			Priorities.Add(WaveInstances[Index]->PlayPriority);
+		}
+		return Priorities;
+	}
+
+	static double TimeUpdates(FAudioDevice* AudioDevice, int32 NumIterations)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			TArray<FWaveInstance*> WaveInstances;
+			AudioDevice->GetSortedActiveWaveInstances(WaveInstances, ESortedActiveWaveGetType::FullUpdate);
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAudioUpdateTest, "System.Engine.Audio.Active Sound Update", EAutomationTestFlags::ATF_Editor)
+
+bool FAudioUpdateTest::RunTest(const FString& Parameters)
+{
+	using namespace AudioUpdateTest;
+
+	IConsoleVariable* VirtualizeVar = IConsoleManager::Get().FindConsoleVariable(TEXT("au.VirtualizeInaudibleSounds"));
+	IConsoleVariable* PartialSortVar = IConsoleManager::Get().FindConsoleVariable(TEXT("au.PartialWaveInstanceSort"));
+	check(VirtualizeVar && PartialSortVar);
+	const int32 OldVirtualize = VirtualizeVar->GetInt();
+	const int32 OldPartialSort = PartialSortVar->GetInt();
+
+	USoundWave* SoundWave = NewObject<USoundWave>();
+	SoundWave->Duration = 1000.0f;
+	SoundWave->MaxConcurrentPlayCount = 0;
+
+	FNullAudioDevice AudioDevice(32);
+	const int32 NumSounds = 4000;
+	PlaySounds(&AudioDevice, SoundWave, NumSounds);
+
+	// the first update evaluates every sound
+	VirtualizeVar->Set(0);
+	PartialSortVar->Set(0);
+	const TArray<float> ReferencePriorities = GetPlayingPriorities(&AudioDevice);
+	const double FullMs = TimeUpdates(&AudioDevice, 20);
+
+	VirtualizeVar->Set(1);
+	PartialSortVar->Set(1);
+	const TArray<float> Priorities = GetPlayingPriorities(&AudioDevice);
+	const double VirtualMs = TimeUpdates(&AudioDevice, 20);
+
+	// skipping the silent sounds and the full sort must not change what gets played
+	TestEqual(TEXT("Playing wave instances"), Priorities.Num(), ReferencePriorities.Num());
+	for (int32 Index = 0; Index < FMath::Min(Priorities.Num(), ReferencePriorities.Num()); Index++)
+	{
+		if (Priorities[Index] != ReferencePriorities[Index])
+		{
+			AddError(FString::Printf(TEXT("Playing wave instance %d has priority %f, expected %f"), Index, Priorities[Index], ReferencePriorities[Index]));
+			break;
+		}
+	}
+
+	AddLogItem(FString::Printf(TEXT("%d active sounds: %.3f ms per update evaluating and sorting all, %.3f ms skipping inaudible sounds and sorting the top %d"),
+		NumSounds, FullMs, VirtualMs, AudioDevice.MaxChannels));
+
+	// one shots that finished playing must go away whether they are in range or not
+	for (FActiveSound* ActiveSound : AudioDevice.GetActiveSounds())
+	{
+		for (auto WaveInstanceIt(ActiveSound->WaveInstances.CreateIterator()); WaveInstanceIt; ++WaveInstanceIt)
+		{
+			WaveInstanceIt.Value()->bIsFinished = true;
+		}
+	}
+	GetPlayingPriorities(&AudioDevice);
+	TestEqual(TEXT("Active sounds left after all finished"), AudioDevice.GetActiveSounds().Num(), 0);
+
+	AudioDevice.StopAllSounds(true);
+	VirtualizeVar->Set(OldVirtualize);
+	PartialSortVar->Set(OldPartialSort);
+	return true;
+}
@@ -6,6 +6,7 @@
 
 #include "EnginePrivate.h"
 #include "TickTaskManagerInterface.h"
+#include "ParallelFor.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogTick, Log, All);
 
@@ -14,6 +15,8 @@ DECLARE_CYCLE_STAT(TEXT("Queue Ticks Wait"),STAT_QueueTicksWait,STATGROUP_Game);
 DECLARE_CYCLE_STAT(TEXT("Queue Tick Task"),STAT_QueueTickTask,STATGROUP_Game);
 DECLARE_CYCLE_STAT(TEXT("Post Queue Tick Task"),STAT_PostTickTask,STATGROUP_Game);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Ticks Queued"),STAT_TicksQueued,STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Parallel Batch Ticks"),STAT_ParallelBatchTicks,STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Parallel Batch Ticks Queued"),STAT_ParallelBatchTicksQueued,STATGROUP_Game);
 
 static TAutoConsoleVariable<int32> CVarLogTicks(
 	TEXT("tick.LogTicks"),0,
@@ -24,6 +27,19 @@ static TAutoConsoleVariable<int32> CVarAllowAsyncComponentTicks(
 	0,
 	TEXT("Used to control async component ticks."));
 
+static TAutoConsoleVariable<int32> CVarAllowParallelBatchTicks(
+	TEXT("tick.AllowParallelBatchTicks"),
+	1,
+	TEXT("If true, tick functions with bRunInParallelBatch run their read-only part in parallel before their tick group, also on dedicated servers."));
+
+static TAutoConsoleVariable<int32> CVarParallelBatchMinSize(
+	TEXT("tick.ParallelBatchMinSize"),
+	16,
+	TEXT("Parallel tick batches smaller than this run on the game thread, it is not worth waking the workers for a few ticks."));
+
+/** Number of tick functions a worker takes at a time from a parallel tick batch; the parallel parts are short. */
+static const int32 ParallelBatchGranularity = 8;
+
 struct FTickContext
 {
 	/** Delta time to tick **/
@@ -115,9 +131,31 @@ class FTickTaskSequencer
 	};
 
 
+	/** A tick function in a parallel batch, with the changes it deferred to the game thread */
+	struct FParallelBatchTick
+	{
+		FTickFunction*				Target;
+		float						DeltaSeconds;
+		ELevelTick					TickType;
+		TArray<TFunction<void()>>	DeferredChanges;
+
+		FParallelBatchTick(FTickFunction* InTarget, const FTickContext& Context)
+			: Target(InTarget)
+			, DeltaSeconds(Context.DeltaSeconds)
+			, TickType(Context.TickType)
+		{
+		}
+	};
+
 	/** Completion handles for each phase of ticks */
 	FGraphEventArray	TickCompletionEvents[TG_MAX];
 
+	/** Tick functions whose parallel part runs when the tick group is released */
+	TArray<FParallelBatchTick> ParallelBatchTicks[TG_MAX];
+
+	/** TLS slot pointing at the DeferredChanges of the FParallelBatchTick being run on this thread, if any */
+	uint32 ParallelBatchTlsSlot;
+
 	/** Held tasks for each tick group. */
 	TArray<TGraphTask<FTickFunctionTask>*> TickTasks[TG_MAX];
 
@@ -130,6 +168,9 @@ class FTickTaskSequencer
 	/** If true, allow concurrent ticks **/
 	bool				bAllowConcurrentTicks; 
 
+	/** If true, tick functions may run their parallel part in a batch **/
+	bool				bAllowParallelBatchTicks;
+
 	/** If true, log each tick **/
 	bool				bLogTicks; 
 
@@ -180,6 +221,41 @@ public:
 		TGraphTask<FTickFunctionTask>* Task = TGraphTask<FTickFunctionTask>::CreateTask(Prerequisites, TickContext.Thread).ConstructAndHold(TickFunction, &UseContext, bLogTicks);
 		TickTasks[TickFunction->ActualTickGroup].Add(Task);
 		TickFunction->CompletionHandle = Task->GetCompletionEvent();
+
+		// the physics scene is being simulated during these groups, so they never run a batch
+		const bool bPhysicsGroup = TickFunction->ActualTickGroup >= TG_StartPhysics && TickFunction->ActualTickGroup <= TG_EndPhysics;
+		if (TickFunction->bRunInParallelBatch && bAllowParallelBatchTicks && bIsOriginalTickGroup && !bPhysicsGroup)
+		{
+			new (ParallelBatchTicks[TickFunction->ActualTickGroup]) FParallelBatchTick(TickFunction, TickContext);
+			INC_DWORD_STAT(STAT_ParallelBatchTicksQueued);
+		}
+	}
+
+	/** @return true if the calling thread is running a parallel tick */
+	FORCEINLINE bool IsInParallelBatch() const
+	{
+		return FPlatformTLS::GetTlsValue(ParallelBatchTlsSlot) != nullptr;
+	}
+
+	/** @return TLS slot holding where DeferToGameThread puts changes on the calling thread */
+	FORCEINLINE uint32 GetParallelBatchTlsSlot() const
+	{
+		return ParallelBatchTlsSlot;
+	}
+
+	/** Queues the change if called from a parallel tick, otherwise makes it right away */
+	void DeferToGameThread(TFunction<void()>&& Change)
+	{
+		TArray<TFunction<void()>>* Changes = (TArray<TFunction<void()>>*)FPlatformTLS::GetTlsValue(ParallelBatchTlsSlot);
+		if (Changes)
+		{
+			Changes->Add(MoveTemp(Change));
+		}
+		else
+		{
+			check(IsInGameThread());
+			Change();
+		}
 	}
 
 	/** Add a completion handle to a tick group **/
@@ -215,6 +291,8 @@ public:
 		}
 		checkSlow(WorldTickGroup >=0 && WorldTickGroup < TG_MAX);
 
+		RunParallelBatch(WorldTickGroup);
+
 		if (SingleThreadedMode())
 		{
 			DispatchTickGroupInner(ENamedThreads::GameThread, WorldTickGroup);
@@ -284,8 +362,11 @@ public:
 		{
 			bAllowConcurrentTicks = !!CVarAllowAsyncComponentTicks.GetValueOnGameThread();
 		}
+		bAllowParallelBatchTicks = !!CVarAllowParallelBatchTicks.GetValueOnGameThread();
 		for (int32 Index = 0; Index < TG_MAX; Index++)
 		{
+			check(!ParallelBatchTicks[Index].Num());  // released along with the tick group
+			ParallelBatchTicks[Index].Reset();
 			check(!TickCompletionEvents[Index].Num());  // we should not be adding to these outside of a ticking proper and they were already cleared after they were ticked
 			TickCompletionEvents[Index].Reset();
 			check(!TickTasks[Index].Num());  // we should not be adding to these outside of a ticking proper and they were already cleared after they were ticked
@@ -308,16 +389,58 @@ public:
 		{
 			check(!TickCompletionEvents[Index].Num());  // we should not be adding to these outside of a ticking proper and they were already cleared after they were ticked
 			check(!TickTasks[Index].Num()); 
+			check(!ParallelBatchTicks[Index].Num());
 		}
 	}
 private:
 
 	FTickTaskSequencer()
-		: bAllowConcurrentTicks(false)
+		: ParallelBatchTlsSlot(FPlatformTLS::AllocTlsSlot())
+		, bAllowConcurrentTicks(false)
+		, bAllowParallelBatchTicks(false)
 		, bLogTicks(false)
 	{
 	}
 
+	/**
+	 * Runs the parallel part of the batched tick functions of a tick group, then applies the changes they deferred.
+	 * Everything before this tick group is complete at this point and nothing of it has started, so the batch sees a stable world.
+	 * @param WorldTickGroup - tick group about to be released
+	 */
+	void RunParallelBatch(ETickingGroup WorldTickGroup)
+	{
+		TArray<FParallelBatchTick>& Batch = ParallelBatchTicks[WorldTickGroup];
+		if (!Batch.Num())
+		{
+			return;
+		}
+		SCOPE_CYCLE_COUNTER(STAT_ParallelBatchTicks);
+		if (bLogTicks)
+		{
+			UE_LOG(LogTick, Log, TEXT("tick %6d ---------------------------------------- Parallel batch of %d for tick group %d"),GFrameCounter, Batch.Num(), (int32)WorldTickGroup);
+		}
+
+		const uint32 TlsSlot = ParallelBatchTlsSlot;
+		const bool bForceSingleThread = Batch.Num() < CVarParallelBatchMinSize.GetValueOnGameThread();
+		ParallelFor(Batch.Num(), [&Batch, TlsSlot](int32 Index)
+		{
+			FParallelBatchTick& Tick = Batch[Index];
+			FPlatformTLS::SetTlsValue(TlsSlot, &Tick.DeferredChanges);
+			Tick.Target->ExecuteParallelTick(Tick.DeltaSeconds, Tick.TickType);
+			FPlatformTLS::SetTlsValue(TlsSlot, nullptr);
+		}, bForceSingleThread, ParallelBatchGranularity);
+
+		// merge in queue order so the result does not depend on which worker ran what
+		for (int32 Index = 0; Index < Batch.Num(); Index++)
+		{
+			for (TFunction<void()>& Change : Batch[Index].DeferredChanges)
+			{
+				Change();
+			}
+		}
+		Batch.Reset();
+	}
+
 	void ResetTickGroupInner(ETickingGroup WorldTickGroup)
 	{
 		TickCompletionEvents[WorldTickGroup].Reset();
@@ -737,6 +860,16 @@ private:
 		return Level->TickTaskLevel;
 	}
 
+	virtual void DeferToGameThread(TFunction<void()> Change) override
+	{
+		TickTaskSequencer.DeferToGameThread(MoveTemp(Change));
+	}
+
+	virtual bool IsInParallelBatch() const override
+	{
+		return TickTaskSequencer.IsInParallelBatch();
+	}
+
 	/** Dumps all tick functions to output device */
 	virtual void DumpAllTickFunctions(FOutputDevice& Ar, UWorld* InWorld, bool bEnabled, bool bDisabled) override
 	{
@@ -785,6 +918,7 @@ FTickFunction::FTickFunction()
 	, bCanEverTick(false)
 	, bAllowTickOnDedicatedServer(true)
 	, bRunOnAnyThread(false)
+	, bRunInParallelBatch(false)
 	, bRegistered(false)
 	, bTickEnabled(true)
 	, TickVisitedGFrameCounter(0)
@@ -944,6 +1078,18 @@ FTickTaskManagerInterface& FTickTaskManagerInterface::Get()
 	return FTickTaskManager::Get();
 }
 
+FScopedDeferredTickChanges::FScopedDeferredTickChanges(TArray<TFunction<void()>>& Changes)
+{
+	const uint32 TlsSlot = FTickTaskSequencer::Get().GetParallelBatchTlsSlot();
+	PreviousChanges = FPlatformTLS::GetTlsValue(TlsSlot);
+	FPlatformTLS::SetTlsValue(TlsSlot, &Changes);
+}
+
+FScopedDeferredTickChanges::~FScopedDeferredTickChanges()
+{
+	FPlatformTLS::SetTlsValue(FTickTaskSequencer::Get().GetParallelBatchTlsSlot(), PreviousChanges);
+}
+
 
 struct FTestTickFunction : public FTickFunction
 {
@@ -9107,6 +9107,53 @@ bool UEngine::LoadMap( FWorldContext& WorldContext, FURL URL, class UPendingNetG
 		}
 	}
 
+	// Additional game worlds hosted in this process get their own copy of the map, loaded into a renamed package like PIE instances do
+	if (NewWorld == NULL && WorldContext.HostedWorldIndex != INDEX_NONE)
+	{
+		FString SourceWorldPackage = URL.Map;
+		if (FPackageName::IsShortPackageName(SourceWorldPackage) && !FPackageName::SearchForPackageOnDisk(URL.Map, &SourceWorldPackage))
+		{
+			Error = FString::Printf(TEXT("Failed to find package '%s'"), *URL.Map);
+			return false;
+		}
+		const FString HostedPackageName = UWorld::ConvertToPIEPackageName(SourceWorldPackage, WorldContext.HostedWorldIndex);
+
+		// Set the world type in the static map, so that UWorld::PostLoad can set the world type
+		const FName HostedPackageFName = FName(*HostedPackageName);
+		UWorld::WorldTypePreLoadMap.FindOrAdd(HostedPackageFName) = WorldContext.WorldType;
+
+		WorldPackage = LoadPackage(CreatePackage(NULL, *HostedPackageName), *SourceWorldPackage, LOAD_None);
+
+		// Clean up the world type list now that PostLoad has occurred
+		UWorld::WorldTypePreLoadMap.Remove(HostedPackageFName);
+
+		if (WorldPackage == NULL)
+		{
+			Error = FString::Printf(TEXT("Failed to load package '%s' for hosted world %d"), *SourceWorldPackage, WorldContext.HostedWorldIndex);
+			return false;
+		}
+
+		NewWorld = UWorld::FindWorldInPackage(WorldPackage);
+
+		// If the world was not found, follow a redirector if there is one.
+		if (!NewWorld)
+		{
+			NewWorld = UWorld::FollowWorldRedirectorInPackage(WorldPackage);
+			if (NewWorld)
+			{
+				WorldPackage = NewWorld->GetOutermost();
+			}
+		}
+		check(NewWorld);
+
+		// streaming levels are loaded into renamed packages as well
+		NewWorld->StreamingLevelsPrefix = UWorld::BuildPIEPackagePrefix(WorldContext.HostedWorldIndex);
+		for (auto StreamingLevel : NewWorld->StreamingLevels)
+		{
+			StreamingLevel->RenameForPIE(WorldContext.HostedWorldIndex);
+		}
+	}
+
 	const FString URLTrueMapName = URL.Map;
 
 	// Normal map loading
@@ -262,4 +262,11 @@ private:
 	/** Apply the interior settings to the ambient sound as appropriate */
 	void HandleInteriorVolumes( const FListener& Listener, struct FSoundParseParameters& ParseParams );
 
+	/**
+	 * Whether the sound is attenuated to silence at the listener, so evaluating its sound nodes would only produce wave instances that can't play.
+	 * Sounds that haven't been evaluated yet never are, so they still start (subtitles, random node choices...) as usual.
+	 * @param ListenerLocation location of the closest listener to the sound
+	 */
+	bool IsInaudible( class FAudioDevice* AudioDevice, const FVector& ListenerLocation );
+
 };
\ No newline at end of file
@@ -11,6 +11,16 @@
 /** Macro to convert from CollisionResponseContainer to bit flag **/
 #define CRC_TO_BITFIELD(x)	(1<<(x))
 
+/** Which bodies a scene query looks at, by how the physics scene stores them */
+enum class EQueryMobilityType
+{
+	Any,
+	/** bodies that can't move (static mobility) */
+	Static,
+	/** bodies that can move or simulate (movable mobility) */
+	Dynamic,
+};
+
 /** Structure that defines parameters passed into collision function */
 struct ENGINE_API FCollisionQueryParams
 {
@@ -35,6 +45,12 @@ struct ENGINE_API FCollisionQueryParams
 	/** Only fill in the PhysMaterial field of  */
 	bool bReturnPhysicalMaterial;
 
+	/** 
+	 * Which bodies to look at. Static bodies never move, so a query can be split into a static part done early
+	 * (e.g. in a parallel tick batch) and a dynamic part done at the last moment. Default is Any.
+	 */
+	EQueryMobilityType MobilityType;
+
 	/** TArray typedef of components to ignore. */
 	typedef TArray<uint32, TInlineAllocator<NumInlinedActorComponents>> IgnoreComponentsArrayType;
 
@@ -51,6 +67,7 @@ struct ENGINE_API FCollisionQueryParams
 		bFindInitialOverlaps = true;
 		bReturnFaceIndex = false;
 		bReturnPhysicalMaterial = false;
+		MobilityType = EQueryMobilityType::Any;
 	}
 
 	FCollisionQueryParams(FName InTraceTag, bool bInTraceComplex=false, const AActor* InIgnoreActor=NULL);
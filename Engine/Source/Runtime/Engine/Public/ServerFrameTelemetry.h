@@ -0,0 +1,184 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/**
+ * ServerFrameTelemetry
+ *
+ * Always-on, low overhead frame time tracking for dedicated servers. Every frame the time spent in a handful of
+ * coarse buckets (world tick, tick groups, replication, GC, ...) is added to per-window histograms, and once per window
+ * (a minute by default) p50/p95/p99/max are written to a small rolling CSV file in the log directory.
+ * Frames over the hitch threshold and match events are written to the same file so hitches can be correlated with
+ * what the game was doing at the time. Use the ServerTelemetry console command to look at the numbers on a live server.
+ */
+
+#pragma once
+
+namespace EServerFrameStat
+{
+	enum Type
+	{
+		/** whole UGameEngine::Tick, everything below is part of this */
+		Frame,
+		WorldTick,
+		TickDispatch,
+		TickGroupFirst,
+		TickGroupLast = TickGroupFirst + TG_MAX - 1,
+		ServerReplicateActors,
+		GarbageCollection,
+		BotAI,
+		/** game code breakdowns, these overlap with the tick groups they run in */
+		CharacterMovement,
+		Projectiles,
+		/** skinned mesh pose ticks and bone updates on the game thread, plus poses games evaluate on demand */
+		Animation,
+		Num
+	};
+}
+
+class ENGINE_API FServerFrameTelemetry
+{
+public:
+	/** number of histogram buckets; bucket N holds frames up to MinBucketMs * BucketGrowth^N milliseconds */
+	enum { NumBuckets = 128 };
+
+	struct FHistogram
+	{
+		uint32 Buckets[NumBuckets];
+		uint32 Count;
+		float MaxMs;
+		double TotalMs;
+
+		FHistogram()
+		{
+			Reset();
+		}
+		void Reset();
+		void Add(float Ms);
+		/** @return upper bound of the bucket holding the given percentile (0-1), clamped to the max seen */
+		float GetPercentile(float Percentile) const;
+	};
+
+	struct FWindow
+	{
+		FHistogram Stats[EServerFrameStat::Num];
+		double StartTime;
+		FDateTime StartDate;
+		int32 NumHitches;
+
+		FWindow()
+			: StartTime(0.0)
+			, NumHitches(0)
+		{
+		}
+	};
+
+	static FServerFrameTelemetry& Get();
+
+	/** whether telemetry is being gathered; the scoped timers check this before touching the clock */
+	static FORCEINLINE bool IsActive()
+	{
+		return bActive;
+	}
+
+	/** adds time to the given stat for the current frame, game thread only */
+	FORCEINLINE void AddCycles(EServerFrameStat::Type Stat, uint32 Cycles)
+	{
+		FrameCycles[Stat] += Cycles;
+	}
+
+	/** moves the current frame into the histograms and closes the window if it is old enough; called at the end of UGameEngine::Tick */
+	void EndFrame();
+
+	/** writes a match event (map change, match state, player join, ...) to the telemetry file */
+	void AddEvent(const FString& Event);
+
+	/** closes the current window now and writes it out */
+	void FlushWindow();
+
+	/** prints the last completed window and the window in progress */
+	void Dump(FOutputDevice& Ar) const;
+
+	/** @return one line per stat with the percentiles of the last completed window, for remote admin tools */
+	void GetSummary(TArray<FString>& OutLines) const;
+
+	/** @return the last completed window, or NULL if none has been completed yet */
+	const FWindow* GetLastWindow() const
+	{
+		return bHasLastWindow ? &LastWindow : NULL;
+	}
+
+	static const TCHAR* GetStatName(EServerFrameStat::Type Stat);
+
+private:
+	FServerFrameTelemetry();
+
+	/** writes out the window in progress and closes the file */
+	void Shutdown();
+	void WriteWindow(const FWindow& Window);
+	void WriteHitch(float FrameMs);
+	void WriteLine(const FString& Line);
+	void RollFileIfNeeded();
+	static void DumpWindow(const FWindow& Window, const TCHAR* Title, FOutputDevice& Ar);
+
+	/** time spent in each stat this frame */
+	uint32 FrameCycles[EServerFrameStat::Num];
+
+	FWindow CurrentWindow;
+	FWindow LastWindow;
+	bool bHasLastWindow;
+
+	FString Filename;
+	FArchive* File;
+
+	static bool bActive;
+};
+
+/** Adds the time spent in its scope to the given stat of the current server frame. */
+class FScopedServerFrameTimer
+{
+public:
+	FORCEINLINE FScopedServerFrameTimer(EServerFrameStat::Type InStat)
+		: Stat(InStat)
+		, bActive(FServerFrameTelemetry::IsActive())
+		, StartCycles(bActive ? FPlatformTime::Cycles() : 0)
+	{
+	}
+
+	FORCEINLINE ~FScopedServerFrameTimer()
+	{
+		if (bActive)
+		{
+			FServerFrameTelemetry::Get().AddCycles(Stat, FPlatformTime::Cycles() - StartCycles);
+		}
+	}
+
+private:
+	EServerFrameStat::Type Stat;
+	bool bActive;
+	uint32 StartCycles;
+};
+
+#define SCOPE_SERVER_FRAME_TIMER(Stat) FScopedServerFrameTimer ServerFrameTimer_##Stat(EServerFrameStat::Stat)
+
+/** Marks a whole engine frame: times it and hands the frame to the histograms when it goes out of scope. */
+class FScopedServerFrame
+{
+public:
+	FORCEINLINE FScopedServerFrame()
+		: StartCycles(FPlatformTime::Cycles())
+	{
+	}
+
+	FORCEINLINE ~FScopedServerFrame()
+	{
+		FServerFrameTelemetry& Telemetry = FServerFrameTelemetry::Get();
+		if (FServerFrameTelemetry::IsActive())
+		{
+			Telemetry.AddCycles(EServerFrameStat::Frame, FPlatformTime::Cycles() - StartCycles);
+		}
+		// always called so that enabling telemetry at runtime takes effect
+		Telemetry.EndFrame();
+	}
+
+private:
+	uint32 StartCycles;
+};
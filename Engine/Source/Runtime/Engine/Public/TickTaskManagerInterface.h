@@ -48,6 +48,17 @@ public:
 	/** Finish a frame of ticks **/
 	virtual void EndFrame() = 0;
 
+	/**
+	 * Runs a change that is not safe to make from a parallel tick. Called from ExecuteParallelTick the change is queued and
+	 * run on the game thread after the batch, in the order the tick functions were queued, before the tick group starts.
+	 * Called from anywhere else it runs right away.
+	 * @param Change - the change to make
+	 */
+	virtual void DeferToGameThread(TFunction<void()> Change) = 0;
+
+	/** @return true if the calling thread is inside ExecuteParallelTick */
+	virtual bool IsInParallelBatch() const = 0;
+
 	/** Dumps all registered tick functions to output device. */
 	virtual void DumpAllTickFunctions(FOutputDevice& Ar, UWorld* InWorld, bool bEnabled, bool bDisabled) = 0;
 
@@ -60,5 +71,19 @@ public:
 
 };
 
+/**
+ * While in scope, changes deferred with FTickTaskManagerInterface::DeferToGameThread on this thread go to Changes.
+ * For parallel ticks that spread their own work over more threads: collect per item, then pass the changes on with
+ * DeferToGameThread in item order so the result does not depend on the threads.
+ */
+class ENGINE_API FScopedDeferredTickChanges
+{
+public:
+	FScopedDeferredTickChanges(TArray<TFunction<void()>>& Changes);
+	~FScopedDeferredTickChanges();
+
+private:
+	void* PreviousChanges;
+};
 
 #endif		// __DerivedDataBackendInterface_h__
\ No newline at end of file
@@ -30,21 +30,18 @@ namespace Online
 {
 	static IOnlineSubsystem* GetSubsystem(UWorld* World, const FName& SubsystemName = NAME_None)
 	{
-#if UE_EDITOR // at present, multiple worlds are only possible in the editor
+		// multiple worlds are possible in the editor (PIE) and on servers hosting several game worlds, each gets its own instance
 		FName Identifier = SubsystemName; 
-		if (World != NULL)
+		if (World != NULL && GEngine != NULL)
 		{
-			FWorldContext& CurrentContext = GEngine->GetWorldContextFromWorldChecked(World);
-			if (CurrentContext.WorldType == EWorldType::PIE)
+			const FWorldContext* CurrentContext = GEngine->GetWorldContextFromWorld(World);
+			if (CurrentContext != NULL && (CurrentContext->WorldType == EWorldType::PIE || CurrentContext->HostedWorldIndex != INDEX_NONE))
 			{ 
-				Identifier = FName(*FString::Printf(TEXT("%s:%s"), SubsystemName != NAME_None ? *SubsystemName.ToString() : TEXT(""), *CurrentContext.ContextHandle.ToString()));
+				Identifier = FName(*FString::Printf(TEXT("%s:%s"), SubsystemName != NAME_None ? *SubsystemName.ToString() : TEXT(""), *CurrentContext->ContextHandle.ToString()));
 			} 
 		}
 
 		return IOnlineSubsystem::Get(Identifier); 
-#else
-		return IOnlineSubsystem::Get(SubsystemName); 
-#endif
 	}
 
 	/** Reimplement all the interfaces of Online.h with support for UWorld accessors */
@@ -0,0 +1,179 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	PrimitiveCullingBounds.cpp: Structure of arrays primitive bounds and vectorized culling.
+=============================================================================*/
+
+#include "RendererPrivate.h"
+#include "ScenePrivate.h"
+
+void FPrimitiveCullingBounds::AddUninitialized()
+{
+	if (NumPrimitives % 4 == 0)
+	{
+		// unused lanes stay zeroed, nothing reads their results
+		Blocks.AddZeroed();
+	}
+	NumPrimitives++;
+}
+
+void FPrimitiveCullingBounds::RemoveAtSwap(int32 Index)
+{
+	check(Index >= 0 && Index < NumPrimitives);
+	const int32 LastIndex = NumPrimitives - 1;
+	FBlock& Block = Blocks[Index / 4];
+	FBlock& LastBlock = Blocks[LastIndex / 4];
+	const int32 Lane = Index % 4;
+	const int32 LastLane = LastIndex % 4;
+
+	Block.OriginX[Lane] = LastBlock.OriginX[LastLane];
+	Block.OriginY[Lane] = LastBlock.OriginY[LastLane];
+	Block.OriginZ[Lane] = LastBlock.OriginZ[LastLane];
+	Block.BoxExtentX[Lane] = LastBlock.BoxExtentX[LastLane];
+	Block.BoxExtentY[Lane] = LastBlock.BoxExtentY[LastLane];
+	Block.BoxExtentZ[Lane] = LastBlock.BoxExtentZ[LastLane];
+	Block.SphereRadius[Lane] = LastBlock.SphereRadius[LastLane];
+	Block.MinDrawDistanceSq[Lane] = LastBlock.MinDrawDistanceSq[LastLane];
+	Block.MaxDrawDistance[Lane] = LastBlock.MaxDrawDistance[LastLane];
+
+	LastBlock.OriginX[LastLane] = LastBlock.OriginY[LastLane] = LastBlock.OriginZ[LastLane] = 0.0f;
+	LastBlock.BoxExtentX[LastLane] = LastBlock.BoxExtentY[LastLane] = LastBlock.BoxExtentZ[LastLane] = 0.0f;
+	LastBlock.SphereRadius[LastLane] = LastBlock.MinDrawDistanceSq[LastLane] = LastBlock.MaxDrawDistance[LastLane] = 0.0f;
+
+	NumPrimitives--;
+	if (NumPrimitives % 4 == 0)
+	{
+		Blocks.RemoveAt(Blocks.Num() - 1, 1, false);
+	}
+}
+
+void FPrimitiveCullingBounds::Set(int32 Index, const FPrimitiveBounds& Bounds)
+{
+	check(Index >= 0 && Index < NumPrimitives);
+	FBlock& Block = Blocks[Index / 4];
+	const int32 Lane = Index % 4;
+
+	Block.OriginX[Lane] = Bounds.Origin.X;
+	Block.OriginY[Lane] = Bounds.Origin.Y;
+	Block.OriginZ[Lane] = Bounds.Origin.Z;
+	Block.BoxExtentX[Lane] = Bounds.BoxExtent.X;
+	Block.BoxExtentY[Lane] = Bounds.BoxExtent.Y;
+	Block.BoxExtentZ[Lane] = Bounds.BoxExtent.Z;
+	Block.SphereRadius[Lane] = Bounds.SphereRadius;
+	Block.MinDrawDistanceSq[Lane] = Bounds.MinDrawDistanceSq;
+	Block.MaxDrawDistance[Lane] = Bounds.MaxDrawDistance;
+}
+
+void FPrimitiveCullingBounds::ApplyWorldOffset(const FVector& Offset)
+{
+	for (FBlock& Block : Blocks)
+	{
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			Block.OriginX[Lane] += Offset.X;
+			Block.OriginY[Lane] += Offset.Y;
+			Block.OriginZ[Lane] += Offset.Z;
+		}
+	}
+}
+
+/** @return bit N set if lane N of the compare result is set */
+static FORCEINLINE uint32 GetLaneMask(const VectorRegister& CompareResult)
+{
+	MS_ALIGN(16) uint32 Lanes[4] GCC_ALIGN(16);
+	VectorStoreAligned(CompareResult, Lanes);
+	return (Lanes[0] & 1) | (Lanes[1] & 2) | (Lanes[2] & 4) | (Lanes[3] & 8);
+}
+
+void FPrimitiveCullingBounds::CullWord(int32 WordIndex, const FCullingParams& Params, FWordResult& OutResult) const
+{
+	FMemory::Memzero(OutResult);
+
+	const int32 FirstPrimitive = WordIndex * PrimitivesPerWord;
+	const int32 NumWordPrimitives = FMath::Min<int32>(NumPrimitives - FirstPrimitive, PrimitivesPerWord);
+	if (NumWordPrimitives <= 0)
+	{
+		return;
+	}
+	OutResult.Primitives = (NumWordPrimitives == PrimitivesPerWord) ? 0xFFFFFFFF : ((1u << NumWordPrimitives) - 1);
+
+	// Splat each plane. They are read back from the permuted planes FConvexVolume::IntersectSphere() and IntersectBox() test
+	// against, skipping the padding copies, so every primitive gets exactly the same distances as it would there.
+	const FConvexVolume& Frustum = *Params.Frustum;
+	const int32 NumPlanes = Frustum.Planes.Num();
+	TArray<VectorRegister, TInlineAllocator<6 * 4> > SplatPlanes;
+	SplatPlanes.AddUninitialized(NumPlanes * 4);
+	for (int32 PlaneIndex = 0; PlaneIndex < NumPlanes; PlaneIndex++)
+	{
+		const float* PermutedPlane = (const float*)&Frustum.PermutedPlanes[(PlaneIndex / 4) * 4];
+		const int32 Lane = PlaneIndex % 4;
+		SplatPlanes[PlaneIndex * 4 + 0] = VectorLoadFloat1(&PermutedPlane[Lane]);
+		SplatPlanes[PlaneIndex * 4 + 1] = VectorLoadFloat1(&PermutedPlane[4 + Lane]);
+		SplatPlanes[PlaneIndex * 4 + 2] = VectorLoadFloat1(&PermutedPlane[8 + Lane]);
+		SplatPlanes[PlaneIndex * 4 + 3] = VectorLoadFloat1(&PermutedPlane[12 + Lane]);
+	}
+
+	const VectorRegister ViewOriginX = VectorLoadFloat1(&Params.ViewOrigin.X);
+	const VectorRegister ViewOriginY = VectorLoadFloat1(&Params.ViewOrigin.Y);
+	const VectorRegister ViewOriginZ = VectorLoadFloat1(&Params.ViewOrigin.Z);
+	const VectorRegister MaxDrawDistanceScale = VectorLoadFloat1(&Params.MaxDrawDistanceScale);
+	const VectorRegister FadeRadius = VectorLoadFloat1(&Params.FadeRadius);
+
+	const int32 FirstBlock = FirstPrimitive / 4;
+	const int32 EndBlock = FirstBlock + FMath::DivideAndRoundUp(NumWordPrimitives, 4);
+	for (int32 BlockIndex = FirstBlock; BlockIndex < EndBlock; BlockIndex++)
+	{
+		const FBlock& Block = Blocks[BlockIndex];
+		const uint32 Shift = (BlockIndex - FirstBlock) * 4;
+
+		const VectorRegister OriginX = VectorLoadAligned(Block.OriginX);
+		const VectorRegister OriginY = VectorLoadAligned(Block.OriginY);
+		const VectorRegister OriginZ = VectorLoadAligned(Block.OriginZ);
+
+		// Distance culling, same operations as (Bounds.Origin - ViewOrigin).SizeSquared() and the draw distance checks in FrustumCull()
+		const VectorRegister DeltaX = VectorSubtract(OriginX, ViewOriginX);
+		const VectorRegister DeltaY = VectorSubtract(OriginY, ViewOriginY);
+		const VectorRegister DeltaZ = VectorSubtract(OriginZ, ViewOriginZ);
+		const VectorRegister DistanceSquared = VectorAdd(VectorAdd(VectorMultiply(DeltaX, DeltaX), VectorMultiply(DeltaY, DeltaY)), VectorMultiply(DeltaZ, DeltaZ));
+		const VectorRegister MaxDrawDistance = VectorMultiply(VectorLoadAligned(Block.MaxDrawDistance), MaxDrawDistanceScale);
+		const VectorRegister MaxFadeDistance = VectorAdd(MaxDrawDistance, FadeRadius);
+		const VectorRegister MinFadeDistance = VectorSubtract(MaxDrawDistance, FadeRadius);
+
+		OutResult.TooClose |= GetLaneMask(VectorCompareGT(VectorLoadAligned(Block.MinDrawDistanceSq), DistanceSquared)) << Shift;
+		OutResult.TooFar |= GetLaneMask(VectorCompareGT(DistanceSquared, VectorMultiply(MaxFadeDistance, MaxFadeDistance))) << Shift;
+		OutResult.BeyondMaxDrawDistance |= GetLaneMask(VectorCompareGT(DistanceSquared, VectorMultiply(MaxDrawDistance, MaxDrawDistance))) << Shift;
+		OutResult.InFadeRange |= GetLaneMask(VectorCompareGT(DistanceSquared, VectorMultiply(MinFadeDistance, MinFadeDistance))) << Shift;
+
+		// Frustum culling, the sphere and box tests of FConvexVolume for four primitives per plane instead of four planes per primitive
+		const VectorRegister SphereRadius = VectorLoadAligned(Block.SphereRadius);
+		const VectorRegister AbsExtentX = VectorAbs(VectorLoadAligned(Block.BoxExtentX));
+		const VectorRegister AbsExtentY = VectorAbs(VectorLoadAligned(Block.BoxExtentY));
+		const VectorRegister AbsExtentZ = VectorAbs(VectorLoadAligned(Block.BoxExtentZ));
+		VectorRegister Outside = VectorZero();
+		for (int32 PlaneIndex = 0; PlaneIndex < NumPlanes; PlaneIndex++)
+		{
+			const VectorRegister PlaneX = SplatPlanes[PlaneIndex * 4 + 0];
+			const VectorRegister PlaneY = SplatPlanes[PlaneIndex * 4 + 1];
+			const VectorRegister PlaneZ = SplatPlanes[PlaneIndex * 4 + 2];
+			const VectorRegister PlaneW = SplatPlanes[PlaneIndex * 4 + 3];
+			// (x * x) + (y * y) + (z * z) - w
+			const VectorRegister DistX = VectorMultiply(OriginX, PlaneX);
+			const VectorRegister DistY = VectorMultiplyAdd(OriginY, PlaneY, DistX);
+			const VectorRegister DistZ = VectorMultiplyAdd(OriginZ, PlaneZ, DistY);
+			const VectorRegister Distance = VectorSubtract(DistZ, PlaneW);
+			// FMath::Abs(x * x) + FMath::Abs(y * y) + FMath::Abs(z * z)
+			const VectorRegister PushX = VectorMultiply(AbsExtentX, VectorAbs(PlaneX));
+			const VectorRegister PushY = VectorMultiplyAdd(AbsExtentY, VectorAbs(PlaneY), PushX);
+			const VectorRegister PushOut = VectorMultiplyAdd(AbsExtentZ, VectorAbs(PlaneZ), PushY);
+
+			Outside = VectorBitwiseOr(Outside, VectorBitwiseOr(VectorCompareGT(Distance, SphereRadius), VectorCompareGT(Distance, PushOut)));
+		}
+		OutResult.OutsideFrustum |= GetLaneMask(Outside) << Shift;
+	}
+
+	OutResult.TooClose &= OutResult.Primitives;
+	OutResult.TooFar &= OutResult.Primitives;
+	OutResult.OutsideFrustum &= OutResult.Primitives;
+	OutResult.BeyondMaxDrawDistance &= OutResult.Primitives;
+	OutResult.InFadeRange &= OutResult.Primitives;
+}
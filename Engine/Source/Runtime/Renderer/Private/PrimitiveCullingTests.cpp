@@ -0,0 +1,224 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+/*=============================================================================
+	PrimitiveCullingTests.cpp: Tests FPrimitiveCullingBounds against culling primitives one at a time.
+=============================================================================*/
+
+#include "RendererPrivate.h"
+#include "ScenePrivate.h"
+#include "AutomationTest.h"
+#include "ParallelFor.h"
+
+namespace PrimitiveCullingTests
+{
+	/** Random bounds spread around the origin, with some draw distances set. */
+	static void MakeBounds(FRandomStream& RandomStream, int32 NumPrimitives, TArray<FPrimitiveBounds>& OutBounds, FPrimitiveCullingBounds& OutCullingBounds)
+	{
+		OutBounds.Empty(NumPrimitives);
+		for (int32 Index = 0; Index < NumPrimitives; Index++)
+		{
+			FPrimitiveBounds Bounds;
+			Bounds.Origin = RandomStream.GetUnitVector() * RandomStream.FRandRange(0.0f, 60000.0f);
+			Bounds.BoxExtent = FVector(RandomStream.FRandRange(0.0f, 2000.0f), RandomStream.FRandRange(0.0f, 2000.0f), RandomStream.FRandRange(0.0f, 2000.0f));
+			// Usually the sphere around the box, sometimes tighter so the box test decides
+			Bounds.SphereRadius = Bounds.BoxExtent.Size() * ((RandomStream.FRand() < 0.8f) ? 1.0f : RandomStream.FRand());
+			Bounds.MinDrawDistanceSq = (RandomStream.FRand() < 0.3f) ? FMath::Square(RandomStream.FRandRange(0.0f, 10000.0f)) : 0.0f;
+			Bounds.MaxDrawDistance = (RandomStream.FRand() < 0.5f) ? RandomStream.FRandRange(1000.0f, 50000.0f) : FLT_MAX;
+			OutBounds.Add(Bounds);
+			OutCullingBounds.AddUninitialized();
+			OutCullingBounds.Set(Index, Bounds);
+		}
+	}
+
+	/** What FrustumCull() did for each primitive before the bounds were laid out for culling several at once. */
+	static void CullReference(const TArray<FPrimitiveBounds>& AllBounds, const FPrimitiveCullingBounds::FCullingParams& Params, TBitArray<>& OutVisible, TBitArray<>& OutFading)
+	{
+		OutVisible.Init(false, AllBounds.Num());
+		OutFading.Init(false, AllBounds.Num());
+		for (int32 Index = 0; Index < AllBounds.Num(); Index++)
+		{
+			const FPrimitiveBounds& Bounds = AllBounds[Index];
+			const float DistanceSquared = (Bounds.Origin - Params.ViewOrigin).SizeSquared();
+			const float MaxDrawDistance = Bounds.MaxDrawDistance * Params.MaxDrawDistanceScale;
+			if (DistanceSquared > FMath::Square(MaxDrawDistance + Params.FadeRadius) ||
+				DistanceSquared < Bounds.MinDrawDistanceSq ||
+				Params.Frustum->IntersectSphere(Bounds.Origin, Bounds.SphereRadius) == false ||
+				Params.Frustum->IntersectBox(Bounds.Origin, Bounds.BoxExtent) == false)
+			{
+				continue;
+			}
+			if (DistanceSquared > FMath::Square(MaxDrawDistance))
+			{
+				OutFading[Index] = true;
+			}
+			else
+			{
+				OutVisible[Index] = true;
+				if (DistanceSquared > FMath::Square(MaxDrawDistance - Params.FadeRadius))
+				{
+					OutFading[Index] = true;
+				}
+			}
+		}
+	}
+
+	/** Culls with FPrimitiveCullingBounds the way FrustumCull() does without custom culling. */
+	static void CullWords(const FPrimitiveCullingBounds& CullingBounds, const FPrimitiveCullingBounds::FCullingParams& Params, TBitArray<>& OutVisible, TBitArray<>& OutFading, bool bSingleThreaded)
+	{
+		OutVisible.Init(false, CullingBounds.Num());
+		OutFading.Init(false, CullingBounds.Num());
+		uint32* VisibilityWords = OutVisible.GetData();
+		uint32* FadingWords = OutFading.GetData();
+		const int32 NumWords = FMath::DivideAndRoundUp<int32>(CullingBounds.Num(), FPrimitiveCullingBounds::PrimitivesPerWord);
+		const int32 WordsPerTask = 32;
+		ParallelFor(FMath::DivideAndRoundUp(NumWords, WordsPerTask), [&](int32 TaskIndex)
+		{
+			const int32 EndWord = FMath::Min(NumWords, (TaskIndex + 1) * WordsPerTask);
+			for (int32 WordIndex = TaskIndex * WordsPerTask; WordIndex < EndWord; WordIndex++)
+			{
+				FPrimitiveCullingBounds::FWordResult Result;
+				CullingBounds.CullWord(WordIndex, Params, Result);
+				const uint32 NotCulled = Result.Primitives & ~(Result.TooClose | Result.TooFar | Result.OutsideFrustum);
+				VisibilityWords[WordIndex] = NotCulled & ~Result.BeyondMaxDrawDistance;
+				FadingWords[WordIndex] = NotCulled & (Result.BeyondMaxDrawDistance | Result.InFadeRange);
+			}
+		}, bSingleThreaded);
+	}
+
+	static void MakeFrustums(FRandomStream& RandomStream, TArray<FConvexVolume>& OutFrustums, TArray<FVector>& OutViewOrigins)
+	{
+		for (int32 Index = 0; Index < 4; Index++)
+		{
+			const FVector ViewOrigin = RandomStream.GetUnitVector() * RandomStream.FRandRange(0.0f, 20000.0f);
+			const FMatrix ViewMatrix = FLookAtMatrix(ViewOrigin, ViewOrigin + RandomStream.GetUnitVector(), FVector(0.0f, 0.0f, 1.0f));
+			// infinite far plane (5 planes) like most views, and a far plane (6 planes)
+			const FMatrix ProjectionMatrix = (Index % 2 == 0)
+				? FMatrix(FPerspectiveMatrix(PI / 4.0f, 1920.0f, 1080.0f, 10.0f))
+				: FMatrix(FPerspectiveMatrix(PI / 4.0f, 1920.0f, 1080.0f, 10.0f, 30000.0f));
+			FConvexVolume Frustum;
+			GetViewFrustumBounds(Frustum, ViewMatrix * ProjectionMatrix, true);
+			OutFrustums.Add(Frustum);
+			OutViewOrigins.Add(ViewOrigin);
+		}
+
+		// more planes than a view frustum has, so some of the permuted planes are padding
+		TArray<FPlane, TInlineAllocator<6> > Planes;
+		for (int32 PlaneIndex = 0; PlaneIndex < 7; PlaneIndex++)
+		{
+			const FVector Normal = RandomStream.GetUnitVector();
+			Planes.Add(FPlane(Normal, RandomStream.FRandRange(0.0f, 40000.0f)));
+		}
+		OutFrustums.Add(FConvexVolume(Planes));
+		OutViewOrigins.Add(FVector::ZeroVector);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPrimitiveCullingTest, "System.Renderer.Primitive Culling", EAutomationTestFlags::ATF_SmokeTest)
+
+bool FPrimitiveCullingTest::RunTest(const FString& Parameters)
+{
+	using namespace PrimitiveCullingTests;
+
+	FRandomStream RandomStream(0x1234);
+	TArray<FPrimitiveBounds> AllBounds;
+	FPrimitiveCullingBounds CullingBounds;
+	// not a multiple of the word size, so the last word is partly used
+	MakeBounds(RandomStream, 10000 + 13, AllBounds, CullingBounds);
+
+	TArray<FConvexVolume> Frustums;
+	TArray<FVector> ViewOrigins;
+	MakeFrustums(RandomStream, Frustums, ViewOrigins);
+
+	for (int32 Pass = 0; Pass < 2; Pass++)
+	{
+		if (Pass == 1)
+		{
+			// removing primitives must keep the culling bounds in the same order as FScene::PrimitiveBounds
+			for (int32 Count = 0; Count < 1000; Count++)
+			{
+				const int32 Index = RandomStream.RandHelper(AllBounds.Num());
+				AllBounds.RemoveAtSwap(Index);
+				CullingBounds.RemoveAtSwap(Index);
+			}
+			TestEqual(TEXT("Culling bounds count after removal"), CullingBounds.Num(), AllBounds.Num());
+		}
+
+		for (int32 FrustumIndex = 0; FrustumIndex < Frustums.Num(); FrustumIndex++)
+		{
+			FPrimitiveCullingBounds::FCullingParams Params;
+			Params.Frustum = &Frustums[FrustumIndex];
+			Params.ViewOrigin = ViewOrigins[FrustumIndex];
+			Params.MaxDrawDistanceScale = (FrustumIndex % 2 == 0) ? 1.0f : 0.7f;
+			Params.FadeRadius = (FrustumIndex % 3 == 0) ? 0.0f : 1000.0f;
+
+			TBitArray<> ReferenceVisible, ReferenceFading, Visible, Fading;
+			CullReference(AllBounds, Params, ReferenceVisible, ReferenceFading);
+			CullWords(CullingBounds, Params, Visible, Fading, false);
+
+			int32 NumMismatches = 0;
+			for (int32 Index = 0; Index < AllBounds.Num(); Index++)
+			{
+				if (ReferenceVisible[Index] != Visible[Index] || ReferenceFading[Index] != Fading[Index])
+				{
+					if (NumMismatches++ < 10)
+					{
+						AddError(FString::Printf(TEXT("Pass %d frustum %d primitive %d: visible %d fading %d, expected visible %d fading %d"),
+							Pass, FrustumIndex, Index, Visible[Index] ? 1 : 0, Fading[Index] ? 1 : 0, ReferenceVisible[Index] ? 1 : 0, ReferenceFading[Index] ? 1 : 0));
+					}
+				}
+			}
+			TestEqual(TEXT("Primitives culled differently"), NumMismatches, 0);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPrimitiveCullingPerformanceTest, "System.Renderer.Primitive Culling Performance", EAutomationTestFlags::ATF_Editor)
+
+bool FPrimitiveCullingPerformanceTest::RunTest(const FString& Parameters)
+{
+	using namespace PrimitiveCullingTests;
+
+	// a large scene's worth of primitives
+	FRandomStream RandomStream(0x5678);
+	TArray<FPrimitiveBounds> AllBounds;
+	FPrimitiveCullingBounds CullingBounds;
+	MakeBounds(RandomStream, 250000, AllBounds, CullingBounds);
+
+	TArray<FConvexVolume> Frustums;
+	TArray<FVector> ViewOrigins;
+	MakeFrustums(RandomStream, Frustums, ViewOrigins);
+
+	FPrimitiveCullingBounds::FCullingParams Params;
+	Params.Frustum = &Frustums[0];
+	Params.ViewOrigin = ViewOrigins[0];
+	Params.MaxDrawDistanceScale = 1.0f;
+	Params.FadeRadius = 1000.0f;
+
+	const int32 NumIterations = 20;
+	TBitArray<> Visible, Fading;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		CullReference(AllBounds, Params, Visible, Fading);
+	}
+	const double ReferenceMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		CullWords(CullingBounds, Params, Visible, Fading, true);
+	}
+	const double VectorMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		CullWords(CullingBounds, Params, Visible, Fading, false);
+	}
+	const double ParallelMs = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumIterations;
+
+	AddLogItem(FString::Printf(TEXT("%d primitives: one at a time %.3f ms, four at a time %.3f ms, parallel %.3f ms"), AllBounds.Num(), ReferenceMs, VectorMs, ParallelMs));
+	return true;
+}
@@ -1231,6 +1231,85 @@ struct FPrimitiveBounds
 	float MaxDrawDistance;
 };
 
+/**
+ * The bounds in FScene::PrimitiveBounds laid out as a structure of arrays for frustum culling. Primitives are grouped in blocks
+ * of four, the block's origin Xs, origin Ys, etc. are next to each other so each loads into one vector register and the whole
+ * block is tested against a plane at once. Kept in the same order as FScene::PrimitiveBounds.
+ */
+class FPrimitiveCullingBounds
+{
+public:
+	/** View values the primitives are culled against. */
+	struct FCullingParams
+	{
+		const FConvexVolume* Frustum;
+		FVector ViewOrigin;
+		float MaxDrawDistanceScale;
+		float FadeRadius;
+	};
+
+	/**
+	 * Culling results for the 32 primitives of one visibility map word, bit N is primitive WordIndex * 32 + N.
+	 * Bits past the last primitive are never set.
+	 */
+	struct FWordResult
+	{
+		/** The primitives in this word. */
+		uint32 Primitives;
+		/** Closer than the min draw distance. */
+		uint32 TooClose;
+		/** Beyond the max draw distance plus the fade radius. */
+		uint32 TooFar;
+		/** Failed the bounding sphere or box test against the frustum. */
+		uint32 OutsideFrustum;
+		/** Beyond the max draw distance. */
+		uint32 BeyondMaxDrawDistance;
+		/** Beyond the max draw distance minus the fade radius. */
+		uint32 InFadeRange;
+	};
+
+	FPrimitiveCullingBounds()
+		: NumPrimitives(0)
+	{}
+
+	FORCEINLINE int32 Num() const
+	{
+		return NumPrimitives;
+	}
+
+	void AddUninitialized();
+	void RemoveAtSwap(int32 Index);
+	void Set(int32 Index, const FPrimitiveBounds& Bounds);
+	void ApplyWorldOffset(const FVector& Offset);
+
+	/**
+	 * Distance and frustum culls the primitives of one visibility map word, with the same results as testing each primitive's
+	 * FPrimitiveBounds against FConvexVolume::IntersectSphere() and FConvexVolume::IntersectBox() one at a time.
+	 */
+	void CullWord(int32 WordIndex, const FCullingParams& Params, FWordResult& OutResult) const;
+
+	/** Primitives per visibility map word. */
+	enum { PrimitivesPerWord = 32 };
+
+private:
+	/** Four primitives, each member is loaded into a vector register. */
+	MS_ALIGN(16) struct FBlock
+	{
+		float OriginX[4];
+		float OriginY[4];
+		float OriginZ[4];
+		float BoxExtentX[4];
+		float BoxExtentY[4];
+		float BoxExtentZ[4];
+		float SphereRadius[4];
+		float MinDrawDistanceSq[4];
+		float MaxDrawDistance[4];
+	} GCC_ALIGN(16);
+
+	TArray<FBlock, TAlignedHeapAllocator<16> > Blocks;
+	int32 NumPrimitives;
+};
+
 /**
  * Precomputed primitive visibility ID.
  */
@@ -1435,6 +1514,8 @@ public:
 	TArray<FPrimitiveSceneInfo*> Primitives;
 	/** Packed array of primitive bounds. */
 	TArray<FPrimitiveBounds> PrimitiveBounds;
+	/** The same bounds laid out for culling many primitives at once. */
+	FPrimitiveCullingBounds PrimitiveCullingBounds;
 	/** Packed array of precomputed primitive visibility IDs. */
 	TArray<FPrimitiveVisibilityId> PrimitiveVisibilityIds;
 	/** Packed array of primitive occlusion flags. See EOcclusionFlags. */
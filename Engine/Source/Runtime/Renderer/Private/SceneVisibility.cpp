@@ -11,6 +11,7 @@
 #include "../../Engine/Private/SkeletalRenderGPUSkin.h"		// GPrevPerBoneMotionBlur
 #include "SceneUtils.h"
 #include "PostProcessing.h"
+#include "ParallelFor.h"
 
 /*------------------------------------------------------------------------------
 	Globals
@@ -54,6 +55,39 @@ static TAutoConsoleVariable<int32> CVarTemporalAASamples(
 	TEXT("Number of jittered positions for temporal AA (4, 8=default, 16, 32, 64)."),
 	ECVF_RenderThreadSafe);
 
+static int32 GParallelFrustumCull = 1;
+static FAutoConsoleVariableRef CVarParallelFrustumCull(
+	TEXT("r.ParallelFrustumCull"),
+	GParallelFrustumCull,
+	TEXT("Toggles frustum culling primitives on multiple threads."),
+	ECVF_RenderThreadSafe
+	);
+
+static int32 GFrustumCullWordsPerTask = 32;
+static FAutoConsoleVariableRef CVarFrustumCullWordsPerTask(
+	TEXT("r.FrustumCullWordsPerTask"),
+	GFrustumCullWordsPerTask,
+	TEXT("Number of visibility map words (32 primitives each) a frustum culling task handles."),
+	ECVF_RenderThreadSafe
+	);
+
+static int32 GStaticMeshMarkWordsPerTask = 64;
+static FAutoConsoleVariableRef CVarStaticMeshMarkWordsPerTask(
+	TEXT("r.StaticMeshMarkWordsPerTask"),
+	GStaticMeshMarkWordsPerTask,
+	TEXT("Number of static mesh visibility map words (32 meshes each) a task builds from the relevance mark masks."),
+	ECVF_RenderThreadSafe
+	);
+
+static int32 GStaticMeshMarkParallelMinWords = 512;
+static FAutoConsoleVariableRef CVarStaticMeshMarkParallelMinWords(
+	TEXT("r.StaticMeshMarkParallelMinWords"),
+	GStaticMeshMarkParallelMinWords,
+	TEXT("Views with fewer static mesh visibility map words than this (32 meshes each) build them from the relevance mark masks on the render thread alone,\n")
+	TEXT("starting the tasks would cost more than it saves. r.BenchmarkStaticMeshMarkMasks times both ways to pick it."),
+	ECVF_RenderThreadSafe
+	);
+
 #if PLATFORM_MAC // @todo: disabled until rendering problems with HZB occlusion in OpenGL are solved
 static int32 GHZBOcclusion = 0;
 #else
@@ -231,65 +265,99 @@ bool FViewInfo::IsDistanceCulled( float DistanceSquared, float MinDrawDistance,
 
 /**
  * Frustum cull primitives in the scene against the view.
+ * Each task culls whole words of the visibility maps, FPrimitiveCullingBounds tests four primitives at a time.
  */
 template<bool UseCustomCulling>
 static int32 FrustumCull(const FScene* Scene, FViewInfo& View)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FrustumCull);
 
-	int32 NumCulledPrimitives = 0;
-	FVector ViewOriginForDistanceCulling = View.ViewMatrices.ViewOrigin;
-	float MaxDrawDistanceScale = GetCachedScalabilityCVars().ViewDistanceScale;
-	float FadeRadius = GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel;
-	uint8 CustomVisibilityFlags = EOcclusionFlags::CanBeOccluded | EOcclusionFlags::HasPrecomputedVisibility;
-
-	for (FSceneBitArray::FIterator BitIt(View.PrimitiveVisibilityMap); BitIt; ++BitIt)
+	FPrimitiveCullingBounds::FCullingParams Params;
+	Params.Frustum = &View.ViewFrustum;
+	Params.ViewOrigin = View.ViewMatrices.ViewOrigin;
+	Params.MaxDrawDistanceScale = GetCachedScalabilityCVars().ViewDistanceScale;
+	Params.FadeRadius = GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel;
+	const bool bDistanceCulledPrimitives = View.Family->EngineShowFlags.DistanceCulledPrimitives;
+	const uint8 CustomVisibilityFlags = EOcclusionFlags::CanBeOccluded | EOcclusionFlags::HasPrecomputedVisibility;
+
+	const FPrimitiveCullingBounds& CullingBounds = Scene->PrimitiveCullingBounds;
+	check(View.PrimitiveVisibilityMap.Num() == CullingBounds.Num() && View.PotentiallyFadingPrimitiveMap.Num() == CullingBounds.Num());
+	uint32* VisibilityWords = View.PrimitiveVisibilityMap.GetData();
+	uint32* FadingWords = View.PotentiallyFadingPrimitiveMap.GetData();
+	const int32 NumWords = FMath::DivideAndRoundUp<int32>(CullingBounds.Num(), FPrimitiveCullingBounds::PrimitivesPerWord);
+	const int32 WordsPerTask = FMath::Max(GFrustumCullWordsPerTask, 1);
+	const int32 NumTasks = FMath::DivideAndRoundUp<int32>(NumWords, WordsPerTask);
+	FThreadSafeCounter NumCulledPrimitives;
+
+	// The custom visibility query isn't known to be thread safe
+	const bool bSingleThreaded = UseCustomCulling || !GParallelFrustumCull || NumTasks < 2;
+	ParallelFor(NumTasks, [&](int32 TaskIndex)
 	{
-		const FPrimitiveBounds& Bounds = Scene->PrimitiveBounds[BitIt.GetIndex()];
-		float DistanceSquared = (Bounds.Origin - ViewOriginForDistanceCulling).SizeSquared();
-		float MaxDrawDistance = Bounds.MaxDrawDistance * MaxDrawDistanceScale;
-		int32 VisibilityId = INDEX_NONE;
-
-		if (UseCustomCulling &&
-			((Scene->PrimitiveOcclusionFlags[BitIt.GetIndex()] & CustomVisibilityFlags) == CustomVisibilityFlags))
+#if STATS
+		int32 NumCulledInTask = 0;
+#endif
+		const int32 EndWord = FMath::Min(NumWords, (TaskIndex + 1) * WordsPerTask);
+		for (int32 WordIndex = TaskIndex * WordsPerTask; WordIndex < EndWord; WordIndex++)
 		{
-			VisibilityId = Scene->PrimitiveVisibilityIds[BitIt.GetIndex()].ByteIndex;
-		}
+			FPrimitiveCullingBounds::FWordResult Result;
+			CullingBounds.CullWord(WordIndex, Params, Result);
+			const int32 FirstPrimitive = WordIndex * FPrimitiveCullingBounds::PrimitivesPerWord;
 
-		// If cull distance is disabled, always show (except foliage)
-		if (View.Family->EngineShowFlags.DistanceCulledPrimitives
-			&& !Scene->Primitives[BitIt.GetIndex()]->Proxy->IsDetailMesh())
-		{
-			MaxDrawDistance = FLT_MAX;
-		}
+			// If cull distance is disabled, always show (except foliage)
+			if (bDistanceCulledPrimitives)
+			{
+				for (uint32 Bits = Result.TooFar | Result.BeyondMaxDrawDistance | Result.InFadeRange; Bits != 0; Bits &= Bits - 1)
+				{
+					const uint32 Bit = Bits & (~Bits + 1);
+					if (!Scene->Primitives[FirstPrimitive + FMath::FloorLog2(Bit)]->Proxy->IsDetailMesh())
+					{
+						Result.TooFar &= ~Bit;
+						Result.BeyondMaxDrawDistance &= ~Bit;
+						Result.InFadeRange &= ~Bit;
+					}
+				}
+			}
 
-		// The primitive is always culled if it exceeds the max fade distance or lay outside the view frustum.
-		if (DistanceSquared > FMath::Square(MaxDrawDistance + FadeRadius) ||
-			DistanceSquared < Bounds.MinDrawDistanceSq ||
-			(UseCustomCulling && !View.CustomVisibilityQuery->IsVisible(VisibilityId, FBoxSphereBounds(Bounds.Origin, Bounds.BoxExtent, Bounds.SphereRadius))) ||
-			View.ViewFrustum.IntersectSphere(Bounds.Origin, Bounds.SphereRadius) == false ||
-			View.ViewFrustum.IntersectBox(Bounds.Origin, Bounds.BoxExtent) == false)
-		{
-			STAT(NumCulledPrimitives++);
-			continue;
-		}
+			// The primitive is always culled if it exceeds the max fade distance or lay outside the view frustum.
+			uint32 Culled = Result.TooClose | Result.TooFar;
+			if (UseCustomCulling)
+			{
+				for (uint32 Bits = Result.Primitives & ~Culled; Bits != 0; Bits &= Bits - 1)
+				{
+					const uint32 Bit = Bits & (~Bits + 1);
+					const int32 PrimitiveIndex = FirstPrimitive + FMath::FloorLog2(Bit);
+					int32 VisibilityId = INDEX_NONE;
+					if ((Scene->PrimitiveOcclusionFlags[PrimitiveIndex] & CustomVisibilityFlags) == CustomVisibilityFlags)
+					{
+						VisibilityId = Scene->PrimitiveVisibilityIds[PrimitiveIndex].ByteIndex;
+					}
+					const FPrimitiveBounds& Bounds = Scene->PrimitiveBounds[PrimitiveIndex];
+					if (!View.CustomVisibilityQuery->IsVisible(VisibilityId, FBoxSphereBounds(Bounds.Origin, Bounds.BoxExtent, Bounds.SphereRadius)))
+					{
+						Culled |= Bit;
+					}
+				}
+			}
+			Culled |= Result.OutsideFrustum;
 
-		if (DistanceSquared > FMath::Square(MaxDrawDistance))
-		{
-			View.PotentiallyFadingPrimitiveMap.AccessCorrespondingBit(BitIt) = true;
-		}
-		else
-		{
-			// The primitive is visible!
-			BitIt.GetValue() = true;
-			if (DistanceSquared > FMath::Square(MaxDrawDistance - FadeRadius))
+			// Primitives beyond the max draw distance are only drawn while they fade out, the rest are visible and may be fading too
+			const uint32 NotCulled = Result.Primitives & ~Culled;
+			VisibilityWords[WordIndex] = NotCulled & ~Result.BeyondMaxDrawDistance;
+			FadingWords[WordIndex] = NotCulled & (Result.BeyondMaxDrawDistance | Result.InFadeRange);
+
+#if STATS
+			for (uint32 Bits = Result.Primitives & Culled; Bits != 0; Bits &= Bits - 1)
 			{
-				View.PotentiallyFadingPrimitiveMap.AccessCorrespondingBit(BitIt) = true;
+				NumCulledInTask++;
 			}
+#endif
 		}
-	}
+#if STATS
+		NumCulledPrimitives.Add(NumCulledInTask);
+#endif
+	}, bSingleThreaded);
 
-	return NumCulledPrimitives;
+	return NumCulledPrimitives.GetValue();
 }
 
 /**
@@ -1236,6 +1304,129 @@ static TAutoConsoleVariable<int32> CVarParallelInitViews(
 	);
 
 
+/** The words of a view's static mesh bit arrays, which TransposeMarkMasks fills in */
+struct FStaticMeshMarkWords
+{
+	uint32* VisibilityMap;
+	uint32* VelocityMap;
+	uint32* ShadowDepthMap;
+	uint32* OccluderMap;
+};
+
+/**
+ * Turns the per mesh mark masks written by the relevance packets into the static mesh bit arrays,
+ * for the 32 meshes of each word in [FirstWord, EndWord). Each call owns whole words so calls can run in parallel.
+ */
+static void TransposeMarkMasks(const FStaticMeshMarkWords& Words, const uint8* RESTRICT MarkMasks, int32 FirstWord, int32 EndWord)
+{
+	uint32* RESTRICT StaticMeshVisibilityMap_Words = Words.VisibilityMap + FirstWord;
+	uint32* RESTRICT StaticMeshVelocityMap_Words = Words.VelocityMap + FirstWord;
+	uint32* RESTRICT StaticMeshShadowDepthMap_Words = Words.ShadowDepthMap + FirstWord;
+	uint32* RESTRICT StaticMeshOccluderMap_Words = Words.OccluderMap + FirstWord;
+	const uint64* RESTRICT MarkMasks64 = (const uint64* RESTRICT)(MarkMasks + FirstWord * 32);
+	const uint8* RESTRICT MarkMasks8 = MarkMasks + FirstWord * 32;
+	for (int32 WordIndex = FirstWord; WordIndex < EndWord; WordIndex++)
+	{
+		uint32 StaticMeshVisibilityMap_Word = 0;
+		uint32 StaticMeshVelocityMap_Word = 0;
+		uint32 StaticMeshShadowDepthMap_Word = 0;
+		uint32 StaticMeshOccluderMap_Word = 0;
+		uint32 Mask = 1;
+		bool bAny = false;
+		for (int32 QWordIndex = 0; QWordIndex < 4; QWordIndex++)
+		{
+			if (*MarkMasks64++)
+			{
+				for (int32 ByteIndex = 0; ByteIndex < 8; ByteIndex++, Mask <<= 1, MarkMasks8++)
+				{
+					uint8 MaskMask = *MarkMasks8;
+					StaticMeshVisibilityMap_Word |= (MaskMask & EMarkMaskBits::StaticMeshVisibilityMapMask) ? Mask : 0;
+					StaticMeshVelocityMap_Word |= (MaskMask & EMarkMaskBits::StaticMeshVelocityMapMask) ? Mask : 0;
+					StaticMeshShadowDepthMap_Word |= (MaskMask & EMarkMaskBits::StaticMeshShadowDepthMapMask) ? Mask : 0;
+					StaticMeshOccluderMap_Word |= (MaskMask & EMarkMaskBits::StaticMeshOccluderMapMask) ? Mask : 0;
+				}
+				bAny = true;
+			}
+			else
+			{
+				MarkMasks8 += 8;
+				Mask <<= 8;
+			}
+		}
+		if (bAny)
+		{
+			checkSlow(!*StaticMeshVisibilityMap_Words && !*StaticMeshVelocityMap_Words && !*StaticMeshShadowDepthMap_Words && !*StaticMeshOccluderMap_Words);
+			*StaticMeshVisibilityMap_Words = StaticMeshVisibilityMap_Word;
+			*StaticMeshVelocityMap_Words = StaticMeshVelocityMap_Word;
+			*StaticMeshShadowDepthMap_Words = StaticMeshShadowDepthMap_Word;
+			*StaticMeshOccluderMap_Words = StaticMeshOccluderMap_Word;
+		}
+		StaticMeshVisibilityMap_Words++;
+		StaticMeshVelocityMap_Words++;
+		StaticMeshShadowDepthMap_Words++;
+		StaticMeshOccluderMap_Words++;
+	}
+}
+
+/**
+ * Runs TransposeMarkMasks over all NumWords words, split into tasks of r.StaticMeshMarkWordsPerTask words
+ * when there are at least MinParallelWords of them.
+ */
+static void TransposeAllMarkMasks(const FStaticMeshMarkWords& Words, const uint8* RESTRICT MarkMasks, int32 NumWords, int32 MinParallelWords)
+{
+	const int32 WordsPerTask = FMath::Max(GStaticMeshMarkWordsPerTask, 1);
+	const int32 NumTasks = FMath::DivideAndRoundUp(NumWords, WordsPerTask);
+	const bool bSingleThreaded = NumWords < MinParallelWords || NumTasks < 2;
+	ParallelFor(NumTasks, [&Words, MarkMasks, NumWords, WordsPerTask](int32 TaskIndex)
+	{
+		const int32 FirstWord = TaskIndex * WordsPerTask;
+		TransposeMarkMasks(Words, MarkMasks, FirstWord, FMath::Min(FirstWord + WordsPerTask, NumWords));
+	}, bSingleThreaded);
+}
+
+/** Times TransposeAllMarkMasks on one thread and in tasks for a range of static mesh counts, to pick r.StaticMeshMarkParallelMinWords. */
+static void BenchmarkStaticMeshMarkMasks()
+{
+	const int32 NumIterations = 50;
+	UE_LOG(LogRenderer, Display, TEXT("Static mesh mark mask transpose, %i words per task, avg of %i runs:"), FMath::Max(GStaticMeshMarkWordsPerTask, 1), NumIterations);
+	for (int32 NumWords = 16; NumWords <= 8192; NumWords *= 2)
+	{
+		// about a quarter of the meshes marked, in runs like the meshes of one primitive
+		TArray<uint8> MarkMasks;
+		MarkMasks.AddZeroed(NumWords * 32);
+		for (int32 MeshIndex = 0; MeshIndex < MarkMasks.Num(); MeshIndex += 4)
+		{
+			if (FMath::Rand() % 4 == 0)
+			{
+				FMemory::Memset(&MarkMasks[MeshIndex], uint8(EMarkMaskBits::StaticMeshVisibilityMapMask | EMarkMaskBits::StaticMeshShadowDepthMapMask), 4);
+			}
+		}
+		TArray<uint32> WordStorage;
+		WordStorage.AddUninitialized(NumWords * 4);
+		FStaticMeshMarkWords Words = { WordStorage.GetData(), WordStorage.GetData() + NumWords, WordStorage.GetData() + NumWords * 2, WordStorage.GetData() + NumWords * 3 };
+
+		double Seconds[2] = { 0.0, 0.0 };
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			for (int32 Parallel = 0; Parallel < 2; Parallel++)
+			{
+				FMemory::Memzero(WordStorage.GetData(), WordStorage.Num() * sizeof(uint32));
+				const double StartTime = FPlatformTime::Seconds();
+				TransposeAllMarkMasks(Words, MarkMasks.GetData(), NumWords, Parallel ? 0 : MAX_int32);
+				Seconds[Parallel] += FPlatformTime::Seconds() - StartTime;
+			}
+		}
+		UE_LOG(LogRenderer, Display, TEXT("  %5i words (%6i meshes): one thread %7.1fus, tasks %7.1fus"), NumWords, NumWords * 32,
+			Seconds[0] * 1000000.0 / NumIterations, Seconds[1] * 1000000.0 / NumIterations);
+	}
+}
+
+static FAutoConsoleCommand BenchmarkStaticMeshMarkMasksCmd(
+	TEXT("r.BenchmarkStaticMeshMarkMasks"),
+	TEXT("Times building static mesh visibility bit arrays from relevance mark masks on one thread and in tasks, for a range of static mesh counts."),
+	FConsoleCommandDelegate::CreateStatic(BenchmarkStaticMeshMarkMasks)
+	);
+
 /**
  * Computes view relevance for visible primitives in the view and adds them to
  * appropriate per-view rendering lists.
@@ -1338,53 +1529,9 @@ static void ComputeAndMarkRelevanceForViewParallel(
 	}
 	QUICK_SCOPE_CYCLE_COUNTER(STAT_ComputeAndMarkRelevanceForViewParallel_TransposeMeshBits);
 	check(View.StaticMeshVelocityMap.Num() == NumMesh && View.StaticMeshShadowDepthMap.Num() == NumMesh && View.StaticMeshVisibilityMap.Num() == NumMesh && View.StaticMeshOccluderMap.Num() == NumMesh);
-	uint32* RESTRICT StaticMeshVisibilityMap_Words = View.StaticMeshVisibilityMap.GetData();
-	uint32* RESTRICT StaticMeshVelocityMap_Words = View.StaticMeshVelocityMap.GetData();
-	uint32* RESTRICT StaticMeshShadowDepthMap_Words = View.StaticMeshShadowDepthMap.GetData();
-	uint32* RESTRICT StaticMeshOccluderMap_Words = View.StaticMeshOccluderMap.GetData();
-	const uint64* RESTRICT MarkMasks64 = (const uint64* RESTRICT)MarkMasks;
-	const uint8* RESTRICT MarkMasks8 = MarkMasks;
-	for (int32 BaseIndex = 0; BaseIndex < NumMesh; BaseIndex += 32)
-	{
-		uint32 StaticMeshVisibilityMap_Word = 0;
-		uint32 StaticMeshVelocityMap_Word = 0;
-		uint32 StaticMeshShadowDepthMap_Word = 0;
-		uint32 StaticMeshOccluderMap_Word = 0;
-		uint32 Mask = 1;
-		bool bAny = false;
-		for (int32 QWordIndex = 0; QWordIndex < 4; QWordIndex++)
-		{
-			if (*MarkMasks64++)
-			{
-				for (int32 ByteIndex = 0; ByteIndex < 8; ByteIndex++, Mask <<= 1, MarkMasks8++)
-				{
-					uint8 MaskMask = *MarkMasks8;
-					StaticMeshVisibilityMap_Word |= (MaskMask & EMarkMaskBits::StaticMeshVisibilityMapMask) ? Mask : 0;
-					StaticMeshVelocityMap_Word |= (MaskMask & EMarkMaskBits::StaticMeshVelocityMapMask) ? Mask : 0;
-					StaticMeshShadowDepthMap_Word |= (MaskMask & EMarkMaskBits::StaticMeshShadowDepthMapMask) ? Mask : 0;
-					StaticMeshOccluderMap_Word |= (MaskMask & EMarkMaskBits::StaticMeshOccluderMapMask) ? Mask : 0;
-				}
-				bAny = true;
-			}
-			else
-			{
-				MarkMasks8 += 8;
-				Mask <<= 8;
-			}
-		}
-		if (bAny)
-		{
-			checkSlow(!*StaticMeshVisibilityMap_Words && !*StaticMeshVelocityMap_Words && !*StaticMeshShadowDepthMap_Words && !*StaticMeshOccluderMap_Words);
-			*StaticMeshVisibilityMap_Words = StaticMeshVisibilityMap_Word;
-			*StaticMeshVelocityMap_Words = StaticMeshVelocityMap_Word;
-			*StaticMeshShadowDepthMap_Words = StaticMeshShadowDepthMap_Word;
-			*StaticMeshOccluderMap_Words = StaticMeshOccluderMap_Word;
-		}
-		StaticMeshVisibilityMap_Words++;
-		StaticMeshVelocityMap_Words++;
-		StaticMeshShadowDepthMap_Words++;
-		StaticMeshOccluderMap_Words++;
-	}
+	FStaticMeshMarkWords Words = { View.StaticMeshVisibilityMap.GetData(), View.StaticMeshVelocityMap.GetData(), View.StaticMeshShadowDepthMap.GetData(), View.StaticMeshOccluderMap.GetData() };
+	const bool bAllowParallel = FApp::ShouldUseThreadingForPerformance() && CVarParallelInitViews.GetValueOnRenderThread() > 0;
+	TransposeAllMarkMasks(Words, MarkMasks, FMath::DivideAndRoundUp(NumMesh, 32), bAllowParallel ? GStaticMeshMarkParallelMinWords : MAX_int32);
 }
 
 void FSceneRenderer::GatherDynamicMeshElements(
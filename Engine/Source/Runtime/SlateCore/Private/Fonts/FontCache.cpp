@@ -6,6 +6,25 @@
 DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Num Font Atlases"), STAT_SlateNumFontAtlases, STATGROUP_SlateMemory);
 DECLARE_MEMORY_STAT(TEXT("Font Kerning Table Memory"), STAT_SlateFontKerningTableMemory, STATGROUP_SlateMemory);
 DEFINE_STAT(STAT_SlateFontMeasureCacheMemory);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Font Atlas Fill (% of a page)"), STAT_SlateFontAtlasFill, STATGROUP_SlateMemory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shaped Text Cache Hits"), STAT_SlateShapedTextCacheHits, STATGROUP_Slate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shaped Text Cache Misses"), STAT_SlateShapedTextCacheMisses, STATGROUP_Slate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Font Prewarm Characters"), STAT_SlateFontPrewarmCharacters, STATGROUP_Slate);
+
+static TAutoConsoleVariable<int32> CVarShapedTextCacheSize(
+	TEXT("Slate.ShapedTextCacheSize"),
+	1000,
+	TEXT("Number of shaped strings a font cache keeps before throwing out the ones that weren't drawn last frame. 0 shapes strings every time they are drawn."));
+
+static TAutoConsoleVariable<float> CVarFontPrewarmBudgetMs(
+	TEXT("Slate.FontPrewarmBudgetMs"),
+	1.0f,
+	TEXT("Milliseconds per frame spent caching characters queued with FSlateFontCache::RequestPrewarm()."));
+
+static TAutoConsoleVariable<float> CVarFontPrewarmMaxAtlasFill(
+	TEXT("Slate.FontPrewarmMaxAtlasFill"),
+	0.75f,
+	TEXT("Prewarming stops once the font atlas is this full, so it never adds a page (which flushes the cache)."));
 
 #ifndef WITH_FREETYPE
 	#define WITH_FREETYPE	0
@@ -1063,6 +1082,7 @@ FCharacterEntry& FCharacterList::CacheCharacter( TCHAR Character )
 FSlateFontCache::FSlateFontCache( TSharedRef<ISlateFontAtlasFactory> InFontAtlasFactory )
 	: FTInterface( new FFreeTypeInterface )
 	, FontAtlasFactory( InFontAtlasFactory )
+	, CacheFrame( 0 )
 	, bFlushRequested( false )
 {
 
@@ -1185,6 +1205,156 @@ FCharacterList& FSlateFontCache::GetCharacterList( const FSlateFontInfo &InFontI
 	return FontToCharacterListCache.Add( FontKey, MakeShareable( new FCharacterList( FontKey, *this ) ) ).Get();
 }
 
+TSharedRef<const FShapedGlyphRun> FSlateFontCache::GetShapedGlyphRun( const FString& Text, const FSlateFontInfo& InFontInfo, float FontScale ) const
+{
+	if( CVarShapedTextCacheSize.GetValueOnAnyThread() <= 0 )
+	{
+		return ShapeGlyphRun( Text, InFontInfo, FontScale );
+	}
+
+	// Nothing is copied to look the run up, only a miss copies the font info and the string for the new key
+	const FShapedGlyphRunKey Key( InFontInfo, FontScale, Text );
+	const FCompositeFont* const CompositeFont = InFontInfo.GetCompositeFont();
+
+	const TSharedRef<FCachedShapedGlyphRun>* FoundRun = ShapedGlyphRuns.Find( Key );
+	if( FoundRun && CompositeFont && (*FoundRun)->Run->CompositeFontHistoryRevision == CompositeFont->HistoryRevision )
+	{
+		INC_DWORD_STAT( STAT_SlateShapedTextCacheHits );
+		(*FoundRun)->Run->LastUsedFrame = CacheFrame;
+		return (*FoundRun)->Run;
+	}
+
+	INC_DWORD_STAT( STAT_SlateShapedTextCacheMisses );
+	TSharedRef<FShapedGlyphRun> NewRun = ShapeGlyphRun( Text, InFontInfo, FontScale );
+	if( FoundRun )
+	{
+		// The composite font changed since, the key is still good
+		(*FoundRun)->Run = NewRun;
+	}
+	else
+	{
+		TSharedRef<FCachedShapedGlyphRun> CachedRun = MakeShareable( new FCachedShapedGlyphRun( InFontInfo, Text, NewRun ) );
+		ShapedGlyphRuns.Add( Key.Rebind( CachedRun->FontInfo, CachedRun->Text ), CachedRun );
+	}
+	return NewRun;
+}
+
+const FShapedGlyphRun* FSlateFontCache::FindShapedGlyphRun( const FString& Text, const FSlateFontInfo& InFontInfo, float FontScale ) const
+{
+	if( ShapedGlyphRuns.Num() == 0 )
+	{
+		return nullptr;
+	}
+
+	const TSharedRef<FCachedShapedGlyphRun>* FoundRun = ShapedGlyphRuns.Find( FShapedGlyphRunKey( InFontInfo, FontScale, Text ) );
+	const FCompositeFont* const CompositeFont = InFontInfo.GetCompositeFont();
+	if( FoundRun && CompositeFont && (*FoundRun)->Run->CompositeFontHistoryRevision == CompositeFont->HistoryRevision )
+	{
+		(*FoundRun)->Run->LastUsedFrame = CacheFrame;
+		return &(*FoundRun)->Run.Get();
+	}
+	return nullptr;
+}
+
+TSharedRef<FShapedGlyphRun> FSlateFontCache::ShapeGlyphRun( const FString& Text, const FSlateFontInfo& InFontInfo, float FontScale ) const
+{
+	FCharacterList& CharacterList = GetCharacterList( InFontInfo, FontScale );
+	const FCompositeFont* const CompositeFont = InFontInfo.GetCompositeFont();
+
+	TSharedRef<FShapedGlyphRun> Run = MakeShareable( new FShapedGlyphRun );
+	Run->MaxHeight = CharacterList.GetMaxHeight();
+	Run->CompositeFontHistoryRevision = CompositeFont ? CompositeFont->HistoryRevision : 0;
+	Run->LastUsedFrame = CacheFrame;
+	Run->Glyphs.Reserve( Text.Len() );
+
+	// Glyphs are placed like FSlateElementBatcher::AddTextElement() always placed them, which leaves out kerning before whitespace.
+	// The size is worked out like FSlateFontMeasure does, which doesn't.
+	float LineX = 0;
+	float LineY = 0;
+	int32 MeasureX = 0;
+	int32 MaxLineWidth = 0;
+	int32 StringSizeY = Run->MaxHeight;
+	FCharacterEntry PreviousCharEntry;
+
+	for( int32 CharIndex = 0; CharIndex < Text.Len(); ++CharIndex )
+	{
+		const TCHAR CurrentChar = Text[ CharIndex ];
+
+		if( CurrentChar == '\n' )
+		{
+			LineY += Run->MaxHeight;
+			LineX = 0;
+			StringSizeY += Run->MaxHeight;
+			MaxLineWidth = FMath::Max( MeasureX, MaxLineWidth );
+			MeasureX = 0;
+		}
+		else
+		{
+			const FCharacterEntry& Entry = CharacterList[ CurrentChar ];
+			const int32 Kerning = PreviousCharEntry.IsValidEntry() ? CharacterList.GetKerning( PreviousCharEntry, Entry ) : 0;
+			const bool bIsWhitespace = FText::IsWhitespace( CurrentChar );
+
+			MeasureX += Kerning + Entry.XAdvance;
+
+			if( !bIsWhitespace )
+			{
+				LineX += Kerning;
+
+				FShapedGlyph& Glyph = Run->Glyphs[ Run->Glyphs.AddUninitialized() ];
+				Glyph.PenX = LineX;
+				Glyph.LineY = LineY;
+				Glyph.Entry = Entry;
+			}
+
+			LineX += Entry.XAdvance;
+			PreviousCharEntry = Entry;
+		}
+	}
+
+	Run->Size = FVector2D( FMath::Max( MeasureX, MaxLineWidth ), StringSizeY );
+	return Run;
+}
+
+void FSlateFontCache::RequestPrewarm( const FSlateFontInfo& InFontInfo, float FontScale, const FString& Characters )
+{
+	if( Characters.Len() > 0 )
+	{
+		PrewarmRequests.Add( FPrewarmRequest( FSlateFontKey( InFontInfo, FontScale ), Characters ) );
+	}
+}
+
+void FSlateFontCache::ProcessPrewarmRequests()
+{
+	const double EndTime = FPlatformTime::Seconds() + CVarFontPrewarmBudgetMs.GetValueOnAnyThread() / 1000.0;
+	const float MaxAtlasFill = CVarFontPrewarmMaxAtlasFill.GetValueOnAnyThread();
+	int32 NumCharacters = 0;
+
+	while( PrewarmRequests.Num() > 0 && FPlatformTime::Seconds() < EndTime )
+	{
+		// Another page would request a flush, throwing out everything that was prewarmed
+		if( FontAtlases.Num() > 1 || ( FontAtlases.Num() == 1 && FontAtlases[0]->GetFillRatio() >= MaxAtlasFill ) )
+		{
+			UE_LOG( LogSlate, Verbose, TEXT("Font atlas is full, dropping %d font prewarm requests"), PrewarmRequests.Num() );
+			PrewarmRequests.Empty();
+			break;
+		}
+
+		FPrewarmRequest& Request = PrewarmRequests[0];
+		if( Request.NextCharIndex < Request.Characters.Len() )
+		{
+			FCharacterList& CharacterList = GetCharacterList( Request.FontKey.GetFontInfo(), Request.FontKey.GetScale() );
+			CharacterList[ Request.Characters[ Request.NextCharIndex++ ] ];
+			++NumCharacters;
+		}
+		else
+		{
+			PrewarmRequests.RemoveAt( 0 );
+		}
+	}
+
+	INC_DWORD_STAT_BY( STAT_SlateFontPrewarmCharacters, NumCharacters );
+}
+
 const FFontData& FSlateFontCache::GetDefaultFontData( const FSlateFontInfo& InFontInfo ) const
 {
 	return FTInterface->GetDefaultFontData(InFontInfo);
@@ -1237,6 +1407,22 @@ void FSlateFontCache::FlushObject( const UObject* const InObject )
 		}
 	}
 
+	for( auto It = ShapedGlyphRuns.CreateIterator(); It; ++It )
+	{
+		if( It.Value()->FontInfo.FontObject == InObject )
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for( int32 RequestIndex = PrewarmRequests.Num() - 1; RequestIndex >= 0; --RequestIndex )
+	{
+		if( PrewarmRequests[RequestIndex].FontKey.GetFontInfo().FontObject == InObject )
+		{
+			PrewarmRequests.RemoveAt( RequestIndex );
+		}
+	}
+
 	if( bHasRemovedEntries )
 	{
 		FTInterface->Flush();
@@ -1254,10 +1440,32 @@ void FSlateFontCache::ConditionalFlushCache()
 
 void FSlateFontCache::UpdateCache()
 {
+	++CacheFrame;
+
+	if( ShapedGlyphRuns.Num() > CVarShapedTextCacheSize.GetValueOnAnyThread() )
+	{
+		// Text that changes all the time (timers, scrolling lists...) would otherwise pile up
+		for( auto It = ShapedGlyphRuns.CreateIterator(); It; ++It )
+		{
+			if( It.Value()->Run->LastUsedFrame + 1 < CacheFrame )
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	if( PrewarmRequests.Num() > 0 )
+	{
+		ProcessPrewarmRequests();
+	}
+
+	STAT( float AtlasFill = 0.0f );
 	for( int32 AtlasIndex = 0; AtlasIndex < FontAtlases.Num(); ++AtlasIndex ) 
 	{
+		STAT( AtlasFill += FontAtlases[AtlasIndex]->GetFillRatio() );
 		FontAtlases[AtlasIndex]->ConditionalUpdateTexture();
 	}
+	SET_FLOAT_STAT( STAT_SlateFontAtlasFill, AtlasFill * 100.0f );
 }
 
 void FSlateFontCache::ReleaseResources()
@@ -1271,6 +1479,7 @@ void FSlateFontCache::ReleaseResources()
 void FSlateFontCache::FlushCache() const
 {
 	FontToCharacterListCache.Empty();
+	ShapedGlyphRuns.Empty();
 	FTInterface->Flush();
 
 	for( int32 AtlasIndex = 0; AtlasIndex < FontAtlases.Num(); ++AtlasIndex ) 
@@ -6,6 +6,9 @@
 #define USE_MEASURE_CACHING 1
 
 SLATE_DECLARE_CYCLE_COUNTER(GSlateMeasureStringTime, "Measure String");
+DECLARE_DWORD_COUNTER_STAT(TEXT("Measure Cache Hits"), STAT_SlateMeasureCacheHits, STATGROUP_Slate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Measure Cache Misses"), STAT_SlateMeasureCacheMisses, STATGROUP_Slate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Measure Shaped Text Hits"), STAT_SlateMeasureShapedTextHits, STATGROUP_Slate);
 
 namespace FontMeasureConstants
 {
@@ -144,6 +147,17 @@ FVector2D FSlateFontMeasure::MeasureStringInternal( const FString& Text, int32 S
 		return FVector2D( 0, MaxHeight );
 	}
 
+	// Text that has been drawn already was measured when it was shaped
+	if( DoesStartAtBeginning && DoesFinishAtEnd && !IncludeKerningWithPrecedingChar && StopAfterHorizontalOffset == INDEX_NONE )
+	{
+		const FShapedGlyphRun* ShapedRun = FontCache->FindShapedGlyphRun( Text, InFontInfo, FontScale );
+		if( ShapedRun )
+		{
+			INC_DWORD_STAT( STAT_SlateMeasureShapedTextHits );
+			return ShapedRun->Size;
+		}
+	}
+
 #if USE_MEASURE_CACHING
 	FMeasureCache* CurrentMeasureCache = nullptr;
 	// Do not cache strings which have small sizes or which have complicated measure requirements
@@ -156,8 +170,10 @@ FVector2D FSlateFontMeasure::MeasureStringInternal( const FString& Text, int32 S
 			const FVector2D* CachedMeasurement = CurrentMeasureCache->AccessItem( Text );
 			if( CachedMeasurement )
 			{
+				INC_DWORD_STAT( STAT_SlateMeasureCacheHits );
 				return *CachedMeasurement;
 			}
+			INC_DWORD_STAT( STAT_SlateMeasureCacheMisses );
 		}
 	}
 #endif
@@ -8,6 +8,7 @@
 
 DECLARE_DWORD_COUNTER_STAT(TEXT("Num Layers"), STAT_SlateNumLayers, STATGROUP_Slate);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Num Batches"), STAT_SlateNumBatches, STATGROUP_Slate);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Num Batches Merged Across Layers"), STAT_SlateNumMergedBatches, STATGROUP_Slate);
 DECLARE_DWORD_COUNTER_STAT(TEXT("Num Vertices"), STAT_SlateVertexCount, STATGROUP_Slate);
 DECLARE_MEMORY_STAT(TEXT("Batch Vertex Memory"), STAT_SlateVertexBatchMemory, STATGROUP_SlateMemory);
 DECLARE_MEMORY_STAT(TEXT("Batch Index Memory"), STAT_SlateIndexBatchMemory, STATGROUP_SlateMemory);
@@ -16,6 +17,16 @@ SLATE_DECLARE_CYCLE_COUNTER(GSlateAddElements, "Add Elements");
 SLATE_DECLARE_CYCLE_COUNTER(GSlateFindBatchTime, "FindElementForBatch");
 SLATE_DECLARE_CYCLE_COUNTER(GSlateFillBatchBuffers, "FillBatchBuffers");
 
+static TAutoConsoleVariable<int32> CVarSlateMergeBatchesAcrossLayers(
+	TEXT("Slate.MergeBatchesAcrossLayers"),
+	1,
+	TEXT("If set, a batch is drawn with a compatible batch of a lower layer when it doesn't overlap anything drawn in between."));
+
+static TAutoConsoleVariable<int32> CVarSlateMergeBatchesSearchDistance(
+	TEXT("Slate.MergeBatchesSearchDistance"),
+	32,
+	TEXT("How many render batches back to look for a batch to merge with."));
+
 // Super-hacky way of storing the scissor rect so we don't have to change all the FSlateDrawElement APIs for this hacky support.
 SLATECORE_API TOptional<FShortRect> GSlateScissorRect;
 
@@ -534,9 +545,10 @@ void FSlateElementBatcher::AddTextElement(const FSlateDrawElement& DrawElement)
 	}
 
 
-	FCharacterList& CharacterList = FontCache.GetCharacterList( InPayload.FontInfo, FontScale );
+	// Text drawn again and again (the common case) is only shaped once
+	const TSharedRef<const FShapedGlyphRun> GlyphRun = FontCache.GetShapedGlyphRun( Text, InPayload.FontInfo, FontScale );
 
-	float MaxHeight = CharacterList.GetMaxHeight();
+	float MaxHeight = GlyphRun->MaxHeight;
 
 	uint32 FontTextureIndex = 0;
 	FSlateShaderResource* FontTexture = nullptr;
@@ -551,119 +563,73 @@ void FSlateElementBatcher::AddTextElement(const FSlateDrawElement& DrawElement)
 	float InvTextureSizeX = 0;
 	float InvTextureSizeY = 0;
 
-	float LineX = 0;
-
-	FCharacterEntry PreviousCharEntry;
-
-	int32 Kerning = 0;
-
-	FVector2D TopLeft(0,0);
-
-	const float PosX = TopLeft.X;
-	float PosY = TopLeft.Y;
-
-	LineX = PosX;
-	
 	FColor FinalColor = GetElementColor( InPayload.Tint, nullptr );
 
-	for( int32 CharIndex = 0; CharIndex < Text.Len(); ++CharIndex )
+	for( const FShapedGlyph& Glyph : GlyphRun->Glyphs )
 	{
-		const TCHAR CurrentChar = Text[ CharIndex ];
+		const FCharacterEntry& Entry = Glyph.Entry;
 
-		const bool IsNewline = (CurrentChar == '\n');
-
-		if (IsNewline)
-		{
-			// Move down: we are drawing the next line.
-			PosY += MaxHeight;
-			// Carriage return 
-			LineX = PosX;
-		}
-		else
+		if( FontTexture == nullptr || Entry.TextureIndex != FontTextureIndex )
 		{
-			const FCharacterEntry& Entry = CharacterList[ CurrentChar ];
+			// Font has a new texture for this glyph. Refresh the batch we use and the index we are currently using
+			FontTextureIndex = Entry.TextureIndex;
 
-			if( FontTexture == nullptr || Entry.TextureIndex != FontTextureIndex )
-			{
-				// Font has a new texture for this glyph. Refresh the batch we use and the index we are currently using
-				FontTextureIndex = Entry.TextureIndex;
+			FontTexture = FontCache.GetSlateTextureResource( FontTextureIndex );
+			ElementBatch = &FindBatchForElement( Layer, FShaderParams(), FontTexture, ESlateDrawPrimitive::TriangleList, ESlateShader::Font, InDrawEffects, ESlateBatchDrawFlag::None, DrawElement.GetScissorRect() );
 
-				FontTexture = FontCache.GetSlateTextureResource( FontTextureIndex );
-				ElementBatch = &FindBatchForElement( Layer, FShaderParams(), FontTexture, ESlateDrawPrimitive::TriangleList, ESlateShader::Font, InDrawEffects, ESlateBatchDrawFlag::None, DrawElement.GetScissorRect() );
+			BatchVertices = &BatchVertexArrays[ElementBatch->VertexArrayIndex];
+			BatchIndices = &BatchIndexArrays[ElementBatch->IndexArrayIndex];
 
-				BatchVertices = &BatchVertexArrays[ElementBatch->VertexArrayIndex];
-				BatchIndices = &BatchIndexArrays[ElementBatch->IndexArrayIndex];
+			VertexOffset = BatchVertices->Num();
+			IndexOffset = BatchIndices->Num();
+			
+			InvTextureSizeX = 1.0f/FontTexture->GetWidth();
+			InvTextureSizeY = 1.0f/FontTexture->GetHeight();
+		}
 
-				VertexOffset = BatchVertices->Num();
-				IndexOffset = BatchIndices->Num();
-				
-				InvTextureSizeX = 1.0f/FontTexture->GetWidth();
-				InvTextureSizeY = 1.0f/FontTexture->GetHeight();
-			}
+		const float X = Glyph.PenX + Entry.HorizontalOffset;
+		// Note LineY is the top of the line the glyph is on.  This computes the Y position of the baseline where text will sit
 
-			const bool bIsWhitespace = FText::IsWhitespace(CurrentChar);
+		const float Y = Glyph.LineY - Entry.VerticalOffset+MaxHeight+Entry.GlobalDescender;
+		const float U = Entry.StartU * InvTextureSizeX;
+		const float V = Entry.StartV * InvTextureSizeY;
+		const float SizeX = Entry.USize;
+		const float SizeY = Entry.VSize;
+		const float SizeU = Entry.USize * InvTextureSizeX;
+		const float SizeV = Entry.VSize * InvTextureSizeY;
 
-			if( !bIsWhitespace && PreviousCharEntry.IsValidEntry() )
-			{
-				Kerning = CharacterList.GetKerning( PreviousCharEntry, Entry );
-			}
-			else
-			{
-				Kerning = 0;
-			}
+		FSlateRect CharRect( X, Y, X+SizeX, Y+SizeY );
 
-			LineX += Kerning;
-			PreviousCharEntry = Entry;
-
-			if( !bIsWhitespace )
-			{
-				const float X = LineX + Entry.HorizontalOffset;
-				// Note PosX,PosY is the upper left corner of the bounding box representing the string.  This computes the Y position of the baseline where text will sit
+		if( FSlateRect::DoRectanglesIntersect( LocalClipRect, CharRect ) )
+		{
+			TArray<FSlateVertex>& BatchVerticesRef = *BatchVertices;
+			TArray<SlateIndex>& BatchIndicesRef = *BatchIndices;
 
-				const float Y = PosY - Entry.VerticalOffset+MaxHeight+Entry.GlobalDescender;
-				const float U = Entry.StartU * InvTextureSizeX;
-				const float V = Entry.StartV * InvTextureSizeY;
-				const float SizeX = Entry.USize;
-				const float SizeY = Entry.VSize;
-				const float SizeU = Entry.USize * InvTextureSizeX;
-				const float SizeV = Entry.VSize * InvTextureSizeY;
+			FVector2D UpperLeft( X, Y );
+			FVector2D UpperRight( X+SizeX, Y );
+			FVector2D LowerLeft( X, Y+SizeY );
+			FVector2D LowerRight( X+SizeX, Y+SizeY );
 
-				FSlateRect CharRect( X, Y, X+SizeX, Y+SizeY );
+			// Add four vertices for this quad
+			BatchVerticesRef.AddUninitialized( 4 );
+			// Add six indices for this quad
+			BatchIndicesRef.AddUninitialized( 6 );
 
-				if( FSlateRect::DoRectanglesIntersect( LocalClipRect, CharRect ) )
-				{
-					TArray<FSlateVertex>& BatchVerticesRef = *BatchVertices;
-					TArray<SlateIndex>& BatchIndicesRef = *BatchIndices;
-
-					FVector2D UpperLeft( X, Y );
-					FVector2D UpperRight( X+SizeX, Y );
-					FVector2D LowerLeft( X, Y+SizeY );
-					FVector2D LowerRight( X+SizeX, Y+SizeY );
-
-					// Add four vertices for this quad
-					BatchVerticesRef.AddUninitialized( 4 );
-					// Add six indices for this quad
-					BatchIndicesRef.AddUninitialized( 6 );
-
-					// The start index of these vertices in the index buffer
-					uint32 IndexStart = VertexOffset;
-
-					// Add four vertices to the list of verts to be added to the vertex buffer
-					BatchVerticesRef[ VertexOffset++ ] = FSlateVertex( RenderTransform, UpperLeft,								FVector2D(U,V),				FinalColor, RenderClipRect );
-					BatchVerticesRef[ VertexOffset++ ] = FSlateVertex( RenderTransform, FVector2D(LowerRight.X,UpperLeft.Y),	FVector2D(U+SizeU, V),		FinalColor, RenderClipRect );
-					BatchVerticesRef[ VertexOffset++ ] = FSlateVertex( RenderTransform, FVector2D(UpperLeft.X,LowerRight.Y),	FVector2D(U, V+SizeV),		FinalColor, RenderClipRect );
-					BatchVerticesRef[ VertexOffset++ ] = FSlateVertex( RenderTransform, LowerRight,								FVector2D(U+SizeU, V+SizeV),FinalColor, RenderClipRect );
-
-					BatchIndicesRef[IndexOffset++] = IndexStart + 0;
-					BatchIndicesRef[IndexOffset++] = IndexStart + 1;
-					BatchIndicesRef[IndexOffset++] = IndexStart + 2;
-					BatchIndicesRef[IndexOffset++] = IndexStart + 1;
-					BatchIndicesRef[IndexOffset++] = IndexStart + 3;
-					BatchIndicesRef[IndexOffset++] = IndexStart + 2;
-				}
-			}
+			// The start index of these vertices in the index buffer
+			uint32 IndexStart = VertexOffset;
 
-			LineX += Entry.XAdvance;
+			// Add four vertices to the list of verts to be added to the vertex buffer
+			BatchVerticesRef[ VertexOffset++ ] = FSlateVertex( RenderTransform, UpperLeft,								FVector2D(U,V),				FinalColor, RenderClipRect );
+			BatchVerticesRef[ VertexOffset++ ] = FSlateVertex( RenderTransform, FVector2D(LowerRight.X,UpperLeft.Y),	FVector2D(U+SizeU, V),		FinalColor, RenderClipRect );
+			BatchVerticesRef[ VertexOffset++ ] = FSlateVertex( RenderTransform, FVector2D(UpperLeft.X,LowerRight.Y),	FVector2D(U, V+SizeV),		FinalColor, RenderClipRect );
+			BatchVerticesRef[ VertexOffset++ ] = FSlateVertex( RenderTransform, LowerRight,								FVector2D(U+SizeU, V+SizeV),FinalColor, RenderClipRect );
+
+			BatchIndicesRef[IndexOffset++] = IndexStart + 0;
+			BatchIndicesRef[IndexOffset++] = IndexStart + 1;
+			BatchIndicesRef[IndexOffset++] = IndexStart + 2;
+			BatchIndicesRef[IndexOffset++] = IndexStart + 1;
+			BatchIndicesRef[IndexOffset++] = IndexStart + 3;
+			BatchIndicesRef[IndexOffset++] = IndexStart + 2;
 		}
 	}
 }
@@ -1501,7 +1467,7 @@ FSlateElementBatch& FSlateElementBatcher::FindBatchForElement(
 }
 
 
-void FSlateElementBatcher::AddVertices( TArray<FSlateVertex>& OutVertices, FSlateElementBatch& ElementBatch, const TArray<FSlateVertex>& VertexBatch )
+void FSlateElementBatcher::AddVertices( TArray<FSlateVertex>& OutVertices, const TArray<FSlateVertex>& VertexBatch )
 {
 	uint32 FirstIndex = OutVertices.Num();
 	OutVertices.AddUninitialized( VertexBatch.Num() );
@@ -1513,26 +1479,54 @@ void FSlateElementBatcher::AddVertices( TArray<FSlateVertex>& OutVertices, FSlat
 	RequiredVertexMemory += RequiredSize;
 	TotalVertexMemory += VertexBatch.GetAllocatedSize();
 	NumVertices += VertexBatch.Num();
-
-	ElementBatch.VertexOffset = FirstIndex;
-	ElementBatch.NumVertices = VertexBatch.Num();
 }
 
 
-void FSlateElementBatcher::AddIndices( TArray<SlateIndex>& OutIndices, FSlateElementBatch& ElementBatch, const TArray<SlateIndex>& IndexBatch )
+void FSlateElementBatcher::AddIndices( TArray<SlateIndex>& OutIndices, const TArray<SlateIndex>& IndexBatch, uint32 BaseVertex )
 {
 	uint32 FirstIndex = OutIndices.Num();
 	OutIndices.AddUninitialized( IndexBatch.Num() );
 
 	uint32 RequiredSize =  IndexBatch.Num() * IndexBatch.GetTypeSize();
 
-	FMemory::Memcpy( &OutIndices[FirstIndex], IndexBatch.GetData(), RequiredSize );
+	if( BaseVertex == 0 )
+	{
+		FMemory::Memcpy( &OutIndices[FirstIndex], IndexBatch.GetData(), RequiredSize );
+	}
+	else
+	{
+		for( int32 Index = 0; Index < IndexBatch.Num(); ++Index )
+		{
+			OutIndices[FirstIndex + Index] = (SlateIndex)( IndexBatch[Index] + BaseVertex );
+		}
+	}
 
 	RequiredIndexMemory += RequiredSize;
 	TotalIndexMemory += IndexBatch.GetAllocatedSize();
+}
+
+
+int32 FSlateElementBatcher::FindBatchToMergeWith( const FBatchToFill& BatchToFill ) const
+{
+	const uint32 MaxVertices = TNumericLimits<SlateIndex>::Max();
+	const int32 MaxSearch = CVarSlateMergeBatchesSearchDistance.GetValueOnAnyThread();
 
-	ElementBatch.IndexOffset = FirstIndex;
-	ElementBatch.NumIndices = IndexBatch.Num();
+	// Moving the batch back in the draw order only changes what is drawn if it overlaps something it moves behind
+	for( int32 Index = RenderBatchesToFill.Num() - 1; Index >= FMath::Max( 0, RenderBatchesToFill.Num() - MaxSearch ); --Index )
+	{
+		const FBatchToFill& OtherBatch = BatchesToFill[ RenderBatchesToFill[Index] ];
+		if( *OtherBatch.ElementBatch == *BatchToFill.ElementBatch && OtherBatch.NumVertices + BatchToFill.NumVertices <= MaxVertices )
+		{
+			return RenderBatchesToFill[Index];
+		}
+
+		if( OtherBatch.ElementBatch->GetCustomDrawer().IsValid() || FSlateRect::DoRectanglesIntersect( OtherBatch.Bounds, BatchToFill.Bounds ) )
+		{
+			break;
+		}
+	}
+
+	return INDEX_NONE;
 }
 
 
@@ -1549,21 +1543,30 @@ void FSlateElementBatcher::FillBatchBuffers( FSlateWindowElementList& WindowElem
 	// Sort by layer
 	LayerToElementBatches.KeySort( TLess<uint32>() );
 
+	const bool bMergeAcrossLayers = CVarSlateMergeBatchesAcrossLayers.GetValueOnAnyThread() != 0;
 
-	STAT(NumLayers = FMath::Max<uint32>(NumLayers, LayerToElementBatches.Num() ));
+	BatchesToFill.Reset();
+	RenderBatchesToFill.Reset();
 
+	uint32 NumUsedLayers = 0;
 	bRequiresStencilTest = false;
-	// For each element batch add its vertices and indices to the bulk lists.
+	// Decide which render batch each element batch is drawn in, in layer order.
 	for( TMap< uint32, TSet<FSlateElementBatch> >::TIterator It( LayerToElementBatches ); It; ++It )
 	{
 		TSet<FSlateElementBatch>& ElementBatches = It.Value();
 
+		NumUsedLayers += ElementBatches.Num() > 0 ? 1 : 0;
 		STAT(NumBatches += ElementBatches.Num());
 		for( TSet<FSlateElementBatch>::TIterator BatchIt(ElementBatches); BatchIt; ++BatchIt )
 		{
 			FSlateElementBatch& ElementBatch = *BatchIt;
 
-			bool bIsMaterial = ElementBatch.GetShaderResource() && ElementBatch.GetShaderResource()->GetType() == ESlateShaderResource::Material;
+			FBatchToFill BatchToFill;
+			BatchToFill.ElementBatch = &ElementBatch;
+			BatchToFill.Bounds = FSlateRect( 0, 0, 0, 0 );
+			BatchToFill.NumVertices = 0;
+			BatchToFill.NextMergedBatch = INDEX_NONE;
+			BatchToFill.LastMergedBatch = BatchesToFill.Num();
 
 			if( !ElementBatch.GetCustomDrawer().IsValid() )
 			{
@@ -1572,43 +1575,104 @@ void FSlateElementBatcher::FillBatchBuffers( FSlateWindowElementList& WindowElem
 					bRequiresStencilTest = true;
 				}
 
-				TArray<FSlateVertex>& BatchVertices = BatchVertexArrays[ ElementBatch.VertexArrayIndex ];
-				// after this loop, we'll be done with the array, so put it back on the free list.
-				VertexArrayFreeList.Add( ElementBatch.VertexArrayIndex );
-
-				TArray<SlateIndex>& BatchIndices = BatchIndexArrays[ ElementBatch.IndexArrayIndex ];
-				// after this loop, we'll be done with the array, so put it back on the free list.
-				IndexArrayFreeList.Add( ElementBatch.IndexArrayIndex );
+				const TArray<FSlateVertex>& BatchVertices = BatchVertexArrays[ ElementBatch.VertexArrayIndex ];
+				const TArray<SlateIndex>& BatchIndices = BatchIndexArrays[ ElementBatch.IndexArrayIndex ];
 
 				// We should have at least some vertices and indices in the batch or none at all
 				check( BatchVertices.Num() > 0 && BatchIndices.Num() > 0  || BatchVertices.Num() == 0 && BatchIndices.Num() == 0 );
 
-				if( BatchVertices.Num() > 0 && BatchIndices.Num() > 0  )
+				if( BatchVertices.Num() == 0 )
 				{
-					AddVertices( OutBatchedVertices, ElementBatch, BatchVertices );
-					AddIndices( OutBatchedIndices, ElementBatch, BatchIndices );
-
-					OutRenderBatches.Add( FSlateRenderBatch( ElementBatch ) );
+					// Nothing to draw, the arrays are free again
+					VertexArrayFreeList.Add( ElementBatch.VertexArrayIndex );
+					IndexArrayFreeList.Add( ElementBatch.IndexArrayIndex );
+					continue;
+				}
 
-					// Done with the batch
-					BatchVertices.Empty(BatchVertices.Num());
-					BatchIndices.Empty(BatchIndices.Num());
+				BatchToFill.NumVertices = BatchVertices.Num();
+				BatchToFill.Bounds = FSlateRect( BatchVertices[0].Position[0], BatchVertices[0].Position[1], BatchVertices[0].Position[0], BatchVertices[0].Position[1] );
+				for( const FSlateVertex& Vertex : BatchVertices )
+				{
+					BatchToFill.Bounds.Left = FMath::Min<float>( BatchToFill.Bounds.Left, Vertex.Position[0] );
+					BatchToFill.Bounds.Top = FMath::Min<float>( BatchToFill.Bounds.Top, Vertex.Position[1] );
+					BatchToFill.Bounds.Right = FMath::Max<float>( BatchToFill.Bounds.Right, Vertex.Position[0] );
+					BatchToFill.Bounds.Bottom = FMath::Max<float>( BatchToFill.Bounds.Bottom, Vertex.Position[1] );
 				}
 
+				const int32 MergeWith = bMergeAcrossLayers ? FindBatchToMergeWith( BatchToFill ) : INDEX_NONE;
+				if( MergeWith != INDEX_NONE )
+				{
+					STAT(++NumMergedBatches);
+					const int32 NewIndex = BatchesToFill.Add( BatchToFill );
+					FBatchToFill& RenderBatch = BatchesToFill[MergeWith];
+					BatchesToFill[RenderBatch.LastMergedBatch].NextMergedBatch = NewIndex;
+					RenderBatch.LastMergedBatch = NewIndex;
+					RenderBatch.NumVertices += BatchToFill.NumVertices;
+					RenderBatch.Bounds = FSlateRect( FMath::Min( RenderBatch.Bounds.Left, BatchToFill.Bounds.Left ), FMath::Min( RenderBatch.Bounds.Top, BatchToFill.Bounds.Top ),
+						FMath::Max( RenderBatch.Bounds.Right, BatchToFill.Bounds.Right ), FMath::Max( RenderBatch.Bounds.Bottom, BatchToFill.Bounds.Bottom ) );
+					continue;
+				}
 			}
-			else
+
+			RenderBatchesToFill.Add( BatchesToFill.Add( BatchToFill ) );
+		}
+	}
+
+	STAT(NumLayers = FMath::Max<uint32>(NumLayers, NumUsedLayers));
+
+	// For each render batch add the vertices and indices of its element batches to the bulk lists.
+	for( int32 RenderBatchIndex : RenderBatchesToFill )
+	{
+		FSlateElementBatch& RenderBatch = *BatchesToFill[RenderBatchIndex].ElementBatch;
+		if( !RenderBatch.GetCustomDrawer().IsValid() )
+		{
+			const uint32 FirstVertex = OutBatchedVertices.Num();
+			const uint32 FirstIndex = OutBatchedIndices.Num();
+			for( int32 Index = RenderBatchIndex; Index != INDEX_NONE; Index = BatchesToFill[Index].NextMergedBatch )
 			{
-				OutRenderBatches.Add( FSlateRenderBatch( ElementBatch ) );
+				FSlateElementBatch& ElementBatch = *BatchesToFill[Index].ElementBatch;
+
+				TArray<FSlateVertex>& BatchVertices = BatchVertexArrays[ ElementBatch.VertexArrayIndex ];
+				// after this loop, we'll be done with the array, so put it back on the free list.
+				VertexArrayFreeList.Add( ElementBatch.VertexArrayIndex );
+
+				TArray<SlateIndex>& BatchIndices = BatchIndexArrays[ ElementBatch.IndexArrayIndex ];
+				// after this loop, we'll be done with the array, so put it back on the free list.
+				IndexArrayFreeList.Add( ElementBatch.IndexArrayIndex );
+
+				AddIndices( OutBatchedIndices, BatchIndices, OutBatchedVertices.Num() - FirstVertex );
+				AddVertices( OutBatchedVertices, BatchVertices );
+
+				// Done with the batch
+				BatchVertices.Empty(BatchVertices.Num());
+				BatchIndices.Empty(BatchIndices.Num());
 			}
+
+			RenderBatch.VertexOffset = FirstVertex;
+			RenderBatch.NumVertices = OutBatchedVertices.Num() - FirstVertex;
+			RenderBatch.IndexOffset = FirstIndex;
+			RenderBatch.NumIndices = OutBatchedIndices.Num() - FirstIndex;
 		}
-	}
 
+		OutRenderBatches.Add( FSlateRenderBatch( RenderBatch ) );
+	}
 }
 
 
 void FSlateElementBatcher::ResetBatches()
 {
-	LayerToElementBatches.Reset();
+	// Keep the batch sets of the layers that were used so they don't have to be allocated again next time
+	for( TMap< uint32, TSet<FSlateElementBatch> >::TIterator It( LayerToElementBatches ); It; ++It )
+	{
+		if( It.Value().Num() > 0 )
+		{
+			It.Value().Reset();
+		}
+		else
+		{
+			It.RemoveCurrent();
+		}
+	}
 	bRequiresVsync = false;
 }
 
@@ -1617,12 +1681,14 @@ void FSlateElementBatcher::ResetStats()
 {
 	SET_DWORD_STAT( STAT_SlateNumLayers, NumLayers );
 	SET_DWORD_STAT( STAT_SlateNumBatches, NumBatches );
+	SET_DWORD_STAT( STAT_SlateNumMergedBatches, NumMergedBatches );
 	SET_DWORD_STAT( STAT_SlateVertexCount, NumVertices );
 	SET_MEMORY_STAT( STAT_SlateVertexBatchMemory, TotalVertexMemory );
 	SET_MEMORY_STAT( STAT_SlateIndexBatchMemory, TotalIndexMemory );
 
 	NumLayers = 0;
 	NumBatches = 0;
+	NumMergedBatches = 0;
 	NumVertices = 0;
 	RequiredIndexMemory = 0;
 	RequiredVertexMemory = 0;
@@ -2,15 +2,45 @@
 
 #include "SlateCorePrivatePCH.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Reused Element List Memory"), STAT_SlateReusedElementListMemory, STATGROUP_Slate);
+
 
 /* FSlateDrawBuffer interface
  *****************************************************************************/
 
+void FSlateDrawBuffer::ClearBuffer( )
+{
+	// Lists not taken over since the last time belonged to windows that are gone
+	Exchange( WindowElementLists, UnusedWindowElementLists );
+	WindowElementLists.Reset();
+
+	for( FSlateWindowElementList& ElementList : UnusedWindowElementLists )
+	{
+		ElementList.ResetBuffers();
+	}
+}
+
+
 FSlateWindowElementList& FSlateDrawBuffer::AddWindowElementList( TSharedRef<SWindow> ForWindow )
 {
 	int32 Index = WindowElementLists.Add(FSlateWindowElementList(ForWindow));
-
-	return WindowElementLists[Index];
+	FSlateWindowElementList& ElementList = WindowElementLists[Index];
+
+	if( UnusedWindowElementLists.Num() > 0 )
+	{
+		// The arrays the same window used last time are about the right size already
+		int32 UnusedIndex = UnusedWindowElementLists.IndexOfByPredicate( [&]( const FSlateWindowElementList& UnusedList ) { return UnusedList.GetWindow().Get() == &ForWindow.Get(); } );
+		if( UnusedIndex == INDEX_NONE )
+		{
+			UnusedIndex = UnusedWindowElementLists.Num() - 1;
+		}
+
+		INC_DWORD_STAT_BY( STAT_SlateReusedElementListMemory, UnusedWindowElementLists[UnusedIndex].GetAllocatedSize() );
+		ElementList.TakeBuffers( UnusedWindowElementLists[UnusedIndex] );
+		UnusedWindowElementLists.RemoveAtSwap( UnusedIndex, 1, false );
+	}
+
+	return ElementList;
 }
 
 
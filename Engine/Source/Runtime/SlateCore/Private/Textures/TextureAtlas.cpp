@@ -24,6 +24,7 @@ void FSlateTextureAtlas::Empty()
 	// Remove all nodes
 	DestroyNodes( RootNode );
 	RootNode = nullptr;
+	UsedArea = 0;
 
 	STAT(uint32 MemoryBefore = AtlasData.GetAllocatedSize());
 
@@ -40,6 +41,11 @@ const FAtlasedTextureSlot* FSlateTextureAtlas::AddTexture( uint32 TextureWidth,
 	// Find a spot for the character in the texture
 	const FAtlasedTextureSlot* NewSlot = FindSlotForTexture(TextureWidth, TextureHeight);
 
+	if (NewSlot)
+	{
+		UsedArea += NewSlot->Width * NewSlot->Height;
+	}
+
 	// handle cases like space, where the size of the glyph is zero. The copy data code doesn't handle zero sized source data with a padding
 	// so make sure to skip this call.
 	if (NewSlot && TextureWidth > 0 && TextureHeight > 0)
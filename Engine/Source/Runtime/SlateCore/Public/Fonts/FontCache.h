@@ -215,6 +215,35 @@ private:
 	mutable int16 Baseline;
 };
 
+/** A glyph of a shaped run, placed relative to the top left of the run */
+struct FShapedGlyph
+{
+	/** Where the pen was when the glyph was placed, kerning included */
+	float PenX;
+	/** Top of the line the glyph is on */
+	float LineY;
+	/** The character, as it was cached when the run was shaped */
+	FCharacterEntry Entry;
+};
+
+/** 
+ * A string shaped in one font at one scale: its measured size and the glyphs to draw for it
+ * Runs reference atlas slots, so they only live as long as the font cache isn't flushed
+ */
+struct FShapedGlyphRun
+{
+	/** Size of the run, which FSlateFontMeasure::Measure() gives back for the whole string once it has been shaped */
+	FVector2D Size;
+	/** Max height of the font the run was shaped with */
+	uint16 MaxHeight;
+	/** The glyphs to draw, whitespace and newlines left out */
+	TArray<FShapedGlyph> Glyphs;
+	/** The history revision of the composite font the run was shaped with */
+	int32 CompositeFontHistoryRevision;
+	/** The font cache frame the run was last used in */
+	uint32 LastUsedFrame;
+};
+
 /**
  * Font caching implementation
  * Caches characters into textures as needed
@@ -257,6 +286,39 @@ public:
 	 */
 	bool AddNewEntry( TCHAR Character, const FSlateFontKey& InKey, FCharacterEntry& OutCharacterEntry ) const;
 
+	/** 
+	 * Gets the size of a whole string and the glyphs to draw for it, shaping it the first time it's seen in this font
+	 *
+	 * @param Text			The string to shape
+	 * @param InFontInfo	Information about the font that the string is drawn with
+	 * @param FontScale		The scale to apply to the font
+	 * @return The shaped run, valid until the cache is flushed
+	 */
+	TSharedRef<const FShapedGlyphRun> GetShapedGlyphRun( const FString& Text, const FSlateFontInfo& InFontInfo, float FontScale ) const;
+
+	/** 
+	 * Finds a string that was already shaped in this font, without shaping it if it wasn't
+	 *
+	 * @param Text			The string to look for
+	 * @param InFontInfo	Information about the font that the string is drawn with
+	 * @param FontScale		The scale to apply to the font
+	 * @return The shaped run, valid until the cache is flushed, or nullptr
+	 */
+	const FShapedGlyphRun* FindShapedGlyphRun( const FString& Text, const FSlateFontInfo& InFontInfo, float FontScale ) const;
+
+	/**
+	 * Queues characters to be cached ahead of being drawn, so opening a menu full of new text doesn't rasterize it all in one frame
+	 * The characters are cached a slice at a time in UpdateCache(), on the thread that owns this cache
+	 *
+	 * @param InFontInfo	Information about the font the characters will be drawn with
+	 * @param FontScale		The scale the characters will be drawn at
+	 * @param Characters	The characters to cache
+	 */
+	void RequestPrewarm( const FSlateFontInfo& InFontInfo, float FontScale, const FString& Characters );
+
+	/** @return true if there are still characters waiting to be prewarmed */
+	bool IsPrewarming() const { return PrewarmRequests.Num() > 0; }
+
 	/**
 	 * Flush the given object out of the cache
 	 */
@@ -268,7 +330,7 @@ public:
 	void ConditionalFlushCache();
 
 	/**
-	 * Updates the texture used for rendering
+	 * Caches a slice of the prewarm requests and updates the texture used for rendering
 	 */
 	void UpdateCache();
 
@@ -360,6 +422,82 @@ private:
 	// Non-copyable
 	FSlateFontCache(const FSlateFontCache&);
 	FSlateFontCache& operator=(const FSlateFontCache&);
+
+	/** Shapes a string the way FSlateFontMeasure measures it and FSlateElementBatcher draws it */
+	TSharedRef<FShapedGlyphRun> ShapeGlyphRun( const FString& Text, const FSlateFontInfo& InFontInfo, float FontScale ) const;
+
+	/** Caches queued prewarm characters until the time budget runs out or the atlas gets too full */
+	void ProcessPrewarmRequests();
+
+	/** 
+	 * Key for a shaped run: the font, the scale and the string, with the hash worked out once
+	 * The key doesn't own the font info or the string. Lookups point at the caller's, keys in the map at the copies their cached run keeps
+	 */
+	struct FShapedGlyphRunKey
+	{
+		FShapedGlyphRunKey( const FSlateFontInfo& InFontInfo, float InFontScale, const FString& InText )
+			: FontInfo( &InFontInfo )
+			, FontScale( InFontScale )
+			, Text( &InText )
+			, KeyHash( HashCombine( HashCombine( GetTypeHash( InFontInfo ), GetTypeHash( InFontScale ) ), FCrc::MemCrc32( *InText, InText.Len() * sizeof(TCHAR) ) ) )
+		{
+		}
+
+		/** @return This key pointing at other copies of the same font info and string, keeping the hash */
+		FShapedGlyphRunKey Rebind( const FSlateFontInfo& InFontInfo, const FString& InText ) const
+		{
+			FShapedGlyphRunKey Key( *this );
+			Key.FontInfo = &InFontInfo;
+			Key.Text = &InText;
+			return Key;
+		}
+
+		bool operator==( const FShapedGlyphRunKey& Other ) const
+		{
+			return KeyHash == Other.KeyHash && FontScale == Other.FontScale && *FontInfo == *Other.FontInfo && Text->Equals( *Other.Text, ESearchCase::CaseSensitive );
+		}
+
+		friend inline uint32 GetTypeHash( const FShapedGlyphRunKey& Key )
+		{
+			return Key.KeyHash;
+		}
+
+		const FSlateFontInfo* FontInfo;
+		float FontScale;
+		const FString* Text;
+		uint32 KeyHash;
+	};
+
+	/** A cached shaped run with the font info and string its key points at */
+	struct FCachedShapedGlyphRun
+	{
+		FCachedShapedGlyphRun( const FSlateFontInfo& InFontInfo, const FString& InText, const TSharedRef<FShapedGlyphRun>& InRun )
+			: FontInfo( InFontInfo )
+			, Text( InText )
+			, Run( InRun )
+		{
+		}
+
+		FSlateFontInfo FontInfo;
+		FString Text;
+		TSharedRef<FShapedGlyphRun> Run;
+	};
+
+	/** Characters waiting to be cached ahead of use */
+	struct FPrewarmRequest
+	{
+		FPrewarmRequest( const FSlateFontKey& InFontKey, const FString& InCharacters )
+			: FontKey( InFontKey )
+			, Characters( InCharacters )
+			, NextCharIndex( 0 )
+		{
+		}
+
+		FSlateFontKey FontKey;
+		FString Characters;
+		int32 NextCharIndex;
+	};
+
 private:
 
 	/** Mapping Font keys to cached data */
@@ -374,6 +512,15 @@ private:
 	/** Factory for creating new font atlases */
 	TSharedRef<ISlateFontAtlasFactory> FontAtlasFactory;
 
+	/** Strings already shaped, thrown out when they haven't been used for a frame and there are too many */
+	mutable TMap<FShapedGlyphRunKey, TSharedRef<FCachedShapedGlyphRun>> ShapedGlyphRuns;
+
+	/** Characters to cache before they are needed, oldest request first */
+	TArray<FPrewarmRequest> PrewarmRequests;
+
+	/** Number of times UpdateCache() has been called, used to age shaped runs */
+	uint32 CacheFrame;
+
 	/** Whether or not we have a pending request to flush the cache when it is safe to do so */
 	mutable bool bFlushRequested;
 };
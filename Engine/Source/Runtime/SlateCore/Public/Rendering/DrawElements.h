@@ -631,6 +631,37 @@ public:
 		BatchedVertices.Empty();
 		BatchedIndices.Empty();
 	}
+
+	/**
+	 * Takes over the arrays of another list, emptied but still allocated, so this list doesn't have to grow its own again.
+	 * The other list gets this list's arrays.
+	 */
+	void TakeBuffers( FSlateWindowElementList& Other )
+	{
+		Exchange( DrawElements, Other.DrawElements );
+		Exchange( RenderBatches, Other.RenderBatches );
+		Exchange( BatchedVertices, Other.BatchedVertices );
+		Exchange( BatchedIndices, Other.BatchedIndices );
+		ResetBuffers();
+	}
+
+	/**
+	 * Remove all the elements from this draw list, keeping the memory for the next ones.
+	 */
+	void ResetBuffers()
+	{
+		DrawElements.Reset();
+		RenderBatches.Reset();
+		BatchedVertices.Reset();
+		BatchedIndices.Reset();
+		DeferredPaintList.Reset();
+	}
+
+	/** @return The memory allocated by the arrays of this list */
+	uint32 GetAllocatedSize() const
+	{
+		return DrawElements.GetAllocatedSize() + RenderBatches.GetAllocatedSize() + BatchedVertices.GetAllocatedSize() + BatchedIndices.GetAllocatedSize();
+	}
 	
 	/**
 	 * Returns a list of element batches for this window
@@ -117,11 +117,45 @@ private:
 											 ESlateBatchDrawFlag::Type DrawFlags,
 											 const TOptional<FShortRect>& ScissorRect);
 
-	void AddVertices( TArray<FSlateVertex>& OutVertices, FSlateElementBatch& ElementBatch, const TArray<FSlateVertex>& VertexBatch );
+	void AddVertices( TArray<FSlateVertex>& OutVertices, const TArray<FSlateVertex>& VertexBatch );
 
-	void AddIndices( TArray<SlateIndex>& OutIndices, FSlateElementBatch& ElementBatch, const TArray<SlateIndex>& IndexBatch );
+	/**
+	 * @param BaseVertex	Added to each index, for batches whose vertices follow another batch's in the same render batch
+	 */
+	void AddIndices( TArray<SlateIndex>& OutIndices, const TArray<SlateIndex>& IndexBatch, uint32 BaseVertex );
 
 private:
+	/** A batch with vertices, in the order they are drawn, before its vertices are copied to the window's buffers */
+	struct FBatchToFill
+	{
+		FSlateElementBatch* ElementBatch;
+
+		/** Window space bounds of the vertices of this batch and the batches merged into it */
+		FSlateRect Bounds;
+
+		/** Number of vertices of this batch and the batches merged into it */
+		uint32 NumVertices;
+
+		/** Index in BatchesToFill of the next batch drawn with this one, or INDEX_NONE */
+		int32 NextMergedBatch;
+
+		/** Index in BatchesToFill of the last batch drawn with this one, or its own index */
+		int32 LastMergedBatch;
+	};
+
+	/**
+	 * Looks for a batch in a lower layer that the batch can be drawn with, stopping at the first batch it overlaps
+	 *
+	 * @return The index in BatchesToFill of the render batch to merge with, or INDEX_NONE
+	 */
+	int32 FindBatchToMergeWith( const FBatchToFill& BatchToFill ) const;
+
+	// Every batch being filled, sorted by layer.
+	TArray<FBatchToFill> BatchesToFill;
+
+	// Indices in BatchesToFill of the batches that become render batches, the others are drawn with one of them.
+	TArray<int32> RenderBatchesToFill;
+
 	// Element batch maps sorted by layer.
 	TMap<uint32, TSet<FSlateElementBatch>> LayerToElementBatches;
 
@@ -151,6 +185,7 @@ private:
 
 	uint32 NumVertices;
 	uint32 NumBatches;
+	uint32 NumMergedBatches;
 	uint32 NumLayers;
 	uint32 TotalVertexMemory;
 	uint32 RequiredVertexMemory;
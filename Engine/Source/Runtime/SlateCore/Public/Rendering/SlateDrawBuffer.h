@@ -18,10 +18,7 @@ public:
 public:
 
 	/** Removes all data from the buffer. */
-	void ClearBuffer( )
-	{
-		WindowElementLists.Empty();
-	}
+	void ClearBuffer( );
 
 	/**
 	 * Creates a new FSlateWindowElementList and returns a reference to it so it can have draw elements added to it
@@ -58,6 +55,9 @@ protected:
 	// List of window element lists.
 	TArray<FSlateWindowElementList> WindowElementLists;
 
+	// The lists of the last time this buffer was used, emptied, whose arrays the new lists take over.
+	TArray<FSlateWindowElementList> UnusedWindowElementLists;
+
 	// 1 if this buffer is locked, 0 otherwise.
 	int32 Locked;
 };
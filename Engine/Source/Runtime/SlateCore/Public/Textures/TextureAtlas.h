@@ -76,6 +76,7 @@ public:
 		, AtlasHeight( InHeight )
 		, BytesPerPixel( InBytesPerPixel )
 		, PaddingStyle( InPaddingStyle )
+		, UsedArea( 0 )
 		, bNeedsUpdate( false )
 		, AtlasOwnerThread( ESlateTextureAtlasOwnerThread::Unknown )
 	{
@@ -102,6 +103,8 @@ public:
 	uint32 GetWidth() const { return AtlasWidth; }
 	/** @return the height of the atlas */
 	uint32 GetHeight() const { return AtlasHeight; }
+	/** @return the fraction of the atlas taken up by slots, padding included */
+	float GetFillRatio() const { return (float)UsedArea / (float)(AtlasWidth * AtlasHeight); }
 
 	/** Marks the texture as dirty and needing its rendering resources updated */
 	void MarkTextureDirty();
@@ -204,6 +207,8 @@ protected:
 	uint32 BytesPerPixel;
 	/** Padding style */
 	ESlateTextureAtlasPaddingStyle PaddingStyle;
+	/** Number of texels taken up by slots */
+	uint32 UsedArea;
 
 	/** True if this texture needs to have its rendering resources updated */
 	bool bNeedsUpdate;
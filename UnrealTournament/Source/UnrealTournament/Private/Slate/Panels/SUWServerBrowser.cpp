@@ -65,6 +65,43 @@ struct FCompareServerByPingDesc
 	}
 };
 
+/** Puts a server into a list that is already sorted with Compare, after the servers that don't sort after it */
+template<typename CompareType>
+static void InsertSortedServer(TArray< TSharedPtr<FServerData> >& Servers, const TSharedPtr<FServerData>& NewServer, const CompareType& Compare)
+{
+	int32 Min = 0;
+	int32 Max = Servers.Num();
+	while (Min < Max)
+	{
+		const int32 Mid = (Min + Max) / 2;
+		if (Compare(NewServer, Servers[Mid]))
+		{
+			Max = Mid;
+		}
+		else
+		{
+			Min = Mid + 1;
+		}
+	}
+	Servers.Insert(NewServer, Min);
+}
+
+template<typename CompareType, typename CompareDescType>
+static void SortOrInsertServer(TArray< TSharedPtr<FServerData> >& Servers, const TSharedPtr<FServerData>& NewServer, bool bDescending)
+{
+	if (NewServer.IsValid())
+	{
+		bDescending ? InsertSortedServer(Servers, NewServer, CompareDescType()) : InsertSortedServer(Servers, NewServer, CompareType());
+	}
+	else
+	{
+		bDescending ? Servers.Sort(CompareDescType()) : Servers.Sort(CompareType());
+	}
+}
+
+/** How often the random HUB's server and player counts are updated while servers are coming in */
+static const double RANDOM_HUB_UPDATE_INTERVAL = 0.5;
+
 
 struct FCompareRulesByRule		{FORCEINLINE bool operator()( const TSharedPtr< FServerRuleData > A, const TSharedPtr< FServerRuleData > B ) const {return ( A->Rule > B->Rule);	}};
 struct FCompareRulesByRuleDesc	{FORCEINLINE bool operator()( const TSharedPtr< FServerRuleData > A, const TSharedPtr< FServerRuleData > B ) const {return ( A->Rule < B->Rule);	}};
@@ -92,6 +129,8 @@ void SUWServerBrowser::ConstructPanel(FVector2D ViewportSize)
 
 	bWantsAFullRefilter = false;
 	bHideUnresponsiveServers = true;	
+	LastRandomHUBUpdateTime = 0.0;
+	RefreshStartTime = 0.0;
 	bShowingHubs = false;
 	bAutoRefresh = false;
 	TSharedRef<SScrollBar> ExternalScrollbar = SNew(SScrollBar);
@@ -100,6 +139,13 @@ void SUWServerBrowser::ConstructPanel(FVector2D ViewportSize)
 	if (OnlineSubsystem) OnlineIdentityInterface = OnlineSubsystem->GetIdentityInterface();
 	if (OnlineSubsystem) OnlineSessionInterface = OnlineSubsystem->GetSessionInterface();
 
+	// the lists are mostly server and player names in these styles, have their characters rasterized a few a frame before the first results come in
+	const float DPIScale = GetDefault<UUserInterfaceSettings>(UUserInterfaceSettings::StaticClass())->GetDPIScaleBasedOnSize(FIntPoint(ViewportSize.X, ViewportSize.Y));
+	const FString PrewarmCharacters = TEXT("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 '\"!#$%&()*+,-./:;<=>?@[]^_{|}~");
+	TSharedRef<FSlateFontCache> FontCache = FSlateApplication::Get().GetRenderer()->GetFontCache();
+	FontCache->RequestPrewarm(SUWindowsStyle::Get().GetWidgetStyle<FTextBlockStyle>("UWindows.Standard.ServerBrowser.NormalText").Font, DPIScale, PrewarmCharacters);
+	FontCache->RequestPrewarm(SUWindowsStyle::Get().GetWidgetStyle<FTextBlockStyle>("UWindows.Standard.ServerBrowser.BoldText").Font, DPIScale, PrewarmCharacters);
+
 	this->ChildSlot
 	[
 		SNew(SOverlay)
@@ -901,25 +947,26 @@ void SUWServerBrowser::OnPlayerSort(EColumnSortPriority::Type Priority, const FN
 
 
 
-void SUWServerBrowser::SortServers(FName ColumnName)
+void SUWServerBrowser::SortServers(FName ColumnName, TSharedPtr<FServerData> NewServer)
 {
-	if (ColumnName == FName(TEXT("ServerName"))) bDescendingSort ? FilteredServersSource.Sort(FCompareServerByNameDesc()) : FilteredServersSource.Sort(FCompareServerByName());
-	else if (ColumnName == FName(TEXT("ServerIP"))) bDescendingSort ? FilteredServersSource.Sort(FCompareServerByIPDesc()) : FilteredServersSource.Sort(FCompareServerByIP());
-	else if (ColumnName == FName(TEXT("ServerGame"))) bDescendingSort ? FilteredServersSource.Sort(FCompareServerByGameModeDesc()) : FilteredServersSource.Sort(FCompareServerByGameMode());
-	else if (ColumnName == FName(TEXT("ServerMap"))) bDescendingSort ? FilteredServersSource.Sort(FCompareServerByMapDesc()) : FilteredServersSource.Sort(FCompareServerByMap());
-	else if (ColumnName == FName(TEXT("ServerVer"))) bDescendingSort ? FilteredServersSource.Sort(FCompareServerByVersionDesc()) : FilteredServersSource.Sort(FCompareServerByVersion());
-	else if (ColumnName == FName(TEXT("ServerNumPlayers"))) bDescendingSort ? FilteredServersSource.Sort(FCompareServerByNumPlayersDesc()) : FilteredServersSource.Sort(FCompareServerByNumPlayers());
-	else if (ColumnName == FName(TEXT("ServerNumSpecs"))) bDescendingSort ? FilteredServersSource.Sort(FCompareServerByNumSpectatorsDesc()) : FilteredServersSource.Sort(FCompareServerByNumSpectators());
-	else if (ColumnName == FName(TEXT("ServerNumFriends"))) bDescendingSort ? FilteredServersSource.Sort(FCompareServerByNumFriendsDesc()) : FilteredServersSource.Sort(FCompareServerByNumFriends());
-	else if (ColumnName == FName(TEXT("ServerPing"))) bDescendingSort ? FilteredServersSource.Sort(FCompareServerByPingDesc()) : FilteredServersSource.Sort(FCompareServerByPing());
+	if (ColumnName == FName(TEXT("ServerName"))) SortOrInsertServer<FCompareServerByName, FCompareServerByNameDesc>(FilteredServersSource, NewServer, bDescendingSort);
+	else if (ColumnName == FName(TEXT("ServerIP"))) SortOrInsertServer<FCompareServerByIP, FCompareServerByIPDesc>(FilteredServersSource, NewServer, bDescendingSort);
+	else if (ColumnName == FName(TEXT("ServerGame"))) SortOrInsertServer<FCompareServerByGameMode, FCompareServerByGameModeDesc>(FilteredServersSource, NewServer, bDescendingSort);
+	else if (ColumnName == FName(TEXT("ServerMap"))) SortOrInsertServer<FCompareServerByMap, FCompareServerByMapDesc>(FilteredServersSource, NewServer, bDescendingSort);
+	else if (ColumnName == FName(TEXT("ServerVer"))) SortOrInsertServer<FCompareServerByVersion, FCompareServerByVersionDesc>(FilteredServersSource, NewServer, bDescendingSort);
+	else if (ColumnName == FName(TEXT("ServerNumPlayers"))) SortOrInsertServer<FCompareServerByNumPlayers, FCompareServerByNumPlayersDesc>(FilteredServersSource, NewServer, bDescendingSort);
+	else if (ColumnName == FName(TEXT("ServerNumSpecs"))) SortOrInsertServer<FCompareServerByNumSpectators, FCompareServerByNumSpectatorsDesc>(FilteredServersSource, NewServer, bDescendingSort);
+	else if (ColumnName == FName(TEXT("ServerNumFriends"))) SortOrInsertServer<FCompareServerByNumFriends, FCompareServerByNumFriendsDesc>(FilteredServersSource, NewServer, bDescendingSort);
+	else if (ColumnName == FName(TEXT("ServerPing"))) SortOrInsertServer<FCompareServerByPing, FCompareServerByPingDesc>(FilteredServersSource, NewServer, bDescendingSort);
+	else if (NewServer.IsValid()) FilteredServersSource.Add(NewServer);
 
 	InternetServerList->RequestListRefresh();
 	CurrentSortColumn = ColumnName;
 }
 
-void SUWServerBrowser::SortHUBs()
+void SUWServerBrowser::SortHUBs(TSharedPtr<FServerData> NewHub)
 {
-	FilteredHubsSource.Sort(FCompareServerByPing());
+	SortOrInsertServer<FCompareServerByPing, FCompareServerByPingDesc>(FilteredHubsSource, NewHub, false);
 	HUBServerList->RequestListRefresh();
 }
 
@@ -1044,6 +1091,7 @@ void SUWServerBrowser::RefreshServers()
 
 		bNeedsRefresh = false;
 		CleanupQoS();
+		RefreshStartTime = FPlatformTime::Seconds();
 
 		// Search for Internet Servers
 
@@ -1081,10 +1129,17 @@ void SUWServerBrowser::FoundServer(FOnlineSessionSearchResult& Result)
 	// prefer using the name in the client's language, if available
 	// TODO: would be nice to not have to load the class, but the localization system doesn't guarantee any particular lookup location for the data,
 	//		so we have no way to know where it is
-	UClass* GameClass = LoadClass<AUTBaseGameMode>(NULL, *ServerGamePath, NULL, LOAD_NoWarn | LOAD_Quiet, NULL);
-	if (GameClass != NULL)
+	// Most servers run one of a few game modes, so only look each class up once rather than for every server in the list
+	FString* GameModeDisplayName = GameModeDisplayNames.Find(ServerGamePath);
+	if (GameModeDisplayName == NULL)
 	{
-		ServerGameName = GameClass->GetDefaultObject<AUTBaseGameMode>()->DisplayName.ToString();
+		UClass* GameClass = LoadClass<AUTBaseGameMode>(NULL, *ServerGamePath, NULL, LOAD_NoWarn | LOAD_Quiet, NULL);
+		GameModeDisplayName = &GameModeDisplayNames.Add(ServerGamePath, (GameClass != NULL) ? GameClass->GetDefaultObject<AUTBaseGameMode>()->DisplayName.ToString() : FString());
+	}
+
+	if (!GameModeDisplayName->IsEmpty())
+	{
+		ServerGameName = *GameModeDisplayName;
 	}
 	else
 	{
@@ -1426,6 +1481,12 @@ void SUWServerBrowser::PingNextServer()
 		}
 
 		bWantsAFullRefilter = false;
+
+		if (RefreshStartTime > 0.0)
+		{
+			UE_LOG(UT, Log, TEXT("Server browser listed %i servers and %i hubs in %.2f seconds"), AllInternetServers.Num(), AllHubServers.Num(), FPlatformTime::Seconds() - RefreshStartTime);
+			RefreshStartTime = 0.0;
+		}
 	}
 
 	while (PingList.Num() > 0 && PingTrackers.Num() < PlayerOwner->ServerPingBlockSize)
@@ -1460,7 +1521,14 @@ void SUWServerBrowser::AddServer(TSharedPtr<FServerData> Server)
 
 			if (AllInternetServers[i] != Server)
 			{
+				// The new data can move the server in the sorted list, so take it out while it changes and filter it again
+				const bool bWasFiltered = FilteredServersSource.Remove(AllInternetServers[i]) > 0;
 				AllInternetServers[i]->Update(Server);
+				if (bWasFiltered)
+				{
+					FilterServer(AllInternetServers[i]);
+					InternetServerList->RequestListRefresh();
+				}
 			}
 
 			return; 
@@ -1499,7 +1567,14 @@ void SUWServerBrowser::AddHub(TSharedPtr<FServerData> Hub)
 
 				if (AllHubServers[i] != Hub)
 				{
+					// Same as servers, the ping it's sorted by can change
+					const bool bWasFiltered = FilteredHubsSource.Remove(AllHubServers[i]) > 0;
 					AllHubServers[i]->Update(Hub);
+					if (bWasFiltered)
+					{
+						FilterHUB(AllHubServers[i]);
+						HUBServerList->RequestListRefresh();
+					}
 				}
 
 				return; 
@@ -1533,46 +1608,19 @@ void SUWServerBrowser::OnServerBeaconResult(AUTServerBeaconClient* Sender, FServ
 	{
 		if (PingTrackers[i].Beacon == Sender)
 		{
+			// Ping and map are sort keys, so a server that is already listed has to come out of the sorted lists before they change
+			TSharedPtr<FServerData> Server = PingTrackers[i].Server;
+			const bool bWasFiltered = FilteredServersSource.Remove(Server) > 0;
+			const bool bWasFilteredHub = FilteredHubsSource.Remove(Server) > 0;
+
 			// Matched... store the data.
 			PingTrackers[i].Server->Ping = Sender->Ping;
 			PingTrackers[i].Server->MOTD = ServerInfo.MOTD;
 			PingTrackers[i].Server->Map = ServerInfo.CurrentMap;
 
-			PingTrackers[i].Server->Players.Empty();
-			TArray<FString> PlayerData;
-			int32 Cnt = ServerInfo.ServerPlayers.ParseIntoArray(PlayerData, TEXT("\t"), true);
-			for (int32 p=0;p+2 < Cnt; p+=3)
-			{
-				FString Name = PlayerData[p];
-				FString Score = PlayerData[p+1];
-				FString Id = PlayerData[p+2];
-
-				PingTrackers[i].Server->AddPlayer(Name, Score, Id);
-			}
-
-			PingTrackers[i].Server->Rules.Empty();
-			TArray<FString> RulesData;
-			Cnt = ServerInfo.ServerRules.ParseIntoArray(RulesData, TEXT("\t"), true);
-			for (int32 r=0; r+1 < Cnt; r+=2)
-			{
-				FString Rule = RulesData[r];
-				FString Value = RulesData[r+1];
-
-				PingTrackers[i].Server->AddRule(Rule, Value);
-			}
-
-			TArray<FString> BrokenIP;
-			if (PingTrackers[i].Server->IP.ParseIntoArray(BrokenIP,TEXT(":"),true) == 2)
-			{
-				PingTrackers[i].Server->AddRule(TEXT("IP"), BrokenIP[0]);
-				PingTrackers[i].Server->AddRule(TEXT("Port"), BrokenIP[1]);
-			}
-			else
-			{
-				PingTrackers[i].Server->AddRule(TEXT("IP"), PingTrackers[i].Server->IP);
-			}
-
-			PingTrackers[i].Server->AddRule(TEXT("Version"), PingTrackers[i].Server->Version);
+			PingTrackers[i].Server->BeaconPlayers = ServerInfo.ServerPlayers;
+			PingTrackers[i].Server->BeaconRules = ServerInfo.ServerRules;
+			PingTrackers[i].Server->bBeaconInfoParsed = false;
 
 			PingTrackers[i].Server->HUBInstances.Empty();
 			for (int32 InstIndex=0; InstIndex < PingTrackers[i].Beacon->InstanceInfo.Num(); InstIndex++ )
@@ -1589,6 +1637,18 @@ void SUWServerBrowser::OnServerBeaconResult(AUTServerBeaconClient* Sender, FServ
 				AddServer(PingTrackers[i].Server);
 			}
 
+			// A server that was already known isn't filtered again by AddServer/AddHub
+			if (bWasFiltered && !FilteredServersSource.Contains(Server))
+			{
+				FilterServer(Server);
+				InternetServerList->RequestListRefresh();
+			}
+			if (bWasFilteredHub && !FilteredHubsSource.Contains(Server))
+			{
+				FilterHUB(Server);
+				HUBServerList->RequestListRefresh();
+			}
+
 			PingTrackers[i].Beacon->DestroyBeacon();
 			PingTrackers.RemoveAt(i,1);
 
@@ -1664,15 +1724,18 @@ void SUWServerBrowser::FilterServer(TSharedPtr< FServerData > NewServer, bool bS
 
 				if ( !IsUnresponsive(NewServer, BestPing) )
 				{
-					FilteredServersSource.Add(NewServer);
+					if (bSortAndUpdate)
+					{
+						// The rest of the list is still sorted, so just put the new server in its place
+						SortServers(CurrentSortColumn, NewServer);
+					}
+					else
+					{
+						FilteredServersSource.Add(NewServer);
+					}
 				}
 			}
 		}
-
-		if (bSortAndUpdate)
-		{
-			SortServers(CurrentSortColumn);
-		}
 	}
 }
 
@@ -1701,25 +1764,26 @@ void SUWServerBrowser::FilterHUB(TSharedPtr< FServerData > NewServer, bool bSort
 	if (QuickFilterText->GetText().IsEmpty() || NewServer->Name.Find(QuickFilterText->GetText().ToString()) >= 0)
 	{
 		int32 BaseRank = PlayerOwner->GetBaseELORank();
-		if (NewServer->bFakeHUB)
-		{
-			FilteredHubsSource.Add(NewServer);
-		}
-		else
+		bool bPassesFilter = NewServer->bFakeHUB;
+		if (!bPassesFilter)
 		{
 			if ( (NewServer->MinRank <= 0 || BaseRank >= NewServer->MinRank) && (NewServer->MaxRank <= 0 || BaseRank <= NewServer->MaxRank))
 			{
-				if ( !IsUnresponsive(NewServer, BestPing) )
-				{
-					FilteredHubsSource.Add(NewServer);
-				}
+				bPassesFilter = !IsUnresponsive(NewServer, BestPing);
 			}
 		}
-	}
 
-	if (bSortAndUpdate)
-	{
-		SortHUBs();
+		if (bPassesFilter)
+		{
+			if (bSortAndUpdate)
+			{
+				SortHUBs(NewServer);
+			}
+			else
+			{
+				FilteredHubsSource.Add(NewServer);
+			}
+		}
 	}
 }
 
@@ -1818,8 +1882,9 @@ void SUWServerBrowser::Tick( const FGeometry& AllottedGeometry, const double InC
 		HUBServerList->RequestListRefresh();
 	}
 
-	if (RandomHUB.IsValid() && RandomHUB->NumMatches != AllInternetServers.Num())
+	if (RandomHUB.IsValid() && RandomHUB->NumMatches != AllInternetServers.Num() && InCurrentTime - LastRandomHUBUpdateTime >= RANDOM_HUB_UPDATE_INTERVAL)
 	{
+		LastRandomHUBUpdateTime = InCurrentTime;
 		int32 NumPlayers = 0;
 		int32 NumSpectators = 0;
 		int32 NumFriends = 0;
@@ -1891,6 +1956,7 @@ void SUWServerBrowser::OnServerListSelectionChanged(TSharedPtr<FServerData> Sele
 	if (SelectedItem.IsValid())
 	{
 		PingServer(SelectedItem);
+		SelectedItem->ParseBeaconInfo();
 
 		RulesListSource.Empty();
 		for (int32 i=0;i<SelectedItem->Rules.Num();i++)
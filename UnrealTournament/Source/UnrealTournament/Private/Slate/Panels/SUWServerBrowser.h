@@ -229,6 +229,12 @@ public:
 	TArray<TSharedPtr<FServerRuleData>> Rules;
 	TArray<TSharedPtr<FServerPlayerData>> Players;
 
+	// The tab separated player and rule lists the beacon last sent.  They are only split up into Players and Rules
+	// when the server's details are shown, not for every server as the results come in.
+	FString BeaconPlayers;
+	FString BeaconRules;
+	bool bBeaconInfoParsed;
+
 	FServerData(const FString& inName, const FString& inIP, const FString& inBeaconIP, const FString& inGameModePath, const FString& inGameModeName, const FString& inMap, int32 inNumPlayers, int32 inNumSpecators, int32 inMaxPlayers, int32 inMaxSpectators, int32 inNumMatches, int32 inMinRank, int32 inMaxRank, const FString& inVersion, int32 inPing, int32 inFlags, int32 inTrustLevel)
 	: Name( inName )
 	, IP( inIP )
@@ -253,6 +259,7 @@ public:
 		NumFriends = 0;	// Move me once implemented
 		MOTD = TEXT("");
 		bFakeHUB = false;
+		bBeaconInfoParsed = true;
 	}
 
 	static TSharedRef<FServerData> Make(const FString& inName, const FString& inIP, const FString& inBeaconIP, const FString& inGameModePath, const FString& inGameModeName, const FString& inMap, int32 inNumPlayers, int32 inNumSpecators, int32 inMaxPlayers,  int32 inMaxSpectators, int32 inNumMatches, int32 inMinRank, int32 inMaxRank, const FString& inVersion, int32 inPing, int32 inFlags, int32 inTrustLevel)
@@ -290,6 +297,48 @@ public:
 		for (int32 i=0;i<NewData->HUBInstances.Num();i++) HUBInstances.Add(NewData->HUBInstances[i]);
 		for (int32 i=0;i<NewData->Rules.Num();i++) Rules.Add(NewData->Rules[i]);
 		for (int32 i=0;i<NewData->Players.Num();i++) Players.Add(NewData->Players[i]);
+		BeaconPlayers = NewData->BeaconPlayers;
+		BeaconRules = NewData->BeaconRules;
+		bBeaconInfoParsed = NewData->bBeaconInfoParsed;
+	}
+
+	// Fills in Players and Rules from what the beacon last sent, if that hasn't been done yet
+	void ParseBeaconInfo()
+	{
+		if (bBeaconInfoParsed)
+		{
+			return;
+		}
+		bBeaconInfoParsed = true;
+
+		Players.Empty();
+		TArray<FString> PlayerData;
+		int32 Cnt = BeaconPlayers.ParseIntoArray(PlayerData, TEXT("\t"), true);
+		for (int32 p=0;p+2 < Cnt; p+=3)
+		{
+			AddPlayer(PlayerData[p], PlayerData[p+1], PlayerData[p+2]);
+		}
+
+		Rules.Empty();
+		TArray<FString> RulesData;
+		Cnt = BeaconRules.ParseIntoArray(RulesData, TEXT("\t"), true);
+		for (int32 r=0; r+1 < Cnt; r+=2)
+		{
+			AddRule(RulesData[r], RulesData[r+1]);
+		}
+
+		TArray<FString> BrokenIP;
+		if (IP.ParseIntoArray(BrokenIP,TEXT(":"),true) == 2)
+		{
+			AddRule(TEXT("IP"), BrokenIP[0]);
+			AddRule(TEXT("Port"), BrokenIP[1]);
+		}
+		else
+		{
+			AddRule(TEXT("IP"), IP);
+		}
+
+		AddRule(TEXT("Version"), Version);
 	}
 
 
@@ -650,8 +699,9 @@ protected:
 	virtual void AddGameFilters();
 	virtual FReply OnGameFilterSelection(FString Filter);
 
-	void SortServers(FName ColumnName);
-	void SortHUBs();
+	// Sorts the filtered servers, or if NewServer is set, inserts it into the already sorted list
+	void SortServers(FName ColumnName, TSharedPtr<FServerData> NewServer = TSharedPtr<FServerData>());
+	void SortHUBs(TSharedPtr<FServerData> NewHub = TSharedPtr<FServerData>());
 	virtual void FilterAllServers();
 	virtual void FilterServer(TSharedPtr< FServerData > NewServer, bool bSortAndUpdate = true, int32 BestPing = 0);
 	virtual void FilterAllHUBs();
@@ -740,6 +790,15 @@ private:
 	TSharedPtr<class FUTOnlineGameSearchBase> LanSearchSettings;
 
 	TSharedPtr<FServerData> RandomHUB;
+
+	// When the random HUB was last rebuilt, it is only rebuilt every so often while servers are coming in
+	double LastRandomHUBUpdateTime;
+
+	// Display names of the game modes servers are running, so each game class is only looked up once.  Empty if the class can't be loaded.
+	TMap<FString, FString> GameModeDisplayNames;
+
+	// When the current refresh started, to log how long it took to get the full list
+	double RefreshStartTime;
 	TSharedPtr<SHorizontalBox> ServerListControlBox;
 
 	float GetReverseScale() const;
@@ -6,6 +6,7 @@ UStat::UStat(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	AbsoluteMaxValue = 0;
+	StatIndex = INDEX_NONE;
 	for(int32 i = 0; i < EStatRecordingPeriod::Max; i++)
 	{
 		StatDataByPeriod.Add(0);
@@ -3,6 +3,7 @@
 #include "UnrealTournament.h"
 #include "StatNames.h"
 #include "UTCTFScoring.h"
+#include "UTStatRegistry.h"
 
 DEFINE_LOG_CATEGORY(LogGameStats);
 
@@ -146,6 +147,7 @@ UStat* UStatManager::MakeStat(FName StatName, bool bBackendStat)
 {
 	UStat* Stat = NewObject<UStat>(this, StatName);
 	Stat->StatName = StatName;
+	Stat->StatIndex = FUTStatRegistry::RegisterStat(StatName);
 	Stat->HighestPeriodToTrack = EStatRecordingPeriod::Persistent;
 	Stat->bBackendStat = bBackendStat;
 
@@ -265,19 +267,22 @@ void UStatManager::PopulateStatLookup()
 	{
 		if (Stat)
 		{
+			Stat->StatIndex = FUTStatRegistry::RegisterStat(Stat->StatName);
 			StatLookup.Add(Stat->StatName, Stat);
 		}
 	}
 }
 
-void UStatManager::PopulateJsonObjectForBackendStats(TSharedPtr<FJsonObject> JsonObject, AUTPlayerState* PS)
+void UStatManager::GatherBackendStats(AUTPlayerState* PS, TArray<FName>& OutStatNames, TArray<float>& OutStatValues) const
 {
+	OutStatNames.Reserve(Stats.Num());
+	OutStatValues.Reserve(Stats.Num());
 	for (auto* Stat : Stats)
 	{
 		if (Stat && Stat->bBackendStat && PS)
 		{
-			float NewStatValue = PS->GetStatsValue(Stat->StatName);
-			JsonObject->SetNumberField(Stat->StatName.ToString(), NewStatValue);
+			OutStatNames.Add(Stat->StatName);
+			OutStatValues.Add(PS->GetStatsValueByIndex(Stat->StatIndex));
 		}
 	}
 }
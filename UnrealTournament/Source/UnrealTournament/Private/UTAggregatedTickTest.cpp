@@ -0,0 +1,178 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTProjectile.h"
+#include "UTProj_Rocket.h"
+#include "UTProjectileMovementComponent.h"
+#include "UTAggregatedTickTest.h"
+
+/** projectiles join their aggregator after their first regular tick, give up if that takes longer than this */
+static const int32 MaxWaitFrames = 30;
+
+AUTAggregatedTickTest::AUTAggregatedTickTest(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = true;
+	ProjClass = AUTProj_Rocket::StaticClass();
+	NumProjectiles = 8;
+	NumFrames = 60;
+	NumWaitFrames = 0;
+	NumProbeTicks = 0;
+	NumProbeFailures = 0;
+	bStarted = false;
+}
+
+void AUTAggregatedTickTest::StartTest()
+{
+	IConsoleVariable* AggregateTicks = IConsoleManager::Get().FindConsoleVariable(TEXT("ut.AggregateTicks"));
+	if (ProjClass == NULL || AggregateTicks == NULL || AggregateTicks->GetInt() == 0)
+	{
+		Finish(false, TEXT("needs ut.AggregateTicks on"));
+		return;
+	}
+	FActorSpawnParameters Params;
+	Params.bNoCollisionFail = true;
+	Params.Owner = this;
+	for (int32 i = 0; i < NumProjectiles; i++)
+	{
+		AUTProjectile* Proj = GetWorld()->SpawnActor<AUTProjectile>(ProjClass, GetActorLocation() + FVector(i * 50.0f, 0.0f, 0.0f), FRotator(90.0f, 0.0f, 0.0f), Params);
+		if (Proj != NULL)
+		{
+			// slowly up, so they still move every frame but don't hit anything while the test runs
+			Proj->ProjectileMovement->Velocity = FVector(0.0f, 0.0f, 10.0f);
+			Proj->SetLifeSpan(30.0f);
+			Projectiles.Add(Proj);
+		}
+	}
+	if (Projectiles.Num() == 0)
+	{
+		Finish(false, TEXT("couldn't spawn any projectiles"));
+		return;
+	}
+	bStarted = true;
+}
+
+void AUTAggregatedTickTest::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bStarted)
+	{
+		return;
+	}
+	if (Probe.Aggregator == NULL)
+	{
+		CheckAggregated();
+	}
+	else if (NumProbeTicks >= NumFrames)
+	{
+		Finish(NumProbeFailures == 0, FString::Printf(TEXT("the probe ran before the projectile movement in %d of %d frames"), NumProbeFailures, NumProbeTicks));
+	}
+}
+
+void AUTAggregatedTickTest::CheckAggregated()
+{
+	NumWaitFrames++;
+	FUTTickAggregator* Aggregator = NULL;
+	for (AUTProjectile* Proj : Projectiles)
+	{
+		if (Proj == NULL || Proj->IsPendingKillPending())
+		{
+			Finish(false, TEXT("a projectile was destroyed early, try again facing open space"));
+			return;
+		}
+		UUTProjectileMovementComponent* Movement = Cast<UUTProjectileMovementComponent>(Proj->ProjectileMovement);
+		if (Movement == NULL)
+		{
+			Finish(false, FString::Printf(TEXT("%s doesn't use UUTProjectileMovementComponent"), *GetNameSafe(ProjClass)));
+			return;
+		}
+		if (!Movement->GetAggregatedTick().IsAggregated())
+		{
+			if (NumWaitFrames > MaxWaitFrames)
+			{
+				Finish(false, TEXT("the projectile movement wasn't aggregated"));
+			}
+			return;
+		}
+		Aggregator = Movement->GetAggregatedTick().Aggregator;
+
+		// the actor tick must wait for the aggregator, not for the unregistered movement tick that would be skipped when queuing
+		bool bWaitsForAggregator = false;
+		for (FTickPrerequisite& Prerequisite : Proj->PrimaryActorTick.GetPrerequisites())
+		{
+			FTickFunction* PrerequisiteFunction = Prerequisite.Get();
+			if (PrerequisiteFunction == &Movement->PrimaryComponentTick)
+			{
+				Finish(false, FString::Printf(TEXT("%s still waits for its unregistered movement tick"), *Proj->GetName()));
+				return;
+			}
+			bWaitsForAggregator = bWaitsForAggregator || (PrerequisiteFunction == Aggregator);
+		}
+		if (!bWaitsForAggregator)
+		{
+			Finish(false, FString::Printf(TEXT("%s doesn't wait for the aggregated movement"), *Proj->GetName()));
+			return;
+		}
+	}
+
+	// same scheduling constraints as the first projectile's actor tick
+	AUTProjectile* Proj = Projectiles[0];
+	Probe.Test = this;
+	Probe.Aggregator = Aggregator;
+	Probe.bCanEverTick = true;
+	Probe.TickGroup = Proj->PrimaryActorTick.TickGroup;
+	for (FTickPrerequisite& Prerequisite : Proj->PrimaryActorTick.GetPrerequisites())
+	{
+		if (Prerequisite.Get() != NULL)
+		{
+			Probe.AddPrerequisite(Prerequisite.PrerequisiteObject.Get(), *Prerequisite.PrerequisiteTickFunction);
+		}
+	}
+	Probe.RegisterTickFunction(GetLevel());
+}
+
+void AUTAggregatedTickTest::FProbeTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Test != NULL && Aggregator != NULL && Test->NumProbeTicks < Test->NumFrames)
+	{
+		Test->NumProbeTicks++;
+		if (Aggregator->GetLastTickFrame() != GFrameCounter)
+		{
+			Test->NumProbeFailures++;
+		}
+	}
+}
+
+void AUTAggregatedTickTest::Finish(bool bPassed, const FString& Message)
+{
+	Report(FString::Printf(TEXT("TestAggregatedTickOrder: %s, %s"), bPassed ? TEXT("passed") : TEXT("FAILED"), *Message));
+	bStarted = false;
+	Destroy();
+}
+
+void AUTAggregatedTickTest::Report(const FString& Line)
+{
+	UE_LOG(UT, Log, TEXT("%s"), *Line);
+	if (ReportTo != NULL)
+	{
+		ReportTo->ClientMessage(Line);
+	}
+}
+
+void AUTAggregatedTickTest::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (Probe.IsTickFunctionRegistered())
+	{
+		Probe.UnRegisterTickFunction();
+	}
+	Probe.Aggregator = NULL;
+	for (AUTProjectile* Proj : Projectiles)
+	{
+		if (Proj != NULL && !Proj->IsPendingKillPending())
+		{
+			Proj->Destroy();
+		}
+	}
+	Projectiles.Empty();
+	Super::EndPlay(EndPlayReason);
+}
@@ -8,6 +8,7 @@
 #include "UTGameEngine.h"
 #include "UnrealNetwork.h"
 #include "UTGameViewportClient.h"
+#include "ServerFrameTelemetry.h"
 
 AUTBasePlayerController::AUTBasePlayerController(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -589,6 +590,34 @@ void AUTBasePlayerController::ServerRconKick_Implementation(const FString& NameO
 	}
 }
 
+void AUTBasePlayerController::RconTelemetry()
+{
+	ServerRconTelemetry();
+}
+
+bool AUTBasePlayerController::ServerRconTelemetry_Validate() { return true; }
+void AUTBasePlayerController::ServerRconTelemetry_Implementation()
+{
+	if (UTPlayerState == nullptr || !UTPlayerState->bIsRconAdmin)
+	{
+		ClientSay(UTPlayerState, TEXT("Rcon not authenticated"), ChatDestinations::System);
+		return;
+	}
+
+	if (!FServerFrameTelemetry::IsActive())
+	{
+		ClientSay(UTPlayerState, TEXT("Server telemetry is off"), ChatDestinations::System);
+		return;
+	}
+
+	TArray<FString> Lines;
+	FServerFrameTelemetry::Get().GetSummary(Lines);
+	for (int32 i = 0; i < Lines.Num(); i++)
+	{
+		ClientSay(UTPlayerState, Lines[i], ChatDestinations::System);
+	}
+}
+
 void AUTBasePlayerController::HandleNetworkFailureMessage(enum ENetworkFailure::Type FailureType, const FString& ErrorString)
 {
 }
@@ -14,6 +14,12 @@
 #include "UTSquadAI.h"
 #include "UTReachSpec_HighJump.h"
 #include "UTAvoidMarker.h"
+#include "ServerFrameTelemetry.h"
+
+static TAutoConsoleVariable<int32> CVarBotInventoryField(
+	TEXT("ut.BotInventoryField"),
+	1,
+	TEXT("Bots find items with the navmesh inventory field instead of searching the node network, unless something the field doesn't cover might be better."));
 
 void FBotEnemyInfo::Update(EAIEnemyUpdateType UpdateType, const FVector& ViewerLoc)
 {
@@ -444,6 +450,8 @@ bool AUTBot::FindBestJumpVelocityXY(FVector& JumpVelocity, const FVector& StartL
 
 void AUTBot::Tick(float DeltaTime)
 {
+	SCOPE_SERVER_FRAME_TIMER(BotAI);
+
 	if (NavData == NULL)
 	{
 		NavData = GetUTNavData(GetWorld());
@@ -654,8 +662,11 @@ void AUTBot::Tick(float DeltaTime)
 		}
 		// start new action, if requested
 		// make sure updates above didn't result in losing Pawn (stop firing -> suicide, etc)
-		if (bPendingWhatToDoNext && GetPawn() != NULL)
+		// the decision may have to wait a few frames for its turn, the current move target is followed in the meantime
+		AUTGameMode* Game = GetWorld()->GetAuthGameMode<AUTGameMode>();
+		if (bPendingWhatToDoNext && GetPawn() != NULL && (Game == NULL || Game->BotDecisionScheduler.CanDecide(this)))
 		{
+			const uint32 StartCycles = FPlatformTime::Cycles();
 			bExecutingWhatToDoNext = true;
 			ExecuteWhatToDoNext();
 			bExecutingWhatToDoNext = false;
@@ -665,6 +676,10 @@ void AUTBot::Tick(float DeltaTime)
 				UE_LOG(UT, Warning, TEXT("%s (%s) failed to get an action from ExecuteWhatToDoNext()"), *GetName(), *PlayerState->PlayerName);
 			}
 			SetDefaultFocus();
+			if (Game != NULL)
+			{
+				Game->BotDecisionScheduler.DecisionMade(this, FPlatformTime::Cycles() - StartCycles);
+			}
 		}
 
 		if (MoveTarget.IsValid() && GetPawn() != NULL)
@@ -2023,7 +2038,13 @@ bool AUTBot::FindInventoryGoal(float MinWeight)
 		LastFindInventoryWeight = MinWeight;
 
 		FBestInventoryEval NodeEval(RespawnPredictionTime, (GetCharacter() != NULL) ? GetCharacter()->GetCharacterMovement()->MaxWalkSpeed : GetDefault<AUTCharacter>()->GetCharacterMovement()->MaxWalkSpeed, (MinWeight > 0.0f) ? FMath::TruncToInt(5.0f / MinWeight) : 0);
-		return NavData->FindBestPath(GetPawn(), GetPawn()->GetNavAgentPropertiesRef(), NodeEval, GetPawn()->GetNavAgentLocation(), MinWeight, false, RouteCache);
+		// the inventory field usually has the answer without searching the network
+		bool bNeedFullSearch = (CVarBotInventoryField.GetValueOnGameThread() == 0);
+		if (!bNeedFullSearch && NavData->FindInventoryFieldPath(GetPawn(), GetPawn()->GetNavAgentPropertiesRef(), NodeEval, GetPawn()->GetNavAgentLocation(), MinWeight, RouteCache, bNeedFullSearch))
+		{
+			return true;
+		}
+		return bNeedFullSearch && NavData->FindBestPath(GetPawn(), GetPawn()->GetNavAgentPropertiesRef(), NodeEval, GetPawn()->GetNavAgentLocation(), MinWeight, false, RouteCache);
 	}
 }
 
@@ -2210,6 +2231,26 @@ void AUTBot::WhatToDoNext()
 	bPendingWhatToDoNext = true;
 }
 
+EBotDecisionPriority::Type AUTBot::GetDecisionPriority() const
+{
+	if (UTChar != NULL && GetWorld()->TimeSeconds - UTChar->LastTakeHitTime < 2.0f)
+	{
+		return EBotDecisionPriority::UnderAttack;
+	}
+	else if (UTChar != NULL && UTChar->GetCarriedObject() != NULL)
+	{
+		return EBotDecisionPriority::CarryingFlag;
+	}
+	else if (Enemy != NULL)
+	{
+		return EBotDecisionPriority::Normal;
+	}
+	else
+	{
+		return EBotDecisionPriority::Idle;
+	}
+}
+
 void AUTBot::ExecuteWhatToDoNext()
 {
 	Target = NULL;
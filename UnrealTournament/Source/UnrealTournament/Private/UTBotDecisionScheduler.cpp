@@ -0,0 +1,158 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTBotDecisionScheduler.h"
+
+DECLARE_STATS_GROUP(TEXT("UT Bot AI"), STATGROUP_UTBotAI, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Decisions"), STAT_UTBotDecisions, STATGROUP_UTBotAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Forced decisions"), STAT_UTBotForcedDecisions, STATGROUP_UTBotAI);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Decision time (ms)"), STAT_UTBotDecisionTime, STATGROUP_UTBotAI);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Longest decision wait (ms)"), STAT_UTBotDecisionWait, STATGROUP_UTBotAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Bots waiting to decide"), STAT_UTBotDecisionQueue, STATGROUP_UTBotAI);
+
+static TAutoConsoleVariable<float> CVarBotDecisionBudget(
+	TEXT("ut.BotDecisionBudget"),
+	1.0f,
+	TEXT("Milliseconds per frame bots may spend deciding what to do next, the rest wait for a later frame. At least one bot decides each frame. 0 means no limit."));
+
+static TAutoConsoleVariable<float> CVarBotDecisionMaxWait(
+	TEXT("ut.BotDecisionMaxWait"),
+	0.3f,
+	TEXT("Seconds a bot waits to decide at most, after that it goes over the budget."));
+
+FUTBotDecisionScheduler::FUTBotDecisionScheduler()
+	: Frame(0)
+	, FrameDecisions(0)
+	, FrameCycles(0)
+	, FrameMaxWait(0.0f)
+	, bQueueGranted(true)
+	, AvgDecisionMs(0.1f)
+{
+	FMemory::Memzero(Totals);
+}
+
+void FUTBotDecisionScheduler::ResetTotals(UWorld* World)
+{
+	FMemory::Memzero(Totals);
+	Totals.StartTime = World->TimeSeconds;
+}
+
+FUTBotDecisionScheduler::FRequest* FUTBotDecisionScheduler::FindRequest(AUTBot* Bot)
+{
+	for (FRequest& Request : Queue)
+	{
+		if (Request.Bot.Get() == Bot)
+		{
+			return &Request;
+		}
+	}
+	return NULL;
+}
+
+void FUTBotDecisionScheduler::StartFrame(UWorld* World)
+{
+	Frame = GFrameCounter;
+	FrameDecisions = 0;
+	FrameCycles = 0;
+	FrameMaxWait = 0.0f;
+
+	// bots that died or were destroyed while waiting don't need to decide anymore
+	Queue.RemoveAll([](const FRequest& Request) { return !Request.Bot.IsValid() || !Request.Bot->WantsToDecide(); });
+	for (FRequest& Request : Queue)
+	{
+		Request.Priority = Request.Bot->GetDecisionPriority();
+	}
+	Queue.Sort([](const FRequest& A, const FRequest& B)
+	{
+		return (A.Priority != B.Priority) ? (A.Priority > B.Priority) : (A.RequestTime < B.RequestTime);
+	});
+
+	const float BudgetMs = CVarBotDecisionBudget.GetValueOnGameThread();
+	const float MaxWait = CVarBotDecisionMaxWait.GetValueOnGameThread();
+	const float Now = World->TimeSeconds;
+	float PlannedMs = 0.0f;
+	bQueueGranted = true;
+	for (FRequest& Request : Queue)
+	{
+		Request.bForced = false;
+		Request.bGranted = (BudgetMs <= 0.0f || PlannedMs == 0.0f || PlannedMs + AvgDecisionMs <= BudgetMs);
+		if (!Request.bGranted && Now - Request.RequestTime >= MaxWait)
+		{
+			Request.bGranted = true;
+			Request.bForced = true;
+		}
+		if (Request.bGranted)
+		{
+			PlannedMs += AvgDecisionMs;
+		}
+		else
+		{
+			bQueueGranted = false;
+		}
+	}
+	SET_DWORD_STAT(STAT_UTBotDecisionQueue, Queue.Num());
+}
+
+bool FUTBotDecisionScheduler::CanDecide(AUTBot* Bot)
+{
+	UWorld* World = Bot->GetWorld();
+	if (GFrameCounter != Frame)
+	{
+		StartFrame(World);
+	}
+
+	const FRequest* Request = FindRequest(Bot);
+	if (Request != NULL)
+	{
+		return Request->bGranted;
+	}
+	// asked this frame; can go right away if nobody from earlier frames is still waiting and there's time left
+	const float BudgetMs = CVarBotDecisionBudget.GetValueOnGameThread();
+	if (bQueueGranted && (BudgetMs <= 0.0f || FrameDecisions == 0 || FPlatformTime::ToMilliseconds(FrameCycles) + AvgDecisionMs <= BudgetMs))
+	{
+		return true;
+	}
+	FRequest* NewRequest = new(Queue) FRequest;
+	NewRequest->Bot = Bot;
+	NewRequest->RequestTime = World->TimeSeconds;
+	NewRequest->Priority = Bot->GetDecisionPriority();
+	NewRequest->bGranted = false;
+	NewRequest->bForced = false;
+	bQueueGranted = false;
+	return false;
+}
+
+void FUTBotDecisionScheduler::DecisionMade(AUTBot* Bot, uint32 Cycles)
+{
+	float Wait = 0.0f;
+	bool bForced = false;
+	for (int32 i = 0; i < Queue.Num(); i++)
+	{
+		if (Queue[i].Bot.Get() == Bot)
+		{
+			Wait = Bot->GetWorld()->TimeSeconds - Queue[i].RequestTime;
+			bForced = Queue[i].bForced;
+			Queue.RemoveAt(i);
+			break;
+		}
+	}
+
+	const float DecisionMs = FPlatformTime::ToMilliseconds(Cycles);
+	AvgDecisionMs = AvgDecisionMs * 0.9f + DecisionMs * 0.1f;
+	FrameDecisions++;
+	FrameCycles += Cycles;
+	FrameMaxWait = FMath::Max<float>(FrameMaxWait, Wait);
+
+	Totals.NumDecisions++;
+	Totals.NumForced += bForced ? 1 : 0;
+	Totals.TotalWait += Wait;
+	Totals.MaxWait = FMath::Max<float>(Totals.MaxWait, Wait);
+	Totals.TotalDecisionMs += DecisionMs;
+
+	INC_DWORD_STAT(STAT_UTBotDecisions);
+	if (bForced)
+	{
+		INC_DWORD_STAT(STAT_UTBotForcedDecisions);
+	}
+	INC_FLOAT_STAT_BY(STAT_UTBotDecisionTime, DecisionMs);
+	SET_FLOAT_STAT(STAT_UTBotDecisionWait, FrameMaxWait * 1000.0f);
+}
@@ -0,0 +1,297 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTBotMatchBenchmark.h"
+#include "UTSimulatedNetConnection.h"
+
+AUTBotMatchBenchmark::AUTBotMatchBenchmark(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = true;
+	MeasureSeconds = 60.0f;
+	WarmupSeconds = 10.0f;
+	Seed = 0;
+	Phase = PHASE_Done;
+	PhaseEndTime = 0.0f;
+	MeasureStartRealTime = 0.0;
+	bCompareAnimUpdateRate = false;
+	SavedAnimUpdateRateOptimizations = 1;
+}
+
+/** one telemetry histogram as JSON, with the time spent per simulated second so runs at different frame rates can be compared */
+static TSharedRef<FJsonObject> HistogramToJson(const FServerFrameTelemetry::FHistogram& Histogram, float SimulatedSeconds)
+{
+	TSharedRef<FJsonObject> StatJson = MakeShareable(new FJsonObject);
+	StatJson->SetNumberField(TEXT("Count"), Histogram.Count);
+	StatJson->SetNumberField(TEXT("AvgMs"), (Histogram.Count > 0) ? float(Histogram.TotalMs / Histogram.Count) : 0.0f);
+	StatJson->SetNumberField(TEXT("P50Ms"), Histogram.GetPercentile(0.5f));
+	StatJson->SetNumberField(TEXT("P95Ms"), Histogram.GetPercentile(0.95f));
+	StatJson->SetNumberField(TEXT("P99Ms"), Histogram.GetPercentile(0.99f));
+	StatJson->SetNumberField(TEXT("MaxMs"), Histogram.MaxMs);
+	StatJson->SetNumberField(TEXT("MsPerSecond"), Histogram.TotalMs / FMath::Max(SimulatedSeconds, 0.001f));
+	return StatJson;
+}
+
+bool AUTBotMatchBenchmark::WantsBenchmark(float& OutMeasureSeconds)
+{
+	OutMeasureSeconds = 0.0f;
+	return FParse::Value(FCommandLine::Get(), TEXT("UTBenchmarkSeconds="), OutMeasureSeconds) && OutMeasureSeconds > 0.0f;
+}
+
+void AUTBotMatchBenchmark::StartBenchmark()
+{
+	FParse::Value(FCommandLine::Get(), TEXT("UTBenchmarkWarmup="), WarmupSeconds);
+	WarmupSeconds = FMath::Max(0.0f, WarmupSeconds);
+	FParse::Value(FCommandLine::Get(), TEXT("UTBenchmarkSeed="), Seed);
+	if (!FParse::Value(FCommandLine::Get(), TEXT("UTBenchmarkReport="), ReportFilename) || ReportFilename.IsEmpty())
+	{
+		ReportFilename = FPaths::GameSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("BotMatch-%s-%s.json"), *GetWorld()->GetMapName(), *FDateTime::Now().ToString());
+	}
+	bCompareAnimUpdateRate = FParse::Param(FCommandLine::Get(), TEXT("UTBenchmarkCompareAnim"));
+	if (bCompareAnimUpdateRate && GetNetMode() == NM_DedicatedServer)
+	{
+		// the animation budget isn't run without a view, so both runs would be the same
+		UE_LOG(UT, Warning, TEXT("BotMatchBenchmark: -UTBenchmarkCompareAnim on a dedicated server only compares on demand poses, run it in a standalone game"));
+	}
+
+	if (!FApp::IsBenchmarking())
+	{
+		// same as -BENCHMARK: fixed time step, frames back to back instead of waiting for the net tick rate
+		UE_LOG(UT, Warning, TEXT("BotMatchBenchmark: -BENCHMARK not given, turning on the fixed time step (%.1f fps)"), 1.0 / FApp::GetFixedDeltaTime());
+		FApp::SetBenchmarking(true);
+	}
+
+	IConsoleManager& ConsoleManager = IConsoleManager::Get();
+	IConsoleVariable* TelemetryEnable = ConsoleManager.FindConsoleVariable(TEXT("ServerTelemetry.Enable"));
+	IConsoleVariable* TelemetryWindowSeconds = ConsoleManager.FindConsoleVariable(TEXT("ServerTelemetry.WindowSeconds"));
+	if (TelemetryEnable == NULL || TelemetryWindowSeconds == NULL)
+	{
+		UE_LOG(UT, Error, TEXT("BotMatchBenchmark: missing telemetry console variables"));
+		FPlatformMisc::RequestExit(false);
+		return;
+	}
+	// always gather, and only close windows when a phase ends; windows are in real time which is well below simulated time here
+	TelemetryEnable->Set(2);
+	TelemetryWindowSeconds->Set((WarmupSeconds + MeasureSeconds) * 10.0f);
+
+	FMath::RandInit(Seed);
+	FMath::SRandInit(Seed);
+
+	UE_LOG(UT, Log, TEXT("BotMatchBenchmark: %s, %.0f seconds warm up, %.0f seconds measured at %.1f fps, seed %d"), *GetWorld()->GetMapName(), WarmupSeconds, MeasureSeconds, 1.0 / FApp::GetFixedDeltaTime(), Seed);
+	Phase = PHASE_WaitingForMatch;
+}
+
+void AUTBotMatchBenchmark::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	AUTGameState* GS = GetWorld()->GetGameState<AUTGameState>();
+	const float Now = GetWorld()->GetTimeSeconds();
+	switch (Phase)
+	{
+		case PHASE_WaitingForMatch:
+			if (GS != NULL && GS->IsMatchInProgress())
+			{
+				Phase = PHASE_WarmUp;
+				PhaseEndTime = Now + WarmupSeconds;
+			}
+			break;
+		case PHASE_WarmUp:
+			if (Now >= PhaseEndTime)
+			{
+				// throw away whatever was gathered so far
+				FServerFrameTelemetry::Get().FlushWindow();
+				if (AUTGameMode* Game = GetWorld()->GetAuthGameMode<AUTGameMode>())
+				{
+					Game->BotDecisionScheduler.ResetTotals(GetWorld());
+				}
+				Phase = PHASE_Measure;
+				PhaseEndTime = Now + MeasureSeconds;
+				MeasureStartRealTime = FPlatformTime::Seconds();
+			}
+			break;
+		case PHASE_Measure:
+			if (Now >= PhaseEndTime)
+			{
+				FinishMeasure(true);
+			}
+			else if (GS == NULL || GS->HasMatchEnded())
+			{
+				// shouldn't happen as the game mode turns off the time and score limits, report what we have
+				FinishMeasure(false);
+			}
+			break;
+		case PHASE_MeasureAnimOff:
+			if (Now >= PhaseEndTime || GS == NULL || GS->HasMatchEnded())
+			{
+				FinishAnimComparison();
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+void AUTBotMatchBenchmark::FinishMeasure(bool bComplete)
+{
+	const double RealSeconds = FPlatformTime::Seconds() - MeasureStartRealTime;
+	Phase = PHASE_Done;
+	FServerFrameTelemetry::Get().FlushWindow();
+	BuildReport(bComplete, RealSeconds);
+
+	IConsoleVariable* AnimUpdateRateCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ut.AnimUpdateRateOptimizations"));
+	if (bComplete && bCompareAnimUpdateRate && ReportJson.IsValid() && AnimUpdateRateCVar != NULL)
+	{
+		const FServerFrameTelemetry::FWindow* Window = FServerFrameTelemetry::Get().GetLastWindow();
+		AnimOnHistogram = Window->Stats[EServerFrameStat::Animation];
+		AnimOnFrameHistogram = Window->Stats[EServerFrameStat::Frame];
+
+		SavedAnimUpdateRateOptimizations = AnimUpdateRateCVar->GetInt();
+		AnimUpdateRateCVar->Set(0);
+		Phase = PHASE_MeasureAnimOff;
+		PhaseEndTime = GetWorld()->GetTimeSeconds() + MeasureSeconds;
+		UE_LOG(UT, Log, TEXT("BotMatchBenchmark: measuring another %.0f seconds with ut.AnimUpdateRateOptimizations off"), MeasureSeconds);
+		return;
+	}
+
+	WriteReport();
+	FPlatformMisc::RequestExit(false);
+}
+
+void AUTBotMatchBenchmark::FinishAnimComparison()
+{
+	Phase = PHASE_Done;
+	FServerFrameTelemetry::Get().FlushWindow();
+	IConsoleVariable* AnimUpdateRateCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("ut.AnimUpdateRateOptimizations"));
+	if (AnimUpdateRateCVar != NULL)
+	{
+		AnimUpdateRateCVar->Set(SavedAnimUpdateRateOptimizations);
+	}
+
+	const FServerFrameTelemetry::FWindow* Window = FServerFrameTelemetry::Get().GetLastWindow();
+	if (Window != NULL && ReportJson.IsValid())
+	{
+		TSharedRef<FJsonObject> CompareJson = MakeShareable(new FJsonObject);
+		TSharedRef<FJsonObject> OnJson = HistogramToJson(AnimOnHistogram, MeasureSeconds);
+		OnJson->SetObjectField(TEXT("Frame"), HistogramToJson(AnimOnFrameHistogram, MeasureSeconds));
+		CompareJson->SetObjectField(TEXT("On"), OnJson);
+		TSharedRef<FJsonObject> OffJson = HistogramToJson(Window->Stats[EServerFrameStat::Animation], MeasureSeconds);
+		OffJson->SetObjectField(TEXT("Frame"), HistogramToJson(Window->Stats[EServerFrameStat::Frame], MeasureSeconds));
+		CompareJson->SetObjectField(TEXT("Off"), OffJson);
+		ReportJson->SetObjectField(TEXT("AnimUpdateRate"), CompareJson);
+
+		const FServerFrameTelemetry::FHistogram* Histograms[2][2] = { { &AnimOnHistogram, &AnimOnFrameHistogram }, { &Window->Stats[EServerFrameStat::Animation], &Window->Stats[EServerFrameStat::Frame] } };
+		for (int32 i = 0; i < 2; i++)
+		{
+			const FServerFrameTelemetry::FHistogram& Anim = *Histograms[i][0];
+			const FServerFrameTelemetry::FHistogram& Frame = *Histograms[i][1];
+			UE_LOG(UT, Log, TEXT("BotMatchBenchmark animation, update rate optimizations %-3s: %.2fms/s, avg %6.2fms p95 %6.2fms max %6.2fms, frame avg %6.2fms"), (i == 0) ? TEXT("on") : TEXT("off"),
+				Anim.TotalMs / FMath::Max(MeasureSeconds, 0.001f), (Anim.Count > 0) ? float(Anim.TotalMs / Anim.Count) : 0.0f, Anim.GetPercentile(0.95f), Anim.MaxMs,
+				(Frame.Count > 0) ? float(Frame.TotalMs / Frame.Count) : 0.0f);
+		}
+	}
+
+	WriteReport();
+	FPlatformMisc::RequestExit(false);
+}
+
+void AUTBotMatchBenchmark::BuildReport(bool bComplete, double RealSeconds)
+{
+	ReportJson.Reset();
+	const FServerFrameTelemetry::FWindow* Window = FServerFrameTelemetry::Get().GetLastWindow();
+	if (Window == NULL)
+	{
+		UE_LOG(UT, Error, TEXT("BotMatchBenchmark: no telemetry was gathered"));
+		return;
+	}
+	AUTGameMode* Game = GetWorld()->GetAuthGameMode<AUTGameMode>();
+
+	ReportJson = MakeShareable(new FJsonObject);
+	ReportJson->SetStringField(TEXT("Map"), GetWorld()->GetMapName());
+	ReportJson->SetStringField(TEXT("GameMode"), GetNameSafe(Game != NULL ? Game->GetClass() : NULL));
+	ReportJson->SetNumberField(TEXT("Bots"), Game != NULL ? Game->NumBots : 0);
+
+	// simulated players that never got into the game don't load the server, so the numbers wouldn't mean what they seem to
+	int32 NumSimulatedClients = 0;
+	int32 NumSimulatedClientsInGame = 0;
+	if (GetWorld()->GetNetDriver() != NULL)
+	{
+		for (UNetConnection* Connection : GetWorld()->GetNetDriver()->ClientConnections)
+		{
+			UUTSimulatedNetConnection* SimulatedConnection = Cast<UUTSimulatedNetConnection>(Connection);
+			if (SimulatedConnection != NULL && SimulatedConnection->State != USOCK_Closed)
+			{
+				NumSimulatedClients++;
+				NumSimulatedClientsInGame += SimulatedConnection->IsInGame() ? 1 : 0;
+			}
+		}
+	}
+	ReportJson->SetNumberField(TEXT("SimulatedClients"), NumSimulatedClients);
+	ReportJson->SetNumberField(TEXT("SimulatedClientsInGame"), NumSimulatedClientsInGame);
+	if (NumSimulatedClientsInGame < NumSimulatedClients)
+	{
+		UE_LOG(UT, Error, TEXT("BotMatchBenchmark: only %d of %d simulated clients got a pawn and replicated actors"), NumSimulatedClientsInGame, NumSimulatedClients);
+	}
+	ReportJson->SetNumberField(TEXT("Difficulty"), Game != NULL ? Game->GameDifficulty : 0.0f);
+	ReportJson->SetNumberField(TEXT("Seed"), Seed);
+	ReportJson->SetNumberField(TEXT("FixedDeltaTime"), FApp::GetFixedDeltaTime());
+	ReportJson->SetNumberField(TEXT("WarmupSeconds"), WarmupSeconds);
+	ReportJson->SetNumberField(TEXT("SimulatedSeconds"), MeasureSeconds);
+	ReportJson->SetNumberField(TEXT("RealSeconds"), RealSeconds);
+	ReportJson->SetBoolField(TEXT("Complete"), bComplete);
+	ReportJson->SetStringField(TEXT("EngineVersion"), GEngineVersion.ToString());
+	ReportJson->SetNumberField(TEXT("Hitches"), Window->NumHitches);
+
+	// everything that was timed: the frame, the engine buckets and tick groups, then the game code breakdowns
+	TSharedRef<FJsonObject> StatsJson = MakeShareable(new FJsonObject);
+	for (int32 Stat = 0; Stat < EServerFrameStat::Num; Stat++)
+	{
+		const FServerFrameTelemetry::FHistogram& Histogram = Window->Stats[Stat];
+		if (Histogram.Count == 0)
+		{
+			continue;
+		}
+		const float AvgMs = float(Histogram.TotalMs / Histogram.Count);
+		StatsJson->SetObjectField(FServerFrameTelemetry::GetStatName(EServerFrameStat::Type(Stat)), HistogramToJson(Histogram, MeasureSeconds));
+
+		UE_LOG(UT, Log, TEXT("BotMatchBenchmark %-22s %6u  avg %6.2fms p50 %6.2fms p95 %6.2fms p99 %6.2fms max %6.2fms"), FServerFrameTelemetry::GetStatName(EServerFrameStat::Type(Stat)),
+			Histogram.Count, AvgMs, Histogram.GetPercentile(0.5f), Histogram.GetPercentile(0.95f), Histogram.GetPercentile(0.99f), Histogram.MaxMs);
+	}
+	ReportJson->SetObjectField(TEXT("Stats"), StatsJson);
+
+	if (Game != NULL)
+	{
+		// how long bots waited for their turn to decide when the decision budget was used up
+		const FUTBotDecisionScheduler::FTotals& Totals = Game->BotDecisionScheduler.GetTotals();
+		TSharedRef<FJsonObject> DecisionsJson = MakeShareable(new FJsonObject);
+		DecisionsJson->SetNumberField(TEXT("Count"), Totals.NumDecisions);
+		DecisionsJson->SetNumberField(TEXT("PerSecond"), Totals.NumDecisions / FMath::Max(MeasureSeconds, 0.001f));
+		DecisionsJson->SetNumberField(TEXT("Forced"), Totals.NumForced);
+		DecisionsJson->SetNumberField(TEXT("AvgMs"), (Totals.NumDecisions > 0) ? Totals.TotalDecisionMs / Totals.NumDecisions : 0.0);
+		DecisionsJson->SetNumberField(TEXT("AvgWaitMs"), (Totals.NumDecisions > 0) ? Totals.TotalWait * 1000.0f / Totals.NumDecisions : 0.0f);
+		DecisionsJson->SetNumberField(TEXT("MaxWaitMs"), Totals.MaxWait * 1000.0f);
+		ReportJson->SetObjectField(TEXT("BotDecisions"), DecisionsJson);
+
+		UE_LOG(UT, Log, TEXT("BotMatchBenchmark bot decisions: %.1f/s, avg %.3fms, avg wait %.1fms, max wait %.1fms, %d forced"), Totals.NumDecisions / FMath::Max(MeasureSeconds, 0.001f),
+			(Totals.NumDecisions > 0) ? Totals.TotalDecisionMs / Totals.NumDecisions : 0.0, (Totals.NumDecisions > 0) ? Totals.TotalWait * 1000.0f / Totals.NumDecisions : 0.0f, Totals.MaxWait * 1000.0f, Totals.NumForced);
+	}
+}
+
+void AUTBotMatchBenchmark::WriteReport()
+{
+	if (!ReportJson.IsValid())
+	{
+		return;
+	}
+
+	FString OutputJsonString;
+	TSharedRef< TJsonWriter< TCHAR, TPrettyJsonPrintPolicy<TCHAR> > > Writer = TJsonWriterFactory< TCHAR, TPrettyJsonPrintPolicy<TCHAR> >::Create(&OutputJsonString);
+	FJsonSerializer::Serialize(ReportJson.ToSharedRef(), Writer);
+	if (FFileHelper::SaveStringToFile(OutputJsonString, *ReportFilename))
+	{
+		UE_LOG(UT, Log, TEXT("BotMatchBenchmark: report written to %s"), *ReportFilename);
+	}
+	else
+	{
+		UE_LOG(UT, Error, TEXT("BotMatchBenchmark: failed to write %s"), *ReportFilename);
+	}
+}
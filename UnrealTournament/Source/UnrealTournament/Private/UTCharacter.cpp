@@ -30,6 +30,7 @@
 #include "StatNames.h"
 #include "UTGhostComponent.h"
 #include "UTTimedPowerup.h"
+#include "ServerFrameTelemetry.h"
 
 UUTMovementBaseInterface::UUTMovementBaseInterface(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -40,6 +41,26 @@ UUTMovementBaseInterface::UUTMovementBaseInterface(const FObjectInitializer& Obj
 
 DEFINE_LOG_CATEGORY_STATIC(LogUTCharacter, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("UT Animation"), STATGROUP_UTAnimation, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Characters evaluated every frame"), STAT_UTAnimFullRate, STATGROUP_UTAnimation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Characters over budget"), STAT_UTAnimOverBudget, STATGROUP_UTAnimation);
+DECLARE_DWORD_COUNTER_STAT(TEXT("On demand pose updates"), STAT_UTAnimOnDemandPoses, STATGROUP_UTAnimation);
+DECLARE_CYCLE_STAT(TEXT("Animation budget time"), STAT_UTAnimBudgetTime, STATGROUP_UTAnimation);
+DECLARE_CYCLE_STAT(TEXT("On demand pose time"), STAT_UTAnimOnDemandPoseTime, STATGROUP_UTAnimation);
+
+static TAutoConsoleVariable<int32> CVarAnimUpdateRateOptimizations(
+	TEXT("ut.AnimUpdateRateOptimizations"),
+	1,
+	TEXT("If set, characters are animated less often the smaller they are on screen and when they aren't rendered, skipped frames are interpolated."));
+
+static TAutoConsoleVariable<int32> CVarAnimFullRateBudget(
+	TEXT("ut.AnimFullRateBudget"),
+	8,
+	TEXT("Maximum number of visible characters, biggest on screen first, whose animation can be evaluated every frame. 0 for no limit."));
+
+/** MaxDistanceFactor below which visible characters are evaluated every 2, 3... frames, same as the engine defaults */
+static const float AnimDistanceFactorThresholds[] = { 0.4f, 0.2f };
+
 AUTCharacter::AUTCharacter(const class FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer.SetDefaultSubobjectClass<UUTCharacterMovement>(ACharacter::CharacterMovementComponentName))
 {
@@ -72,6 +93,7 @@ AUTCharacter::AUTCharacter(const class FObjectInitializer& ObjectInitializer)
 	GetMesh()->bEnablePhysicsOnDedicatedServer = true; // needed for feign death; death ragdoll shouldn't be invoked on server
 	GetMesh()->bReceivesDecals = false;
 	GetMesh()->bLightAttachmentsAsGroup = true;
+	LastOnDemandPoseFrame = 0;
 
 	UTCharacterMovement = Cast<UUTCharacterMovement>(GetCharacterMovement());
 
@@ -396,6 +418,7 @@ void AUTCharacter::UpdateCrouchedEyeHeight()
 
 void AUTCharacter::OnEndCrouch(float HeightAdjust, float ScaledHeightAdjust)
 {
+	LastOnDemandPoseFrame = 0;
 	float StartBaseEyeHeight = BaseEyeHeight;
 	Super::OnEndCrouch(HeightAdjust, ScaledHeightAdjust);
 	CrouchEyeOffset.Z += StartBaseEyeHeight - BaseEyeHeight - HeightAdjust;
@@ -405,6 +428,7 @@ void AUTCharacter::OnEndCrouch(float HeightAdjust, float ScaledHeightAdjust)
 
 void AUTCharacter::OnStartCrouch(float HeightAdjust, float ScaledHeightAdjust)
 {
+	LastOnDemandPoseFrame = 0;
 	if (HeightAdjust == 0.f)
 	{
 		// early out - it's a crouch while already sliding
@@ -424,6 +448,13 @@ void AUTCharacter::OnStartCrouch(float HeightAdjust, float ScaledHeightAdjust)
 	}
 }
 
+void AUTCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
+{
+	// the animation blueprint poses by movement mode
+	LastOnDemandPoseFrame = 0;
+	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
+}
+
 void AUTCharacter::Restart()
 {
 	Super::Restart();
@@ -495,11 +526,23 @@ static TAutoConsoleVariable<int32> CVarDebugHeadshots(
 FVector AUTCharacter::GetHeadLocation(float PredictionTime)
 {
 	// force mesh update if necessary
+	// dedicated servers never tick the pose, this is the only place it gets evaluated for hit detection
 	if (!GetMesh()->ShouldTickPose())
 	{
-		GetMesh()->TickAnimation(0.0f);
-		GetMesh()->RefreshBoneTransforms();
-		GetMesh()->UpdateComponentToWorld();
+		const FTransform MeshTransform = GetMesh()->GetComponentTransform();
+		const FRotator AimRotation = GetBaseAimRotation();
+		if (LastOnDemandPoseFrame != GFrameCounter || !LastOnDemandPoseTransform.Equals(MeshTransform, 0.0f) || LastOnDemandPoseAim != AimRotation)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_UTAnimOnDemandPoseTime);
+			SCOPE_SERVER_FRAME_TIMER(Animation);
+			INC_DWORD_STAT(STAT_UTAnimOnDemandPoses);
+			LastOnDemandPoseFrame = GFrameCounter;
+			GetMesh()->TickAnimation(0.0f);
+			GetMesh()->RefreshBoneTransforms();
+			GetMesh()->UpdateComponentToWorld();
+			LastOnDemandPoseTransform = GetMesh()->GetComponentTransform();
+			LastOnDemandPoseAim = AimRotation;
+		}
 	}
 	FVector Result = GetMesh()->GetSocketLocation(HeadBone) + FVector(0.0f, 0.0f, HeadHeight);
 	
@@ -507,6 +550,51 @@ FVector AUTCharacter::GetHeadLocation(float PredictionTime)
 	return Result + GetRewindLocation(PredictionTime) - GetActorLocation();
 }
 
+void AUTCharacter::UpdateAnimationBudget(UWorld* World)
+{
+	SCOPE_CYCLE_COUNTER(STAT_UTAnimBudgetTime);
+
+	const bool bUseUpdateRateOptimizations = (CVarAnimUpdateRateOptimizations.GetValueOnGameThread() != 0);
+	// same test as the engine's update rate optimizations
+	const float RecentlyRenderedTime = World->TimeSeconds - 1.0f;
+	TArray<USkeletalMeshComponent*, TInlineAllocator<32> > VisibleMeshes;
+	for (FConstPawnIterator It = World->GetPawnIterator(); It; ++It)
+	{
+		AUTCharacter* UTC = Cast<AUTCharacter>(*It);
+		USkeletalMeshComponent* CharMesh = (UTC != NULL) ? UTC->GetMesh() : NULL;
+		if (CharMesh != NULL && CharMesh->AnimUpdateRateParams != NULL)
+		{
+			// ragdolls, feign death and TacCom change the update flag and need the pose every frame
+			CharMesh->bEnableUpdateRateOptimizations = bUseUpdateRateOptimizations && CharMesh->MeshComponentUpdateFlag == EMeshComponentUpdateFlag::OnlyTickPoseWhenRendered
+														&& !CharMesh->IsSimulatingPhysics();
+			// locally controlled characters are always updated every frame so they don't use up the budget
+			if (CharMesh->bEnableUpdateRateOptimizations && !UTC->IsLocallyControlled() && CharMesh->LastRenderTime > RecentlyRenderedTime)
+			{
+				VisibleMeshes.Add(CharMesh);
+			}
+		}
+	}
+
+	VisibleMeshes.Sort([](const USkeletalMeshComponent& A, const USkeletalMeshComponent& B) { return A.MaxDistanceFactor > B.MaxDistanceFactor; });
+	const int32 FullRateBudget = CVarAnimFullRateBudget.GetValueOnGameThread();
+	for (int32 i = 0; i < VisibleMeshes.Num(); i++)
+	{
+		TArray<float>& Thresholds = VisibleMeshes[i]->AnimUpdateRateParams->BaseVisibleDistanceFactorThresholds;
+		Thresholds.Reset();
+		if (FullRateBudget > 0 && i >= FullRateBudget)
+		{
+			// never every frame, each screen size gets one more skipped frame than it would otherwise
+			Thresholds.Add(FLT_MAX);
+			INC_DWORD_STAT(STAT_UTAnimOverBudget);
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_UTAnimFullRate);
+		}
+		Thresholds.Append(AnimDistanceFactorThresholds, ARRAY_COUNT(AnimDistanceFactorThresholds));
+	}
+}
+
 bool AUTCharacter::IsHeadShot(FVector HitLocation, FVector ShotDirection, float WeaponHeadScaling, bool bConsumeArmor, AUTCharacter* ShotInstigator, float PredictionTime)
 {
 	if (UTCharacterMovement && UTCharacterMovement->bIsFloorSliding)
@@ -1050,7 +1138,7 @@ void AUTCharacter::SpawnBloodDecal(const FVector& TraceStart, const FVector& Tra
 				FHitResult Hit;
 				if (GetWorld()->LineTraceSingleByChannel(Hit, TraceStart, TraceStart + TraceDir * (GetCapsuleComponent()->GetUnscaledCapsuleRadius() + 200.0f), ECC_Visibility, FCollisionQueryParams(NAME_BloodDecal, false, this)) && Hit.Component->bReceivesDecals)
 				{
-					UDecalComponent* Decal = NewObject<UDecalComponent>(GetWorld(), UDecalComponent::StaticClass());
+					UDecalComponent* Decal = Settings->NewDecal();
 					if (Hit.Component.Get() != NULL && Hit.Component->Mobility == EComponentMobility::Movable)
 					{
 						Decal->SetAbsolute(false, false, true);
@@ -1511,11 +1599,20 @@ void AUTCharacter::SpawnGib(FName BoneName, TSubclassOf<UUTDamageType> DmgType)
 	if (GibClass != NULL)
 	{
 		FTransform SpawnPos = GetMesh()->GetSocketTransform(BoneName);
-		FActorSpawnParameters Params;
-		Params.bNoCollisionFail = true;
-		Params.Instigator = this;
-		Params.Owner = this;
-		AUTGib* Gib = GetWorld()->SpawnActor<AUTGib>(GibClass, SpawnPos.GetLocation(), SpawnPos.Rotator(), Params);
+		AUTGib* Gib = NULL;
+		AUTWorldSettings* Settings = Cast<AUTWorldSettings>(GetWorldSettings());
+		if (Settings != NULL)
+		{
+			Gib = Settings->SpawnGib(GibClass, SpawnPos.GetLocation(), SpawnPos.Rotator(), this);
+		}
+		else
+		{
+			FActorSpawnParameters Params;
+			Params.bNoCollisionFail = true;
+			Params.Instigator = this;
+			Params.Owner = this;
+			Gib = GetWorld()->SpawnActor<AUTGib>(GibClass, SpawnPos.GetLocation(), SpawnPos.Rotator(), Params);
+		}
 		if (Gib != NULL)
 		{
 			Gib->BloodDecals = BloodDecals;
@@ -8,6 +8,7 @@
 #include "UTWaterVolume.h"
 #include "UTBot.h"
 #include "StatNames.h"
+#include "ServerFrameTelemetry.h"
 
 const float MAX_STEP_SIDE_Z = 0.08f;	// maximum z value for the normal on the vertical side of steps
 
@@ -415,6 +416,8 @@ void UUTCharacterMovement::AdjustMovementTimers(float Adjustment)
 
 void UUTCharacterMovement::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
+	SCOPE_SERVER_FRAME_TIMER(CharacterMovement);
+
 	AUTCharacter* UTOwner = Cast<AUTCharacter>(CharacterOwner);
 	UMovementComponent::TickComponent(DeltaTime, TickType, ThisTickFunction);
 	bool bOwnerIsRagdoll = UTOwner && UTOwner->IsRagdoll();
@@ -29,6 +29,10 @@
 #include "UTCarriedObject.h"
 #include "UTCharacterContent.h"
 #include "UTImpactEffect.h"
+#include "UTProjectileTickBenchmark.h"
+#include "UTEffectPoolBenchmark.h"
+#include "UTRecastNavMesh.h"
+#include "UTAggregatedTickTest.h"
 
 UUTCheatManager::UUTCheatManager(const class FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -202,6 +206,180 @@ void UUTCheatManager::ImpartEyewear(const FString& Eyewear)
 	}
 }
 
+void UUTCheatManager::ProjectileTickBenchmark(int32 NumProjectiles, float PhaseSeconds)
+{
+	APlayerController* PC = GetOuterAPlayerController();
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		PC->ClientMessage(TEXT("ProjectileTickBenchmark needs to run in a standalone game or on a listen server"));
+		return;
+	}
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	FActorSpawnParameters Params;
+	Params.bNoCollisionFail = true;
+	AUTProjectileTickBenchmark* Benchmark = GetWorld()->SpawnActor<AUTProjectileTickBenchmark>(AUTProjectileTickBenchmark::StaticClass(), ViewLocation + ViewRotation.Vector() * 500.0f, FRotator::ZeroRotator, Params);
+	if (Benchmark != NULL)
+	{
+		if (NumProjectiles > 0)
+		{
+			Benchmark->NumProjectiles = NumProjectiles;
+		}
+		if (PhaseSeconds > 0.0f)
+		{
+			Benchmark->PhaseSeconds = PhaseSeconds;
+		}
+		Benchmark->ReportTo = PC;
+		Benchmark->StartBenchmark();
+	}
+}
+
+void UUTCheatManager::EffectPoolBenchmark(int32 EffectsPerFrame, float PhaseSeconds)
+{
+	APlayerController* PC = GetOuterAPlayerController();
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		PC->ClientMessage(TEXT("EffectPoolBenchmark needs to run in a standalone game or on a listen server"));
+		return;
+	}
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	FActorSpawnParameters Params;
+	Params.bNoCollisionFail = true;
+	AUTEffectPoolBenchmark* Benchmark = GetWorld()->SpawnActor<AUTEffectPoolBenchmark>(AUTEffectPoolBenchmark::StaticClass(), ViewLocation + ViewRotation.Vector() * 500.0f, FRotator::ZeroRotator, Params);
+	if (Benchmark != NULL)
+	{
+		// use the player's own gibs and blood so the benchmark spawns what a real game does
+		AUTCharacter* UTC = Cast<AUTCharacter>(PC->GetPawn());
+		if (UTC != NULL)
+		{
+			if (UTC->GibClass != NULL)
+			{
+				Benchmark->GibClass = UTC->GibClass;
+			}
+			if (UTC->BloodDecals.Num() > 0)
+			{
+				Benchmark->DecalInfo = UTC->BloodDecals[0];
+			}
+		}
+		if (EffectsPerFrame > 0)
+		{
+			Benchmark->EffectsPerFrame = EffectsPerFrame;
+		}
+		if (PhaseSeconds > 0.0f)
+		{
+			Benchmark->PhaseSeconds = PhaseSeconds;
+		}
+		Benchmark->ReportTo = PC;
+		Benchmark->StartBenchmark();
+	}
+}
+
+/** only accepts the given pickups */
+struct FTestInventoryFieldEval : public FBestInventoryEval
+{
+	TArray<AActor*> AllowedPickups;
+
+	virtual bool AllowPickup(APawn* Asker, AActor* Pickup, float Desireability, float PickupDist) override
+	{
+		return AllowedPickups.Contains(Pickup);
+	}
+
+	FTestInventoryFieldEval(float InMoveSpeed)
+		: FBestInventoryEval(0.0f, InMoveSpeed)
+	{}
+};
+
+void UUTCheatManager::TestInventoryField()
+{
+	APlayerController* PC = GetOuterAPlayerController();
+	APawn* P = PC->GetPawn();
+	AUTRecastNavMesh* NavData = GetUTNavData(GetWorld());
+	if (P == NULL || NavData == NULL || !NavData->GetInventoryField().IsInitialized())
+	{
+		PC->ClientMessage(TEXT("TestInventoryField needs a pawn and a map with pickups on the navmesh in a standalone game or on a listen server"));
+		return;
+	}
+	const FUTInventoryField& Field = NavData->GetInventoryField();
+	const UUTPathNode* StartNode = NavData->GetNodeFromPoly(NavData->FindAnchorPoly(P->GetNavAgentLocation(), P, P->GetNavAgentPropertiesRef()));
+	if (StartNode == NULL || StartNode->InventoryField.Num() < Field.GetNumTypes())
+	{
+		PC->ClientMessage(TEXT("TestInventoryField: not on the navmesh"));
+		return;
+	}
+	const float MoveSpeed = (Cast<ACharacter>(P) != NULL) ? ((ACharacter*)P)->GetCharacterMovement()->MaxWalkSpeed : GetDefault<AUTCharacter>()->GetCharacterMovement()->MaxWalkSpeed;
+
+	int32 NumTested = 0;
+	int32 NumFailed = 0;
+	for (int32 Type = 0; Type < Field.GetNumTypes(); Type++)
+	{
+		// block the nearest pickup of this type and allow the others that are available
+		const int32 NearestSource = StartNode->InventoryField[Type].Source;
+		if (NearestSource == INDEX_NONE || !Field.GetSource(NearestSource).Pickup.IsValid())
+		{
+			continue;
+		}
+		AUTPickup* Blocked = Field.GetSource(NearestSource).Pickup.Get();
+		FTestInventoryFieldEval NodeEval(MoveSpeed);
+		for (const FUTInventoryField::FSource& Source : Field.GetSources())
+		{
+			AUTPickup* Pickup = Source.Pickup.Get();
+			if (Pickup != NULL && Pickup != Blocked && Source.bAvailable && Source.Type == Type && Pickup->BotDesireability(P, 1.0f) > 0.0f)
+			{
+				NodeEval.AllowedPickups.Add(Pickup);
+			}
+		}
+		if (NodeEval.AllowedPickups.Num() == 0)
+		{
+			continue;
+		}
+		NumTested++;
+
+		// whatever the field can't answer itself the full search does, same as AUTBot::FindInventoryGoal()
+		TArray<FRouteCacheItem> Route;
+		float Weight = 0.0f;
+		bool bNeedFullSearch = false;
+		bool bFound = NavData->FindInventoryFieldPath(P, P->GetNavAgentPropertiesRef(), NodeEval, P->GetNavAgentLocation(), Weight, Route, bNeedFullSearch);
+		if (!bFound && bNeedFullSearch)
+		{
+			Weight = 0.0f;
+			bFound = NavData->FindBestPath(P, P->GetNavAgentPropertiesRef(), NodeEval, P->GetNavAgentLocation(), Weight, false, Route);
+		}
+		if (!bFound || NodeEval.BestPickup == NULL || NodeEval.BestPickup == Blocked)
+		{
+			NumFailed++;
+			PC->ClientMessage(FString::Printf(TEXT("TestInventoryField: FAILED with %s blocked, %s"), *Blocked->GetName(), bFound ? TEXT("got the blocked pickup") : TEXT("nothing found")));
+		}
+	}
+	PC->ClientMessage(FString::Printf(TEXT("TestInventoryField: %d of %d pickup types found a further pickup when the nearest was blocked"), NumTested - NumFailed, NumTested));
+}
+
+void UUTCheatManager::TestAggregatedTickOrder()
+{
+	APlayerController* PC = GetOuterAPlayerController();
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		PC->ClientMessage(TEXT("TestAggregatedTickOrder needs to run in a standalone game or on a listen server"));
+		return;
+	}
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	FActorSpawnParameters Params;
+	Params.bNoCollisionFail = true;
+	AUTAggregatedTickTest* Test = GetWorld()->SpawnActor<AUTAggregatedTickTest>(AUTAggregatedTickTest::StaticClass(), ViewLocation + ViewRotation.Vector() * 300.0f, FRotator::ZeroRotator, Params);
+	if (Test != NULL)
+	{
+		Test->ReportTo = PC;
+		Test->StartTest();
+	}
+}
+
 void UUTCheatManager::BugItWorker(FVector TheLocation, FRotator TheRotation)
 {
 	Super::BugItWorker(TheLocation, TheRotation);
@@ -3,6 +3,7 @@
 #include "UTDamageType.h"
 #include "UTAnnouncer.h"
 #include "UTTimedPowerup.h"
+#include "UTStatRegistry.h"
 
 UUTDamageType::UUTDamageType(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -22,6 +23,8 @@ UUTDamageType::UUTDamageType(const FObjectInitializer& ObjectInitializer)
 	bBlockedByArmor = true;
 	RewardAnnouncementClass = NULL;
 	WeaponSpreeCount = 15;
+	KillStatsIndex = INDEX_NONE;
+	DeathStatsIndex = INDEX_NONE;
 
 	static ConstructorHelpers::FObjectFinder<UCurveLinearColor> DefaultFlash(TEXT("CurveLinearColor'/Game/RestrictedAssets/Effects/RedHitFlash.RedHitFlash'"));
 	BodyDamageColor = DefaultFlash.Object;
@@ -142,3 +145,42 @@ void UUTDamageType::PrecacheAnnouncements(UUTAnnouncer* Announcer) const
 {
 	Announcer->PrecacheAnnouncement(SpreeSoundName);
 }
+
+void UUTDamageType::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		UpdateStatsIndices();
+	}
+}
+
+void UUTDamageType::PostLoad()
+{
+	Super::PostLoad();
+
+	// blueprint damage types only have their StatsName once loaded
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		UpdateStatsIndices();
+	}
+}
+
+void UUTDamageType::UpdateStatsIndices() const
+{
+	if (StatsName != StatsIndicesName)
+	{
+		StatsIndicesName = StatsName;
+		if (StatsName.IsEmpty())
+		{
+			KillStatsIndex = INDEX_NONE;
+			DeathStatsIndex = INDEX_NONE;
+		}
+		else
+		{
+			KillStatsIndex = FUTStatRegistry::RegisterStat(FName(*(StatsName + TEXT("Kills"))));
+			DeathStatsIndex = FUTStatRegistry::RegisterStat(FName(*(StatsName + TEXT("Deaths"))));
+		}
+	}
+}
@@ -0,0 +1,212 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTGib.h"
+#include "UTWorldSettings.h"
+#include "UTEffectPoolBenchmark.h"
+#include "ServerFrameTelemetry.h"
+
+AUTEffectPoolBenchmark::AUTEffectPoolBenchmark(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = true;
+	GibClass = AUTGib::StaticClass();
+	EffectsPerFrame = 4;
+	PhaseSeconds = 10.0f;
+	SpawnRadius = 1000.0f;
+	Phase = PHASE_Done;
+	bWaitingForGC = false;
+	GibSeconds = 0.0;
+	DecalSeconds = 0.0;
+	StartGibsSpawned = 0;
+	StartGibsReused = 0;
+	StartDecalsCreated = 0;
+	StartDecalsReused = 0;
+	PoolingOffCostMs = 0.0f;
+	bSavedSettings = false;
+}
+
+void AUTEffectPoolBenchmark::StartBenchmark()
+{
+	IConsoleManager& ConsoleManager = IConsoleManager::Get();
+	IConsoleVariable* TelemetryEnable = ConsoleManager.FindConsoleVariable(TEXT("ServerTelemetry.Enable"));
+	IConsoleVariable* TelemetryWindowSeconds = ConsoleManager.FindConsoleVariable(TEXT("ServerTelemetry.WindowSeconds"));
+	IConsoleVariable* EffectPooling = ConsoleManager.FindConsoleVariable(TEXT("ut.EffectPooling"));
+	if (GibClass == NULL || Cast<AUTWorldSettings>(GetWorldSettings()) == NULL || TelemetryEnable == NULL || TelemetryWindowSeconds == NULL || EffectPooling == NULL)
+	{
+		Report(TEXT("EffectPoolBenchmark: missing gib class, UT world settings or console variables"));
+		Destroy();
+		return;
+	}
+	SavedTelemetryEnable = TelemetryEnable->GetInt();
+	SavedTelemetryWindowSeconds = TelemetryWindowSeconds->GetFloat();
+	SavedEffectPooling = EffectPooling->GetInt();
+	bSavedSettings = true;
+
+	// always gather, and only close windows when a phase ends
+	TelemetryEnable->Set(2);
+	TelemetryWindowSeconds->Set(PhaseSeconds * 10.0f);
+
+	Report(FString::Printf(TEXT("EffectPoolBenchmark: %d x %s and %d decals per frame, %.0f seconds per phase"), EffectsPerFrame, *GibClass->GetName(), EffectsPerFrame, PhaseSeconds));
+	StartPhase(PHASE_WarmUp);
+}
+
+void AUTEffectPoolBenchmark::StartPhase(EPhase NewPhase)
+{
+	AUTWorldSettings* Settings = Cast<AUTWorldSettings>(GetWorldSettings());
+	Phase = NewPhase;
+	PhaseEndTime = GetWorld()->RealTimeSeconds + PhaseSeconds;
+	bWaitingForGC = false;
+	GibSeconds = 0.0;
+	DecalSeconds = 0.0;
+	StartGibsSpawned = Settings->NumGibsSpawned;
+	StartGibsReused = Settings->NumGibsReused;
+	StartDecalsCreated = Settings->NumDecalsCreated;
+	StartDecalsReused = Settings->NumDecalsReused;
+	IConsoleManager::Get().FindConsoleVariable(TEXT("ut.EffectPooling"))->Set(Phase == PHASE_PoolingOff ? 0 : 1);
+	// throw away whatever was gathered before the phase
+	FServerFrameTelemetry::Get().FlushWindow();
+}
+
+void AUTEffectPoolBenchmark::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Phase == PHASE_Done)
+	{
+		return;
+	}
+	SpawnEffects();
+
+	if (bWaitingForGC)
+	{
+		// the collection forced last frame is in this phase's window now
+		EndPhase();
+	}
+	else if (GetWorld()->RealTimeSeconds >= PhaseEndTime)
+	{
+		if (Phase == PHASE_WarmUp)
+		{
+			EndPhase();
+		}
+		else
+		{
+			// effects destroyed without pooling are only freed by the next collection, so make it part of the phase
+			GetWorld()->ForceGarbageCollection(true);
+			bWaitingForGC = true;
+		}
+	}
+}
+
+void AUTEffectPoolBenchmark::EndPhase()
+{
+	switch (Phase)
+	{
+		case PHASE_WarmUp:
+			StartPhase(PHASE_PoolingOff);
+			break;
+		case PHASE_PoolingOff:
+			FServerFrameTelemetry::Get().FlushWindow();
+			ReportPhase(TEXT("pool off"));
+			StartPhase(PHASE_PoolingOn);
+			break;
+		default:
+			FServerFrameTelemetry::Get().FlushWindow();
+			ReportPhase(TEXT("pool on"));
+			Phase = PHASE_Done;
+			Destroy();
+			break;
+	}
+}
+
+void AUTEffectPoolBenchmark::SpawnEffects()
+{
+	AUTWorldSettings* Settings = Cast<AUTWorldSettings>(GetWorldSettings());
+	for (int32 i = 0; i < EffectsPerFrame; i++)
+	{
+		// short lifespans so gibs go back to the pool (or are destroyed) about as fast as they come in
+		const FVector GibLocation = GetActorLocation() + FMath::VRand() * FMath::FRandRange(0.0f, SpawnRadius);
+		double StartTime = FPlatformTime::Seconds();
+		AUTGib* Gib = Settings->SpawnGib(GibClass, GibLocation, FRotator(FMath::FRandRange(0.0f, 360.0f), FMath::FRandRange(0.0f, 360.0f), 0.0f), NULL);
+		GibSeconds += FPlatformTime::Seconds() - StartTime;
+		if (Gib != NULL)
+		{
+			Gib->SetLifeSpan(FMath::FRandRange(0.5f, 1.5f));
+		}
+
+		// set up like AUTCharacter::SpawnBloodDecal(); the impact effect budget expires them
+		const FVector DecalLocation = GetActorLocation() + FVector(FMath::FRandRange(-SpawnRadius, SpawnRadius), FMath::FRandRange(-SpawnRadius, SpawnRadius), 0.0f);
+		StartTime = FPlatformTime::Seconds();
+		UDecalComponent* Decal = Settings->NewDecal();
+		Decal->SetAbsolute(true, true, true);
+		FVector2D DecalScale = DecalInfo.BaseScale * FMath::FRandRange(DecalInfo.ScaleMultRange.X, DecalInfo.ScaleMultRange.Y);
+		Decal->SetWorldScale3D(FVector(1.0f, DecalScale.X, DecalScale.Y));
+		Decal->SetWorldLocation(DecalLocation);
+		Decal->SetWorldRotation(FRotator(-90.0f, 0.0f, 360.0f * FMath::FRand()));
+		Decal->SetDecalMaterial(DecalInfo.Material);
+		Decal->RegisterComponentWithWorld(GetWorld());
+		Settings->AddImpactEffect(Decal);
+		DecalSeconds += FPlatformTime::Seconds() - StartTime;
+	}
+}
+
+void AUTEffectPoolBenchmark::ReportPhase(const TCHAR* Title)
+{
+	const FServerFrameTelemetry::FWindow* Window = FServerFrameTelemetry::Get().GetLastWindow();
+	AUTWorldSettings* Settings = Cast<AUTWorldSettings>(GetWorldSettings());
+	if (Window == NULL || Settings == NULL)
+	{
+		return;
+	}
+	const uint32 GibsSpawned = Settings->NumGibsSpawned - StartGibsSpawned;
+	const uint32 GibsReused = Settings->NumGibsReused - StartGibsReused;
+	const uint32 DecalsCreated = Settings->NumDecalsCreated - StartDecalsCreated;
+	const uint32 DecalsReused = Settings->NumDecalsReused - StartDecalsReused;
+	const uint32 NumGibs = GibsSpawned + GibsReused;
+	const uint32 NumDecals = DecalsCreated + DecalsReused;
+	const FServerFrameTelemetry::FHistogram& Frame = Window->Stats[EServerFrameStat::Frame];
+	const FServerFrameTelemetry::FHistogram& GC = Window->Stats[EServerFrameStat::GarbageCollection];
+	Report(FString::Printf(TEXT("EffectPoolBenchmark %-8s %5u frames  gibs %6u, %5.1f%% reused, avg %6.2fus each  decals %6u, %5.1f%% reused, avg %6.2fus each  spawning %6.2fms per frame  GC total %7.2fms max %6.2fms  Frame avg %6.2fms"),
+		Title, Frame.Count,
+		NumGibs, NumGibs ? GibsReused * 100.0f / NumGibs : 0.0f, NumGibs ? float(GibSeconds * 1000000.0 / NumGibs) : 0.0f,
+		NumDecals, NumDecals ? DecalsReused * 100.0f / NumDecals : 0.0f, NumDecals ? float(DecalSeconds * 1000000.0 / NumDecals) : 0.0f,
+		Frame.Count ? float((GibSeconds + DecalSeconds) * 1000.0 / Frame.Count) : 0.0f,
+		float(GC.TotalMs), GC.MaxMs,
+		Frame.Count ? float(Frame.TotalMs / Frame.Count) : 0.0f));
+
+	const float CostMs = Frame.Count ? float(((GibSeconds + DecalSeconds) * 1000.0 + GC.TotalMs) / Frame.Count) : 0.0f;
+	if (Phase == PHASE_PoolingOff)
+	{
+		PoolingOffCostMs = CostMs;
+	}
+	else
+	{
+		Report(FString::Printf(TEXT("EffectPoolBenchmark spawn + GC %6.3fms per frame off, %6.3fms on, pooling saves %6.3fms per frame"), PoolingOffCostMs, CostMs, PoolingOffCostMs - CostMs));
+	}
+}
+
+void AUTEffectPoolBenchmark::Report(const FString& Line)
+{
+	UE_LOG(UT, Log, TEXT("%s"), *Line);
+	if (ReportTo != NULL)
+	{
+		ReportTo->ClientMessage(Line);
+	}
+}
+
+void AUTEffectPoolBenchmark::RestoreSettings()
+{
+	if (bSavedSettings)
+	{
+		bSavedSettings = false;
+		IConsoleManager& ConsoleManager = IConsoleManager::Get();
+		ConsoleManager.FindConsoleVariable(TEXT("ServerTelemetry.Enable"))->Set(SavedTelemetryEnable);
+		ConsoleManager.FindConsoleVariable(TEXT("ServerTelemetry.WindowSeconds"))->Set(SavedTelemetryWindowSeconds);
+		ConsoleManager.FindConsoleVariable(TEXT("ut.EffectPooling"))->Set(SavedEffectPooling);
+	}
+}
+
+void AUTEffectPoolBenchmark::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	RestoreSettings();
+	Super::EndPlay(EndPlayReason);
+}
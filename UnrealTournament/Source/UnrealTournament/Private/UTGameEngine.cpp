@@ -2,6 +2,7 @@
 #include "UnrealTournament.h"
 #include "UTGameEngine.h"
 #include "UTAnalytics.h"
+#include "UTStatsUploader.h"
 #include "Runtime/Analytics/Analytics/Public/Analytics.h"
 #include "Runtime/Analytics/Analytics/Public/Interfaces/IAnalyticsProvider.h"
 
@@ -11,6 +12,7 @@
 #include "Runtime/Launch/Resources/Version.h"
 #include "Net/UnrealNetwork.h"
 #include "UTConsole.h"
+#include "Online.h"
 #if !UE_SERVER
 #include "SlateBasics.h"
 #include "MoviePlayer.h"
@@ -51,6 +53,7 @@ UUTGameEngine::UUTGameEngine(const FObjectInitializer& ObjectInitializer)
 	MaximumSmoothedTime = 0.04f;
 
 	ServerMaxPredictionPing = 160.f;
+	NextHostedWorldIndex = 1;
 
 #if !UE_SERVER
 	ConstructorHelpers::FObjectFinder<UClass> TutorialMenuFinder(TEXT("/Game/RestrictedAssets/Tutorials/Blueprints/TutMainMenuWidget.TutMainMenuWidget_C"));
@@ -87,6 +90,9 @@ void UUTGameEngine::Init(IEngineLoop* InEngineLoop)
 
 	Super::Init(InEngineLoop);
 
+	// start loading what earlier runs left in the stats spool now, so a restarted server retries them without waiting for a match to end
+	FUTStatsUploader::Get();
+
 
 	if (FUTAnalytics::IsAvailable())
 	{
@@ -131,6 +137,9 @@ void UUTGameEngine::PreExit()
 
 
 
+	// anything not sent yet stays in the spool for the next run
+	FUTStatsUploader::Shutdown();
+
 	Super::PreExit();
 	FUTAnalytics::Shutdown();
 }
@@ -246,6 +255,11 @@ bool UUTGameEngine::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Out)
 
 void UUTGameEngine::Tick(float DeltaSeconds, bool bIdleMode)
 {
+	if (PendingHostedMatches.Num() > 0 || HostedMatchesToStop.Num() > 0)
+	{
+		UpdateHostedMatches();
+	}
+
 	// HACK: make sure our default URL options are in all travel URLs since FURL code to do this was removed
 	for (int32 WorldIdx = 0; WorldIdx < WorldList.Num(); ++WorldIdx)
 	{
@@ -295,6 +309,125 @@ void UUTGameEngine::Tick(float DeltaSeconds, bool bIdleMode)
 	}
 }
 
+void UUTGameEngine::StartHostedMatch(const FString& MatchURL, int32 Port)
+{
+	PendingHostedMatches.Add(FPendingHostedMatch(MatchURL, Port));
+}
+
+void UUTGameEngine::StopHostedMatch(UWorld* MatchWorld)
+{
+	FWorldContext* Context = GetWorldContextFromWorld(MatchWorld);
+	if (Context != NULL && Context->HostedWorldIndex != INDEX_NONE)
+	{
+		HostedMatchesToStop.AddUnique(Context->ContextHandle);
+	}
+}
+
+bool UUTGameEngine::IsHostedMatchWorld(UWorld* World)
+{
+	FWorldContext* Context = GetWorldContextFromWorld(World);
+	return Context != NULL && Context->HostedWorldIndex != INDEX_NONE;
+}
+
+void UUTGameEngine::UpdateHostedMatches()
+{
+	UWorld* OriginalGWorld = GWorld;
+
+	TArray<FName> ContextsToStop = HostedMatchesToStop;
+	HostedMatchesToStop.Empty();
+	for (FName ContextHandle : ContextsToStop)
+	{
+		FWorldContext* Context = GetWorldContextFromHandle(ContextHandle);
+		if (Context != NULL)
+		{
+			DestroyHostedMatch(*Context);
+		}
+	}
+
+	TArray<FPendingHostedMatch> MatchesToStart = PendingHostedMatches;
+	PendingHostedMatches.Empty();
+	for (const FPendingHostedMatch& Match : MatchesToStart)
+	{
+		CreateHostedMatch(Match);
+	}
+
+	// loading maps changes GWorld
+	GWorld = OriginalGWorld;
+}
+
+void UUTGameEngine::CreateHostedMatch(const FPendingHostedMatch& Match)
+{
+	const uint64 MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+	UGameInstance* MatchInstance = NewObject<UGameInstance>(this, GameInstance->GetClass());
+	HostedMatchInstances.Add(MatchInstance);
+	MatchInstance->InitializeStandalone();
+
+	FWorldContext* Context = MatchInstance->GetWorldContext();
+	Context->HostedWorldIndex = NextHostedWorldIndex++;
+
+	FURL DefaultURL;
+	DefaultURL.LoadURLConfig(TEXT("DefaultPlayer"), GGameIni);
+	FURL URL(&DefaultURL, *Match.URL, TRAVEL_Partial);
+	URL.Port = Match.Port;
+
+	FString Error;
+	if (!URL.Valid || Browse(*Context, URL, Error) != EBrowseReturnVal::Success)
+	{
+		UE_LOG(UT, Warning, TEXT("Failed to start hosted match %s on port %i: %s"), *Match.URL, Match.Port, *Error);
+		DestroyHostedMatch(*Context);
+		return;
+	}
+
+	const uint64 MemoryAfter = FPlatformMemory::GetStats().UsedPhysical;
+	UE_LOG(UT, Log, TEXT("Started hosted match %s on port %i, %i hosted matches running.  Process memory went from %.1fMB to %.1fMB (%+.1fMB)."),
+		*Match.URL, Match.Port, HostedMatchInstances.Num(), MemoryBefore / 1048576.0, MemoryAfter / 1048576.0, (double(MemoryAfter) - double(MemoryBefore)) / 1048576.0);
+}
+
+void UUTGameEngine::DestroyHostedMatch(FWorldContext& Context)
+{
+	const FName ContextHandle = Context.ContextHandle;
+	UGameInstance* MatchInstance = Context.OwningGameInstance;
+	UWorld* World = Context.World();
+	if (World != NULL)
+	{
+		UE_LOG(UT, Log, TEXT("Shutting down hosted match %s"), *World->GetMapName());
+
+		World->bIsTearingDown = true;
+		ShutdownWorldNetDriver(World);
+
+		for (FActorIterator ActorIt(World); ActorIt; ++ActorIt)
+		{
+			ActorIt->RouteEndPlay(EEndPlayReason::LevelTransition);
+		}
+	}
+	if (MatchInstance != NULL)
+	{
+		MatchInstance->Shutdown();
+		HostedMatchInstances.Remove(MatchInstance);
+	}
+	if (World != NULL)
+	{
+		World->CleanupWorld();
+		WorldDestroyed(World);
+		World->RemoveFromRoot();
+	}
+	for (int32 i = 0; i < WorldList.Num(); i++)
+	{
+		if (WorldList[i].ContextHandle == ContextHandle)
+		{
+			WorldList[i].SetCurrentWorld(NULL);
+			WorldList.RemoveAt(i);
+			break;
+		}
+	}
+
+	// the match had its own online subsystem instance, see Online::GetSubsystem()
+	IOnlineSubsystem::Destroy(FName(*FString::Printf(TEXT(":%s"), *ContextHandle.ToString())));
+
+	ForceGarbageCollection(true);
+}
+
 EBrowseReturnVal::Type UUTGameEngine::Browse( FWorldContext& WorldContext, FURL URL, FString& Error )
 {
 	UUTLocalPlayer* UTLocalPlayer = Cast<UUTLocalPlayer>(GetLocalPlayerFromControllerId(WorldContext.World(),0));
@@ -36,6 +36,8 @@
 #include "UTWeap_Enforcer.h"
 #include "Engine/DemoNetDriver.h"
 #include "EngineBuildSettings.h"
+#include "UTBotMatchBenchmark.h"
+#include "UTSimulatedNetConnection.h"
 
 UUTResetInterface::UUTResetInterface(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -103,6 +105,12 @@ AUTGameMode::AUTGameMode(const class FObjectInitializer& ObjectInitializer)
 	LobbyInstanceID = 0;
 	DemoFilename = TEXT("%m-%td");
 	bDedicatedInstance = false;
+	bPooledInstance = false;
+	bFixedBotSkill = false;
+	SimulatedClientCount = 0;
+	SimulatedClientLatency = 60;
+	SimulatedClientLoss = 0;
+	NextSimulatedClientIndex = 0;
 
 	MapVoteTime = 30;
 
@@ -188,6 +196,11 @@ void AUTGameMode::InitGame( const FString& MapName, const FString& Options, FStr
 	InOpt = ParseOption(Options, TEXT("HubKey"));
 	if (!InOpt.IsEmpty()) HubKey = InOpt;
 
+	bPooledInstance = HasOption(Options, TEXT("PoolIdle"));
+
+	InOpt = ParseOption(Options, TEXT("FixedBotSkill"));
+	bFixedBotSkill = EvalBoolOptions(InOpt, bFixedBotSkill);
+
 	// alias for testing convenience
 	if (HasOption(Options, TEXT("Bots")))
 	{
@@ -201,6 +214,28 @@ void AUTGameMode::InitGame( const FString& MapName, const FString& Options, FStr
 	InOpt = ParseOption(Options, TEXT("CasterControl"));
 	bCasterControl = EvalBoolOptions(InOpt, bCasterControl);
 
+	SimulatedClientCount = FMath::Max(0, GetIntOption(Options, TEXT("SimClients"), SimulatedClientCount));
+	SimulatedClientLatency = FMath::Max(0, GetIntOption(Options, TEXT("SimLatency"), SimulatedClientLatency));
+	SimulatedClientLoss = FMath::Clamp(GetIntOption(Options, TEXT("SimLoss"), SimulatedClientLoss), 0, 100);
+
+	float BenchmarkSeconds = 0.0f;
+	if (AUTBotMatchBenchmark::WantsBenchmark(BenchmarkSeconds))
+	{
+		// start with the bots right away and keep playing until the benchmark ends the process
+		bFixedBotSkill = true;
+		bDelayedStart = false;
+		TimeLimit = 0;
+		GoalScore = 0;
+		FActorSpawnParameters Params;
+		Params.Owner = this;
+		BotMatchBenchmark = GetWorld()->SpawnActor<AUTBotMatchBenchmark>(AUTBotMatchBenchmark::StaticClass(), Params);
+		if (BotMatchBenchmark != NULL)
+		{
+			BotMatchBenchmark->MeasureSeconds = BenchmarkSeconds;
+			BotMatchBenchmark->StartBenchmark();
+		}
+	}
+
 	for (int32 i = 0; i < BuiltInMutators.Num(); i++)
 	{
 		AddMutatorClass(BuiltInMutators[i]);
@@ -598,7 +633,7 @@ AUTBot* AUTGameMode::AddBot(uint8 TeamNum)
 				NewBot->CharacterData = BotData;
 				NewBot->Personality = BotData->Personality;
 				SetUniqueBotName(NewBot, BotData);
-				NewBot->InitializeSkill(BotData->Skill);
+				NewBot->InitializeSkill(bFixedBotSkill ? GameDifficulty : BotData->Skill);
 				AUTPlayerState* PS = Cast<AUTPlayerState>(NewBot->PlayerState);
 				if (PS != NULL)
 				{
@@ -683,7 +718,7 @@ AUTBot* AUTGameMode::AddNamedBot(const FString& BotName, uint8 TeamNum)
 				PS->ServerReceiveEyewearVariant(BotData->EyewearVariantId);
 			}
 
-			NewBot->InitializeSkill(BotData->Skill);
+			NewBot->InitializeSkill(bFixedBotSkill ? GameDifficulty : BotData->Skill);
 			NumBots++;
 			ChangeTeam(NewBot, TeamNum);
 			GenericPlayerInitialization(NewBot);
@@ -715,7 +750,7 @@ AUTBot* AUTGameMode::AddAssetBot(const FStringAssetReference& BotAssetPath, uint
 				PS->ServerReceiveEyewearVariant(BotData->EyewearVariantId);
 			}
 
-			NewBot->InitializeSkill(BotData->Skill);
+			NewBot->InitializeSkill(bFixedBotSkill ? GameDifficulty : BotData->Skill);
 			NumBots++;
 			ChangeTeam(NewBot, TeamNum);
 			GenericPlayerInitialization(NewBot);
@@ -791,6 +826,45 @@ void AUTGameMode::KillBots()
 	}
 }
 
+void AUTGameMode::SetSimulatedClients(int32 NewCount)
+{
+	SimulatedClientCount = FMath::Max(0, NewCount);
+	CheckSimulatedClients();
+}
+
+void AUTGameMode::CheckSimulatedClients()
+{
+	// the net driver only exists once the server is listening
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver == NULL || !NetDriver->IsServer())
+	{
+		return;
+	}
+	TArray<UUTSimulatedNetConnection*> SimulatedConnections;
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		UUTSimulatedNetConnection* SimulatedConnection = Cast<UUTSimulatedNetConnection>(Connection);
+		if (SimulatedConnection != NULL && SimulatedConnection->State != USOCK_Closed)
+		{
+			SimulatedConnection->CheckInGame();
+			SimulatedConnections.Add(SimulatedConnection);
+		}
+	}
+	while (SimulatedConnections.Num() > SimulatedClientCount)
+	{
+		SimulatedConnections.Pop()->Close();
+	}
+	for (int32 i = SimulatedConnections.Num(); i < SimulatedClientCount; i++)
+	{
+		if (UUTSimulatedNetConnection::AddSimulatedClient(NetDriver, NextSimulatedClientIndex++, SimulatedClientLatency, SimulatedClientLoss) == NULL)
+		{
+			// e.g. the server is full, don't keep trying
+			SimulatedClientCount = i;
+			break;
+		}
+	}
+}
+
 bool AUTGameMode::AllowRemovingBot(AUTBot* B)
 {
 	AUTPlayerState* PS = Cast<AUTPlayerState>(B->PlayerState);
@@ -899,9 +973,18 @@ void AUTGameMode::DefaultTimer()
 		// if the server is empty and would be asking the hub to kill it, just kill ourselves rather than waiting for reconnection
 		// this relies on there being good monitoring and cleanup code in the hub, but it's better than some kind of network port failure leaving an instance spamming connection attempts forever
 		// also handles the hub itself failing
-		if (!bDedicatedInstance && NumPlayers <= 0 && MatchState != MatchState::WaitingToStart)
+		if ((!bDedicatedInstance && NumPlayers <= 0 && MatchState != MatchState::WaitingToStart) || bPooledInstance)
 		{
-			FPlatformMisc::RequestExit(false);
+			// a match hosted next to others in the same process only takes itself down
+			UUTGameEngine* UTEngine = Cast<UUTGameEngine>(GEngine);
+			if (UTEngine != NULL && UTEngine->IsHostedMatchWorld(GetWorld()))
+			{
+				UTEngine->StopHostedMatch(GetWorld());
+			}
+			else
+			{
+				FPlatformMisc::RequestExit(false);
+			}
 			return;
 		}
 
@@ -929,11 +1012,19 @@ void AUTGameMode::DefaultTimer()
 		}
 	}
 
+	CheckSimulatedClients();
 	CheckBotCount();
 
+	// trace visibility between player starts ahead of time, a few at a time
+	SpawnRatingCache.Update(GetWorld());
+
 	int32 NumPlayers = GetNumPlayers();
 
-	if (IsGameInstanceServer() && LobbyBeacon)
+	if (IsGameInstanceServer() && LobbyBeacon && bPooledInstance)
+	{
+		// Idle in the hub's pool, there is no match to report on or time out until the hub gives us one
+	}
+	else if (IsGameInstanceServer() && LobbyBeacon)
 	{
 		if (GetWorld()->GetTimeSeconds() - LastLobbyUpdateTime >= 10.0f) // MAKE ME CONIFG!!!!
 		{
@@ -965,7 +1056,7 @@ void AUTGameMode::DefaultTimer()
 	else
 	{
 		// Look to see if we should restart the game due to server inactivity
-		if (GetNumPlayers() <= 0 && NumSpectators <= 0 && HasMatchStarted())
+		if (GetNumPlayers() <= 0 && NumSpectators <= 0 && HasMatchStarted() && BotMatchBenchmark == NULL)
 		{
 			EmptyServerTime++;
 			if (EmptyServerTime >= AutoRestartTime)
@@ -1536,7 +1627,7 @@ void AUTGameMode::SendEndOfGameStats(FName Reason)
 		}
 
 		const double CloudStatsTime = FPlatformTime::Seconds() - CloudStatsStartTime;
-		UE_LOG(UT, Verbose, TEXT("Cloud stats write time %.3f"), CloudStatsTime);
+		UE_LOG(UT, Log, TEXT("Cloud stats write time %.3f"), CloudStatsTime);
 	}
 
 	AwardProfileItems();
@@ -1589,6 +1680,8 @@ void AUTGameMode::EndGame(AUTPlayerState* Winner, FName Reason )
 	// Dont ever end the game in PIE
 	if (GetWorld()->WorldType == EWorldType::PIE) return;
 
+	const double EndGameStartTime = FPlatformTime::Seconds();
+
 	// If we don't have a winner, then go and find one
 	if (Winner == NULL)
 	{
@@ -1636,6 +1729,9 @@ void AUTGameMode::EndGame(AUTPlayerState* Winner, FName Reason )
 	SendEndOfGameStats(Reason);
 
 	EndMatch();
+
+	// the end of match frame is where stats gathering used to hitch, keep an eye on it
+	UE_LOG(UT, Log, TEXT("EndGame took %.2f ms of the end of match frame"), (FPlatformTime::Seconds() - EndGameStartTime) * 1000.0);
 }
 
 void AUTGameMode::StopReplayRecording()
@@ -1847,6 +1943,9 @@ void AUTGameMode::RestartPlayer(AController* aPlayer)
 		((AUTPlayerController*)aPlayer)->ClientSwitchToBestWeapon();
 	}
 
+	// a new pawn, the spawn rating grid has to pick it up
+	SpawnRatingCache.InvalidatePawns();
+
 	// clear spawn choices
 	Cast<AUTPlayerState>(aPlayer->PlayerState)->RespawnChoiceA = nullptr;
 	Cast<AUTPlayerState>(aPlayer->PlayerState)->RespawnChoiceB = nullptr;
@@ -2084,75 +2183,83 @@ float AUTGameMode::RatePlayerStart(APlayerStart* P, AController* Player)
 	if (Player != NULL)
 	{
 		bool bTwoPlayerGame = (NumPlayers + NumBots == 2);
-		for (FConstControllerIterator Iterator = GetWorld()->GetControllerIterator(); Iterator; ++Iterator)
+		if (bHasRespawnChoices)
 		{
-			AController* OtherController = *Iterator;
-			ACharacter* OtherCharacter = Cast<ACharacter>( OtherController->GetPawn());
-
-			if ( OtherCharacter && OtherCharacter->PlayerState )
+			for (FConstControllerIterator Iterator = GetWorld()->GetControllerIterator(); Iterator; ++Iterator)
 			{
-				if (FMath::Abs(StartLoc.Z - OtherCharacter->GetActorLocation().Z) < P->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + OtherCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()
-					&& (StartLoc - OtherCharacter->GetActorLocation()).Size2D() < P->GetCapsuleComponent()->GetScaledCapsuleRadius() + OtherCharacter->GetCapsuleComponent()->GetScaledCapsuleRadius())
+				AController* OtherController = *Iterator;
+				if (OtherController->PlayerState && !OtherController->GetPawn() && !OtherController->PlayerState->bOnlySpectator)
 				{
-					// overlapping - would telefrag
-					return -10.f;
-				}
-
-				float NextDist = (OtherCharacter->GetActorLocation() - StartLoc).Size();
-				static FName NAME_RatePlayerStart = FName(TEXT("RatePlayerStart"));
-				bool bIsLastKiller = (OtherCharacter->PlayerState == Cast<AUTPlayerState>(Player->PlayerState)->LastKillerPlayerState);
-
-				if (((NextDist < 8000.0f) || bTwoPlayerGame) && !UTGameState->OnSameTeam(Player, OtherController))
-				{
-					if (!GetWorld()->LineTraceTestByChannel(StartLoc, OtherCharacter->GetActorLocation() + FVector(0.f, 0.f, OtherCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()), ECC_Visibility, FCollisionQueryParams(NAME_RatePlayerStart, false)))
+					// make sure no one else has this start as a pending choice
+					AUTPlayerState* OtherUTPS = Cast<AUTPlayerState>(OtherController->PlayerState);
+					if (OtherUTPS)
 					{
-						// Avoid the last person that killed me
-						if (bIsLastKiller)
+						if (P == OtherUTPS->RespawnChoiceA || P == OtherUTPS->RespawnChoiceB)
 						{
-							Score -= 7.f;
+							return -5.f;
 						}
-
-						Score -= (5.f - 0.0003f * NextDist);
-					}
-					else if (NextDist < 4000.0f)
-					{
-						// Avoid the last person that killed me
-						Score -= bIsLastKiller ? 5.f : 0.0005f * (5000.f - NextDist);
-
-						if (!GetWorld()->LineTraceTestByChannel(StartLoc, OtherCharacter->GetActorLocation(), ECC_Visibility, FCollisionQueryParams(NAME_RatePlayerStart, false, this)))
+						if (bTwoPlayerGame)
 						{
-							Score -= 2.f;
+							// avoid choosing starts near a pending start
+							if (OtherUTPS->RespawnChoiceA)
+							{
+								float Dist = (OtherUTPS->RespawnChoiceA->GetActorLocation() - StartLoc).Size();
+								Score -= 7.f * FMath::Max(0.f, (5000.f - Dist) / 5000.f);
+							}
+							if (OtherUTPS->RespawnChoiceB)
+							{
+								float Dist = (OtherUTPS->RespawnChoiceB->GetActorLocation() - StartLoc).Size();
+								Score -= 7.f * FMath::Max(0.f, (5000.f - Dist) / 5000.f);
+							}
 						}
 					}
 				}
 			}
-			else if (bHasRespawnChoices && OtherController->PlayerState && !OtherController->GetPawn() && !OtherController->PlayerState->bOnlySpectator)
+		}
+
+		// only characters within 8000 matter unless it's just the two of us
+		TArray<ACharacter*> NearbyCharacters;
+		SpawnRatingCache.GetCharactersNear(GetWorld(), StartLoc, bTwoPlayerGame ? 0.f : 8000.f, NearbyCharacters);
+		for (ACharacter* OtherCharacter : NearbyCharacters)
+		{
+			AController* OtherController = OtherCharacter->Controller;
+			if (OtherController == NULL)
+			{
+				continue;
+			}
+			if (FMath::Abs(StartLoc.Z - OtherCharacter->GetActorLocation().Z) < P->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + OtherCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight()
+				&& (StartLoc - OtherCharacter->GetActorLocation()).Size2D() < P->GetCapsuleComponent()->GetScaledCapsuleRadius() + OtherCharacter->GetCapsuleComponent()->GetScaledCapsuleRadius())
 			{
-				// make sure no one else has this start as a pending choice
-				AUTPlayerState* OtherUTPS = Cast<AUTPlayerState>(OtherController->PlayerState);
-				if (OtherUTPS)
+				// overlapping - would telefrag
+				return -10.f;
+			}
+
+			float NextDist = (OtherCharacter->GetActorLocation() - StartLoc).Size();
+			bool bIsLastKiller = (OtherCharacter->PlayerState == Cast<AUTPlayerState>(Player->PlayerState)->LastKillerPlayerState);
+
+			if (((NextDist < 8000.0f) || bTwoPlayerGame) && !UTGameState->OnSameTeam(Player, OtherController))
+			{
+				if (SpawnRatingCache.IsVisible(GetWorld(), P, StartLoc, OtherCharacter->GetActorLocation() + FVector(0.f, 0.f, OtherCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight())))
 				{
-					if (P == OtherUTPS->RespawnChoiceA || P == OtherUTPS->RespawnChoiceB)
+					// Avoid the last person that killed me
+					if (bIsLastKiller)
 					{
-						return -5.f;
+						Score -= 7.f;
 					}
-					if (bTwoPlayerGame)
+
+					Score -= (5.f - 0.0003f * NextDist);
+				}
+				else if (NextDist < 4000.0f)
+				{
+					// Avoid the last person that killed me
+					Score -= bIsLastKiller ? 5.f : 0.0005f * (5000.f - NextDist);
+
+					if (SpawnRatingCache.IsVisible(GetWorld(), P, StartLoc, OtherCharacter->GetActorLocation()))
 					{
-						// avoid choosing starts near a pending start
-						if (OtherUTPS->RespawnChoiceA)
-						{
-							float Dist = (OtherUTPS->RespawnChoiceA->GetActorLocation() - StartLoc).Size();
-							Score -= 7.f * FMath::Max(0.f, (5000.f - Dist) / 5000.f);
-						}
-						if (OtherUTPS->RespawnChoiceB)
-						{
-							float Dist = (OtherUTPS->RespawnChoiceB->GetActorLocation() - StartLoc).Size();
-							Score -= 7.f * FMath::Max(0.f, (5000.f - Dist) / 5000.f);
-						}
+						Score -= 2.f;
 					}
 				}
 			}
-
 		}
 	}
 	return FMath::Max(Score, 0.2f);
@@ -3082,9 +3189,10 @@ void AUTGameMode::AssignDefaultSquadFor(AController* C)
 
 void AUTGameMode::NotifyLobbyGameIsReady()
 {
-	if (IsGameInstanceServer() && LobbyBeacon)
+	if (IsGameInstanceServer() && LobbyBeacon && !bPooledInstance)
 	{
 		LobbyBeacon->Lobby_NotifyInstanceIsReady(LobbyInstanceID, ServerInstanceGUID);
+		LobbyBeacon->ReportMemory(LobbyInstanceID);
 	}
 }
 
@@ -2,6 +2,7 @@
 #include "UnrealTournament.h"
 #include "UTGameSession.h"
 #include "Online.h"
+#include "OnlineSubsystemUtils.h"
 #include "OnlineSubsystemTypes.h"
 #include "UTOnlineGameSettingsBase.h"
 #include "UTBaseGameMode.h"
@@ -143,7 +144,7 @@ FString AUTGameSession::ApproveLogin(const FString& Options)
 
 void AUTGameSession::CleanUpOnlineSubsystem()
 {
-	const auto OnlineSub = IOnlineSubsystem::Get();
+	const auto OnlineSub = Online::GetSubsystem(GetWorld());
 	if (OnlineSub)
 	{
 		const auto SessionInterface = OnlineSub->GetSessionInterface();
@@ -175,7 +176,7 @@ void AUTGameSession::RegisterServer()
 {
 	UE_LOG(UT,Verbose,TEXT("--------------[REGISTER SERVER]----------------"));
 
-	const auto OnlineSub = IOnlineSubsystem::Get();
+	const auto OnlineSub = Online::GetSubsystem(GetWorld());
 	if (OnlineSub && GetWorld()->GetNetMode() == NM_DedicatedServer)
 	{
 		const auto SessionInterface = OnlineSub->GetSessionInterface();
@@ -235,7 +236,7 @@ void AUTGameSession::UnRegisterServer(bool bShuttingDown)
 	{
 		UE_LOG(UT,Verbose,TEXT("--------------[UN-REGISTER SERVER]----------------"));
 
-		const auto OnlineSub = IOnlineSubsystem::Get();
+		const auto OnlineSub = Online::GetSubsystem(GetWorld());
 		const auto SessionInterface = OnlineSub->GetSessionInterface();
 		EOnlineSessionState::Type State = SessionInterface->GetSessionState(GameSessionName);
 
@@ -259,7 +260,7 @@ void AUTGameSession::StartMatch()
 
 	UE_LOG(UT,Log,TEXT("--------------[MCP START MATCH] ----------------"));
 
-	const auto OnlineSub = IOnlineSubsystem::Get();
+	const auto OnlineSub = Online::GetSubsystem(GetWorld());
 	if (OnlineSub && GetWorld()->GetNetMode() == NM_DedicatedServer)
 	{
 		const auto SessionInterface = OnlineSub->GetSessionInterface();
@@ -275,7 +276,7 @@ void AUTGameSession::EndMatch()
 {
 	UE_LOG(UT,Log,TEXT("--------------[MCP END MATCH] ----------------"));
 
-	const auto OnlineSub = IOnlineSubsystem::Get();
+	const auto OnlineSub = Online::GetSubsystem(GetWorld());
 	if (OnlineSub && GetWorld()->GetNetMode() == NM_DedicatedServer)
 	{
 		const auto SessionInterface = OnlineSub->GetSessionInterface();
@@ -318,7 +319,7 @@ void AUTGameSession::OnCreateSessionComplete(FName SessionName, bool bWasSuccess
 	}
 
 
-	const auto OnlineSub = IOnlineSubsystem::Get();
+	const auto OnlineSub = Online::GetSubsystem(GetWorld());
 	if (OnlineSub && GetWorld()->GetNetMode() == NM_DedicatedServer)
 	{
 		const auto SessionInterface = OnlineSub->GetSessionInterface();
@@ -360,7 +361,7 @@ void AUTGameSession::OnStartSessionComplete(FName SessionName, bool bWasSuccessf
 	}
 
 	// Immediately perform an update so as to pickup any players that have joined since.
-	const auto OnlineSub = IOnlineSubsystem::Get();
+	const auto OnlineSub = Online::GetSubsystem(GetWorld());
 	if (OnlineSub && GetWorld()->GetNetMode() == NM_DedicatedServer)
 	{
 		const auto SessionInterface = OnlineSub->GetSessionInterface();
@@ -377,14 +378,14 @@ void AUTGameSession::OnEndSessionComplete(FName SessionName, bool bWasSuccessful
 	if (!bWasSuccessful)
 	{
 		UE_LOG(UT,Log,TEXT("Failed to end the session '%s' so match stats will not save.  See the logs!"), *SessionName.ToString());
-		IOnlineSubsystem::Get()->GetSessionInterface()->DumpSessionState();
+		Online::GetSubsystem(GetWorld())->GetSessionInterface()->DumpSessionState();
 	}
 	else
 	{
 		UE_LOG(UT,Verbose,TEXT("OnEndSessionComplete %s"), *SessionName.ToString());
 	}
 
-	const auto OnlineSub = IOnlineSubsystem::Get();
+	const auto OnlineSub = Online::GetSubsystem(GetWorld());
 	if (OnlineSub && GetWorld()->GetNetMode() == NM_DedicatedServer)
 	{
 		const auto SessionInterface = OnlineSub->GetSessionInterface();
@@ -406,7 +407,7 @@ void AUTGameSession::OnDestroySessionComplete(FName SessionName, bool bWasSucces
 		UE_LOG(UT,Verbose,TEXT("OnDestroySessionComplete %s"), *SessionName.ToString());
 	}
 
-	const auto OnlineSub = IOnlineSubsystem::Get();
+	const auto OnlineSub = Online::GetSubsystem(GetWorld());
 	if (OnlineSub && GetWorld()->GetNetMode() == NM_DedicatedServer)
 	{
 		const auto SessionInterface = OnlineSub->GetSessionInterface();
@@ -418,7 +419,7 @@ void AUTGameSession::OnDestroySessionComplete(FName SessionName, bool bWasSucces
 }
 void AUTGameSession::UpdateGameState()
 {
-	const auto OnlineSub = IOnlineSubsystem::Get();
+	const auto OnlineSub = Online::GetSubsystem(GetWorld());
 	if (UTGameMode && OnlineSub && GetWorld()->GetNetMode() == NM_DedicatedServer)
 	{
 		const auto SessionInterface = OnlineSub->GetSessionInterface();
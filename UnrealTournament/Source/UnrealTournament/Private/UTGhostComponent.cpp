@@ -5,6 +5,13 @@
 #include "UTGhostData.h"
 #include "UTGhostEvent.h"
 #include "UTGhostController.h"
+#include "UTWeapon.h"
+#include "UTReplicatedEmitter.h"
+
+static FIntVector QuantizeGhostVector(const FVector& V)
+{
+	return FIntVector(FMath::RoundToInt(V.X), FMath::RoundToInt(V.Y), FMath::RoundToInt(V.Z));
+}
 
 
 UUTGhostComponent::UUTGhostComponent()
@@ -31,15 +38,33 @@ void UUTGhostComponent::TickComponent( float DeltaTime, ELevelTick TickType, FAc
 	{
 		if (bGhostPlaying)
 		{
-			float CurrentTime = GetWorld()->TimeSeconds - GhostStartTime;
+			const float CurrentTime = GetWorld()->TimeSeconds - GhostStartTime;
 
-			while (GhostData->Events.IsValidIndex(GhostEventIndex) && GhostData->Events[GhostEventIndex]->Time < CurrentTime)
+			// apply whatever is due from the three tracks in time order
+			for (;;)
 			{
-				GhostData->Events[GhostEventIndex]->ApplyEvent(UTOwner);
-				GhostEventIndex++;
+				const float MoveTime = GhostData->Moves.IsValidIndex(GhostMoveIndex) ? GhostData->Moves[GhostMoveIndex].Time : MAX_FLT;
+				const float TrackEventTime = GhostData->TrackEvents.IsValidIndex(GhostTrackEventIndex) ? GhostData->TrackEvents[GhostTrackEventIndex].Time : MAX_FLT;
+				const float EventTime = GhostData->Events.IsValidIndex(GhostEventIndex) ? GhostData->Events[GhostEventIndex]->Time : MAX_FLT;
+				if (MoveTime < CurrentTime && MoveTime <= TrackEventTime && MoveTime <= EventTime)
+				{
+					ApplyTrackMove(GhostData->Moves[GhostMoveIndex++]);
+				}
+				else if (TrackEventTime < CurrentTime && TrackEventTime <= EventTime)
+				{
+					ApplyTrackEvent(GhostData->TrackEvents[GhostTrackEventIndex++]);
+				}
+				else if (EventTime < CurrentTime)
+				{
+					GhostData->Events[GhostEventIndex++]->ApplyEvent(UTOwner);
+				}
+				else
+				{
+					break;
+				}
 			}
 
-			if (!GhostData->Events.IsValidIndex(GhostEventIndex))
+			if (!GhostData->Moves.IsValidIndex(GhostMoveIndex) && !GhostData->TrackEvents.IsValidIndex(GhostTrackEventIndex) && !GhostData->Events.IsValidIndex(GhostEventIndex))
 			{
 				GhostStopPlaying();
 			}
@@ -64,7 +89,7 @@ void UUTGhostComponent::GhostStartRecording()
 
 		if (GhostData != nullptr)
 		{
-			GhostData->Events.Empty();
+			GhostData->ClearRecording();
 			GhostData->StartTransform = UTOwner->GetTransform();
 			bGhostRecording = true;
 			GhostStartTime = GetWorld()->TimeSeconds;
@@ -76,11 +101,7 @@ void UUTGhostComponent::GhostStartRecording()
 			//add the current weapon if there is one being held
 			if (UTOwner->Weapon != nullptr)
 			{
-				UUTGhostEvent_Weapon* WeaponEvent = Cast<UUTGhostEvent_Weapon>(CreateAndAddEvent(UUTGhostEvent_Weapon::StaticClass()));
-				if (WeaponEvent != nullptr)
-				{
-					WeaponEvent->WeaponClass = UTOwner->Weapon->GetClass();
-				}
+				GhostSwitchWeapon(UTOwner->Weapon);
 			}
 		}
 	}
@@ -97,11 +118,13 @@ void UUTGhostComponent::GhostStopRecording()
 
 void UUTGhostComponent::GhostStartPlaying()
 {
-	if (!bGhostRecording && !bGhostPlaying && GhostData != nullptr && GhostData->Events.Num() > 0)
+	if (!bGhostRecording && !bGhostPlaying && GhostData != nullptr && GhostData->HasRecording())
 	{
 		bGhostPlaying = true;
 		GhostStartTime = GetWorld()->TimeSeconds;
 		GhostEventIndex = 0;
+		GhostMoveIndex = 0;
+		GhostTrackEventIndex = 0;
 		GhostFireFlags = 0;
 		OldCompressedFlags = 0;
 		NextMoveTime = 0.0f;
@@ -157,19 +180,19 @@ void UUTGhostComponent::GhostMove()
 		//If the movement compressed flags change. save the movment regardless of MaxMoveDelta
 		if (NextMoveTime <= GetWorld()->TimeSeconds || FakeMove.GetCompressedFlags() != OldCompressedFlags)
 		{
-			UUTGhostEvent_Move* MoveEvent = Cast<UUTGhostEvent_Move>(CreateAndAddEvent(UUTGhostEvent_Move::StaticClass()));
-			if (MoveEvent != nullptr)
-			{
-				MoveEvent->bIsCrouched = UTOwner->bIsCrouched;
-				MoveEvent->bApplyWallSlide = UTOwner->bApplyWallSlide;
+			UTOwner->GatherUTMovement();
+			const FRepUTMovement& RepMovement = UTOwner->UTReplicatedMovement;
 
-				UTOwner->GatherUTMovement();
-				MoveEvent->RepMovement = UTOwner->UTReplicatedMovement;
-				MoveEvent->RepMovement.Rotation.Pitch = UTOwner->Controller->GetControlRotation().Pitch;
+			FUTGhostMove& Move = GhostData->Moves[GhostData->Moves.AddUninitialized()];
+			Move.Time = GetWorld()->TimeSeconds - GhostStartTime;
+			Move.Location = QuantizeGhostVector(RepMovement.Location);
+			Move.Velocity = QuantizeGhostVector(RepMovement.LinearVelocity);
+			Move.Yaw = FRotator::CompressAxisToShort(RepMovement.Rotation.Yaw);
+			Move.Pitch = FRotator::CompressAxisToShort(UTOwner->Controller->GetControlRotation().Pitch);
+			Move.MoveFlags = (RepMovement.AccelDir & FUTGhostMove::MOVEFLAG_AccelDir) | (UTOwner->bIsCrouched ? FUTGhostMove::MOVEFLAG_Crouched : 0) | (UTOwner->bApplyWallSlide ? FUTGhostMove::MOVEFLAG_WallSlide : 0);
+			Move.CompressedFlags = FakeMove.GetCompressedFlags();
+			OldCompressedFlags = Move.CompressedFlags;
 
-				MoveEvent->CompressedFlags = FakeMove.GetCompressedFlags();
-				OldCompressedFlags = FakeMove.GetCompressedFlags();
-			}
 			NextMoveTime = GetWorld()->TimeSeconds + MaxMoveDelta;
 		}
 	}
@@ -179,11 +202,11 @@ void UUTGhostComponent::GhostStartFire(uint8 FireModeNum)
 {
 	if (bGhostRecording && GhostData != nullptr)
 	{
-		UUTGhostEvent_Input* InputEvent = Cast<UUTGhostEvent_Input>(CreateAndAddEvent(UUTGhostEvent_Input::StaticClass()));
+		FUTGhostTrackEvent* InputEvent = AddTrackEvent(EGhostTrackEvent::Input);
 		if (InputEvent != nullptr)
 		{
 			GhostFireFlags |= (1 << FireModeNum);
-			InputEvent->FireFlags = GhostFireFlags;
+			InputEvent->Data = GhostFireFlags;
 		}
 	}
 }
@@ -191,12 +214,11 @@ void UUTGhostComponent::GhostStopFire(uint8 FireModeNum)
 {
 	if (bGhostRecording && GhostData != nullptr)
 	{
-		UUTGhostEvent_Input* InputEvent = Cast<UUTGhostEvent_Input>(CreateAndAddEvent(UUTGhostEvent_Input::StaticClass()));
+		FUTGhostTrackEvent* InputEvent = AddTrackEvent(EGhostTrackEvent::Input);
 		if (InputEvent != nullptr)
 		{
 			GhostFireFlags &= ~(1 << FireModeNum);
-			InputEvent->FireFlags = GhostFireFlags;
-			CreateAndAddEvent(UUTGhostEvent::StaticClass());
+			InputEvent->Data = GhostFireFlags;
 		}
 	}
 }
@@ -205,10 +227,10 @@ void UUTGhostComponent::GhostSwitchWeapon(AUTWeapon* NewWeapon)
 {
 	if (bGhostRecording && NewWeapon != nullptr && GhostData != nullptr)
 	{
-		UUTGhostEvent_Weapon* WeaponEvent = Cast<UUTGhostEvent_Weapon>(CreateAndAddEvent(UUTGhostEvent_Weapon::StaticClass()));
+		FUTGhostTrackEvent* WeaponEvent = AddTrackEvent(EGhostTrackEvent::Weapon);
 		if (WeaponEvent != nullptr)
 		{
-			WeaponEvent->WeaponClass = NewWeapon->GetClass();
+			WeaponEvent->Object = GhostData->AddReferencedObject(NewWeapon->GetClass());
 		}
 	}
 }
@@ -217,10 +239,11 @@ void UUTGhostComponent::GhostMovementEvent(const FMovementEventInfo& MovementEve
 {
 	if (bGhostRecording && GhostData != nullptr)
 	{
-		UUTGhostEvent_MovementEvent* NewEvent = Cast<UUTGhostEvent_MovementEvent>(CreateAndAddEvent(UUTGhostEvent_MovementEvent::StaticClass()));
+		FUTGhostTrackEvent* NewEvent = AddTrackEvent(EGhostTrackEvent::MovementEvent);
 		if (NewEvent != nullptr)
 		{
-			NewEvent->MovementEvent = MovementEvent;
+			NewEvent->Data = MovementEvent.EventType;
+			NewEvent->Location = QuantizeGhostVector(MovementEvent.EventLocation);
 		}
 	}
 }
@@ -229,11 +252,11 @@ void UUTGhostComponent::GhostJumpBoots(TSubclassOf<class AUTReplicatedEmitter> S
 {
 	if (bGhostRecording && GhostData != nullptr)
 	{
-		UUTGhostEvent_JumpBoots* NewEvent = Cast<UUTGhostEvent_JumpBoots>(CreateAndAddEvent(UUTGhostEvent_JumpBoots::StaticClass()));
+		FUTGhostTrackEvent* NewEvent = AddTrackEvent(EGhostTrackEvent::JumpBoots);
 		if (NewEvent != nullptr)
 		{
-			NewEvent->SuperJumpEffect = SuperJumpEffect;
-			NewEvent->SuperJumpSound = SuperJumpSound;
+			NewEvent->Object = GhostData->AddReferencedObject(*SuperJumpEffect);
+			NewEvent->Object2 = GhostData->AddReferencedObject(SuperJumpSound);
 		}
 	}
 }
@@ -251,4 +274,144 @@ UUTGhostEvent* UUTGhostComponent::CreateAndAddEvent(TSubclassOf<UUTGhostEvent> E
 		}
 	}
 	return NewEvent;
-}
\ No newline at end of file
+}
+
+FUTGhostTrackEvent* UUTGhostComponent::AddTrackEvent(uint8 Type)
+{
+	FUTGhostTrackEvent* NewEvent = nullptr;
+	if (bGhostRecording && GhostData != nullptr)
+	{
+		NewEvent = &GhostData->TrackEvents[GhostData->TrackEvents.AddZeroed()];
+		NewEvent->Time = GetWorld()->TimeSeconds - GhostStartTime;
+		NewEvent->Type = Type;
+		NewEvent->Object = INDEX_NONE;
+		NewEvent->Object2 = INDEX_NONE;
+	}
+	return NewEvent;
+}
+
+void UUTGhostComponent::ApplyTrackMove(const FUTGhostMove& Move)
+{
+	FRepUTMovement RepMovement;
+	RepMovement.Location = FVector(Move.Location);
+	RepMovement.LinearVelocity = FVector(Move.Velocity);
+	RepMovement.Rotation = FRotator(FRotator::DecompressAxisFromShort(Move.Pitch), FRotator::DecompressAxisFromShort(Move.Yaw), 0.0f);
+	RepMovement.AccelDir = Move.MoveFlags & FUTGhostMove::MOVEFLAG_AccelDir;
+	ApplyMove(RepMovement, Move.CompressedFlags, (Move.MoveFlags & FUTGhostMove::MOVEFLAG_Crouched) != 0, (Move.MoveFlags & FUTGhostMove::MOVEFLAG_WallSlide) != 0);
+}
+
+void UUTGhostComponent::ApplyTrackEvent(const FUTGhostTrackEvent& Event)
+{
+	switch (Event.Type)
+	{
+		case EGhostTrackEvent::Input:
+			ApplyFireFlags(Event.Data);
+			break;
+		case EGhostTrackEvent::Weapon:
+			ApplyWeapon(Cast<UClass>(GhostData->GetReferencedObject(Event.Object)));
+			break;
+		case EGhostTrackEvent::MovementEvent:
+		{
+			FMovementEventInfo MovementEvent;
+			MovementEvent.EventType = EMovementEvent(Event.Data);
+			MovementEvent.EventLocation = FVector(Event.Location);
+			ApplyMovementEvent(MovementEvent);
+			break;
+		}
+		case EGhostTrackEvent::JumpBoots:
+			ApplyJumpBoots(Cast<UClass>(GhostData->GetReferencedObject(Event.Object)), Cast<USoundBase>(GhostData->GetReferencedObject(Event.Object2)));
+			break;
+		default:
+			break;
+	}
+}
+
+void UUTGhostComponent::ApplyMove(const FRepUTMovement& RepMovement, uint8 CompressedFlags, bool bIsCrouched, bool bApplyWallSlide)
+{
+	//Copy over the RepMovement so SimulatedMove can play it
+	UTOwner->UTReplicatedMovement = RepMovement;
+	UTOwner->OnRep_UTReplicatedMovement();
+
+	//Set the movement flags
+	if (UTOwner->UTCharacterMovement != nullptr)
+	{
+		//Rotate the controller so weapon fire is in the right direction
+		if (UTOwner->GetController() != nullptr)
+		{
+			UTOwner->GetController()->SetControlRotation(RepMovement.Rotation);
+		}
+
+		UTOwner->UTCharacterMovement->UpdateFromCompressedFlags(CompressedFlags);
+		UTOwner->OnRepFloorSliding();
+
+		UTOwner->bIsCrouched = bIsCrouched;
+		UTOwner->OnRep_IsCrouched();
+		UTOwner->bApplyWallSlide = bApplyWallSlide;
+	}
+}
+
+void UUTGhostComponent::ApplyFireFlags(uint8 FireFlags)
+{
+	if (UTOwner->GetWeapon() != nullptr)
+	{
+		for (int32 FireBit = 0; FireBit < sizeof(uint8) * 8; FireBit++)
+		{
+			uint8 OldBit = (GhostFireFlags >> FireBit) & 1;
+			uint8 NewBit = (FireFlags >> FireBit) & 1;
+			if (NewBit != OldBit)
+			{
+				if (NewBit == 1)
+				{
+					UTOwner->GetWeapon()->BeginFiringSequence(FireBit, true);
+				}
+				else
+				{
+					UTOwner->GetWeapon()->EndFiringSequence(FireBit);
+				}
+			}
+		}
+		GhostFireFlags = FireFlags;
+	}
+}
+
+void UUTGhostComponent::ApplyWeapon(TSubclassOf<AUTWeapon> WeaponClass)
+{
+	if (WeaponClass != nullptr)
+	{
+		FActorSpawnParameters Params;
+		Params.bNoCollisionFail = true;
+		Params.Instigator = UTOwner;
+		AUTWeapon* NewWeapon = GetWorld()->SpawnActor<AUTWeapon>(WeaponClass, UTOwner->GetActorLocation(), UTOwner->GetActorRotation(), Params);
+
+		//Give infinite ammo and instant switch speed to avoid any syncing issues
+		for (int32 i = 0; i < NewWeapon->AmmoCost.Num(); i++)
+		{
+			NewWeapon->AmmoCost[i] = 0;
+		}
+		NewWeapon->BringUpTime = 0.0f;
+		NewWeapon->PutDownTime = 0.0f;
+
+		UTOwner->AddInventory(NewWeapon, true);
+		UTOwner->SwitchWeapon(NewWeapon);
+		UTOwner->WeaponChanged(); //force the pending weapon switch right away
+	}
+}
+
+void UUTGhostComponent::ApplyMovementEvent(const FMovementEventInfo& MovementEvent)
+{
+	UTOwner->MovementEvent = MovementEvent;
+	UTOwner->MovementEventReplicated();
+}
+
+void UUTGhostComponent::ApplyJumpBoots(TSubclassOf<AUTReplicatedEmitter> SuperJumpEffect, USoundBase* SuperJumpSound)
+{
+	if (SuperJumpEffect != NULL)
+	{
+		FActorSpawnParameters Params;
+		Params.Owner = UTOwner;
+		Params.Instigator = UTOwner;
+		GetWorld()->SpawnActor<AUTReplicatedEmitter>(SuperJumpEffect, UTOwner->GetActorLocation(), UTOwner->GetActorRotation(), Params);
+	}
+
+	UUTGameplayStatics::UTPlaySound(GetWorld(), SuperJumpSound, UTOwner, SRT_AllButOwner);
+}
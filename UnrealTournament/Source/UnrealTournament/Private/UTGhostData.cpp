@@ -0,0 +1,371 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealTournament.h"
+#include "UTGhostData.h"
+#include "UTGhostEvent.h"
+
+/** bump when the packed layout changes, older data is dropped */
+static const uint8 GhostTracksVersion = 1;
+static const uint32 GhostFileTag = 0x54534847; // 'GHST'
+/** sanity check for corrupt files that could OOM crash */
+static const int32 GhostFileSizeLimit = 64 * 1024 * 1024;
+
+// variable length integers, small deltas between consecutive moves take a byte or two
+
+static void WritePackedUInt(FArchive& Ar, uint32 Value)
+{
+	do
+	{
+		uint8 Byte = Value & 0x7F;
+		Value >>= 7;
+		if (Value != 0)
+		{
+			Byte |= 0x80;
+		}
+		Ar << Byte;
+	} while (Value != 0);
+}
+
+static uint32 ReadPackedUInt(FArchive& Ar)
+{
+	uint32 Value = 0;
+	for (int32 Shift = 0; Shift < 35 && !Ar.IsError(); Shift += 7)
+	{
+		uint8 Byte = 0;
+		Ar << Byte;
+		Value |= uint32(Byte & 0x7F) << Shift;
+		if ((Byte & 0x80) == 0)
+		{
+			break;
+		}
+	}
+	return Value;
+}
+
+static void WritePackedInt(FArchive& Ar, int32 Value)
+{
+	// zigzag so small negative deltas stay small
+	WritePackedUInt(Ar, (uint32(Value) << 1) ^ uint32(Value >> 31));
+}
+
+static int32 ReadPackedInt(FArchive& Ar)
+{
+	const uint32 Value = ReadPackedUInt(Ar);
+	return int32(Value >> 1) ^ -int32(Value & 1);
+}
+
+static void WritePackedDelta(FArchive& Ar, const FIntVector& Value, const FIntVector& Previous)
+{
+	WritePackedInt(Ar, Value.X - Previous.X);
+	WritePackedInt(Ar, Value.Y - Previous.Y);
+	WritePackedInt(Ar, Value.Z - Previous.Z);
+}
+
+static FIntVector ReadPackedDelta(FArchive& Ar, const FIntVector& Previous)
+{
+	FIntVector Value;
+	Value.X = Previous.X + ReadPackedInt(Ar);
+	Value.Y = Previous.Y + ReadPackedInt(Ar);
+	Value.Z = Previous.Z + ReadPackedInt(Ar);
+	return Value;
+}
+
+/** times are stored as milliseconds since the previous entry */
+static void WritePackedTime(FArchive& Ar, float Time, uint32& PreviousMS)
+{
+	const uint32 MS = uint32(FMath::Max<int32>(FMath::RoundToInt(Time * 1000.0f), PreviousMS));
+	WritePackedUInt(Ar, MS - PreviousMS);
+	PreviousMS = MS;
+}
+
+static float ReadPackedTime(FArchive& Ar, uint32& PreviousMS)
+{
+	PreviousMS += ReadPackedUInt(Ar);
+	return PreviousMS * 0.001f;
+}
+
+void UUTGhostData::PreSave()
+{
+	Super::PreSave();
+
+	PackedTracks.Reset();
+	if (Moves.Num() > 0 || TrackEvents.Num() > 0)
+	{
+		PackTracks(PackedTracks);
+	}
+}
+
+void UUTGhostData::PostLoad()
+{
+	Super::PostLoad();
+
+	if (PackedTracks.Num() > 0 && !UnpackTracks(PackedTracks))
+	{
+		UE_LOG(UT, Warning, TEXT("Failed to unpack ghost tracks of %s"), *GetPathName());
+	}
+	// the unpacked tracks are what's used from now on
+	PackedTracks.Empty();
+}
+
+void UUTGhostData::ClearRecording()
+{
+	Events.Empty();
+	Moves.Empty();
+	TrackEvents.Empty();
+	ReferencedObjects.Empty();
+	PackedTracks.Empty();
+}
+
+int32 UUTGhostData::AddReferencedObject(UObject* Obj)
+{
+	return (Obj != NULL) ? ReferencedObjects.AddUnique(Obj) : INDEX_NONE;
+}
+
+void UUTGhostData::PackTracks(TArray<uint8>& OutData) const
+{
+	FMemoryWriter Ar(OutData);
+
+	uint8 Version = GhostTracksVersion;
+	Ar << Version;
+
+	int32 NumMoves = Moves.Num();
+	Ar << NumMoves;
+	FUTGhostMove Previous;
+	FMemory::Memzero(Previous);
+	uint32 PreviousMS = 0;
+	for (const FUTGhostMove& Move : Moves)
+	{
+		WritePackedTime(Ar, Move.Time, PreviousMS);
+		WritePackedDelta(Ar, Move.Location, Previous.Location);
+		WritePackedDelta(Ar, Move.Velocity, Previous.Velocity);
+		WritePackedInt(Ar, int16(Move.Yaw - Previous.Yaw));
+		WritePackedInt(Ar, int16(Move.Pitch - Previous.Pitch));
+		uint8 MoveFlags = Move.MoveFlags;
+		uint8 CompressedFlags = Move.CompressedFlags;
+		Ar << MoveFlags;
+		Ar << CompressedFlags;
+		Previous = Move;
+	}
+
+	int32 NumEvents = TrackEvents.Num();
+	Ar << NumEvents;
+	PreviousMS = 0;
+	for (const FUTGhostTrackEvent& Event : TrackEvents)
+	{
+		WritePackedTime(Ar, Event.Time, PreviousMS);
+		uint8 Type = Event.Type;
+		uint8 Data = Event.Data;
+		Ar << Type;
+		Ar << Data;
+		switch (Event.Type)
+		{
+			case EGhostTrackEvent::MovementEvent:
+				WritePackedDelta(Ar, Event.Location, FIntVector::ZeroValue);
+				break;
+			case EGhostTrackEvent::Weapon:
+			case EGhostTrackEvent::JumpBoots:
+				WritePackedInt(Ar, Event.Object);
+				WritePackedInt(Ar, Event.Object2);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+bool UUTGhostData::UnpackTracks(const TArray<uint8>& InData)
+{
+	Moves.Reset();
+	TrackEvents.Reset();
+
+	FMemoryReader Ar(InData);
+
+	uint8 Version = 0;
+	Ar << Version;
+	if (Version != GhostTracksVersion)
+	{
+		return false;
+	}
+
+	int32 NumMoves = 0;
+	Ar << NumMoves;
+	// each move takes at least 11 bytes
+	if (NumMoves < 0 || NumMoves > InData.Num() / 11)
+	{
+		return false;
+	}
+	Moves.Reserve(NumMoves);
+	FUTGhostMove Previous;
+	FMemory::Memzero(Previous);
+	uint32 PreviousMS = 0;
+	for (int32 i = 0; i < NumMoves && !Ar.IsError(); i++)
+	{
+		FUTGhostMove Move;
+		Move.Time = ReadPackedTime(Ar, PreviousMS);
+		Move.Location = ReadPackedDelta(Ar, Previous.Location);
+		Move.Velocity = ReadPackedDelta(Ar, Previous.Velocity);
+		Move.Yaw = uint16(Previous.Yaw + ReadPackedInt(Ar));
+		Move.Pitch = uint16(Previous.Pitch + ReadPackedInt(Ar));
+		Ar << Move.MoveFlags;
+		Ar << Move.CompressedFlags;
+		Moves.Add(Move);
+		Previous = Move;
+	}
+
+	int32 NumEvents = 0;
+	Ar << NumEvents;
+	if (NumEvents < 0 || NumEvents > InData.Num() / 3)
+	{
+		return false;
+	}
+	TrackEvents.Reserve(NumEvents);
+	PreviousMS = 0;
+	for (int32 i = 0; i < NumEvents && !Ar.IsError(); i++)
+	{
+		FUTGhostTrackEvent Event;
+		FMemory::Memzero(Event);
+		Event.Object = INDEX_NONE;
+		Event.Object2 = INDEX_NONE;
+		Event.Time = ReadPackedTime(Ar, PreviousMS);
+		Ar << Event.Type;
+		Ar << Event.Data;
+		switch (Event.Type)
+		{
+			case EGhostTrackEvent::MovementEvent:
+				Event.Location = ReadPackedDelta(Ar, FIntVector::ZeroValue);
+				break;
+			case EGhostTrackEvent::Weapon:
+			case EGhostTrackEvent::JumpBoots:
+				Event.Object = ReadPackedInt(Ar);
+				Event.Object2 = ReadPackedInt(Ar);
+				break;
+			default:
+				break;
+		}
+		TrackEvents.Add(Event);
+	}
+
+	if (Ar.IsError())
+	{
+		Moves.Empty();
+		TrackEvents.Empty();
+		return false;
+	}
+	return true;
+}
+
+bool UUTGhostData::SaveToFile(const FString& Filename)
+{
+	TArray<uint8> Data;
+	{
+		FMemoryWriter DataAr(Data);
+		DataAr << StartTransform;
+
+		// referenced objects go by path so the file doesn't depend on the package it was recorded in
+		int32 NumObjects = ReferencedObjects.Num();
+		DataAr << NumObjects;
+		for (UObject* Obj : ReferencedObjects)
+		{
+			FString PathName = (Obj != NULL) ? Obj->GetPathName() : FString();
+			DataAr << PathName;
+		}
+
+		TArray<uint8> Tracks;
+		PackTracks(Tracks);
+		DataAr << Tracks;
+	}
+
+	int32 UncompressedSize = Data.Num();
+	TArray<uint8> CompressedData;
+	// zlib can grow data that doesn't compress
+	int32 CompressedSize = UncompressedSize + UncompressedSize / 10 + 64;
+	CompressedData.SetNum(CompressedSize);
+	if (!FCompression::CompressMemory(ECompressionFlags(COMPRESS_ZLIB | COMPRESS_BiasMemory), CompressedData.GetData(), CompressedSize, Data.GetData(), Data.Num()))
+	{
+		return false;
+	}
+	CompressedData.SetNum(CompressedSize);
+
+	FArchive* FileAr = IFileManager::Get().CreateFileWriter(*Filename);
+	if (FileAr == NULL)
+	{
+		return false;
+	}
+	uint32 Tag = GhostFileTag;
+	*FileAr << Tag;
+	*FileAr << UncompressedSize;
+	*FileAr << CompressedData;
+	const bool bSuccess = !FileAr->IsError();
+	delete FileAr;
+	return bSuccess;
+}
+
+bool UUTGhostData::LoadFromFile(const FString& Filename)
+{
+	TArray<uint8> Data;
+	{
+		FArchive* FileAr = IFileManager::Get().CreateFileReader(*Filename);
+		if (FileAr == NULL)
+		{
+			return false;
+		}
+		uint32 Tag = 0;
+		int32 UncompressedSize = 0;
+		*FileAr << Tag;
+		*FileAr << UncompressedSize;
+		if (Tag != GhostFileTag || UncompressedSize <= 0 || UncompressedSize > GhostFileSizeLimit)
+		{
+			UE_LOG(UT, Warning, TEXT("%s is not a valid ghost recording"), *Filename);
+			delete FileAr;
+			return false;
+		}
+		TArray<uint8> CompressedData;
+		*FileAr << CompressedData;
+		const bool bReadError = FileAr->IsError();
+		delete FileAr;
+
+		Data.AddUninitialized(UncompressedSize);
+		if (bReadError || !FCompression::UncompressMemory(ECompressionFlags(COMPRESS_ZLIB | COMPRESS_BiasMemory), Data.GetData(), UncompressedSize, CompressedData.GetData(), CompressedData.Num()))
+		{
+			return false;
+		}
+	}
+
+	FMemoryReader DataAr(Data);
+	FTransform NewStartTransform;
+	DataAr << NewStartTransform;
+
+	int32 NumObjects = 0;
+	DataAr << NumObjects;
+	if (NumObjects < 0 || NumObjects > Data.Num())
+	{
+		return false;
+	}
+	TArray<UObject*> NewReferencedObjects;
+	NewReferencedObjects.Reserve(NumObjects);
+	for (int32 i = 0; i < NumObjects && !DataAr.IsError(); i++)
+	{
+		FString PathName;
+		DataAr << PathName;
+		UObject* Obj = PathName.IsEmpty() ? NULL : StaticLoadObject(UObject::StaticClass(), NULL, *PathName, NULL, LOAD_NoWarn);
+		if (Obj == NULL && !PathName.IsEmpty())
+		{
+			UE_LOG(UT, Warning, TEXT("Ghost recording %s refers to missing %s"), *Filename, *PathName);
+		}
+		NewReferencedObjects.Add(Obj);
+	}
+
+	TArray<uint8> Tracks;
+	DataAr << Tracks;
+	if (DataAr.IsError() || !UnpackTracks(Tracks))
+	{
+		Moves.Empty();
+		TrackEvents.Empty();
+		return false;
+	}
+
+	Events.Empty();
+	StartTransform = NewStartTransform;
+	ReferencedObjects = NewReferencedObjects;
+	return true;
+}
@@ -26,15 +26,20 @@ AUTGib::AUTGib(const FObjectInitializer& ObjectInitializer)
 void AUTGib::PreInitializeComponents()
 {
 	LastBloodTime = GetWorld()->TimeSeconds;
+	if (MeshChoices.Num() > 0 && Mesh != NULL && Mesh->StaticMesh != NULL)
+	{
+		MeshChoices.AddUnique(Mesh->StaticMesh);
+	}
+	ChooseMesh();
+	Super::PreInitializeComponents();
+}
+
+void AUTGib::ChooseMesh()
+{
 	if (MeshChoices.Num() > 0 && Mesh != NULL)
 	{
-		if (Mesh->StaticMesh != NULL)
-		{
-			MeshChoices.AddUnique(Mesh->StaticMesh);
-		}
 		Mesh->SetStaticMesh(MeshChoices[FMath::RandHelper(MeshChoices.Num())]);
 	}
-	Super::PreInitializeComponents();
 }
 
 void AUTGib::BeginPlay()
@@ -51,11 +56,67 @@ void AUTGib::BeginPlay()
 void AUTGib::CheckGibVisibility()
 {
 	if (GetWorld()->GetTimeSeconds() - GetLastRenderTime() > 1.f)
+	{
+		Recycle();
+	}
+}
+
+void AUTGib::LifeSpanExpired()
+{
+	Recycle();
+}
+
+void AUTGib::Recycle()
+{
+	AUTWorldSettings* Settings = Cast<AUTWorldSettings>(GetWorldSettings());
+	if (Settings != NULL)
+	{
+		Settings->RecycleGib(this);
+	}
+	else
 	{
 		Destroy();
 	}
 }
 
+void AUTGib::PutAway()
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	DetachRootComponentFromParent(true);
+	if (Mesh != NULL)
+	{
+		Mesh->SetSimulatePhysics(false);
+	}
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	BloodDecals.Empty();
+	BloodEffects.Empty();
+}
+
+void AUTGib::Reactivate(const FVector& NewLocation, const FRotator& NewRotation)
+{
+	const AUTGib* DefaultGib = GetClass()->GetDefaultObject<AUTGib>();
+	SetActorLocationAndRotation(NewLocation, NewRotation);
+	if (RootComponent != NULL && DefaultGib->GetRootComponent() != NULL)
+	{
+		SetActorScale3D(DefaultGib->GetRootComponent()->RelativeScale3D);
+	}
+	ChooseMesh();
+	LastBloodTime = GetWorld()->TimeSeconds;
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	if (Mesh != NULL && DefaultGib->Mesh != NULL && DefaultGib->Mesh->BodyInstance.bSimulatePhysics)
+	{
+		Mesh->SetSimulatePhysics(true);
+		Mesh->SetPhysicsAngularVelocity(FVector::ZeroVector);
+		Mesh->SetPhysicsLinearVelocity(FVector::ZeroVector);
+	}
+	// same as a newly spawned gib
+	SetLifeSpan(DefaultGib->InitialLifeSpan);
+	FTimerHandle TempHandle;
+	GetWorldTimerManager().SetTimer(TempHandle, this, &AUTGib::CheckGibVisibility, 7.f, false);
+}
+
 void AUTGib::OnPhysicsCollision(AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
 #if !UE_SERVER
@@ -88,7 +149,7 @@ void AUTGib::OnPhysicsCollision(AActor* OtherActor, UPrimitiveComponent* OtherCo
 					FHitResult DecalHit;
 					if (GetWorld()->LineTraceSingleByChannel(DecalHit, GetActorLocation(), GetActorLocation() - Hit.Normal * 200.0f, ECC_Visibility, FCollisionQueryParams(NAME_BloodDecal, false, this)) && Hit.Component->bReceivesDecals)
 					{
-						UDecalComponent* Decal = NewObject<UDecalComponent>(GetWorld());
+						UDecalComponent* Decal = Settings->NewDecal();
 						if (Hit.Component.Get() != NULL && Hit.Component->Mobility == EComponentMobility::Movable)
 						{
 							Decal->SetAbsolute(false, false, true);
@@ -17,10 +17,13 @@
 #include "Json.h"
 #include "DisplayDebugHelpers.h"
 #include "UTRemoteRedeemer.h"
+#include "EngineFontServices.h"
 
 AUTHUD::AUTHUD(const class FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	WidgetOpacity = 1.0f;
+	StandingPS = NULL;
+	StandingScore = 0.0f;
 
 	// Set the crosshair texture
 	static ConstructorHelpers::FObjectFinder<UTexture2D> CrosshairTexObj(TEXT("Texture2D'/Game/RestrictedAssets/Textures/crosshair.crosshair'"));
@@ -378,21 +381,29 @@ void AUTHUD::CacheFonts()
 	FText MessageText = NSLOCTEXT("AUTHUD", "FontCacheText", "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789';:-=+*(),.?!");
 	FFontRenderInfo TextRenderInfo;
 	TextRenderInfo.bEnableShadow = true;
-	float YPos = 0.f;
 	Canvas->DrawColor = FLinearColor::White;
-	Canvas->DrawText(TinyFont, MessageText, 0.f, YPos, 0.1f, 0.1f, TextRenderInfo);
-	//YPos += 0.1f*Canvas->ClipY;
-	Canvas->DrawText(SmallFont, MessageText, 0.f, YPos, 0.1f, 0.1f, TextRenderInfo);
-	//YPos += 0.1f*Canvas->ClipY;
-	Canvas->DrawText(MediumFont, MessageText, 0.f, YPos, 0.1f, 0.1f, TextRenderInfo);
-	//YPos += 0.1f*Canvas->ClipY;
-	Canvas->DrawText(LargeFont, MessageText, 0.f, YPos, 0.1f, 0.1f, TextRenderInfo);
-	//YPos += 0.1f*Canvas->ClipY;
-	Canvas->DrawText(ScoreFont, MessageText, 0.f, YPos, 0.1f, 0.1f, TextRenderInfo);
-	//YPos += 0.1f*Canvas->ClipY;
-	Canvas->DrawText(NumberFont, MessageText, 0.f, YPos, 0.1f, 0.1f, TextRenderInfo);
-	//YPos += 0.1f*Canvas->ClipY;
-	Canvas->DrawText(HugeFont, MessageText, 0.f, YPos, 0.1f, 0.1f, TextRenderInfo);
+
+#if !UE_SERVER
+	// runtime fonts are rasterized a few characters a frame at the scoreboard's scale, instead of all at once at a scale nothing is drawn at
+	TSharedPtr<FSlateFontCache> FontCache = FEngineFontServices::Get().GetFontCache();
+	const float FontScale = Canvas->ClipY / ((MyUTScoreboard != NULL) ? MyUTScoreboard->DesignedResolution : 1080.f);
+#endif
+	UFont* Fonts[] = { TinyFont, SmallFont, MediumFont, LargeFont, ScoreFont, NumberFont, HugeFont };
+	for (UFont* Font : Fonts)
+	{
+		if (Font == NULL)
+		{
+			continue;
+		}
+#if !UE_SERVER
+		if (Font->FontCacheType == EFontCacheType::Runtime && FontCache.IsValid())
+		{
+			FontCache->RequestPrewarm(Font->GetLegacySlateFontInfo(), FontScale, MessageText.ToString());
+			continue;
+		}
+#endif
+		Canvas->DrawText(Font, MessageText, 0.f, 0.f, 0.1f, 0.1f, TextRenderInfo);
+	}
 	bFontsCached = true;
 }
 
@@ -491,7 +502,9 @@ void AUTHUD::DrawString(FText Text, float X, float Y, ETextHorzPos::Type HorzAli
 	FVector2D RenderPos = FVector2D(X,Y);
 
 	float XL, YL;
-	Canvas->TextSize(Font, Text.ToString(), XL, YL, Scale, Scale);
+	const FVector2D TextSize = TextLayouts.TextSize(Canvas, Text.ToString(), Font, Scale);
+	XL = TextSize.X;
+	YL = TextSize.Y;
 
 	if (HorzAlignment != ETextHorzPos::Left)
 	{
@@ -515,11 +528,17 @@ void AUTHUD::DrawString(FText Text, float X, float Y, ETextHorzPos::Type HorzAli
 	Canvas->DrawItem(TextItem);
 }
 
-void AUTHUD::DrawNumber(int32 Number, float X, float Y, FLinearColor Color, float GlowOpacity, float Scale, int32 MinDigits, bool bRightAlign)
+void AUTHUD::DrawNumber(int32 Number, float X, float Y, FLinearColor Color, float GlowOpacity, float Scale, int32 MinDigits, bool bRightAlign, FUTRetainedText* RetainedNumber)
 {
-	FNumberFormattingOptions Opts;
-	Opts.MinimumIntegralDigits = MinDigits;
-	DrawString(FText::AsNumber(Number, &Opts), X, Y, bRightAlign ? ETextHorzPos::Right : ETextHorzPos::Left, ETextVertPos::Top, NumberFont, Color, Scale, true);
+	FUTRetainedText TempNumber;
+	FUTRetainedText& NumberText = (RetainedNumber != NULL) ? *RetainedNumber : TempNumber;
+	if (NumberText.NeedsUpdate((int64(Number) << 8) | (MinDigits & 0xFF)))
+	{
+		FNumberFormattingOptions Opts;
+		Opts.MinimumIntegralDigits = MinDigits;
+		NumberText.Text = FText::AsNumber(Number, &Opts);
+	}
+	DrawString(NumberText.Text, X, Y, bRightAlign ? ETextHorzPos::Right : ETextHorzPos::Left, ETextVertPos::Top, NumberFont, Color, Scale, true);
 }
 
 void AUTHUD::PawnDamaged(FVector HitLocation, int32 DamageAmount, bool bFriendlyFire)
@@ -629,81 +648,98 @@ void AUTHUD::CalcStanding()
 		return;
 	}
 	CalcStandingTime = GetWorld()->GetTimeSeconds();
-	Leaderboard.Empty();
-
-	CurrentPlayerStanding = 0;
-	CurrentPlayerSpread = 0;
-	CurrentPlayerScore = 0;
-	NumActualPlayers = 0;
 
 	AUTPlayerState* MyPS = GetScorerPlayerState();
-
-	if (!UTPlayerOwner || !MyPS) return;	// Quick out if not ready
-
-	CurrentPlayerScore = int32(MyPS->Score);
-
 	AUTGameState* GameState = GetWorld()->GetGameState<AUTGameState>();
-	if (GameState)
+	if (!UTPlayerOwner || !MyPS || !GameState)
+	{
+		// Quick out if not ready
+		Leaderboard.Empty();
+		StandingInputs.Empty();
+		StandingPS = NULL;
+		CurrentPlayerStanding = 0;
+		CurrentPlayerSpread = 0;
+		CurrentPlayerScore = (UTPlayerOwner && MyPS) ? int32(MyPS->Score) : 0;
+		NumActualPlayers = 0;
+		return;
+	}
+
+	// Only rebuild if a player came or went or a score changed
+	bool bChanged = (MyPS != StandingPS || MyPS->Score != StandingScore);
+	int32 NumInputs = 0;
+	for (int32 i=0;i<GameState->PlayerArray.Num();i++)
 	{
-		// Build the leaderboard.
-		for (int32 i=0;i<GameState->PlayerArray.Num();i++)
+		AUTPlayerState* PS = Cast<AUTPlayerState>(GameState->PlayerArray[i]);
+		if (PS != NULL && !PS->bIsSpectator && !PS->bOnlySpectator)
 		{
-			AUTPlayerState* PS = Cast<AUTPlayerState>(GameState->PlayerArray[i]);
-			if (PS != NULL && !PS->bIsSpectator && !PS->bOnlySpectator)
+			if (NumInputs == StandingInputs.Num())
 			{
-				// Sort in to the leaderboard
-				int32 Index = -1;
-				for (int32 j=0;j<Leaderboard.Num();j++)
-				{
-					if (PS->Score > Leaderboard[j]->Score)
-					{
-						Index = j;
-						break;
-					}
-				}
-
-				if (Index >=0)
-				{
-					Leaderboard.Insert(PS, Index);
-				}
-				else
-				{
-					Leaderboard.Add(PS);
-				}
+				StandingInputs.AddUninitialized();
+				bChanged = true;
+			}
+			FStandingInput& Input = StandingInputs[NumInputs++];
+			if (bChanged || Input.PS != PS || Input.Score != PS->Score)
+			{
+				Input.PS = PS;
+				Input.Score = PS->Score;
+				bChanged = true;
 			}
 		}
-		
-		NumActualPlayers = Leaderboard.Num();
+	}
+	if (NumInputs != StandingInputs.Num())
+	{
+		StandingInputs.SetNum(NumInputs);
+		bChanged = true;
+	}
+	if (!bChanged)
+	{
+		return;
+	}
+	StandingPS = MyPS;
+	StandingScore = MyPS->Score;
 
-		// Find my index in it.
-		CurrentPlayerStanding = 1;
-		int32 MyIndex = Leaderboard.Find(MyPS);
-		if (MyIndex >= 0)
+	CurrentPlayerStanding = 0;
+	CurrentPlayerSpread = 0;
+	CurrentPlayerScore = int32(MyPS->Score);
+
+	// Build the leaderboard, players with the same score stay in PlayerArray order
+	Leaderboard.Reset();
+	for (const FStandingInput& Input : StandingInputs)
+	{
+		Leaderboard.Add(const_cast<AUTPlayerState*>(Input.PS));
+	}
+	Leaderboard.StableSort([](const AUTPlayerState& A, const AUTPlayerState& B) { return A.Score > B.Score; });
+
+	NumActualPlayers = Leaderboard.Num();
+
+	// Find my index in it.
+	CurrentPlayerStanding = 1;
+	int32 MyIndex = Leaderboard.Find(MyPS);
+	if (MyIndex >= 0)
+	{
+		for (int32 i=0; i < MyIndex; i++)
 		{
-			for (int32 i=0; i < MyIndex; i++)
+			if (Leaderboard[i]->Score > MyPS->Score)
 			{
-				if (Leaderboard[i]->Score > MyPS->Score)
-				{
-					CurrentPlayerStanding++;
-				}
+				CurrentPlayerStanding++;
 			}
 		}
+	}
 
-		if (CurrentPlayerStanding > 1)
-		{
-			CurrentPlayerSpread = MyPS->Score - Leaderboard[0]->Score;
-		}
-		else if (MyIndex < Leaderboard.Num()-1)
-		{
-			CurrentPlayerSpread = MyPS->Score - Leaderboard[MyIndex+1]->Score;
-		}
+	if (CurrentPlayerStanding > 1)
+	{
+		CurrentPlayerSpread = MyPS->Score - Leaderboard[0]->Score;
+	}
+	else if (MyIndex < Leaderboard.Num()-1)
+	{
+		CurrentPlayerSpread = MyPS->Score - Leaderboard[MyIndex+1]->Score;
+	}
 
-		if ( Leaderboard.Num() > 0 && Leaderboard[0]->Score == MyPS->Score && Leaderboard[0] != MyPS)
-		{
-			// Bubble this player to the top
-			Leaderboard.Remove(MyPS);
-			Leaderboard.Insert(MyPS,0);
-		}
+	if ( Leaderboard.Num() > 0 && Leaderboard[0]->Score == MyPS->Score && Leaderboard[0] != MyPS)
+	{
+		// Bubble this player to the top
+		Leaderboard.Remove(MyPS);
+		Leaderboard.Insert(MyPS,0);
 	}
 }
 
@@ -0,0 +1,123 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTHUDTextCache.h"
+
+DECLARE_STATS_GROUP(TEXT("UT HUD"), STATGROUP_UTHUD, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Text rebuilds"), STAT_UTHUDTextRebuilds, STATGROUP_UTHUD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Retained text draws"), STAT_UTHUDTextRetained, STATGROUP_UTHUD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Text layouts built"), STAT_UTHUDLayoutsBuilt, STATGROUP_UTHUD);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cached text layouts drawn"), STAT_UTHUDLayoutsCached, STATGROUP_UTHUD);
+
+static TAutoConsoleVariable<int32> CVarHUDRetained(
+	TEXT("ut.HUDRetained"),
+	1,
+	TEXT("If set, HUD text is only formatted, measured and word wrapped again when what it shows changes. Otherwise it is all rebuilt every frame."));
+
+/** more layouts than this and those not drawn last frame are thrown out */
+static const int32 MAX_HUD_TEXT_LAYOUTS = 256;
+
+bool FUTRetainedText::NeedsUpdate(int64 NewInputs)
+{
+	if (bValid && Inputs == NewInputs && CVarHUDRetained.GetValueOnGameThread() != 0)
+	{
+		INC_DWORD_STAT(STAT_UTHUDTextRetained);
+		return false;
+	}
+	INC_DWORD_STAT(STAT_UTHUDTextRebuilds);
+	Inputs = NewInputs;
+	bValid = true;
+	return true;
+}
+
+template<typename LayoutType>
+LayoutType* FUTHUDTextLayoutCache::FindLayout(TMap<FLayoutKey, LayoutType>& Layouts, const FLayoutKey& Key)
+{
+	LayoutType* Layout = (CVarHUDRetained.GetValueOnGameThread() != 0) ? Layouts.Find(Key) : NULL;
+	if (Layout != NULL)
+	{
+		INC_DWORD_STAT(STAT_UTHUDLayoutsCached);
+		Layout->LastUsedFrame = GFrameCounter;
+	}
+	return Layout;
+}
+
+template<typename LayoutType>
+LayoutType& FUTHUDTextLayoutCache::AddLayout(TMap<FLayoutKey, LayoutType>& Layouts, const FLayoutKey& Key)
+{
+	INC_DWORD_STAT(STAT_UTHUDLayoutsBuilt);
+	if (Layouts.Num() >= MAX_HUD_TEXT_LAYOUTS)
+	{
+		// text that changes all the time (timers, names scrolling by...) would otherwise pile up
+		for (typename TMap<FLayoutKey, LayoutType>::TIterator It(Layouts); It; ++It)
+		{
+			if (It.Value().LastUsedFrame + 1 < GFrameCounter)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+	LayoutType& Layout = Layouts.Add(Key.MakeOwned());
+	Layout.LastUsedFrame = GFrameCounter;
+	return Layout;
+}
+
+FVector2D FUTHUDTextLayoutCache::StrLen(UCanvas* Canvas, const FString& Text, UFont* Font)
+{
+	const FLayoutKey Key(Text, Font, 1.0f, 0);
+	FSizeLayout* Layout = FindLayout(StrLenLayouts, Key);
+	if (Layout == NULL)
+	{
+		Layout = &AddLayout(StrLenLayouts, Key);
+		Canvas->StrLen(Font, Text, Layout->Size.X, Layout->Size.Y);
+	}
+	return Layout->Size;
+}
+
+FVector2D FUTHUDTextLayoutCache::TextSize(UCanvas* Canvas, const FString& Text, UFont* Font, float Scale)
+{
+	const FLayoutKey Key(Text, Font, Scale, 0);
+	FSizeLayout* Layout = FindLayout(TextSizeLayouts, Key);
+	if (Layout == NULL)
+	{
+		Layout = &AddLayout(TextSizeLayouts, Key);
+		Canvas->TextSize(Font, Text, Layout->Size.X, Layout->Size.Y, Scale, Scale);
+	}
+	return Layout->Size;
+}
+
+const FText& FUTHUDTextLayoutCache::WrapText(FCanvasWordWrapper& WordWrapper, const FText& Text, UFont* Font, float Scale, float WrapWidth, float WrapHeight)
+{
+	const FString& TextString = Text.ToString();
+	const FLayoutKey Key(TextString, Font, Scale, FMath::TruncToInt(WrapWidth));
+	FWrapLayout* Layout = FindLayout(WrapLayouts, Key);
+	if (Layout == NULL)
+	{
+		Layout = &AddLayout(WrapLayouts, Key);
+
+		// same as FUTCanvasTextItem::Draw()
+		FTextSizingParameters Parms(Font, Scale, Scale);
+		Parms.DrawXL = Key.WrapWidth;
+		Parms.DrawYL = WrapHeight;
+		TArray<FWrappedStringElement> Lines;
+		UCanvas::WrapString(WordWrapper, Parms, 0, *TextString, Lines);
+
+		FString NewText;
+		for (int32 i = 0; i < Lines.Num(); i++)
+		{
+			if (i > 0)
+			{
+				NewText += TEXT("\n");
+			}
+			NewText += Lines[i].Value;
+		}
+		Layout->WrappedText = (NewText == TextString) ? Text : FText::FromString(NewText);
+	}
+	return Layout->WrappedText;
+}
+
+void FUTHUDTextLayoutCache::Empty()
+{
+	StrLenLayouts.Empty();
+	TextSizeLayouts.Empty();
+	WrapLayouts.Empty();
+}
@@ -683,8 +683,9 @@ FVector2D UUTHUDWidget::DrawText(FText Text, float X, float Y, UFont* Font, bool
 			UE_LOG(UT, Warning, TEXT("%s draw text with font %s"), *GetName(), *Font->GetName());
 		}*/
 		
-		Canvas->StrLen(Font, Text.ToString(), XL, YL);
-		TextSize = FVector2D(XL,YL); // Save for Later
+		TextSize = TextLayouts.StrLen(Canvas, Text.ToString(), Font); // Save for Later
+		XL = TextSize.X;
+		YL = TextSize.Y;
 
 		if (bScaleByDesignedResolution)
 		{
@@ -713,11 +714,17 @@ FVector2D UUTHUDWidget::DrawText(FText Text, float X, float Y, UFont* Font, bool
 		DrawColor.A = Opacity * DrawOpacity * UTHUDOwner->WidgetOpacity;
 		Canvas->DrawColor = DrawColor.ToFColor(false);
 
-		if (!WordWrapper.IsValid())
+		if (!RenderInfo.bClipText)
 		{
-			WordWrapper = MakeShareable(new FCanvasWordWrapper());
+			// wrap here instead of in FUTCanvasTextItem::Draw() so it is only done when the text changes
+			if (!WordWrapper.IsValid())
+			{
+				WordWrapper = MakeShareable(new FCanvasWordWrapper());
+			}
+			const FIntPoint RenderTargetSize = Canvas->Canvas->GetRenderTarget()->GetSizeXY();
+			Text = TextLayouts.WrapText(*WordWrapper, Text, Font, TextScaling, RenderTargetSize.X - RenderPos.X, RenderTargetSize.Y);
 		}
-		FUTCanvasTextItem TextItem(RenderPos, Text, Font, DrawColor, WordWrapper);
+		FUTCanvasTextItem TextItem(RenderPos, Text, Font, DrawColor, NULL);
 		TextItem.FontRenderInfo = RenderInfo;
 
 		if (bDrawOutline)
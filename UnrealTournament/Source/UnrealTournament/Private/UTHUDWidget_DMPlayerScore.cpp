@@ -33,8 +33,12 @@ void UUTHUDWidget_DMPlayerScore::Draw_Implementation(float DeltaTime)
 			LastScore = Score;
 
 			DrawTexture(HudTexture, 0.0f, 0.0f, 114.0f, 43.0f, 375.0f, 396.0f, 114.0f, 43.0f, 1.0f, ApplyHUDColor(FLinearColor::White));
-			UTHUDOwner->DrawNumber(Score, RenderPosition.X + 22 * RenderScale, RenderPosition.Y + 7 * RenderScale, FLinearColor::Yellow, ScoreFlashOpacity, RenderScale * 0.5f, 3.0f);
-			DrawText(FText::Format(NSLOCTEXT("UTHUD", "Deaths", "{0} Deaths"), FText::AsNumber(Deaths)), 114.0f, 46.0f, UTHUDOwner->TinyFont, 1.0f, 1.0f, FLinearColor::White, ETextHorzPos::Right);
+			UTHUDOwner->DrawNumber(Score, RenderPosition.X + 22 * RenderScale, RenderPosition.Y + 7 * RenderScale, FLinearColor::Yellow, ScoreFlashOpacity, RenderScale * 0.5f, 3.0f, false, &RetainedScoreText);
+			if (DeathsText.NeedsUpdate(PS->Deaths))
+			{
+				DeathsText.Text = FText::Format(NSLOCTEXT("UTHUD", "Deaths", "{0} Deaths"), FText::AsNumber(Deaths));
+			}
+			DrawText(DeathsText.Text, 114.0f, 46.0f, UTHUDOwner->TinyFont, 1.0f, 1.0f, FLinearColor::White, ETextHorzPos::Right);
 
 			if (ScoreFlashOpacity > 0.0f)
 			{
@@ -41,20 +41,31 @@ void UUTHUDWidget_GameClock::Draw_Implementation(float DeltaTime)
 
 FText UUTHUDWidget_GameClock::GetPlayerScoreText_Implementation()
 {
-	return FText::AsNumber(UTHUDOwner->CurrentPlayerScore);
+	if (RetainedScoreText.NeedsUpdate(UTHUDOwner->CurrentPlayerScore))
+	{
+		RetainedScoreText.Text = FText::AsNumber(UTHUDOwner->CurrentPlayerScore);
+	}
+	return RetainedScoreText.Text;
 }
 
 FText UUTHUDWidget_GameClock::GetClockText_Implementation()
 {
 	float RemainingTime = UTGameState ? UTGameState->GetClockTime() : 0.f;
-	FText ClockString = UTHUDOwner->ConvertTime(FText::GetEmpty(),FText::GetEmpty(), RemainingTime,false);
+	if (RetainedClockText.NeedsUpdate(int32(RemainingTime)))
+	{
+		RetainedClockText.Text = UTHUDOwner->ConvertTime(FText::GetEmpty(),FText::GetEmpty(), RemainingTime,false);
+	}
 	ClockText.TextScale = (RemainingTime >= 3600) ? AltClockScale : GetClass()->GetDefaultObject<UUTHUDWidget_GameClock>()->ClockText.TextScale;
-	return ClockString;
+	return RetainedClockText.Text;
 }
 
 FText UUTHUDWidget_GameClock::GetPlayerRankText_Implementation()
 {
-	return FText::AsNumber(UTHUDOwner->CurrentPlayerStanding);
+	if (RetainedRankText.NeedsUpdate(UTHUDOwner->CurrentPlayerStanding))
+	{
+		RetainedRankText.Text = FText::AsNumber(UTHUDOwner->CurrentPlayerStanding);
+	}
+	return RetainedRankText.Text;
 }
 
 FText UUTHUDWidget_GameClock::GetPlayerRankThText_Implementation()
@@ -64,8 +75,12 @@ FText UUTHUDWidget_GameClock::GetPlayerRankThText_Implementation()
 
 FText UUTHUDWidget_GameClock::GetNumPlayersText_Implementation()
 {
-	FFormatNamedArguments Args;
-	Args.Add("PlayerCount", FText::AsNumber(UTHUDOwner->NumActualPlayers));
-	return FText::Format(NSLOCTEXT("UTHUD", "NumPlayersDisplay", "/{PlayerCount}"), Args);
+	if (RetainedNumPlayersText.NeedsUpdate(UTHUDOwner->NumActualPlayers))
+	{
+		FFormatNamedArguments Args;
+		Args.Add("PlayerCount", FText::AsNumber(UTHUDOwner->NumActualPlayers));
+		RetainedNumPlayersText.Text = FText::Format(NSLOCTEXT("UTHUD", "NumPlayersDisplay", "/{PlayerCount}"), Args);
+	}
+	return RetainedNumPlayersText.Text;
 }
 
@@ -29,12 +29,21 @@ void UUTHUDWidget_Paperdoll::InitializeWidget(AUTHUD* Hud)
 FText UUTHUDWidget_Paperdoll::GetPlayerHealth_Implementation()
 {
 	AUTCharacter* UTC = Cast<AUTCharacter>(UTHUDOwner->UTPlayerOwner->GetViewTarget());
-	return (UTC != NULL && !UTC->IsDead()) ? FText::AsNumber(UTC->Health) : FText::AsNumber(0);
+	const int32 Health = (UTC != NULL && !UTC->IsDead()) ? UTC->Health : 0;
+	if (RetainedHealthText.NeedsUpdate(Health))
+	{
+		RetainedHealthText.Text = FText::AsNumber(Health);
+	}
+	return RetainedHealthText.Text;
 }
 
 FText UUTHUDWidget_Paperdoll::GetPlayerArmor_Implementation()
 {
-	return FText::AsNumber(PlayerArmor);
+	if (RetainedArmorText.NeedsUpdate(PlayerArmor))
+	{
+		RetainedArmorText.Text = FText::AsNumber(PlayerArmor);
+	}
+	return RetainedArmorText.Text;
 }
 
 void UUTHUDWidget_Paperdoll::ProcessArmor()
@@ -48,21 +48,32 @@ void UUTHUDWidget_TeamGameClock::Draw_Implementation(float DeltaTime)
 
 FText UUTHUDWidget_TeamGameClock::GetRedScoreText_Implementation()
 {
-	if (UTGameState && UTGameState->bTeamGame && UTGameState->Teams.Num() > 0 && UTGameState->Teams[0]) return FText::AsNumber(UTGameState->Teams[0]->Score);
-	return FText::AsNumber(0);
+	const int32 Score = (UTGameState && UTGameState->bTeamGame && UTGameState->Teams.Num() > 0 && UTGameState->Teams[0]) ? UTGameState->Teams[0]->Score : 0;
+	if (RetainedRedScoreText.NeedsUpdate(Score))
+	{
+		RetainedRedScoreText.Text = FText::AsNumber(Score);
+	}
+	return RetainedRedScoreText.Text;
 }
 
 FText UUTHUDWidget_TeamGameClock::GetBlueScoreText_Implementation()
 {
-	if (UTGameState && UTGameState->bTeamGame && UTGameState->Teams.Num() > 1 && UTGameState->Teams[1]) return FText::AsNumber(UTGameState->Teams[1]->Score);
-	return FText::AsNumber(0);
+	const int32 Score = (UTGameState && UTGameState->bTeamGame && UTGameState->Teams.Num() > 1 && UTGameState->Teams[1]) ? UTGameState->Teams[1]->Score : 0;
+	if (RetainedBlueScoreText.NeedsUpdate(Score))
+	{
+		RetainedBlueScoreText.Text = FText::AsNumber(Score);
+	}
+	return RetainedBlueScoreText.Text;
 }
 
 
 FText UUTHUDWidget_TeamGameClock::GetClockText_Implementation()
 {
 	float RemainingTime = UTGameState ? UTGameState->GetClockTime() : 0.f;
-	FText ClockString = UTHUDOwner->ConvertTime(FText::GetEmpty(),FText::GetEmpty(),RemainingTime,false);
+	if (RetainedClockText.NeedsUpdate(int32(RemainingTime)))
+	{
+		RetainedClockText.Text = UTHUDOwner->ConvertTime(FText::GetEmpty(),FText::GetEmpty(),RemainingTime,false);
+	}
 	ClockText.TextScale = (RemainingTime >= 3600) ? AltClockScale : GetClass()->GetDefaultObject<UUTHUDWidget_TeamGameClock>()->ClockText.TextScale;
-	return ClockString;
+	return RetainedClockText.Text;
 }
@@ -83,6 +83,10 @@ void UUTHUDWidget_WeaponInfo::Draw_Implementation(float DeltaTime)
 
 FText UUTHUDWidget_WeaponInfo::GetAmmoAmount_Implementation()
 {
-	return FText::AsNumber(LastAmmoAmount);
+	if (RetainedAmmoText.NeedsUpdate(LastAmmoAmount))
+	{
+		RetainedAmmoText.Text = FText::AsNumber(LastAmmoAmount);
+	}
+	return RetainedAmmoText.Text;
 }
 
@@ -0,0 +1,418 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTLobbyGameState.h"
+#include "UTLobbyMatchInfo.h"
+#include "UTHubLaunchBenchmark.h"
+
+AUTHubLaunchBenchmark::AUTHubLaunchBenchmark(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bTickEvenWhenPaused = true;
+	NumLaunches = 5;
+	NumMemoryMatches = 4;
+	LaunchTimeout = 120.0f;
+	Phase = PHASE_Done;
+	MatchInfo = NULL;
+	LaunchStartTime = 0.0;
+	SavedMinIdleInstances = 0;
+	SavedMaxIdleInstances = 0;
+	SavedMaxMatchesPerInstance = 1;
+	SavedSharedInstanceMaxPlayers = 0;
+	SharedIdleKB = 0;
+	SharedHostInstanceID = 0;
+}
+
+bool AUTHubLaunchBenchmark::WantsBenchmark(int32& OutNumLaunches)
+{
+	OutNumLaunches = 0;
+	return FParse::Value(FCommandLine::Get(), TEXT("UTHubLaunchBenchmark="), OutNumLaunches) && OutNumLaunches > 0;
+}
+
+AUTLobbyGameState* AUTHubLaunchBenchmark::GetLobbyGameState() const
+{
+	return GetWorld()->GetGameState<AUTLobbyGameState>();
+}
+
+void AUTHubLaunchBenchmark::StartBenchmark()
+{
+	AUTLobbyGameState* LobbyGameState = GetLobbyGameState();
+	if (LobbyGameState == NULL)
+	{
+		UE_LOG(UT, Error, TEXT("HubLaunchBenchmark: not a hub"));
+		FPlatformMisc::RequestExit(false);
+		return;
+	}
+
+	FParse::Value(FCommandLine::Get(), TEXT("UTHubBenchmarkRuleset="), RulesetTag);
+	FParse::Value(FCommandLine::Get(), TEXT("UTHubBenchmarkMemoryMatches="), NumMemoryMatches);
+	NumMemoryMatches = FMath::Max(0, NumMemoryMatches);
+	if (!FParse::Value(FCommandLine::Get(), TEXT("UTBenchmarkReport="), ReportFilename) || ReportFilename.IsEmpty())
+	{
+		ReportFilename = FPaths::GameSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("HubLaunch-%s.json"), *FDateTime::Now().ToString());
+	}
+
+	SavedMinIdleInstances = LobbyGameState->MinIdleInstances;
+	SavedMaxIdleInstances = LobbyGameState->MaxIdleInstances;
+	SavedMaxMatchesPerInstance = LobbyGameState->MaxMatchesPerInstance;
+	SavedSharedInstanceMaxPlayers = LobbyGameState->SharedInstanceMaxPlayers;
+
+	UE_LOG(UT, Log, TEXT("HubLaunchBenchmark: %i launches without and %i with the instance pool, then memory of %i matches in separate and shared processes"), NumLaunches, NumLaunches, NumMemoryMatches);
+	SetPoolSize(0);
+	Phase = PHASE_ColdSetup;
+}
+
+void AUTHubLaunchBenchmark::SetPoolSize(int32 NumIdle, int32 MaxMatchesPerInstance)
+{
+	AUTLobbyGameState* LobbyGameState = GetLobbyGameState();
+	LobbyGameState->MinIdleInstances = NumIdle;
+	LobbyGameState->MaxIdleInstances = NumIdle;
+	LobbyGameState->MaxMatchesPerInstance = MaxMatchesPerInstance;
+	for (int32 i = LobbyGameState->InstancePool.Num() - 1; i >= NumIdle; i--)
+	{
+		LobbyGameState->TerminatePooledInstance(i);
+	}
+	LobbyGameState->MaintainInstancePool();
+}
+
+const FPooledGameInstance* AUTHubLaunchBenchmark::FindFreePooledInstance() const
+{
+	for (const FPooledGameInstance& Pooled : GetLobbyGameState()->InstancePool)
+	{
+		if (Pooled.IsIdle() && Pooled.NumSharedMatches == 0)
+		{
+			return &Pooled;
+		}
+	}
+	return NULL;
+}
+
+TWeakObjectPtr<AUTReplicatedGameRuleset> AUTHubLaunchBenchmark::FindBenchmarkRuleset()
+{
+	AUTLobbyGameState* LobbyGameState = GetLobbyGameState();
+	TWeakObjectPtr<AUTReplicatedGameRuleset> Ruleset;
+	if (!RulesetTag.IsEmpty())
+	{
+		Ruleset = LobbyGameState->FindRuleset(RulesetTag);
+	}
+	for (int32 i = 0; i < LobbyGameState->AvailableGameRulesets.Num() && !Ruleset.IsValid(); i++)
+	{
+		Ruleset = LobbyGameState->AvailableGameRulesets[i];
+		RulesetTag = Ruleset.IsValid() ? Ruleset->UniqueTag : RulesetTag;
+	}
+	return Ruleset;
+}
+
+bool AUTHubLaunchBenchmark::Launch()
+{
+	AUTLobbyGameState* LobbyGameState = GetLobbyGameState();
+	TWeakObjectPtr<AUTReplicatedGameRuleset> Ruleset = FindBenchmarkRuleset();
+	if (!Ruleset.IsValid())
+	{
+		UE_LOG(UT, Error, TEXT("HubLaunchBenchmark: no ruleset to launch matches with"));
+		return false;
+	}
+
+	// not added to AvailableMatches, so nobody can join it and the hub's match upkeep leaves it alone
+	MatchInfo = GetWorld()->SpawnActor<AUTLobbyMatchInfo>();
+	if (MatchInfo == NULL)
+	{
+		return false;
+	}
+	MatchInfo->SetRules(Ruleset, Ruleset->DefaultMap);
+
+	// same URL as AUTLobbyMatchInfo::LaunchMatch without bots
+	FString GameURL = FString::Printf(TEXT("%s?Game=%s?MaxPlayers=%i"), *MatchInfo->InitialMap, *Ruleset->GameMode, Ruleset->MaxPlayers);
+	GameURL += Ruleset->GameOptions;
+
+	LaunchStartTime = FPlatformTime::Seconds();
+	LobbyGameState->LaunchGameInstance(MatchInfo, GameURL);
+	if (LobbyGameState->FindGameInstanceData(MatchInfo) == NULL)
+	{
+		MatchInfo->Destroy();
+		MatchInfo = NULL;
+		return false;
+	}
+	return true;
+}
+
+void AUTHubLaunchBenchmark::FinishLaunch(bool bTimedOut)
+{
+	AUTLobbyGameState* LobbyGameState = GetLobbyGameState();
+	FGameInstanceData* InstanceData = LobbyGameState->FindGameInstanceData(MatchInfo);
+	float TimeToReady = (!bTimedOut && InstanceData != NULL) ? InstanceData->TimeToReady : 0.0f;
+	bool bPooled = InstanceData != NULL && InstanceData->bPooledLaunch;
+	TArray<float>& Times = (Phase == PHASE_Cold) ? ColdTimes : PooledTimes;
+	Times.Add(TimeToReady);
+	if (bTimedOut)
+	{
+		UE_LOG(UT, Warning, TEXT("HubLaunchBenchmark: launch %i wasn't ready after %.0fs"), Times.Num(), LaunchTimeout);
+	}
+	else
+	{
+		UE_LOG(UT, Log, TEXT("HubLaunchBenchmark: %s launch %i ready after %.2fs"), bPooled ? TEXT("pooled") : TEXT("cold"), Times.Num(), TimeToReady);
+	}
+
+	LobbyGameState->TerminateGameInstance(MatchInfo);
+	MatchInfo->Destroy();
+	MatchInfo = NULL;
+}
+
+void AUTHubLaunchBenchmark::FinishMemoryLaunch(bool bTimedOut)
+{
+	AUTLobbyGameState* LobbyGameState = GetLobbyGameState();
+	FGameInstanceData* InstanceData = LobbyGameState->FindGameInstanceData(MatchInfo);
+	int32 UsedPhysicalKB = (!bTimedOut && InstanceData != NULL) ? InstanceData->UsedPhysicalKB : 0;
+	TArray<int32>& ProcessKB = (Phase == PHASE_Separate) ? SeparateProcessKB : SharedProcessKB;
+	ProcessKB.Add(UsedPhysicalKB);
+	if (bTimedOut)
+	{
+		UE_LOG(UT, Warning, TEXT("HubLaunchBenchmark: match %i wasn't ready after %.0fs"), ProcessKB.Num(), LaunchTimeout);
+	}
+	else if (Phase == PHASE_Shared && InstanceData->HostInstanceID != SharedHostInstanceID)
+	{
+		UE_LOG(UT, Warning, TEXT("HubLaunchBenchmark: shared match %i went to instance %i instead of %i, check SharedInstanceMaxPlayers"), ProcessKB.Num(), InstanceData->HostInstanceID, SharedHostInstanceID);
+	}
+	else
+	{
+		UE_LOG(UT, Log, TEXT("HubLaunchBenchmark: %s match %i ready, process uses %.1fMB"), (Phase == PHASE_Separate) ? TEXT("separate") : TEXT("shared"), ProcessKB.Num(), UsedPhysicalKB / 1024.0f);
+	}
+
+	if (bTimedOut)
+	{
+		LobbyGameState->TerminateGameInstance(MatchInfo);
+		MatchInfo->Destroy();
+	}
+	else
+	{
+		RunningMatches.Add(MatchInfo);
+	}
+	MatchInfo = NULL;
+}
+
+void AUTHubLaunchBenchmark::StopRunningMatches()
+{
+	AUTLobbyGameState* LobbyGameState = GetLobbyGameState();
+	for (AUTLobbyMatchInfo* RunningMatch : RunningMatches)
+	{
+		if (RunningMatch != NULL)
+		{
+			LobbyGameState->TerminateGameInstance(RunningMatch);
+			RunningMatch->Destroy();
+		}
+	}
+	RunningMatches.Empty();
+}
+
+void AUTHubLaunchBenchmark::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	AUTLobbyGameState* LobbyGameState = GetLobbyGameState();
+	if (Phase == PHASE_Done || LobbyGameState == NULL)
+	{
+		return;
+	}
+
+	if (MatchInfo != NULL)
+	{
+		bool bTimedOut = FPlatformTime::Seconds() - LaunchStartTime > LaunchTimeout;
+		bool bReady = MatchInfo->CurrentState == ELobbyMatchState::InProgress;
+		if (Phase == PHASE_Separate || Phase == PHASE_Shared)
+		{
+			// the instance sends its memory right after saying it's ready
+			FGameInstanceData* InstanceData = LobbyGameState->FindGameInstanceData(MatchInfo);
+			if ((bReady && InstanceData != NULL && InstanceData->UsedPhysicalKB > 0) || bTimedOut)
+			{
+				FinishMemoryLaunch(bTimedOut);
+			}
+		}
+		else if (bReady || bTimedOut)
+		{
+			FinishLaunch(bTimedOut);
+		}
+
+		if (MatchInfo == NULL)
+		{
+			if (Phase == PHASE_Cold && ColdTimes.Num() >= NumLaunches)
+			{
+				SetPoolSize(1);
+				Phase = PHASE_PooledSetup;
+			}
+			else if (Phase == PHASE_Pooled)
+			{
+				if (PooledTimes.Num() < NumLaunches)
+				{
+					Phase = PHASE_PooledSetup;
+				}
+				else if (NumMemoryMatches > 0)
+				{
+					SetPoolSize(0);
+					Phase = PHASE_SeparateSetup;
+				}
+				else
+				{
+					FinishBenchmark();
+				}
+			}
+			else if (Phase == PHASE_Separate && SeparateProcessKB.Num() >= NumMemoryMatches)
+			{
+				StopRunningMatches();
+
+				// one pooled process that takes every match
+				TWeakObjectPtr<AUTReplicatedGameRuleset> Ruleset = FindBenchmarkRuleset();
+				LobbyGameState->SharedInstanceMaxPlayers = FMath::Max(SavedSharedInstanceMaxPlayers, Ruleset.IsValid() ? Ruleset->MaxPlayers : 0);
+				SetPoolSize(1, NumMemoryMatches);
+				Phase = PHASE_SharedSetup;
+			}
+			else if (Phase == PHASE_Shared && SharedProcessKB.Num() >= NumMemoryMatches)
+			{
+				FinishBenchmark();
+			}
+		}
+		return;
+	}
+
+	if (Phase == PHASE_ColdSetup || Phase == PHASE_SeparateSetup)
+	{
+		if (LobbyGameState->InstancePool.Num() == 0)
+		{
+			Phase = (Phase == PHASE_ColdSetup) ? PHASE_Cold : PHASE_Separate;
+		}
+	}
+	else if (Phase == PHASE_PooledSetup)
+	{
+		// the previous pooled instance was used up, wait until its replacement has loaded its idle map
+		if (FindFreePooledInstance() != NULL)
+		{
+			Phase = PHASE_Pooled;
+		}
+	}
+	else if (Phase == PHASE_SharedSetup)
+	{
+		const FPooledGameInstance* Pooled = FindFreePooledInstance();
+		if (Pooled != NULL && Pooled->UsedPhysicalKB > 0)
+		{
+			SharedHostInstanceID = Pooled->InstanceID;
+			SharedIdleKB = Pooled->UsedPhysicalKB;
+			UE_LOG(UT, Log, TEXT("HubLaunchBenchmark: idle pooled instance %i uses %.1fMB"), SharedHostInstanceID, SharedIdleKB / 1024.0f);
+			Phase = PHASE_Shared;
+		}
+	}
+
+	if ((Phase == PHASE_Cold || Phase == PHASE_Pooled || Phase == PHASE_Separate || Phase == PHASE_Shared) && !Launch())
+	{
+		FinishBenchmark();
+	}
+}
+
+void AUTHubLaunchBenchmark::ReportTimes(const TCHAR* Title, const TArray<float>& Times, TSharedRef<FJsonObject> ReportJson)
+{
+	TSharedRef<FJsonObject> TimesJson = MakeShareable(new FJsonObject);
+	TArray< TSharedPtr<FJsonValue> > TimesArray;
+	float Total = 0.0f;
+	float MinTime = 0.0f;
+	float MaxTime = 0.0f;
+	int32 NumReady = 0;
+	for (float Time : Times)
+	{
+		TimesArray.Add(MakeShareable(new FJsonValueNumber(Time)));
+		if (Time > 0.0f)
+		{
+			MinTime = (NumReady == 0) ? Time : FMath::Min(MinTime, Time);
+			MaxTime = FMath::Max(MaxTime, Time);
+			Total += Time;
+			NumReady++;
+		}
+	}
+	float AvgTime = (NumReady > 0) ? Total / NumReady : 0.0f;
+	TimesJson->SetArrayField(TEXT("Seconds"), TimesArray);
+	TimesJson->SetNumberField(TEXT("Ready"), NumReady);
+	TimesJson->SetNumberField(TEXT("Avg"), AvgTime);
+	TimesJson->SetNumberField(TEXT("Min"), MinTime);
+	TimesJson->SetNumberField(TEXT("Max"), MaxTime);
+	ReportJson->SetObjectField(Title, TimesJson);
+
+	UE_LOG(UT, Log, TEXT("HubLaunchBenchmark %-6s: %i/%i ready, time to ready avg %6.2fs min %6.2fs max %6.2fs"), Title, NumReady, Times.Num(), AvgTime, MinTime, MaxTime);
+}
+
+void AUTHubLaunchBenchmark::ReportMemory(TSharedRef<FJsonObject> ReportJson)
+{
+	// a match in its own process costs the whole process
+	int64 SeparateTotalKB = 0;
+	int32 NumSeparate = 0;
+	TArray< TSharedPtr<FJsonValue> > SeparateArray;
+	for (int32 UsedPhysicalKB : SeparateProcessKB)
+	{
+		SeparateArray.Add(MakeShareable(new FJsonValueNumber(UsedPhysicalKB)));
+		if (UsedPhysicalKB > 0)
+		{
+			SeparateTotalKB += UsedPhysicalKB;
+			NumSeparate++;
+		}
+	}
+	float SeparatePerMatchMB = (NumSeparate > 0) ? SeparateTotalKB / (NumSeparate * 1024.0f) : 0.0f;
+
+	// a shared match costs what the process grew by
+	int32 SharedFinalKB = SharedIdleKB;
+	int32 NumShared = 0;
+	TArray< TSharedPtr<FJsonValue> > SharedArray;
+	for (int32 UsedPhysicalKB : SharedProcessKB)
+	{
+		SharedArray.Add(MakeShareable(new FJsonValueNumber(UsedPhysicalKB)));
+		if (UsedPhysicalKB > 0)
+		{
+			SharedFinalKB = UsedPhysicalKB;
+			NumShared++;
+		}
+	}
+	float SharedPerMatchMB = (NumShared > 0) ? (SharedFinalKB - SharedIdleKB) / (NumShared * 1024.0f) : 0.0f;
+
+	TSharedRef<FJsonObject> MemoryJson = MakeShareable(new FJsonObject);
+	MemoryJson->SetNumberField(TEXT("Matches"), NumMemoryMatches);
+	MemoryJson->SetArrayField(TEXT("SeparateProcessKB"), SeparateArray);
+	MemoryJson->SetNumberField(TEXT("SharedIdleKB"), SharedIdleKB);
+	MemoryJson->SetArrayField(TEXT("SharedProcessKB"), SharedArray);
+	MemoryJson->SetNumberField(TEXT("SeparateMBPerMatch"), SeparatePerMatchMB);
+	MemoryJson->SetNumberField(TEXT("SharedMBPerMatch"), SharedPerMatchMB);
+	ReportJson->SetObjectField(TEXT("Memory"), MemoryJson);
+
+	UE_LOG(UT, Log, TEXT("HubLaunchBenchmark memory per additional match: separate processes %.1fMB (%i matches), shared process %.1fMB (%i matches, idle process %.1fMB)"),
+		SeparatePerMatchMB, NumSeparate, SharedPerMatchMB, NumShared, SharedIdleKB / 1024.0f);
+}
+
+void AUTHubLaunchBenchmark::FinishBenchmark()
+{
+	StopRunningMatches();
+	Phase = PHASE_Done;
+
+	AUTLobbyGameState* LobbyGameState = GetLobbyGameState();
+	LobbyGameState->MinIdleInstances = SavedMinIdleInstances;
+	LobbyGameState->MaxIdleInstances = SavedMaxIdleInstances;
+	LobbyGameState->MaxMatchesPerInstance = SavedMaxMatchesPerInstance;
+	LobbyGameState->SharedInstanceMaxPlayers = SavedSharedInstanceMaxPlayers;
+
+	TSharedRef<FJsonObject> ReportJson = MakeShareable(new FJsonObject);
+	ReportJson->SetStringField(TEXT("Ruleset"), RulesetTag);
+	ReportJson->SetNumberField(TEXT("Launches"), NumLaunches);
+	ReportTimes(TEXT("Cold"), ColdTimes, ReportJson);
+	ReportTimes(TEXT("Pooled"), PooledTimes, ReportJson);
+	if (NumMemoryMatches > 0)
+	{
+		ReportMemory(ReportJson);
+	}
+
+	FString OutputJsonString;
+	TSharedRef< TJsonWriter< TCHAR, TPrettyJsonPrintPolicy<TCHAR> > > Writer = TJsonWriterFactory< TCHAR, TPrettyJsonPrintPolicy<TCHAR> >::Create(&OutputJsonString);
+	FJsonSerializer::Serialize(ReportJson, Writer);
+	if (FFileHelper::SaveStringToFile(OutputJsonString, *ReportFilename))
+	{
+		UE_LOG(UT, Log, TEXT("HubLaunchBenchmark: wrote %s"), *ReportFilename);
+	}
+	else
+	{
+		UE_LOG(UT, Error, TEXT("HubLaunchBenchmark: couldn't write %s"), *ReportFilename);
+	}
+
+	FPlatformMisc::RequestExit(false);
+}
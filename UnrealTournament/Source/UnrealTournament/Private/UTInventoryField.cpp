@@ -0,0 +1,236 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTInventoryField.h"
+#include "UTRecastNavMesh.h"
+#include "UTPickupInventory.h"
+#include "UTDroppedPickup.h"
+
+FUTInventoryField::FUTInventoryField()
+	: bInitialized(false)
+{
+}
+
+UClass* FUTInventoryField::GetPickupType(AUTPickup* Pickup)
+{
+	// all weapon lockers, health vials, etc are the same class, what they give tells them apart
+	AUTPickupInventory* InvPickup = Cast<AUTPickupInventory>(Pickup);
+	return (InvPickup != NULL && InvPickup->GetInventoryType() != NULL) ? *InvPickup->GetInventoryType() : Pickup->GetClass();
+}
+
+void FUTInventoryField::Init(AUTRecastNavMesh* NavMesh, const TArray<UUTPathNode*>& PathNodes)
+{
+	bInitialized = true;
+	Nodes = PathNodes;
+	for (int32 i = 0; i < Nodes.Num(); i++)
+	{
+		NodeIndices.Add(Nodes[i], i);
+		Nodes[i]->InventoryField.Reset();
+	}
+	OutLinks.SetNum(Nodes.Num());
+	InLinks.SetNum(Nodes.Num());
+
+	// links usable by a standard player; the default character stands in for crouching, nothing that needs a specific bot (translocator, etc) is used
+	const FNavAgentProperties& AgentProps = GetDefault<AUTCharacter>()->GetNavAgentPropertiesRef();
+	int32 Radius, Height, MaxFallSpeed;
+	uint32 MoveFlags;
+	AUTRecastNavMesh::CalcReachParams(GetMutableDefault<AUTCharacter>(), AgentProps, Radius, Height, MaxFallSpeed, MoveFlags);
+
+	for (int32 i = 0; i < Nodes.Num(); i++)
+	{
+		const UUTPathNode* Node = Nodes[i];
+		if (Node->Polys.Num() == 0)
+		{
+			continue;
+		}
+		// link costs depend on where in the node you start, go by the middle of the node
+		NavNodeRef CenterPoly = Node->Polys[0];
+		float BestDistSq = BIG_NUMBER;
+		for (NavNodeRef Poly : Node->Polys)
+		{
+			FVector PolyCenter;
+			if (NavMesh->GetPolyCenter(Poly, PolyCenter) && (PolyCenter - Node->Location).SizeSquared() < BestDistSq)
+			{
+				BestDistSq = (PolyCenter - Node->Location).SizeSquared();
+				CenterPoly = Poly;
+			}
+		}
+		for (const FUTPathLink& Link : Node->Paths)
+		{
+			const int32* EndIndex = Link.End.IsValid() ? NodeIndices.Find(Link.End.Get()) : NULL;
+			if (EndIndex != NULL && *EndIndex != i && Link.Supports(Radius, Height, MoveFlags))
+			{
+				const int32 Cost = Link.CostFor(NULL, AgentProps, CenterPoly, NavMesh);
+				if (Cost < BLOCKED_PATH_COST)
+				{
+					const FFieldLink OutLink = { *EndIndex, FMath::Max<int32>(Cost, 1) };
+					OutLinks[i].Add(OutLink);
+					const FFieldLink InLink = { i, OutLink.Cost };
+					InLinks[*EndIndex].Add(InLink);
+				}
+			}
+		}
+	}
+}
+
+int32 FUTInventoryField::FindOrAddType(UClass* TypeClass)
+{
+	int32 Type = Types.Find(TypeClass);
+	if (Type == INDEX_NONE)
+	{
+		Type = Types.Add(TypeClass);
+		for (UUTPathNode* Node : Nodes)
+		{
+			Node->InventoryField.Add(FUTInventoryFieldEntry());
+		}
+	}
+	return Type;
+}
+
+void FUTInventoryField::AddPickup(AUTRecastNavMesh* NavMesh, const TArray<UUTPathNode*>& PathNodes, AUTPickup* Pickup, UUTPathNode* Node)
+{
+	if (!bInitialized)
+	{
+		Init(NavMesh, PathNodes);
+	}
+	const int32* NodeIndex = NodeIndices.Find(Node);
+	if (NodeIndex == NULL || PickupToSource.Contains(Pickup))
+	{
+		return;
+	}
+
+	const int32 SourceIndex = (FreeSources.Num() > 0) ? FreeSources.Pop(false) : Sources.AddZeroed();
+	FSource& Source = Sources[SourceIndex];
+	Source.Pickup = Pickup;
+	Source.Node = *NodeIndex;
+	Source.Type = FindOrAddType(GetPickupType(Pickup));
+	Source.NodeDistance = FMath::Max<int32>(1, FMath::TruncToInt((Pickup->GetActorLocation() - Node->Location).Size()));
+	Source.bAvailable = false;
+	PickupToSource.Add(Pickup, SourceIndex);
+
+	if (Pickup->State.bActive)
+	{
+		SetSourceAvailable(SourceIndex, true);
+	}
+}
+
+void FUTInventoryField::RemovePickup(AUTPickup* Pickup)
+{
+	int32 SourceIndex = INDEX_NONE;
+	if (PickupToSource.RemoveAndCopyValue(Pickup, SourceIndex))
+	{
+		SetSourceAvailable(SourceIndex, false);
+		Sources[SourceIndex].Pickup.Reset();
+		FreeSources.Add(SourceIndex);
+	}
+}
+
+void FUTInventoryField::PickupStateChanged(AUTPickup* Pickup)
+{
+	const int32* SourceIndex = PickupToSource.Find(Pickup);
+	if (SourceIndex != NULL)
+	{
+		SetSourceAvailable(*SourceIndex, Pickup->State.bActive);
+	}
+}
+
+void FUTInventoryField::AddDroppedPickup(AUTDroppedPickup* Pickup)
+{
+	DroppedPickups.AddUnique(Pickup);
+}
+
+void FUTInventoryField::RemoveDroppedPickup(AUTDroppedPickup* Pickup)
+{
+	DroppedPickups.RemoveSingleSwap(Pickup);
+}
+
+void FUTInventoryField::OfferDistance(int32 Node, int32 Type, int32 Distance, int32 SourceIndex)
+{
+	FUTInventoryFieldEntry& Entry = Nodes[Node]->InventoryField[Type];
+	if (Distance < Entry.Distance)
+	{
+		Entry.Distance = Distance;
+		Entry.Source = SourceIndex;
+		OpenNodes.HeapPush(FOpenNode(Distance, Node));
+	}
+}
+
+void FUTInventoryField::Propagate(int32 Type)
+{
+	while (OpenNodes.Num() > 0)
+	{
+		FOpenNode Open(0, 0);
+		OpenNodes.HeapPop(Open);
+		const FUTInventoryFieldEntry& Entry = Nodes[Open.Node]->InventoryField[Type];
+		// stale, the node got closer after it was queued
+		if (Open.Distance == Entry.Distance)
+		{
+			for (const FFieldLink& Link : InLinks[Open.Node])
+			{
+				OfferDistance(Link.Node, Type, Open.Distance + Link.Cost, Entry.Source);
+			}
+		}
+	}
+}
+
+void FUTInventoryField::SetSourceAvailable(int32 SourceIndex, bool bAvailable)
+{
+	FSource& Source = Sources[SourceIndex];
+	if (Source.bAvailable == bAvailable)
+	{
+		return;
+	}
+	Source.bAvailable = bAvailable;
+	const int32 Type = Source.Type;
+	OpenNodes.Reset();
+
+	if (bAvailable)
+	{
+		// only nodes that are now closer to this pickup than to anything else change
+		OfferDistance(Source.Node, Type, Source.NodeDistance, SourceIndex);
+	}
+	else
+	{
+		// the nodes that led to this pickup form a tree around it, clear them...
+		TArray<int32> Affected;
+		if (Nodes[Source.Node]->InventoryField[Type].Source == SourceIndex)
+		{
+			Nodes[Source.Node]->InventoryField[Type].Source = INDEX_NONE;
+			Affected.Add(Source.Node);
+		}
+		for (int32 i = 0; i < Affected.Num(); i++)
+		{
+			for (const FFieldLink& Link : InLinks[Affected[i]])
+			{
+				if (Nodes[Link.Node]->InventoryField[Type].Source == SourceIndex)
+				{
+					Nodes[Link.Node]->InventoryField[Type].Source = INDEX_NONE;
+					Affected.Add(Link.Node);
+				}
+			}
+		}
+		for (int32 Node : Affected)
+		{
+			Nodes[Node]->InventoryField[Type] = FUTInventoryFieldEntry();
+		}
+		// ...then fill them in again from the other pickups in the cleared area and the neighbors outside of it
+		for (int32 i = 0; i < Sources.Num(); i++)
+		{
+			if (Sources[i].bAvailable && Sources[i].Type == Type && Nodes[Sources[i].Node]->InventoryField[Type].Source == INDEX_NONE)
+			{
+				OfferDistance(Sources[i].Node, Type, Sources[i].NodeDistance, i);
+			}
+		}
+		for (int32 Node : Affected)
+		{
+			for (const FFieldLink& Link : OutLinks[Node])
+			{
+				const FUTInventoryFieldEntry& NeighborEntry = Nodes[Link.Node]->InventoryField[Type];
+				if (NeighborEntry.Source != INDEX_NONE)
+				{
+					OfferDistance(Node, Type, NeighborEntry.Distance + Link.Cost, NeighborEntry.Source);
+				}
+			}
+		}
+	}
+	Propagate(Type);
+}
@@ -10,6 +10,7 @@
 #include "UTLobbyHUD.h"
 #include "UTGameMessage.h"
 #include "UTAnalytics.h"
+#include "UTHubLaunchBenchmark.h"
 #include "Runtime/Analytics/Analytics/Public/Analytics.h"
 #include "Runtime/Analytics/Analytics/Public/Interfaces/IAnalyticsProvider.h"
 
@@ -73,6 +74,19 @@ void AUTLobbyGameMode::InitGameState()
 		// Setupo the beacons to listen for updates from Game Server Instances
 		UTLobbyGameState->SetupLobbyBeacons();
 
+		int32 NumBenchmarkLaunches = 0;
+		if (AUTHubLaunchBenchmark::WantsBenchmark(NumBenchmarkLaunches))
+		{
+			FActorSpawnParameters Params;
+			Params.Owner = this;
+			AUTHubLaunchBenchmark* HubLaunchBenchmark = GetWorld()->SpawnActor<AUTHubLaunchBenchmark>(AUTHubLaunchBenchmark::StaticClass(), Params);
+			if (HubLaunchBenchmark != NULL)
+			{
+				HubLaunchBenchmark->NumLaunches = NumBenchmarkLaunches;
+				HubLaunchBenchmark->StartBenchmark();
+			}
+		}
+
 		// Break the MOTD up in to strings to be sent to clients when they login.
 		FString Converted = UTLobbyGameState->ServerMOTD.Replace( TEXT("\\n"), TEXT("\n"));
 		Converted.ParseIntoArray(ParsedMOTD,TEXT("\n"),true);
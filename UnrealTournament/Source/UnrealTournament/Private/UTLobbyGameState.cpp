@@ -12,6 +12,14 @@
 AUTLobbyGameState::AUTLobbyGameState(const class FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
+	IdleInstanceURL = TEXT("UT-Entry?Game=DM?BotFill=0");
+	MinIdleInstances = 1;
+	MaxIdleInstances = 4;
+	InstancePoolDemandWindow = 600.0f;
+	MaxMatchesPerPooledInstance = 10;
+	PooledInstanceTimeout = 120.0f;
+	MaxMatchesPerInstance = 1;
+	SharedInstanceMaxPlayers = 2;
 }
 
 void AUTLobbyGameState::BeginPlay()
@@ -38,6 +46,9 @@ void AUTLobbyGameState::PostInitializeComponents()
 		FTimerHandle TempHandle;
 		GetWorldTimerManager().SetTimer(TempHandle, this, &AUTLobbyGameState::CheckInstanceHealth, 60.0f, true);	
 
+		FTimerHandle PoolHandle;
+		GetWorldTimerManager().SetTimer(PoolHandle, this, &AUTLobbyGameState::MaintainInstancePool, 5.0f, true);
+
 		// Grab all of the available map assets.
 		TArray<FAssetData> MapAssets;
 		FindAllPlayableMaps(MapAssets);
@@ -105,7 +116,13 @@ void AUTLobbyGameState::CheckInstanceHealth()
 				{
 					UE_LOG(UT, Log, TEXT("Recycling game instance that no longer has a process"));
 					MatchInfo->SetLobbyMatchState(ELobbyMatchState::Recycling);
-					ProcessesToGetReturnCode.Add(MatchInfo->GameInstanceProcessHandle);
+
+					// Matches sharing a process hold the pooled instance's handle, the pool waits on that one
+					FGameInstanceData* InstanceData = FindGameInstanceData(MatchInfo);
+					if (InstanceData == NULL || InstanceData->HostInstanceID == 0)
+					{
+						ProcessesToGetReturnCode.Add(MatchInfo->GameInstanceProcessHandle);
+					}
 					MatchInfo->GameInstanceProcessHandle.Reset();
 				}
 			}
@@ -404,41 +421,87 @@ void AUTLobbyGameState::LaunchGameInstance(AUTLobbyMatchInfo* MatchOwner, FStrin
 	AUTLobbyGameMode* LobbyGame = GetWorld()->GetAuthGameMode<AUTLobbyGameMode>();
 	if (LobbyGame && MatchOwner && MatchOwner->CurrentRuleset.IsValid())
 	{
-		GameInstanceID++;
-		if (GameInstanceID == 0) GameInstanceID = 1;	// Always skip 0.
+		RecentLaunchTimes.Add(FPlatformTime::Seconds());
 
 		// Apply additional options.
 		if (!ForcedInstanceGameOptions.IsEmpty()) GameURL += ForcedInstanceGameOptions;
 
-		GameURL += FString::Printf(TEXT("?InstanceID=%i?HostPort=%i"), GameInstanceID, GameInstanceListenPort);
+		// Small matches can run next to others inside an idle instance, which saves a whole process per match.
+		int32 HostIndex = FindSharedMatchHost(MatchOwner);
 
-		int32 InstancePort = LobbyGame->StartingInstancePort + (LobbyGame->InstancePortStep * GameInstances.Num());
+		// Otherwise use an idle instance if there is one, it only has to load the map.
+		int32 PoolIndex = INDEX_NONE;
+		for (int32 i = 0; i < InstancePool.Num() && HostIndex == INDEX_NONE; i++)
+		{
+			if (InstancePool[i].IsIdle() && InstancePool[i].NumSharedMatches == 0 && FPlatformProcess::IsProcRunning(InstancePool[i].ProcessHandle))
+			{
+				PoolIndex = i;
+				break;
+			}
+		}
 
-		FString ExecPath = FPlatformProcess::GenerateApplicationPath(FApp::GetName(), FApp::GetBuildConfiguration());
-		FString Options = FString::Printf(TEXT("UnrealTournament %s -server -port=%i -log"), *GameURL, InstancePort);
-		
-		// Add in additional command line params
-		if (!AdditionalInstanceCommandLine.IsEmpty()) Options += TEXT(" ") + AdditionalInstanceCommandLine;
+		if (HostIndex != INDEX_NONE)
+		{
+			FPooledGameInstance& Host = InstancePool[HostIndex];
+			uint32 NewInstanceID = GetNextGameInstanceID();
+			int32 InstancePort = FindFreeInstancePort();
+			GameURL += FString::Printf(TEXT("?InstanceID=%i?HostPort=%i"), NewInstanceID, GameInstanceListenPort);
+			UE_LOG(UT,Verbose,TEXT("Pooled instance %i will host the match %s next to %i others"), Host.InstanceID, *GameURL, Host.NumSharedMatches);
+
+			Host.Beacon->Instance_HostMatch(GameURL, InstancePort);
+			Host.NumSharedMatches++;
+
+			MatchOwner->GameInstanceProcessHandle = Host.ProcessHandle;
+			int32 Index = GameInstances.Add(FGameInstanceData(MatchOwner, InstancePort, 1, true));
+			GameInstances[Index].HostInstanceID = Host.InstanceID;
+			MatchOwner->SetLobbyMatchState(ELobbyMatchState::Launching);
+			MatchOwner->GameInstanceID = NewInstanceID;
+
+			// The host can't take a match of its own anymore
+			MaintainInstancePool();
+		}
+		else if (PoolIndex != INDEX_NONE)
+		{
+			FPooledGameInstance Pooled = InstancePool[PoolIndex];
+			InstancePool.RemoveAt(PoolIndex);
 
-		UE_LOG(UT,Verbose,TEXT("Launching %s with Params %s"), *ExecPath, *Options);
+			GameURL += FString::Printf(TEXT("?InstanceID=%i?HostPort=%i"), Pooled.InstanceID, GameInstanceListenPort);
+			UE_LOG(UT,Verbose,TEXT("Giving pooled instance %i the match %s"), Pooled.InstanceID, *GameURL);
 
-		MatchOwner->GameInstanceProcessHandle = FPlatformProcess::CreateProc(*ExecPath, *Options, true, false, false, NULL, 0, NULL, NULL);
+			Pooled.Beacon->Instance_AssignMatch(GameURL);
 
-		if (MatchOwner->GameInstanceProcessHandle.IsValid())
-		{
-			GameInstances.Add(FGameInstanceData(MatchOwner, InstancePort));
+			MatchOwner->GameInstanceProcessHandle = Pooled.ProcessHandle;
+			GameInstances.Add(FGameInstanceData(MatchOwner, Pooled.InstancePort, Pooled.NumMatchesHosted + 1, true));
 			MatchOwner->SetLobbyMatchState(ELobbyMatchState::Launching);
-			MatchOwner->GameInstanceID = GameInstanceID;
+			MatchOwner->GameInstanceID = Pooled.InstanceID;
+
+			// Replace the instance we just used
+			MaintainInstancePool();
 		}
 		else
 		{
-			UE_LOG(UT,Warning,TEXT("Could not start an instance (the ProcHandle is Invalid)"));
-			if (MatchOwner)
+			uint32 NewInstanceID = GetNextGameInstanceID();
+			GameURL += FString::Printf(TEXT("?InstanceID=%i?HostPort=%i"), NewInstanceID, GameInstanceListenPort);
+
+			int32 InstancePort = FindFreeInstancePort();
+			MatchOwner->GameInstanceProcessHandle = CreateInstanceProcess(GameURL, InstancePort);
+
+			if (MatchOwner->GameInstanceProcessHandle.IsValid())
 			{
-				TWeakObjectPtr<AUTLobbyPlayerState> OwnerPS = MatchOwner->GetOwnerPlayerState();
-				if (OwnerPS.IsValid())
+				GameInstances.Add(FGameInstanceData(MatchOwner, InstancePort, 1, false));
+				MatchOwner->SetLobbyMatchState(ELobbyMatchState::Launching);
+				MatchOwner->GameInstanceID = NewInstanceID;
+			}
+			else
+			{
+				UE_LOG(UT,Warning,TEXT("Could not start an instance (the ProcHandle is Invalid)"));
+				if (MatchOwner)
 				{
-					OwnerPS->ClientMatchError(NSLOCTEXT("LobbyMessage", "FailedToStart", "Unfortunately, the server had trouble starting a new instance.  Please try again in a few moments."));
+					TWeakObjectPtr<AUTLobbyPlayerState> OwnerPS = MatchOwner->GetOwnerPlayerState();
+					if (OwnerPS.IsValid())
+					{
+						OwnerPS->ClientMatchError(NSLOCTEXT("LobbyMessage", "FailedToStart", "Unfortunately, the server had trouble starting a new instance.  Please try again in a few moments."));
+					}
 				}
 			}
 		}
@@ -451,9 +514,203 @@ void AUTLobbyGameState::LaunchGameInstance(AUTLobbyMatchInfo* MatchOwner, FStrin
 	}
 }
 
+uint32 AUTLobbyGameState::GetNextGameInstanceID()
+{
+	GameInstanceID++;
+	if (GameInstanceID == 0) GameInstanceID = 1;	// Always skip 0.
+	return GameInstanceID;
+}
+
+int32 AUTLobbyGameState::FindFreeInstancePort()
+{
+	AUTLobbyGameMode* LobbyGame = GetWorld()->GetAuthGameMode<AUTLobbyGameMode>();
+	for (int32 Slot = 0; ; Slot++)
+	{
+		int32 InstancePort = LobbyGame->StartingInstancePort + (LobbyGame->InstancePortStep * Slot);
+		bool bInUse = false;
+		for (int32 i = 0; i < GameInstances.Num() && !bInUse; i++)
+		{
+			bInUse = GameInstances[i].InstancePort == InstancePort;
+		}
+		for (int32 i = 0; i < InstancePool.Num() && !bInUse; i++)
+		{
+			bInUse = InstancePool[i].InstancePort == InstancePort;
+		}
+
+		if (!bInUse)
+		{
+			return InstancePort;
+		}
+	}
+}
+
+FProcHandle AUTLobbyGameState::CreateInstanceProcess(const FString& GameURL, int32 InstancePort)
+{
+	FString ExecPath = FPlatformProcess::GenerateApplicationPath(FApp::GetName(), FApp::GetBuildConfiguration());
+	FString Options = FString::Printf(TEXT("UnrealTournament %s -server -port=%i -log"), *GameURL, InstancePort);
+		
+	// Add in additional command line params
+	if (!AdditionalInstanceCommandLine.IsEmpty()) Options += TEXT(" ") + AdditionalInstanceCommandLine;
+
+	UE_LOG(UT,Verbose,TEXT("Launching %s with Params %s"), *ExecPath, *Options);
+
+	return FPlatformProcess::CreateProc(*ExecPath, *Options, true, false, false, NULL, 0, NULL, NULL);
+}
+
+FString AUTLobbyGameState::GetIdleInstanceURL(uint32 InInstanceID)
+{
+	return IdleInstanceURL + FString::Printf(TEXT("?InstanceID=%i?HostPort=%i?PoolIdle=1"), InInstanceID, GameInstanceListenPort);
+}
+
+int32 AUTLobbyGameState::GetNumFreePooledInstances()
+{
+	int32 NumFree = 0;
+	for (int32 i = 0; i < InstancePool.Num(); i++)
+	{
+		if (InstancePool[i].NumSharedMatches == 0)
+		{
+			NumFree++;
+		}
+	}
+	return NumFree;
+}
+
+int32 AUTLobbyGameState::FindSharedMatchHost(AUTLobbyMatchInfo* MatchOwner)
+{
+	if (MaxMatchesPerInstance <= 1 || !MatchOwner->CurrentRuleset.IsValid() || MatchOwner->CurrentRuleset->MaxPlayers > SharedInstanceMaxPlayers)
+	{
+		return INDEX_NONE;
+	}
+
+	// Fill up the instances that already share before starting on a free one, so free ones stay around for big matches
+	int32 BestIndex = INDEX_NONE;
+	for (int32 i = 0; i < InstancePool.Num(); i++)
+	{
+		const FPooledGameInstance& Pooled = InstancePool[i];
+		if (Pooled.IsIdle() && Pooled.NumSharedMatches < MaxMatchesPerInstance && FPlatformProcess::IsProcRunning(Pooled.ProcessHandle) &&
+			(BestIndex == INDEX_NONE || Pooled.NumSharedMatches > InstancePool[BestIndex].NumSharedMatches))
+		{
+			BestIndex = i;
+		}
+	}
+	return BestIndex;
+}
+
+FGameInstanceData* AUTLobbyGameState::FindGameInstanceData(AUTLobbyMatchInfo* MatchOwner)
+{
+	for (int32 i = 0; i < GameInstances.Num(); i++)
+	{
+		if (GameInstances[i].MatchInfo == MatchOwner)
+		{
+			return &GameInstances[i];
+		}
+	}
+	return NULL;
+}
+
+int32 AUTLobbyGameState::GetTargetPoolSize()
+{
+	return FMath::Clamp<int32>(RecentLaunchTimes.Num(), MinIdleInstances, MaxIdleInstances);
+}
+
+void AUTLobbyGameState::MaintainInstancePool()
+{
+	AUTLobbyGameMode* LobbyGame = GetWorld()->GetAuthGameMode<AUTLobbyGameMode>();
+	if (LobbyGame == NULL || LobbyBeacon_Listener == NULL)
+	{
+		return;
+	}
+
+	double Now = FPlatformTime::Seconds();
+	while (RecentLaunchTimes.Num() > 0 && Now - RecentLaunchTimes[0] > InstancePoolDemandWindow)
+	{
+		RecentLaunchTimes.RemoveAt(0);
+	}
+
+	for (int32 i = InstancePool.Num() - 1; i >= 0; i--)
+	{
+		FPooledGameInstance& Pooled = InstancePool[i];
+		if (Pooled.IsIdle())
+		{
+			Pooled.LastSeenTime = Now;
+		}
+		else if (!FPlatformProcess::IsProcRunning(Pooled.ProcessHandle) || Now - Pooled.LastSeenTime > PooledInstanceTimeout)
+		{
+			UE_LOG(UT, Log, TEXT("Pooled instance %i has gone away, removing it from the pool"), Pooled.InstanceID);
+			TerminatePooledInstance(i);
+		}
+	}
+
+	int32 TargetPoolSize = GetTargetPoolSize();
+	int32 NumFreeInstances = GetNumFreePooledInstances();
+	while (NumFreeInstances < TargetPoolSize && GameInstances.Num() + InstancePool.Num() < LobbyGame->MaxInstances)
+	{
+		uint32 NewInstanceID = GetNextGameInstanceID();
+		int32 InstancePort = FindFreeInstancePort();
+		FProcHandle ProcessHandle = CreateInstanceProcess(GetIdleInstanceURL(NewInstanceID), InstancePort);
+		if (!ProcessHandle.IsValid())
+		{
+			UE_LOG(UT,Warning,TEXT("Could not start a pooled instance (the ProcHandle is Invalid)"));
+			break;
+		}
+		InstancePool.Add(FPooledGameInstance(NewInstanceID, InstancePort, ProcessHandle, 0));
+		NumFreeInstances++;
+	}
+
+	// Shut down idle instances nobody needs anymore, oldest first.  Ones still starting up or hosting small matches are left alone.
+	for (int32 i = 0; i < InstancePool.Num() && NumFreeInstances > TargetPoolSize; )
+	{
+		if (InstancePool[i].IsIdle() && InstancePool[i].NumSharedMatches == 0)
+		{
+			UE_LOG(UT, Verbose, TEXT("Shutting down pooled instance %i, the pool only needs %i"), InstancePool[i].InstanceID, TargetPoolSize);
+			TerminatePooledInstance(i);
+			NumFreeInstances--;
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+void AUTLobbyGameState::TerminatePooledInstance(int32 PoolIndex)
+{
+	FPooledGameInstance& Pooled = InstancePool[PoolIndex];
+	if (FPlatformProcess::IsProcRunning(Pooled.ProcessHandle))
+	{
+		FPlatformProcess::TerminateProc(Pooled.ProcessHandle);
+	}
+	ProcessesToGetReturnCode.Add(Pooled.ProcessHandle);
+	InstancePool.RemoveAt(PoolIndex);
+}
+
 void AUTLobbyGameState::TerminateGameInstance(AUTLobbyMatchInfo* MatchOwner, bool bAborting)
 {
-	if (MatchOwner->GameInstanceProcessHandle.IsValid())
+	// A match that shares a pooled instance's process is shut down by that instance, the process keeps running
+	FGameInstanceData* InstanceData = FindGameInstanceData(MatchOwner);
+	if (InstanceData != NULL && InstanceData->HostInstanceID != 0)
+	{
+		for (int32 i = 0; i < InstancePool.Num(); i++)
+		{
+			if (InstancePool[i].InstanceID == InstanceData->HostInstanceID)
+			{
+				InstancePool[i].NumSharedMatches = FMath::Max<int32>(InstancePool[i].NumSharedMatches - 1, 0);
+				if (InstancePool[i].Beacon.IsValid() && MatchOwner->GameInstanceID != 0)
+				{
+					InstancePool[i].Beacon->Instance_StopHostedMatch(MatchOwner->GameInstanceID);
+				}
+				break;
+			}
+		}
+
+		if (MatchOwner->GameInstanceProcessHandle.IsValid())
+		{
+			MatchOwner->SetLobbyMatchState(bAborting ? ELobbyMatchState::WaitingForPlayers : ELobbyMatchState::Recycling);
+			MatchOwner->GameInstanceProcessHandle.Reset();
+		}
+		MatchOwner->GameInstanceID = 0;
+	}
+	else if (MatchOwner->GameInstanceProcessHandle.IsValid())
 	{
 		// if we have an active game instance that is coming up but we have not started the travel to it yet, Kill the instance.
 		if (FPlatformProcess::IsProcRunning(MatchOwner->GameInstanceProcessHandle))
@@ -492,12 +749,81 @@ void AUTLobbyGameState::GameInstance_Ready(uint32 InGameInstanceID, FGuid GameIn
 	{
 		if (GameInstances[i].MatchInfo->GameInstanceID == InGameInstanceID)
 		{
+			// An instance can report in more than once, only the first one counts
+			if (GameInstances[i].LaunchTime > 0.0)
+			{
+				double TimeToReady = FPlatformTime::Seconds() - GameInstances[i].LaunchTime;
+				GameInstances[i].LaunchTime = 0.0;
+				GameInstances[i].TimeToReady = float(TimeToReady);
+				if (GameInstances[i].bPooledLaunch)
+				{
+					NumPooledLaunches++;
+					TotalPooledLaunchTime += TimeToReady;
+				}
+				else
+				{
+					NumColdLaunches++;
+					TotalColdLaunchTime += TimeToReady;
+				}
+				UE_LOG(UT, Log, TEXT("Game instance %i ready %.2fs after launch (%s).  Average %.2fs over %i pooled launches, %.2fs over %i cold launches."),
+					InGameInstanceID, TimeToReady, GameInstances[i].bPooledLaunch ? TEXT("pooled") : TEXT("cold"),
+					NumPooledLaunches > 0 ? TotalPooledLaunchTime / NumPooledLaunches : 0.0, NumPooledLaunches,
+					NumColdLaunches > 0 ? TotalColdLaunchTime / NumColdLaunches : 0.0, NumColdLaunches);
+			}
+
 			GameInstances[i].MatchInfo->GameInstanceReady(GameInstanceGUID);
 			break;
 		}
 	}
 }
 
+void AUTLobbyGameState::GameInstance_Memory(uint32 InGameInstanceID, int32 UsedPhysicalKB)
+{
+	for (int32 i = 0; i < GameInstances.Num(); i++)
+	{
+		if (GameInstances[i].MatchInfo->GameInstanceID == InGameInstanceID)
+		{
+			GameInstances[i].UsedPhysicalKB = UsedPhysicalKB;
+
+			// A shared match reports for the whole process it runs in
+			InGameInstanceID = (GameInstances[i].HostInstanceID != 0) ? GameInstances[i].HostInstanceID : InGameInstanceID;
+			break;
+		}
+	}
+
+	for (int32 i = 0; i < InstancePool.Num(); i++)
+	{
+		if (InstancePool[i].InstanceID == InGameInstanceID)
+		{
+			InstancePool[i].UsedPhysicalKB = UsedPhysicalKB;
+			break;
+		}
+	}
+
+	UE_LOG(UT, Verbose, TEXT("Game instance %i is using %.1fMB"), InGameInstanceID, UsedPhysicalKB / 1024.0f);
+}
+
+void AUTLobbyGameState::GameInstance_Idle(AUTServerBeaconLobbyClient* Beacon, uint32 InGameInstanceID)
+{
+	for (int32 i = 0; i < InstancePool.Num(); i++)
+	{
+		if (InstancePool[i].InstanceID == InGameInstanceID)
+		{
+			if (!InstancePool[i].IsIdle())
+			{
+				UE_LOG(UT, Verbose, TEXT("Pooled instance %i is idle, took %.2fs"), InGameInstanceID, FPlatformTime::Seconds() - InstancePool[i].PoolTime);
+			}
+			InstancePool[i].Beacon = Beacon;
+			InstancePool[i].LastSeenTime = FPlatformTime::Seconds();
+			return;
+		}
+	}
+
+	// Not one of ours (anymore), don't leave it running where nobody keeps track of it
+	UE_LOG(UT, Log, TEXT("Unknown pooled instance %i reported in, telling it to shut down"), InGameInstanceID);
+	Beacon->Instance_LeavePool();
+}
+
 void AUTLobbyGameState::GameInstance_MatchUpdate(uint32 InGameInstanceID, const FString& Update)
 {
 	for (int32 i = 0; i < GameInstances.Num(); i++)
@@ -584,17 +910,31 @@ void AUTLobbyGameState::GameInstance_EndGame(uint32 InGameInstanceID, const FStr
 	}
 }
 
-void AUTLobbyGameState::GameInstance_Empty(uint32 InGameInstanceID)
+void AUTLobbyGameState::GameInstance_Empty(AUTServerBeaconLobbyClient* Beacon, uint32 InGameInstanceID)
 {
 	for (int32 i = 0; i < GameInstances.Num(); i++)
 	{
-		if (GameInstances[i].MatchInfo->GameInstanceID == InGameInstanceID && !GameInstances[i].MatchInfo->bDedicatedMatch)
+		AUTLobbyMatchInfo* MatchInfo = GameInstances[i].MatchInfo;
+		if (MatchInfo->GameInstanceID == InGameInstanceID && !MatchInfo->bDedicatedMatch)
 		{
 			// Set the match info's state to recycling so all returning players will be directed properly.
-			GameInstances[i].MatchInfo->SetLobbyMatchState(ELobbyMatchState::Recycling);
+			MatchInfo->SetLobbyMatchState(ELobbyMatchState::Recycling);
+
+			// If the pool could use another instance, send this one back to the idle map instead of killing it
+			if (Beacon != NULL && GameInstances[i].HostInstanceID == 0 && GameInstances[i].NumMatchesHosted < MaxMatchesPerPooledInstance && GetNumFreePooledInstances() < GetTargetPoolSize() &&
+				MatchInfo->GameInstanceProcessHandle.IsValid() && FPlatformProcess::IsProcRunning(MatchInfo->GameInstanceProcessHandle))
+			{
+				UE_LOG(UT, Verbose, TEXT("Returning instance %i to the pool after %i matches"), InGameInstanceID, GameInstances[i].NumMatchesHosted);
+				InstancePool.Add(FPooledGameInstance(InGameInstanceID, GameInstances[i].InstancePort, MatchInfo->GameInstanceProcessHandle, GameInstances[i].NumMatchesHosted));
+				Beacon->Instance_ReturnToPool(GetIdleInstanceURL(InGameInstanceID));
+
+				// The process belongs to the pool now, so terminating the match leaves it running
+				MatchInfo->GameInstanceProcessHandle.Reset();
+				MatchInfo->GameInstanceID = 0;
+			}
 
 			// Terminate the game instance
-			TerminateGameInstance(GameInstances[i].MatchInfo);
+			TerminateGameInstance(MatchInfo);
 			break;
 		}
 	}
@@ -56,6 +56,9 @@ AUTPickup::AUTPickup(const FObjectInitializer& ObjectInitializer)
 	bAlwaysRelevant = true;
 	NetUpdateFrequency = 1.0f;
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bRunInParallelBatch = true;
+	ParallelRespawnProgress = -1.0f;
+	ParallelRespawnProgressFrame = 0;
 	PickupMessageString = NSLOCTEXT("PickupMessage", "ItemPickedUp", "Item snagged.");
 	bHasTacComView = false;
 	TeamSide = 255;
@@ -90,6 +93,7 @@ void AUTPickup::BeginPlay()
 
 void AUTPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	FUTTickAggregator::Remove(AggregatedTick);
 	Super::EndPlay(EndPlayReason);
 
 	GetWorldTimerManager().ClearAllTimersForObject(this);
@@ -235,6 +239,12 @@ void AUTPickup::StartSleeping_Implementation()
 		State.bActive = false;
 		State.ChangeCounter++;
 		ForceNetUpdate();
+
+		AUTRecastNavMesh* NavData = GetUTNavData(GetWorld());
+		if (NavData != NULL)
+		{
+			NavData->PickupStateChanged(this);
+		}
 	}
 }
 void AUTPickup::PlayTakenEffects(bool bReplicate)
@@ -280,6 +290,12 @@ void AUTPickup::WakeUp_Implementation()
 		State.ChangeCounter++;
 		ForceNetUpdate();
 		LastRespawnTime = GetWorld()->TimeSeconds;
+
+		AUTRecastNavMesh* NavData = GetUTNavData(GetWorld());
+		if (NavData != NULL)
+		{
+			NavData->PickupStateChanged(this);
+		}
 	}
 
 	PlayRespawnEffects();
@@ -333,18 +349,40 @@ float AUTPickup::GetRespawnTimeOffset(APawn* Asker) const
 	}
 }
 
+float AUTPickup::GetRespawnProgress() const
+{
+	const FTimerManager& TimerManager = GetWorldTimerManager();
+	if (RespawnTime > 0.0f && !State.bActive && TimerManager.IsTimerActive(WakeUpTimerHandle))
+	{
+		return 1.0f - TimerManager.GetTimerRemaining(WakeUpTimerHandle) / RespawnTime;
+	}
+	return -1.0f;
+}
+
+void AUTPickup::ParallelTick(float DeltaSeconds)
+{
+	// the timer lookups search the whole timer list, which adds up with many pickups, so they are done in the parallel batch
+	ParallelRespawnProgress = GetRespawnProgress();
+	ParallelRespawnProgressFrame = GFrameCounter;
+}
+
 void AUTPickup::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	UWorld* World = GetWorld();
-	if (RespawnTime > 0.0f && !State.bActive && World->GetTimerManager().IsTimerActive(WakeUpTimerHandle))
+	if (TimerEffect != NULL)
 	{
-		if (TimerEffect != NULL)
+		const float Progress = (ParallelRespawnProgressFrame == GFrameCounter) ? ParallelRespawnProgress : GetRespawnProgress();
+		if (Progress >= 0.0f && !State.bActive)
 		{
-			TimerEffect->SetFloatParameter(NAME_Progress, 1.0f - World->GetTimerManager().GetTimerRemaining(WakeUpTimerHandle) / RespawnTime);
+			TimerEffect->SetFloatParameter(NAME_Progress, Progress);
 		}
 	}
+
+	if (!AggregatedTick.IsAggregated() && !IsPendingKillPending())
+	{
+		FUTTickAggregator::Add(PrimaryActorTick, this, GetLevel(), AggregatedTick);
+	}
 }
 
 float AUTPickup::BotDesireability_Implementation(APawn* Asker, float PathDistance)
@@ -12,6 +12,8 @@
 #include "Slate/SUWPlayerInfoDialog.h"
 #include "Slate/Widgets/SUTTabWidget.h"
 #include "StatNames.h"
+#include "UTStatRegistry.h"
+#include "UTStatsUploader.h"
 #include "UTAnalytics.h"
 #include "Runtime/Analytics/Analytics/Public/Analytics.h"
 #include "Runtime/Analytics/Analytics/Public/Interfaces/IAnalyticsProvider.h"
@@ -22,6 +24,7 @@ AUTPlayerState::AUTPlayerState(const class FObjectInitializer& ObjectInitializer
 	: Super(ObjectInitializer)
 {
 	bWaitingPlayer = false;
+	StatsData.AddZeroed(FUTStatRegistry::NumStats());
 	bReadyToPlay = false;
 	bPendingTeamSwitch = false;
 	bCaster = false;
@@ -197,10 +200,10 @@ void AUTPlayerState::IncrementKills(TSubclassOf<UDamageType> DamageType, bool bE
 		bool bAnnounceWeaponSpree = false;
 		if (UTDamage)
 		{
-			if (!UTDamage.GetDefaultObject()->StatsName.IsEmpty())
+			const int32 KillStatsIndex = UTDamage.GetDefaultObject()->GetKillStatsIndex();
+			if (KillStatsIndex != INDEX_NONE)
 			{
-				// FIXMESTEVE - preset, not constructed FName
-				ModifyStatsValue(FName(*(UTDamage.GetDefaultObject()->StatsName + TEXT("Kills"))), 1);
+				ModifyStatsValueByIndex(KillStatsIndex, 1);
 			}
 			if (UTDamage.GetDefaultObject()->SpreeSoundName != NAME_None)
 			{
@@ -316,10 +319,10 @@ void AUTPlayerState::IncrementDeaths(TSubclassOf<UDamageType> DamageType, AUTPla
 
 	ModifyStatsValue(NAME_Deaths, 1);
 	TSubclassOf<UUTDamageType> UTDamage(*DamageType);
-	if (UTDamage && !UTDamage.GetDefaultObject()->StatsName.IsEmpty())
+	const int32 DeathStatsIndex = UTDamage ? UTDamage.GetDefaultObject()->GetDeathStatsIndex() : INDEX_NONE;
+	if (DeathStatsIndex != INDEX_NONE)
 	{
-		// FIXMESTEVE - preset, not constructed FName
-		ModifyStatsValue(FName(*(UTDamage.GetDefaultObject()->StatsName + TEXT("Deaths"))), 1);
+		ModifyStatsValueByIndex(DeathStatsIndex, 1);
 	}
 
 	// spree has ended
@@ -898,76 +901,12 @@ void AUTPlayerState::WriteStatsToCloud()
 			bWroteStatsToCloud = true;
 		}
 
-		// Write the stats going to the backend
+		// Write the stats going to the backend, the uploader batches, serializes and sends them
 		{
-			TSharedPtr<FJsonObject> StatsJson = MakeShareable(new FJsonObject);
-			StatManager->PopulateJsonObjectForBackendStats(StatsJson, this);
-			FString OutputJsonString;
-			TArray<uint8> BackendStatsData;
-			TSharedRef< TJsonWriter< TCHAR, TCondensedJsonPrintPolicy<TCHAR> > > Writer = TJsonWriterFactory< TCHAR, TCondensedJsonPrintPolicy<TCHAR> >::Create(&OutputJsonString);
-			FJsonSerializer::Serialize(StatsJson.ToSharedRef(), Writer);
-			{
-				FMemoryWriter MemoryWriter(BackendStatsData);
-				MemoryWriter.Serialize(TCHAR_TO_ANSI(*OutputJsonString), OutputJsonString.Len() + 1);
-			}
-
-#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-			FString BaseURL = TEXT("https://ut-public-service-gamedev.ol.epicgames.net/ut/api/stats/accountId/") + StatsID + TEXT("/bulk?ownertype=1");
-#else
-			FString BaseURL = TEXT("https://ut-public-service-prod10.ol.epicgames.com/ut/api/stats/accountId/") + StatsID + TEXT("/bulk?ownertype=1");
-#endif
-
-			FString McpConfigOverride;
-			FParse::Value(FCommandLine::Get(), TEXT("MCPCONFIG="), McpConfigOverride);
-
-			if (McpConfigOverride == TEXT("prodnet"))
-			{
-				BaseURL = TEXT("https://ut-public-service-prod10.ol.epicgames.com/ut/api/stats/accountId/") + StatsID + TEXT("/bulk?ownertype=1");
-			}
-			else if (McpConfigOverride == TEXT("localhost"))
-			{
-				BaseURL = TEXT("http://localhost:8080/ut/api/stats/accountId/") + StatsID + TEXT("/bulk?ownertype=1");
-			}
-			else if (McpConfigOverride == TEXT("gamedev"))
-			{
-				BaseURL = TEXT("https://ut-public-service-gamedev.ol.epicgames.net/ut/api/stats/accountId/") + StatsID + TEXT("/bulk?ownertype=1");
-			}
-
-			FHttpRequestPtr StatsWriteRequest = FHttpModule::Get().CreateRequest();
-			if (StatsWriteRequest.IsValid())
-			{
-				StatsWriteRequest->SetURL(BaseURL);
-				StatsWriteRequest->OnProcessRequestComplete().BindUObject(this, &AUTPlayerState::StatsWriteComplete);
-				StatsWriteRequest->SetVerb(TEXT("POST"));
-				StatsWriteRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-				
-				if (OnlineIdentityInterface.IsValid())
-				{
-					FString AuthToken = OnlineIdentityInterface->GetAuthToken(0);
-					StatsWriteRequest->SetHeader(TEXT("Authorization"), FString(TEXT("bearer ")) + AuthToken);
-				}
-
-				UE_LOG(LogGameStats, VeryVerbose, TEXT("%s"), *OutputJsonString);
-
-				StatsWriteRequest->SetContent(BackendStatsData);
-				StatsWriteRequest->ProcessRequest();
-			}
-		}
-
-	}
-}
-
-void AUTPlayerState::StatsWriteComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded)
-{
-	if (HttpRequest.IsValid() && HttpResponse.IsValid())
-	{
-		if (bSucceeded && HttpResponse->GetResponseCode() == 200)
-		{
-			UE_LOG(LogGameStats, Verbose, TEXT("Stats write succeeded %s %s"), *HttpRequest->GetURL(), *HttpResponse->GetContentAsString());
-		}
-		else
-		{
-			UE_LOG(LogGameStats, Warning, TEXT("Stats write failed %s %s"), *HttpRequest->GetURL(), *HttpResponse->GetContentAsString());
+			FUTBackendStatsEntry Entry;
+			Entry.StatsID = StatsID;
+			StatManager->GatherBackendStats(this, Entry.StatNames, Entry.StatValues);
+			FUTStatsUploader::Get().AddPlayerStats(MoveTemp(Entry));
 		}
 	}
 }
@@ -1622,20 +1561,38 @@ void AUTPlayerState::OnRepSpecialPlayer()
 
 float AUTPlayerState::GetStatsValue(FName StatsName) const
 {
-	return StatsData.FindRef(StatsName);
+	return GetStatsValueByIndex(FUTStatRegistry::FindStat(StatsName));
 }
 
 void AUTPlayerState::SetStatsValue(FName StatsName, float NewValue)
 {
-	LastScoreStatsUpdateTime = GetWorld()->GetTimeSeconds();
-	StatsData.Add(StatsName, NewValue);
+	SetStatsValueByIndex(FUTStatRegistry::RegisterStat(StatsName), NewValue);
 }
 
 void AUTPlayerState::ModifyStatsValue(FName StatsName, float Change)
+{
+	ModifyStatsValueByIndex(FUTStatRegistry::RegisterStat(StatsName), Change);
+}
+
+void AUTPlayerState::SetStatsValueByIndex(int32 StatIndex, float NewValue)
 {
 	LastScoreStatsUpdateTime = GetWorld()->GetTimeSeconds();
-	float CurrentValue = StatsData.FindRef(StatsName);
-	StatsData.Add(StatsName, CurrentValue + Change);
+	if (StatIndex >= StatsData.Num())
+	{
+		// only grows for stats registered after this player was created
+		StatsData.AddZeroed(FUTStatRegistry::NumStats() - StatsData.Num());
+	}
+	StatsData[StatIndex] = NewValue;
+}
+
+void AUTPlayerState::ModifyStatsValueByIndex(int32 StatIndex, float Change)
+{
+	LastScoreStatsUpdateTime = GetWorld()->GetTimeSeconds();
+	if (StatIndex >= StatsData.Num())
+	{
+		StatsData.AddZeroed(FUTStatRegistry::NumStats() - StatsData.Num());
+	}
+	StatsData[StatIndex] += Change;
 }
 
 bool AUTPlayerState::RegisterVote_Validate(AUTReplicatedMapInfo* VoteInfo) { return true; }
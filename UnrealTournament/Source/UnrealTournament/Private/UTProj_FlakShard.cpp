@@ -57,13 +57,22 @@ AUTProj_FlakShard::AUTProj_FlakShard(const class FObjectInitializer& ObjectIniti
 	PrimaryActorTick.bStartWithTickEnabled = true;
 	bNetTemporary = true;
 	NumSatelliteShards = 1;
+	bAllowPooling = true;
 }
 
 void AUTProj_FlakShard::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (!IsPendingKillPending() && (GetNetMode() != NM_DedicatedServer) && !DisableEmitterLights())
+	if (!IsPendingKillPending())
+	{
+		AddSatelliteShards();
+	}
+}
+
+void AUTProj_FlakShard::AddSatelliteShards()
+{
+	if ((GetNetMode() != NM_DedicatedServer) && !DisableEmitterLights())
 	{
 		UStaticMeshComponent* ShardMesh = Cast<UStaticMeshComponent>(Mesh);
 		if (ShardMesh)
@@ -85,6 +94,33 @@ void AUTProj_FlakShard::BeginPlay()
 	}
 }
 
+void AUTProj_FlakShard::Reactivate(const FVector& NewLocation, const FRotator& NewRotation)
+{
+	// satellite shards from the last flight, including those RemoveSatelliteShards() only hid
+	TArray<UStaticMeshComponent*> MeshComponents;
+	GetComponents<UStaticMeshComponent>(MeshComponents);
+	for (UStaticMeshComponent* MeshComp : MeshComponents)
+	{
+		if (MeshComp != Mesh && MeshComp->GetArchetype()->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			MeshComp->DestroyComponent();
+		}
+	}
+	SatelliteShards.Empty();
+
+	const AUTProj_FlakShard* DefaultShard = GetClass()->GetDefaultObject<AUTProj_FlakShard>();
+	BouncesRemaining = DefaultShard->BouncesRemaining;
+	FullGravityDelay = DefaultShard->FullGravityDelay;
+	if (Mesh != NULL)
+	{
+		Mesh->SetRelativeRotation(FRotator(360.0f * FMath::FRand(), 360.0f * FMath::FRand(), 360.0f * FMath::FRand()));
+	}
+
+	Super::Reactivate(NewLocation, NewRotation);
+
+	AddSatelliteShards();
+}
+
 void AUTProj_FlakShard::CatchupTick(float CatchupTickDelta)
 {
 	Super::CatchupTick(CatchupTickDelta);
@@ -53,6 +53,12 @@ void AUTProj_FlakShardMain::OnBounce(const struct FHitResult& ImpactResult, cons
 	MaxBonusTime = 0.f;
 }
 
+void AUTProj_FlakShardMain::Reactivate(const FVector& NewLocation, const FRotator& NewRotation)
+{
+	MaxBonusTime = GetClass()->GetDefaultObject<AUTProj_FlakShardMain>()->MaxBonusTime;
+	Super::Reactivate(NewLocation, NewRotation);
+}
+
 /**
 * Increase damage to UTPawns based on how centered this shard is on target.  If it is within the time MaxBonusTime time period.
 * e.g. point blank shot with the flak cannon you will do mega damage.  Once MaxBonusTime passes then this shard becomes a normal shard.
@@ -13,6 +13,14 @@ AUTProj_LinkPlasma::AUTProj_LinkPlasma(const class FObjectInitializer& ObjectIni
 	MaxSpeedPerLink = 700.f;
 	ExtraScalePerLink = 0.25f;
 	bLowPriorityLight = true;
+	bAllowPooling = true;
+}
+
+void AUTProj_LinkPlasma::Reactivate(const FVector& NewLocation, const FRotator& NewRotation)
+{
+	// speed and scale go back to the defaults in Super, the link gun sets the new shot's links
+	Links = 0;
+	Super::Reactivate(NewLocation, NewRotation);
 }
 
 void AUTProj_LinkPlasma::SetLinks(int32 NewLinks)
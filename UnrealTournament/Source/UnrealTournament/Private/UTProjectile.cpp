@@ -11,6 +11,7 @@
 #include "UTWorldSettings.h"
 #include "UTWeaponRedirector.h"
 #include "UTProj_WeaponScreen.h"
+#include "ServerFrameTelemetry.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogUTProjectile, Log, All);
 
@@ -80,6 +81,7 @@ AUTProjectile::AUTProjectile(const class FObjectInitializer& ObjectInitializer)
 	MasterProjectile = NULL;
 	bHasSpawnedFully = false;
 	bLowPriorityLight = false;
+	bAllowPooling = false;
 }
 
 bool AUTProjectile::DisableEmitterLights() const 
@@ -179,31 +181,7 @@ void AUTProjectile::BeginPlay()
 			InitialReplicationTick.RegisterTickFunction(GetLevel());
 		}
 
-		if (bInitiallyWarnTarget && InstigatorController != NULL && !bExploded)
-		{
-			AUTBot* TargetBot = NULL;
-
-			AUTPlayerController* PC = Cast<AUTPlayerController>(InstigatorController);
-			if (PC != NULL)
-			{
-				if (PC->LastShotTargetGuess != NULL)
-				{
-					TargetBot = Cast<AUTBot>(PC->LastShotTargetGuess->Controller);
-				}
-			}
-			else
-			{
-				AUTBot* MyBot = Cast<AUTBot>(InstigatorController);
-				if (MyBot != NULL && Cast<APawn>(MyBot->GetTarget()) != NULL)
-				{
-					TargetBot = Cast<AUTBot>(((APawn*)MyBot->GetTarget())->Controller);
-				}
-			}
-			if (TargetBot != NULL)
-			{
-				TargetBot->ReceiveProjWarning(this);
-			}
-		}
+		WarnTarget();
 	}
 	else
 	{
@@ -281,6 +259,35 @@ void AUTProjectile::BeginPlay()
 	}
 }
 
+void AUTProjectile::WarnTarget()
+{
+	if (bInitiallyWarnTarget && InstigatorController != NULL && !bExploded)
+	{
+		AUTBot* TargetBot = NULL;
+
+		AUTPlayerController* PC = Cast<AUTPlayerController>(InstigatorController);
+		if (PC != NULL)
+		{
+			if (PC->LastShotTargetGuess != NULL)
+			{
+				TargetBot = Cast<AUTBot>(PC->LastShotTargetGuess->Controller);
+			}
+		}
+		else
+		{
+			AUTBot* MyBot = Cast<AUTBot>(InstigatorController);
+			if (MyBot != NULL && Cast<APawn>(MyBot->GetTarget()) != NULL)
+			{
+				TargetBot = Cast<AUTBot>(((APawn*)MyBot->GetTarget())->Controller);
+			}
+		}
+		if (TargetBot != NULL)
+		{
+			TargetBot->ReceiveProjWarning(this);
+		}
+	}
+}
+
 void AUTProjectile::CatchupTick(float CatchupTickDelta)
 {
 	if (ProjectileMovement)
@@ -406,6 +413,8 @@ void AUTProjectile::SendInitialReplication()
 
 void AUTProjectile::TickActor(float DeltaTime, ELevelTick TickType, FActorTickFunction& ThisTickFunction)
 {
+	SCOPE_SERVER_FRAME_TIMER(Projectiles);
+
 	if (&ThisTickFunction == &InitialReplicationTick)
 	{
 		SendInitialReplication();
@@ -808,12 +817,183 @@ void AUTProjectile::Destroyed()
 {
 	if (MyFakeProjectile)
 	{
-		MyFakeProjectile->Destroy();
+		MyFakeProjectile->Recycle();
 	}
 	GetWorldTimerManager().ClearAllTimersForObject(this);
 	Super::Destroyed();
 }
 
+bool AUTProjectile::CanBePooled() const
+{
+	// replicated projectiles are torn off when they explode and can't be sent to clients again
+	return bAllowPooling && (bFakeClientProjectile || GetNetMode() == NM_Standalone) && !IsPendingKillPending();
+}
+
+void AUTProjectile::LifeSpanExpired()
+{
+	Recycle();
+}
+
+void AUTProjectile::Recycle()
+{
+	AUTWorldSettings* Settings = CanBePooled() ? Cast<AUTWorldSettings>(GetWorldSettings()) : NULL;
+	if (Settings != NULL)
+	{
+		Settings->RecycleProjectile(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void AUTProjectile::PutAway()
+{
+	if (MasterProjectile != NULL && MasterProjectile->MyFakeProjectile == this)
+	{
+		MasterProjectile->MyFakeProjectile = NULL;
+	}
+	MasterProjectile = NULL;
+	if (MyFakeProjectile != NULL)
+	{
+		MyFakeProjectile->Recycle();
+		MyFakeProjectile = NULL;
+	}
+	AUTPlayerController* PC = Cast<AUTPlayerController>(InstigatorController);
+	if (PC != NULL)
+	{
+		PC->FakeProjectiles.Remove(this);
+	}
+
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	DetachRootComponentFromParent(true);
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	ProjectileMovement->SetActive(false);
+	TArray<USceneComponent*> Components;
+	GetComponents<USceneComponent>(Components);
+	for (int32 i = 0; i < Components.Num(); i++)
+	{
+		UParticleSystemComponent* PSC = Cast<UParticleSystemComponent>(Components[i]);
+		if (PSC != NULL)
+		{
+			PSC->KillParticlesForced();
+			PSC->DeactivateSystem();
+		}
+		else
+		{
+			UAudioComponent* Audio = Cast<UAudioComponent>(Components[i]);
+			if (Audio != NULL)
+			{
+				Audio->Stop();
+			}
+		}
+	}
+	bExploded = true;
+}
+
+void AUTProjectile::Reactivate(const FVector& NewLocation, const FRotator& NewRotation)
+{
+	const AUTProjectile* DefaultProj = GetClass()->GetDefaultObject<AUTProjectile>();
+
+	// what weapons and flight may have changed
+	bExploded = false;
+	bTearOff = false;
+	bFakeClientProjectile = false;
+	bHasSpawnedFully = false;
+	bReplicateUTMovement = DefaultProj->bReplicateUTMovement;
+	bCanHitInstigator = DefaultProj->bCanHitInstigator;
+	DamageParams = DefaultProj->DamageParams;
+	Momentum = DefaultProj->Momentum;
+	MyDamageType = DefaultProj->MyDamageType;
+	FFInstigatorController = NULL;
+	FFDamageType = NULL;
+	ImpactedActor = NULL;
+	InstigatorController = (Instigator != NULL) ? Instigator->Controller : NULL;
+	CreationTime = GetWorld()->TimeSeconds;
+
+	if (RootComponent != NULL && DefaultProj->GetRootComponent() != NULL)
+	{
+		SetActorScale3D(DefaultProj->GetRootComponent()->RelativeScale3D);
+	}
+	SetActorLocationAndRotation(NewLocation, NewRotation);
+
+	// ShutDown() hid the class' components, extra ones made at runtime (which have the component class as archetype) stay as they are
+	const bool bTurnOffLights = DisableEmitterLights();
+	TArray<USceneComponent*> Components;
+	GetComponents<USceneComponent>(Components);
+	for (int32 i = 0; i < Components.Num(); i++)
+	{
+		const USceneComponent* Archetype = Cast<USceneComponent>(Components[i]->GetArchetype());
+		if (Archetype == NULL || Archetype->HasAnyFlags(RF_ClassDefaultObject))
+		{
+			continue;
+		}
+		Components[i]->SetHiddenInGame(Archetype->bHiddenInGame);
+		Components[i]->SetVisibility(Archetype->bVisible && !(bTurnOffLights && Components[i]->IsA(ULightComponent::StaticClass())));
+		if (Archetype->bAutoActivate)
+		{
+			UParticleSystemComponent* PSC = Cast<UParticleSystemComponent>(Components[i]);
+			if (PSC != NULL)
+			{
+				PSC->ActivateSystem(true);
+			}
+			else
+			{
+				UAudioComponent* Audio = Cast<UAudioComponent>(Components[i]);
+				if (Audio != NULL)
+				{
+					Audio->Play();
+				}
+			}
+		}
+	}
+	SetActorHiddenInGame(DefaultProj->bHidden);
+	SetActorTickEnabled(DefaultProj->PrimaryActorTick.bStartWithTickEnabled);
+
+	// same as UProjectileMovementComponent::InitializeComponent()
+	const UProjectileMovementComponent* DefaultMovement = DefaultProj->ProjectileMovement;
+	ProjectileMovement->SetUpdatedComponent(RootComponent);
+	ProjectileMovement->InitialSpeed = DefaultMovement->InitialSpeed;
+	ProjectileMovement->MaxSpeed = DefaultMovement->MaxSpeed;
+	ProjectileMovement->ProjectileGravityScale = DefaultMovement->ProjectileGravityScale;
+	ProjectileMovement->bShouldBounce = DefaultMovement->bShouldBounce;
+	ProjectileMovement->bIsHomingProjectile = DefaultMovement->bIsHomingProjectile;
+	ProjectileMovement->HomingTargetComponent = NULL;
+	UUTProjectileMovementComponent* UTMovement = Cast<UUTProjectileMovementComponent>(ProjectileMovement);
+	if (UTMovement != NULL)
+	{
+		UTMovement->Acceleration = ((const UUTProjectileMovementComponent*)DefaultMovement)->Acceleration;
+		UTMovement->ReplicatedAcceleration = FVector::ZeroVector;
+	}
+	ProjectileMovement->Velocity = DefaultMovement->Velocity;
+	if (ProjectileMovement->Velocity.SizeSquared() > 0.f)
+	{
+		if (ProjectileMovement->InitialSpeed > 0.f)
+		{
+			ProjectileMovement->Velocity = ProjectileMovement->Velocity.GetSafeNormal() * ProjectileMovement->InitialSpeed;
+		}
+		if (ProjectileMovement->bInitialVelocityInLocalSpace)
+		{
+			ProjectileMovement->SetVelocityInLocalSpace(ProjectileMovement->Velocity);
+		}
+		if (ProjectileMovement->bRotationFollowsVelocity)
+		{
+			RootComponent->SetWorldRotation(ProjectileMovement->Velocity.Rotation());
+		}
+		ProjectileMovement->UpdateComponentVelocity();
+	}
+	ProjectileMovement->SetActive(true);
+	SetActorEnableCollision(true);
+
+	// the rest of what BeginPlay() does for projectiles that aren't replicated
+	SetLifeSpan(DefaultProj->InitialLifeSpan);
+	bHasSpawnedFully = true;
+	ProjectileMovement->Velocity.Z += TossZ;
+	WarnTarget();
+}
+
 void AUTProjectile::ShutDown()
 {
 	if (MyFakeProjectile)
@@ -836,7 +1016,8 @@ void AUTProjectile::ShutDown()
 				// tick the particles one last time for e.g. SpawnPerUnit effects (particularly noticeable improvement for fast moving projectiles)
 				PSC->TickComponent(0.0f, LEVELTICK_All, NULL);
 				PSC->DeactivateSystem();
-				PSC->bAutoDestroy = true;
+				// pooled projectiles keep their particle components for next time
+				PSC->bAutoDestroy = !CanBePooled();
 				bFoundParticles = true;
 			}
 			else
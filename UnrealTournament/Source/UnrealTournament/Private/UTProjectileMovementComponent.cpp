@@ -3,12 +3,14 @@
 #include "UTRemoteRedeemer.h"
 #include "Net/UnrealNetwork.h"
 #include "UTProjectileMovementComponent.h"
+#include "ServerFrameTelemetry.h"
 
 UUTProjectileMovementComponent::UUTProjectileMovementComponent(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
 	HitZStopSimulatingThreshold = -1.1f; // default is always stop
 	bPreventZHoming = false;
+	PrimaryComponentTick.bRunInParallelBatch = true;
 }
 
 void UUTProjectileMovementComponent::InitializeComponent()
@@ -37,8 +39,119 @@ void UUTProjectileMovementComponent::InitializeComponent()
 	}
 }
 
+static const FName NAME_PredictProjectileMove(TEXT("PredictProjectileMove"));
+
+void UUTProjectileMovementComponent::ParallelTickComponent(float DeltaTime)
+{
+	// this runs in parallel with other projectiles, so it only reads the world and only writes PredictedMove
+	PredictedMove.bValid = false;
+
+	UPrimitiveComponent* UpdatedPrim = Cast<UPrimitiveComponent>(UpdatedComponent);
+	AActor* ActorOwner = (UpdatedComponent != NULL) ? UpdatedComponent->GetOwner() : NULL;
+	if (UpdatedPrim == NULL || ActorOwner == NULL || ActorOwner->IsPendingKill() || HasStoppedSimulation() || UpdatedPrim->IsSimulatingPhysics() || UpdatedPrim->GetWorld() == NULL)
+	{
+		return;
+	}
+
+	// same as the first iteration of UProjectileMovementComponent::TickComponent()
+	const float TimeTick = ShouldUseSubStepping() ? GetSimulationTimeStep(DeltaTime, 1) : DeltaTime;
+	const FVector MoveDelta = ComputeMoveDelta(Velocity, TimeTick);
+	const FRotator NewRotation = (bRotationFollowsVelocity && !Velocity.IsNearlyZero(0.01f)) ? Velocity.Rotation() : ActorOwner->GetActorRotation();
+	if (MoveDelta.IsNearlyZero())
+	{
+		return;
+	}
+	// the additional components are swept after the root has been rotated, which can't be predicted without moving it
+	if (AddlUpdatedComponents.Num() > 0 && !NewRotation.Quaternion().Equals(UpdatedComponent->GetComponentQuat()))
+	{
+		return;
+	}
+
+	PredictedMove.Delta = MoveDelta;
+	PredictedMove.Rotation = NewRotation;
+	PredictedMove.StartLocations.Reset();
+	PredictedMove.bClear = true;
+
+	TArray<FHitResult> Hits;
+	for (int32 i = -1; i < AddlUpdatedComponents.Num() && PredictedMove.bClear; i++)
+	{
+		UPrimitiveComponent* Prim = (i < 0) ? UpdatedPrim : AddlUpdatedComponents[i];
+		if (Prim == NULL || Prim->IsPendingKill())
+		{
+			return;
+		}
+		const FVector Start = Prim->GetComponentLocation();
+		PredictedMove.StartLocations.Add(Start);
+		// MoveComponent() doesn't sweep these either
+		if (Prim->IsCollisionEnabled())
+		{
+			// same query as UPrimitiveComponent::MoveComponent(); any hit, even a touch, needs the full move
+			// only static bodies, anything that can move is swept right before the move in IsPredictedPathStillClear()
+			FComponentQueryParams Params(NAME_PredictProjectileMove, ActorOwner);
+			FCollisionResponseParams ResponseParam;
+			Prim->InitSweepCollisionParams(Params, ResponseParam);
+			Params.MobilityType = EQueryMobilityType::Static;
+			Prim->GetWorld()->ComponentSweepMulti(Hits, Prim, Start, Start + MoveDelta, Prim->GetComponentQuat(), Params);
+			PredictedMove.bClear = (Hits.Num() == 0);
+		}
+	}
+	PredictedMove.bValid = true;
+}
+
+bool UUTProjectileMovementComponent::MatchesPredictedStart() const
+{
+	if (PredictedMove.StartLocations.Num() != AddlUpdatedComponents.Num() + 1 || UpdatedComponent->GetComponentLocation() != PredictedMove.StartLocations[0])
+	{
+		return false;
+	}
+	for (int32 i = 0; i < AddlUpdatedComponents.Num(); i++)
+	{
+		if (AddlUpdatedComponents[i] == NULL || AddlUpdatedComponents[i]->GetComponentLocation() != PredictedMove.StartLocations[i + 1])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UUTProjectileMovementComponent::IsPredictedPathStillClear() const
+{
+	// the batched sweep only looked at static bodies; pawns, other projectiles, lifts, ragdolls... are swept now, where they are after
+	// whatever ticked earlier in this group, with the same channel and responses as the real move, so together the two sweeps are the move's sweep
+	TArray<FHitResult> Hits;
+	for (int32 i = -1; i < AddlUpdatedComponents.Num(); i++)
+	{
+		UPrimitiveComponent* Prim = (i < 0) ? Cast<UPrimitiveComponent>(UpdatedComponent) : AddlUpdatedComponents[i];
+		if (Prim != NULL && Prim->IsCollisionEnabled())
+		{
+			FComponentQueryParams Params(NAME_PredictProjectileMove, UpdatedComponent->GetOwner());
+			FCollisionResponseParams ResponseParam;
+			Prim->InitSweepCollisionParams(Params, ResponseParam);
+			Params.MobilityType = EQueryMobilityType::Dynamic;
+			const FVector Start = Prim->GetComponentLocation();
+			GetWorld()->ComponentSweepMulti(Hits, Prim, Start, Start + PredictedMove.Delta, Prim->GetComponentQuat(), Params);
+			if (Hits.Num() > 0)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 bool UUTProjectileMovementComponent::MoveUpdatedComponent(const FVector& Delta, const FRotator& NewRotation, bool bSweep, FHitResult* OutHit)
 {
+	// the prediction is only good for the first move after it was made
+	if (PredictedMove.bValid && UpdatedComponent != NULL)
+	{
+		PredictedMove.bValid = false;
+		if (bSweep && PredictedMove.bClear && Delta == PredictedMove.Delta && NewRotation == PredictedMove.Rotation && MatchesPredictedStart() && IsPredictedPathStillClear())
+		{
+			// the static and the dynamic halves of the move's sweep found nothing in the way, so just teleport; overlaps at the end are still updated by the move
+			return Super::MoveUpdatedComponent(Delta, NewRotation, false, OutHit);
+		}
+	}
+
 	// if we have no extra components or we don't need to sweep, use the default behavior
 	if (AddlUpdatedComponents.Num() == 0 || UpdatedComponent == NULL || !bSweep || Delta.IsNearlyZero())
 	{
@@ -194,8 +307,23 @@ bool UUTProjectileMovementComponent::MoveUpdatedComponent(const FVector& Delta,
 
 void UUTProjectileMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	// only the game thread part, ParallelTickComponent() runs on the workers where the frame timers can't be used
+	SCOPE_SERVER_FRAME_TIMER(Projectiles);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	PredictedMove.bValid = false;
 	UpdateState(DeltaTime);
+
+	if (!AggregatedTick.IsAggregated() && !IsPendingKill())
+	{
+		FUTTickAggregator::Add(PrimaryComponentTick, this, GetComponentLevel(), AggregatedTick);
+	}
+}
+
+void UUTProjectileMovementComponent::OnUnregister()
+{
+	FUTTickAggregator::Remove(AggregatedTick);
+	Super::OnUnregister();
 }
 void UUTProjectileMovementComponent::HandleImpact(const FHitResult& Hit, float TimeSlice, const FVector& MoveDelta)
 {
@@ -0,0 +1,269 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTProjectile.h"
+#include "UTProj_Rocket.h"
+#include "UTProj_FlakShard.h"
+#include "UTWorldSettings.h"
+#include "UTProjectileTickBenchmark.h"
+#include "ServerFrameTelemetry.h"
+
+AUTProjectileTickBenchmark::AUTProjectileTickBenchmark(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = true;
+	// spawn replacements before the projectiles tick so the count is constant while measuring
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
+	ProjClass = AUTProj_Rocket::StaticClass();
+	PoolingProjClass = AUTProj_FlakShard::StaticClass();
+	NumProjectiles = 500;
+	PhaseSeconds = 10.0f;
+	SpawnRadius = 2000.0f;
+	Phase = PHASE_Done;
+	bWaitingForGC = false;
+	NumSpawned = 0;
+	SpawnSeconds = 0.0;
+	SerialProjectileMs = 0.0f;
+	bSavedSettings = false;
+}
+
+void AUTProjectileTickBenchmark::StartBenchmark()
+{
+	IConsoleManager& ConsoleManager = IConsoleManager::Get();
+	IConsoleVariable* ParallelBatchTicks = ConsoleManager.FindConsoleVariable(TEXT("tick.AllowParallelBatchTicks"));
+	IConsoleVariable* TelemetryEnable = ConsoleManager.FindConsoleVariable(TEXT("ServerTelemetry.Enable"));
+	IConsoleVariable* TelemetryWindowSeconds = ConsoleManager.FindConsoleVariable(TEXT("ServerTelemetry.WindowSeconds"));
+	IConsoleVariable* EffectPooling = ConsoleManager.FindConsoleVariable(TEXT("ut.EffectPooling"));
+	if (ProjClass == NULL || ParallelBatchTicks == NULL || TelemetryEnable == NULL || TelemetryWindowSeconds == NULL || EffectPooling == NULL)
+	{
+		Report(TEXT("ProjectileTickBenchmark: missing projectile class or console variables"));
+		Destroy();
+		return;
+	}
+	SavedParallelBatchTicks = ParallelBatchTicks->GetInt();
+	SavedTelemetryEnable = TelemetryEnable->GetInt();
+	SavedTelemetryWindowSeconds = TelemetryWindowSeconds->GetFloat();
+	SavedEffectPooling = EffectPooling->GetInt();
+	bSavedSettings = true;
+
+	// always gather, and only close windows when a phase ends
+	TelemetryEnable->Set(2);
+	TelemetryWindowSeconds->Set(PhaseSeconds * 10.0f);
+
+	Report(FString::Printf(TEXT("ProjectileTickBenchmark: %d x %s, %.0f seconds per phase"), NumProjectiles, *ProjClass->GetName(), PhaseSeconds));
+	StartPhase(PHASE_WarmUp);
+}
+
+void AUTProjectileTickBenchmark::StartPhase(EPhase NewPhase)
+{
+	if (NewPhase == PHASE_PoolingWarmUp)
+	{
+		// start over with the pooling class
+		for (AUTProjectile* Proj : Projectiles)
+		{
+			if (Proj != NULL && !Proj->IsPendingKillPending())
+			{
+				Proj->Destroy();
+			}
+		}
+		Projectiles.Empty();
+	}
+	Phase = NewPhase;
+	PhaseEndTime = GetWorld()->RealTimeSeconds + PhaseSeconds;
+	bWaitingForGC = false;
+	NumSpawned = 0;
+	SpawnSeconds = 0.0;
+	IConsoleManager::Get().FindConsoleVariable(TEXT("tick.AllowParallelBatchTicks"))->Set(Phase == PHASE_Serial ? 0 : 1);
+	// the other phases leave pooling as the player had it
+	IConsoleManager::Get().FindConsoleVariable(TEXT("ut.EffectPooling"))->Set(Phase == PHASE_PoolingOff ? 0 : (IsPoolingPhase() ? 1 : SavedEffectPooling));
+	// throw away whatever was gathered before the phase
+	FServerFrameTelemetry::Get().FlushWindow();
+}
+
+void AUTProjectileTickBenchmark::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Phase == PHASE_Done)
+	{
+		return;
+	}
+	SpawnProjectiles();
+
+	if (bWaitingForGC)
+	{
+		// the collection forced last frame is in this phase's window now
+		EndPhase();
+	}
+	else if (GetWorld()->RealTimeSeconds >= PhaseEndTime)
+	{
+		if (Phase == PHASE_PoolingOff || Phase == PHASE_PoolingOn)
+		{
+			// the projectiles destroyed without pooling are only freed by the next collection, so make it part of the phase
+			GetWorld()->ForceGarbageCollection(true);
+			bWaitingForGC = true;
+		}
+		else
+		{
+			EndPhase();
+		}
+	}
+}
+
+void AUTProjectileTickBenchmark::EndPhase()
+{
+	switch (Phase)
+	{
+		case PHASE_WarmUp:
+			StartPhase(PHASE_Serial);
+			break;
+		case PHASE_Serial:
+			FServerFrameTelemetry::Get().FlushWindow();
+			ReportPhase(TEXT("serial"));
+			StartPhase(PHASE_Parallel);
+			break;
+		case PHASE_Parallel:
+			FServerFrameTelemetry::Get().FlushWindow();
+			ReportPhase(TEXT("parallel"));
+			// only projectiles that are never replicated are pooled, so on a listen server the two settings would be the same
+			if (GetNetMode() == NM_Standalone && PoolingProjClass != NULL && PoolingProjClass.GetDefaultObject()->bAllowPooling)
+			{
+				StartPhase(PHASE_PoolingWarmUp);
+			}
+			else
+			{
+				Phase = PHASE_Done;
+				Destroy();
+			}
+			break;
+		case PHASE_PoolingWarmUp:
+			StartPhase(PHASE_PoolingOff);
+			break;
+		case PHASE_PoolingOff:
+			FServerFrameTelemetry::Get().FlushWindow();
+			ReportPoolingPhase(TEXT("pool off"));
+			StartPhase(PHASE_PoolingOn);
+			break;
+		default:
+			FServerFrameTelemetry::Get().FlushWindow();
+			ReportPoolingPhase(TEXT("pool on"));
+			Phase = PHASE_Done;
+			Destroy();
+			break;
+	}
+}
+
+void AUTProjectileTickBenchmark::SpawnProjectiles()
+{
+	for (int32 i = Projectiles.Num() - 1; i >= 0; i--)
+	{
+		// pooled projectiles are put away rather than destroyed
+		if (Projectiles[i] == NULL || Projectiles[i]->IsPendingKillPending() || (IsPoolingPhase() && Projectiles[i]->bExploded && Projectiles[i]->bHidden))
+		{
+			Projectiles.RemoveAt(i);
+		}
+	}
+
+	FActorSpawnParameters Params;
+	Params.bNoCollisionFail = true;
+	Params.Owner = this;
+	AUTWorldSettings* Settings = IsPoolingPhase() ? Cast<AUTWorldSettings>(GetWorldSettings()) : NULL;
+	const double StartTime = FPlatformTime::Seconds();
+	while (Projectiles.Num() < NumProjectiles)
+	{
+		// mostly horizontal so they live long enough to matter, a few hit the floor and walls which exercises the hit path too
+		const FVector Dir = FVector(FMath::FRandRange(-1.0f, 1.0f), FMath::FRandRange(-1.0f, 1.0f), FMath::FRandRange(-0.2f, 0.2f)).GetSafeNormal();
+		const FVector SpawnLocation = GetActorLocation() + FMath::VRand() * FMath::FRandRange(0.0f, SpawnRadius);
+		AUTProjectile* Proj = (Settings != NULL) ? Settings->SpawnProjectile(PoolingProjClass, SpawnLocation, Dir.Rotation(), Params) : GetWorld()->SpawnActor<AUTProjectile>(ProjClass, SpawnLocation, Dir.Rotation(), Params);
+		if (Proj == NULL)
+		{
+			// no point in trying again this frame
+			break;
+		}
+		Proj->SetLifeSpan(FMath::FRandRange(1.0f, 3.0f));
+		Projectiles.Add(Proj);
+		NumSpawned++;
+	}
+	SpawnSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void AUTProjectileTickBenchmark::ReportPhase(const TCHAR* Title)
+{
+	const FServerFrameTelemetry::FWindow* Window = FServerFrameTelemetry::Get().GetLastWindow();
+	if (Window == NULL)
+	{
+		return;
+	}
+	const FServerFrameTelemetry::FHistogram& Frame = Window->Stats[EServerFrameStat::Frame];
+	const FServerFrameTelemetry::FHistogram& PrePhysics = Window->Stats[EServerFrameStat::TickGroupFirst + TG_PrePhysics];
+	const FServerFrameTelemetry::FHistogram& WorldTick = Window->Stats[EServerFrameStat::WorldTick];
+	// the game thread part of projectile movement, with batches on that is the dynamic sweep and the move; the static sweeps run on the workers
+	const FServerFrameTelemetry::FHistogram& ProjectileStat = Window->Stats[EServerFrameStat::Projectiles];
+	const float ProjectileMs = Frame.Count ? float(ProjectileStat.TotalMs / Frame.Count) : 0.0f;
+	Report(FString::Printf(TEXT("ProjectileTickBenchmark %-8s %5u frames  Projectiles %6.2fms per frame p95 %6.3fms  PrePhysics avg %6.2fms p50 %6.2fms p95 %6.2fms  WorldTick avg %6.2fms  Frame avg %6.2fms"),
+		Title, Frame.Count,
+		ProjectileMs, ProjectileStat.GetPercentile(0.95f),
+		PrePhysics.Count ? float(PrePhysics.TotalMs / PrePhysics.Count) : 0.0f, PrePhysics.GetPercentile(0.5f), PrePhysics.GetPercentile(0.95f),
+		WorldTick.Count ? float(WorldTick.TotalMs / WorldTick.Count) : 0.0f,
+		Frame.Count ? float(Frame.TotalMs / Frame.Count) : 0.0f));
+
+	if (Phase == PHASE_Serial)
+	{
+		SerialProjectileMs = ProjectileMs;
+	}
+	else if (Phase == PHASE_Parallel && SerialProjectileMs > 0.0f)
+	{
+		Report(FString::Printf(TEXT("ProjectileTickBenchmark projectile game thread time %.2fms -> %.2fms per frame (%+.0f%%)"), SerialProjectileMs, ProjectileMs, (ProjectileMs / SerialProjectileMs - 1.0f) * 100.0f));
+	}
+}
+
+void AUTProjectileTickBenchmark::ReportPoolingPhase(const TCHAR* Title)
+{
+	const FServerFrameTelemetry::FWindow* Window = FServerFrameTelemetry::Get().GetLastWindow();
+	if (Window == NULL)
+	{
+		return;
+	}
+	const FServerFrameTelemetry::FHistogram& Frame = Window->Stats[EServerFrameStat::Frame];
+	const FServerFrameTelemetry::FHistogram& GC = Window->Stats[EServerFrameStat::GarbageCollection];
+	Report(FString::Printf(TEXT("ProjectileTickBenchmark %-8s %5u frames  %6d spawned, avg %6.2fus each, %6.2fms per frame  GC total %7.2fms max %6.2fms  Frame avg %6.2fms"),
+		Title, Frame.Count,
+		NumSpawned, NumSpawned ? float(SpawnSeconds * 1000000.0 / NumSpawned) : 0.0f, Frame.Count ? float(SpawnSeconds * 1000.0 / Frame.Count) : 0.0f,
+		float(GC.TotalMs), GC.MaxMs,
+		Frame.Count ? float(Frame.TotalMs / Frame.Count) : 0.0f));
+}
+
+void AUTProjectileTickBenchmark::Report(const FString& Line)
+{
+	UE_LOG(UT, Log, TEXT("%s"), *Line);
+	if (ReportTo != NULL)
+	{
+		ReportTo->ClientMessage(Line);
+	}
+}
+
+void AUTProjectileTickBenchmark::RestoreSettings()
+{
+	if (bSavedSettings)
+	{
+		bSavedSettings = false;
+		IConsoleManager& ConsoleManager = IConsoleManager::Get();
+		ConsoleManager.FindConsoleVariable(TEXT("tick.AllowParallelBatchTicks"))->Set(SavedParallelBatchTicks);
+		ConsoleManager.FindConsoleVariable(TEXT("ServerTelemetry.Enable"))->Set(SavedTelemetryEnable);
+		ConsoleManager.FindConsoleVariable(TEXT("ServerTelemetry.WindowSeconds"))->Set(SavedTelemetryWindowSeconds);
+		ConsoleManager.FindConsoleVariable(TEXT("ut.EffectPooling"))->Set(SavedEffectPooling);
+	}
+}
+
+void AUTProjectileTickBenchmark::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	RestoreSettings();
+	for (AUTProjectile* Proj : Projectiles)
+	{
+		if (Proj != NULL && !Proj->IsPendingKillPending())
+		{
+			Proj->Destroy();
+		}
+	}
+	Projectiles.Empty();
+	Super::EndPlay(EndPlayReason);
+}
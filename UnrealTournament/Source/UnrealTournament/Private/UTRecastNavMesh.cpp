@@ -1933,25 +1933,7 @@ bool AUTRecastNavMesh::FindBestPath(APawn* Asker, const FNavAgentProperties& Age
 				NextRouteNode = NextRouteNode->PrevPath;
 			}
 
-			// ask any ReachSpecs along path if there is an Actor target to assign to the route point
-			if (NodeRoute.Num() > 0)
-			{
-				{
-					int32 LinkIndex = NextRouteNode->Node->GetBestLinkTo(NextRouteNode->Poly, NodeRoute[0], Asker, AgentProps, this);
-					if (LinkIndex != INDEX_NONE && NextRouteNode->Node->Paths[LinkIndex].Spec.IsValid())
-					{
-						NodeRoute[0].Actor = NextRouteNode->Node->Paths[LinkIndex].Spec->GetMoveTargetActor();
-					}
-				}
-				for (int32 i = 1; i < NodeRoute.Num(); i++)
-				{
-					int32 LinkIndex = NodeRoute[i - 1].Node->GetBestLinkTo(NodeRoute[i - 1].TargetPoly, NodeRoute[i], Asker, AgentProps, this);
-					if (LinkIndex != INDEX_NONE && NodeRoute[i - 1].Node->Paths[LinkIndex].Spec.IsValid())
-					{
-						NodeRoute[i].Actor = NodeRoute[i - 1].Node->Paths[LinkIndex].Spec->GetMoveTargetActor();
-					}
-				}
-			}
+			SetRouteSpecActors(NextRouteNode->Node, NextRouteNode->Poly, Asker, AgentProps, NodeRoute);
 
 			FVector RouteGoalLoc = FVector::ZeroVector;
 			AActor* RouteGoal = NULL;
@@ -2495,6 +2477,183 @@ void AUTRecastNavMesh::LoadMapLearningData()
 	}
 }
 
+bool AUTRecastNavMesh::FindInventoryFieldPath(APawn* Asker, const FNavAgentProperties& AgentProps, FBestInventoryEval& NodeEval, const FVector& StartLoc, float& Weight, TArray<FRouteCacheItem>& NodeRoute, bool& bNeedFullSearch)
+{
+	DECLARE_CYCLE_STAT(TEXT("UT inventory field pathing time"), STAT_Navigation_UTInventoryField, STATGROUP_Navigation);
+
+	SCOPE_CYCLE_COUNTER(STAT_Navigation_UTInventoryField);
+
+	NodeRoute.Reset();
+	bNeedFullSearch = true;
+	if (!InventoryField.IsInitialized())
+	{
+		return false;
+	}
+	const NavNodeRef StartPoly = FindAnchorPoly(StartLoc, Asker, AgentProps);
+	const UUTPathNode* StartNode = PolyToNode.FindRef(StartPoly);
+	if (StartPoly == INVALID_NAVNODEREF || StartNode == NULL || StartNode->InventoryField.Num() < InventoryField.GetNumTypes())
+	{
+		// off the mesh, FindBestPath() knows how to get back on
+		return false;
+	}
+
+	// rate the nearest available pickup of each type
+	float BestWeight = Weight;
+	int32 BestSource = INDEX_NONE;
+	// per type, the nearest pickup if it was turned down for this bot, in which case the field doesn't know whether one further away would do
+	TArray<int32> RejectedSources;
+	RejectedSources.Init(INDEX_NONE, StartNode->InventoryField.Num());
+	for (int32 Type = 0; Type < StartNode->InventoryField.Num(); Type++)
+	{
+		const FUTInventoryFieldEntry& Entry = StartNode->InventoryField[Type];
+		AUTPickup* Pickup = (Entry.Source != INDEX_NONE) ? InventoryField.GetSource(Entry.Source).Pickup.Get() : NULL;
+		if (Pickup != NULL)
+		{
+			const float PickupDist = (InventoryField.GetSourceNode(Entry.Source) == StartNode) ? FMath::Max<float>(1.0f, (Pickup->GetActorLocation() - StartLoc).Size()) : float(Entry.Distance);
+			// everything else of this type is further, so there's no need to look at the others when this one is out of range
+			if (NodeEval.MaxDist <= 0 || PickupDist < NodeEval.MaxDist)
+			{
+				float NewWeight = Pickup->BotDesireability(Asker, PickupDist);
+				if (NewWeight > 0.0f && NodeEval.AllowPickup(Asker, Pickup, NewWeight, PickupDist))
+				{
+					NewWeight /= PickupDist;
+					if (NewWeight > BestWeight)
+					{
+						BestWeight = NewWeight;
+						BestSource = Entry.Source;
+					}
+				}
+				else
+				{
+					RejectedSources[Type] = Entry.Source;
+				}
+			}
+		}
+	}
+
+	// pickups that will respawn soon, dropped pickups and the ones behind a rejected nearest pickup of their type aren't covered by the field;
+	// rate them as if they were in a straight line, which is the best they could do, and only search the network if one of them might win
+	for (int32 i = 0; i < InventoryField.GetSources().Num(); i++)
+	{
+		const FUTInventoryField::FSource& Source = InventoryField.GetSource(i);
+		AUTPickup* Pickup = Source.Pickup.Get();
+		if (Pickup != NULL)
+		{
+			if (!Source.bAvailable)
+			{
+				if (NodeEval.RespawnPredictionTime > Pickup->GetRespawnTimeOffset(Asker))
+				{
+					const float MinDist = FMath::Max<float>(1.0f, (Pickup->GetActorLocation() - StartLoc).Size());
+					if (Pickup->BotDesireability(Asker, MinDist) / MinDist > BestWeight)
+					{
+						return false;
+					}
+				}
+			}
+			else if (RejectedSources.IsValidIndex(Source.Type) && RejectedSources[Source.Type] != INDEX_NONE && RejectedSources[Source.Type] != i)
+			{
+				const float MinDist = FMath::Max<float>(1.0f, (Pickup->GetActorLocation() - StartLoc).Size());
+				if (NodeEval.MaxDist <= 0 || MinDist < NodeEval.MaxDist)
+				{
+					const float NewWeight = Pickup->BotDesireability(Asker, MinDist);
+					if (NewWeight / MinDist > BestWeight && NodeEval.AllowPickup(Asker, Pickup, NewWeight, MinDist))
+					{
+						return false;
+					}
+				}
+			}
+		}
+	}
+	for (const TWeakObjectPtr<AUTDroppedPickup>& Drop : InventoryField.GetDroppedPickups())
+	{
+		if (Drop.IsValid())
+		{
+			const float MinDist = FMath::Max<float>(1.0f, (Drop->GetActorLocation() - StartLoc).Size());
+			if (Drop->BotDesireability(Asker, MinDist) / MinDist > BestWeight)
+			{
+				return false;
+			}
+		}
+	}
+	bNeedFullSearch = false;
+	if (BestSource == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// walk down the field, every step gets closer so this ends after at most one step per node
+	const int32 Type = InventoryField.GetSource(BestSource).Type;
+	const UUTPathNode* GoalNode = InventoryField.GetSourceNode(BestSource);
+	int32 Radius, Height, MaxFallSpeed;
+	uint32 MoveFlags;
+	CalcReachParams(Asker, AgentProps, Radius, Height, MaxFallSpeed, MoveFlags);
+	const UUTPathNode* CurrentNode = StartNode;
+	NavNodeRef CurrentPoly = StartPoly;
+	while (CurrentNode != GoalNode)
+	{
+		const int32 CurrentDistance = CurrentNode->InventoryField[Type].Distance;
+		int32 BestLink = INDEX_NONE;
+		int32 BestRemaining = BLOCKED_PATH_COST;
+		for (int32 i = 0; i < CurrentNode->Paths.Num(); i++)
+		{
+			const FUTPathLink& Link = CurrentNode->Paths[i];
+			const UUTPathNode* NextNode = Link.End.Get();
+			if ( NextNode != NULL && NextNode->InventoryField.IsValidIndex(Type) && NextNode->InventoryField[Type].Source == BestSource && NextNode->InventoryField[Type].Distance < CurrentDistance &&
+				Link.Supports(Radius, Height, MoveFlags) )
+			{
+				const int32 Cost = Link.CostFor(Asker, AgentProps, CurrentPoly, this);
+				if (Cost < BLOCKED_PATH_COST && Cost + NextNode->InventoryField[Type].Distance < BestRemaining)
+				{
+					BestRemaining = Cost + NextNode->InventoryField[Type].Distance;
+					BestLink = i;
+				}
+			}
+		}
+		if (BestLink == INDEX_NONE)
+		{
+			// the field is for a standard player and this one can't take that route
+			NodeRoute.Reset();
+			bNeedFullSearch = true;
+			return false;
+		}
+		const FUTPathLink& Link = CurrentNode->Paths[BestLink];
+		NodeRoute.Add(FRouteCacheItem(Link.End.Get(), GetPolyCenter(Link.EndPoly), Link.EndPoly));
+		CurrentNode = Link.End.Get();
+		CurrentPoly = Link.EndPoly;
+	}
+	SetRouteSpecActors(StartNode, StartPoly, Asker, AgentProps, NodeRoute);
+
+	AUTPickup* BestPickup = InventoryField.GetSource(BestSource).Pickup.Get();
+	new(NodeRoute) FRouteCacheItem(BestPickup, BestPickup->GetActorLocation(), FindNearestPoly(BestPickup->GetActorLocation(), FVector(AgentProps.AgentRadius, AgentProps.AgentRadius, AgentProps.AgentHeight)));
+	Weight = BestWeight;
+	NodeEval.BestPickup = BestPickup;
+	NodeEval.BestWeight = BestWeight;
+	return true;
+}
+
+void AUTRecastNavMesh::SetRouteSpecActors(const UUTPathNode* StartNode, NavNodeRef StartPoly, APawn* Asker, const FNavAgentProperties& AgentProps, TArray<FRouteCacheItem>& NodeRoute) const
+{
+	// ask any ReachSpecs along path if there is an Actor target to assign to the route point
+	if (NodeRoute.Num() > 0)
+	{
+		{
+			int32 LinkIndex = StartNode->GetBestLinkTo(StartPoly, NodeRoute[0], Asker, AgentProps, this);
+			if (LinkIndex != INDEX_NONE && StartNode->Paths[LinkIndex].Spec.IsValid())
+			{
+				NodeRoute[0].Actor = StartNode->Paths[LinkIndex].Spec->GetMoveTargetActor();
+			}
+		}
+		for (int32 i = 1; i < NodeRoute.Num(); i++)
+		{
+			int32 LinkIndex = NodeRoute[i - 1].Node->GetBestLinkTo(NodeRoute[i - 1].TargetPoly, NodeRoute[i], Asker, AgentProps, this);
+			if (LinkIndex != INDEX_NONE && NodeRoute[i - 1].Node->Paths[LinkIndex].Spec.IsValid())
+			{
+				NodeRoute[i].Actor = NodeRoute[i - 1].Node->Paths[LinkIndex].Spec->GetMoveTargetActor();
+			}
+		}
+	}
+}
+
 void AUTRecastNavMesh::AddToNavigation(AActor* NewPOI)
 {
 	// in editor this will be handled by path building
@@ -2514,6 +2673,18 @@ void AUTRecastNavMesh::AddToNavigation(AActor* NewPOI)
 		{
 			BestNode->POIs.Add(NewPOI);
 			POIToNode.Add(NewPOI, BestNode);
+			if (GetNetMode() != NM_Client)
+			{
+				AUTPickup* Pickup = Cast<AUTPickup>(NewPOI);
+				if (Pickup != NULL)
+				{
+					InventoryField.AddPickup(this, PathNodes, Pickup, BestNode);
+				}
+				else if (Cast<AUTDroppedPickup>(NewPOI) != NULL)
+				{
+					InventoryField.AddDroppedPickup((AUTDroppedPickup*)NewPOI);
+				}
+			}
 		}
 		else
 		{
@@ -2531,10 +2702,26 @@ void AUTRecastNavMesh::RemoveFromNavigation(AActor* OldPOI)
 		{
 			Node->POIs.Remove(OldPOI);
 			POIToNode.Remove(OldPOI);
+			if (Cast<AUTPickup>(OldPOI) != NULL)
+			{
+				InventoryField.RemovePickup((AUTPickup*)OldPOI);
+			}
+			else if (Cast<AUTDroppedPickup>(OldPOI) != NULL)
+			{
+				InventoryField.RemoveDroppedPickup((AUTDroppedPickup*)OldPOI);
+			}
 		}
 	}
 }
 
+void AUTRecastNavMesh::PickupStateChanged(AUTPickup* Pickup)
+{
+	if (GetWorld()->IsGameWorld() && InventoryField.IsInitialized())
+	{
+		InventoryField.PickupStateChanged(Pickup);
+	}
+}
+
 void AUTRecastNavMesh::GetNodeTriangleMap(TMap<const UUTPathNode*, FNavMeshTriangleList>& TriangleMap)
 {
 	if (GetRecastNavMeshImpl() != NULL)
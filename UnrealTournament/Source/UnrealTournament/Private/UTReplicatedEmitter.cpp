@@ -20,6 +20,20 @@ AUTReplicatedEmitter::AUTReplicatedEmitter(const FObjectInitializer& ObjectIniti
 	bNetTemporary = true;
 }
 
+void AUTReplicatedEmitter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// emitters are spammed by flak and bio; the component has usually not ticked yet, so it starts with the next aggregated tick
+	FUTTickAggregator::Add(PSC->PrimaryComponentTick, PSC, GetLevel(), PSCAggregatedTick);
+}
+
+void AUTReplicatedEmitter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FUTTickAggregator::Remove(PSCAggregatedTick);
+	Super::EndPlay(EndPlayReason);
+}
+
 AUTPersistentReplicatedEmitter::AUTPersistentReplicatedEmitter(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
 {
@@ -5,6 +5,7 @@
 #include "Net/UnrealNetwork.h"
 #include "UTLobbyGameState.h"
 #include "UTLobbyMatchInfo.h"
+#include "UTGameEngine.h"
 
 AUTServerBeaconLobbyClient::AUTServerBeaconLobbyClient(const class FObjectInitializer& PCIP) :
 Super(PCIP)
@@ -32,7 +33,13 @@ void AUTServerBeaconLobbyClient::OnConnected()
 	}
 
 	AUTGameMode* UTGameMode = GetWorld()->GetAuthGameMode<AUTGameMode>();
-	if (UTGameMode)
+	if (UTGameMode && UTGameMode->bPooledInstance)
+	{
+		// Nothing to prime, we're just waiting to be given a match
+		Lobby_NotifyInstanceIdle(GameInstanceID);
+		ReportMemory(GameInstanceID);
+	}
+	else if (UTGameMode)
 	{
 		Lobby_PrimeMapList(GameInstanceID);
 
@@ -98,6 +105,83 @@ void AUTServerBeaconLobbyClient::Lobby_NotifyInstanceIsReady_Implementation(uint
 
 }
 
+bool AUTServerBeaconLobbyClient::Lobby_NotifyInstanceIdle_Validate(uint32 InstanceID) { return true; }
+void AUTServerBeaconLobbyClient::Lobby_NotifyInstanceIdle_Implementation(uint32 InstanceID)
+{
+	UE_LOG(UT,Verbose,TEXT("[HUB] NotifyInstanceIdle: Instance %i"), InstanceID);
+	AUTLobbyGameState* LobbyGameState = GetWorld()->GetGameState<AUTLobbyGameState>();
+	if (LobbyGameState)
+	{
+		LobbyGameState->GameInstance_Idle(this, InstanceID);
+	}
+}
+
+void AUTServerBeaconLobbyClient::ReportMemory(uint32 InstanceID)
+{
+	Lobby_ReportMemory(InstanceID, int32(FPlatformMemory::GetStats().UsedPhysical / 1024));
+}
+
+bool AUTServerBeaconLobbyClient::Lobby_ReportMemory_Validate(uint32 InstanceID, int32 UsedPhysicalKB) { return true; }
+void AUTServerBeaconLobbyClient::Lobby_ReportMemory_Implementation(uint32 InstanceID, int32 UsedPhysicalKB)
+{
+	AUTLobbyGameState* LobbyGameState = GetWorld()->GetGameState<AUTLobbyGameState>();
+	if (LobbyGameState)
+	{
+		LobbyGameState->GameInstance_Memory(InstanceID, UsedPhysicalKB);
+	}
+}
+
+void AUTServerBeaconLobbyClient::Instance_AssignMatch_Implementation(const FString& GameURL)
+{
+	AUTGameMode* UTGameMode = GetWorld()->GetAuthGameMode<AUTGameMode>();
+	if (UTGameMode && UTGameMode->bPooledInstance)
+	{
+		UE_LOG(UT,Log,TEXT("Pooled instance %i was given the match %s"), GameInstanceID, *GameURL);
+
+		// The URL carries the instance id and hub port, so the new game connects back to the hub on its own
+		GetWorld()->ServerTravel(GameURL, true);
+	}
+}
+
+void AUTServerBeaconLobbyClient::Instance_ReturnToPool_Implementation(const FString& IdleURL)
+{
+	UE_LOG(UT,Log,TEXT("Instance %i is going back to the pool"), GameInstanceID);
+	GetWorld()->ServerTravel(IdleURL, true);
+}
+
+void AUTServerBeaconLobbyClient::Instance_LeavePool_Implementation()
+{
+	UE_LOG(UT,Log,TEXT("Instance %i is not wanted by the hub, shutting down"), GameInstanceID);
+	FPlatformMisc::RequestExit(false);
+}
+
+void AUTServerBeaconLobbyClient::Instance_HostMatch_Implementation(const FString& GameURL, int32 Port)
+{
+	UUTGameEngine* UTEngine = Cast<UUTGameEngine>(GEngine);
+	if (UTEngine)
+	{
+		UE_LOG(UT,Log,TEXT("Instance %i is hosting the match %s on port %i"), GameInstanceID, *GameURL, Port);
+		UTEngine->StartHostedMatch(GameURL, Port);
+	}
+}
+
+void AUTServerBeaconLobbyClient::Instance_StopHostedMatch_Implementation(uint32 InstanceID)
+{
+	UUTGameEngine* UTEngine = Cast<UUTGameEngine>(GEngine);
+	if (UTEngine)
+	{
+		for (const FWorldContext& Context : UTEngine->GetWorldContexts())
+		{
+			AUTGameMode* UTGameMode = (Context.World() != NULL) ? Context.World()->GetAuthGameMode<AUTGameMode>() : NULL;
+			if (UTGameMode && UTGameMode->LobbyInstanceID == InstanceID && UTEngine->IsHostedMatchWorld(Context.World()))
+			{
+				UTEngine->StopHostedMatch(Context.World());
+				return;
+			}
+		}
+	}
+}
+
 bool AUTServerBeaconLobbyClient::Lobby_UpdateMatch_Validate(uint32 InstanceID, const FString& Update) { return true; }
 void AUTServerBeaconLobbyClient::Lobby_UpdateMatch_Implementation(uint32 InstanceID, const FString& Update)
 {
@@ -141,7 +225,7 @@ void AUTServerBeaconLobbyClient::Lobby_InstanceEmpty_Implementation(uint32 Insta
 	AUTLobbyGameState* LobbyGameState = GetWorld()->GetGameState<AUTLobbyGameState>();
 	if (LobbyGameState)
 	{
-		LobbyGameState->GameInstance_Empty(InstanceID);
+		LobbyGameState->GameInstance_Empty(this, InstanceID);
 	}
 
 }
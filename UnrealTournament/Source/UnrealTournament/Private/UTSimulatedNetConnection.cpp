@@ -0,0 +1,268 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTSimulatedNetConnection.h"
+#include "UTCharacterMovement.h"
+
+UUTSimulatedNetConnection::UUTSimulatedNetConnection(const FObjectInitializer& ObjectInitializer)
+: Super(ObjectInitializer)
+{
+	MoveRate = 60.0f;
+	SimulatedIndex = 0;
+	OneWayLatency = 0.0f;
+	LossChance = 0.0f;
+	ClientPacketId = 0;
+	NextClientPacketTime = 0.0;
+	ClientTimeStamp = 0.0f;
+	NextInputChangeTime = 0.0;
+	InputYaw = 0.0f;
+	InputPitch = 0.0f;
+	bInputMoving = false;
+	NextRestartTime = 0.0;
+	JoinTime = 0.0;
+	bHadPawn = false;
+	bReportedNotInGame = false;
+}
+
+APlayerController* UUTSimulatedNetConnection::AddSimulatedClient(UNetDriver* NetDriver, int32 Index, int32 LatencyMs, int32 PacketLoss)
+{
+	UWorld* World = (NetDriver != NULL) ? NetDriver->GetWorld() : NULL;
+	if (World == NULL || !NetDriver->IsServer())
+	{
+		return NULL;
+	}
+
+	UUTSimulatedNetConnection* Connection = NewObject<UUTSimulatedNetConnection>();
+	Connection->InitSimulatedConnection(NetDriver, Index, LatencyMs, PacketLoss);
+	NetDriver->AddClientConnection(Connection);
+
+	// what the control channel does for a real client once it has joined; without the world package name the server
+	// thinks the client is still loading the map, so it isn't counted as a player, can't spawn and gets almost nothing replicated
+	Connection->ClientWorldPackageName = World->GetOutermost()->GetFName();
+	FString Error;
+	APlayerController* PC = World->SpawnPlayActor(Connection, ROLE_AutonomousProxy, Connection->URL, TSharedPtr<FUniqueNetId>(), Error);
+	if (PC == NULL)
+	{
+		UE_LOG(UT, Warning, TEXT("Simulated client %d failed to log in: %s"), Index, *Error);
+		Connection->Close();
+		return NULL;
+	}
+	AUTPlayerState* PS = Cast<AUTPlayerState>(PC->PlayerState);
+	if (PS != NULL)
+	{
+		PS->bReadyToPlay = true;
+	}
+	return PC;
+}
+
+void UUTSimulatedNetConnection::InitSimulatedConnection(UNetDriver* InDriver, int32 InIndex, int32 LatencyMs, int32 PacketLoss)
+{
+	SimulatedIndex = InIndex;
+	OneWayLatency = FMath::Max(0, LatencyMs) * 0.0005f;
+	LossChance = FMath::Clamp(PacketLoss, 0, 100) * 0.01f;
+	RandomStream.Initialize(InIndex + 1);
+
+	FURL ConnectURL;
+	ConnectURL.Op.Add(FString::Printf(TEXT("Name=SimClient%d"), InIndex));
+	// same packet size and overhead as a UIpConnection so bandwidth and saturation match
+	InitBase(InDriver, NULL, ConnectURL, USOCK_Open, 512, 32);
+	InitSendBuffer();
+	NextClientPacketTime = Driver->Time;
+	JoinTime = Driver->Time;
+}
+
+bool UUTSimulatedNetConnection::IsInGame() const
+{
+	// more actor channels than the one for its own controller means the game is replicating to it
+	return bHadPawn && ActorChannels.Num() > 1;
+}
+
+void UUTSimulatedNetConnection::CheckInGame()
+{
+	if (!bReportedNotInGame && State != USOCK_Closed && Driver != NULL && Driver->Time - JoinTime > 10.0 && !IsInGame())
+	{
+		bReportedNotInGame = true;
+		UE_LOG(UT, Warning, TEXT("Simulated client %d is not in the game %.0f seconds after joining: %s, %d replicated actors"), SimulatedIndex, Driver->Time - JoinTime,
+			bHadPawn ? TEXT("had a pawn") : TEXT("never had a pawn"), ActorChannels.Num());
+	}
+}
+
+FString UUTSimulatedNetConnection::LowLevelGetRemoteAddress(bool bAppendPort)
+{
+	return FString::Printf(TEXT("SimClient%d"), SimulatedIndex);
+}
+
+FString UUTSimulatedNetConnection::LowLevelDescribe()
+{
+	return FString::Printf(TEXT("Simulated client %d, %.0fms round trip, %.1f%% loss"), SimulatedIndex, OneWayLatency * 2000.0f, LossChance * 100.0f);
+}
+
+bool UUTSimulatedNetConnection::ClientHasInitializedLevelFor(const UObject* TestObject) const
+{
+	// never loads anything, so it is never waiting for a level either
+	return true;
+}
+
+void UUTSimulatedNetConnection::LowLevelSend(void* Data, int32 Count)
+{
+	// FlushNet() has already counted the bytes; the packet only has to be acknowledged, OutPacketId is its id until FlushNet() returns
+	if (LossChance > 0.0f && RandomStream.FRand() < LossChance)
+	{
+		return;
+	}
+	FSentPacket Sent;
+	Sent.PacketId = OutPacketId;
+	Sent.ArrivalTime = Driver->Time + OneWayLatency;
+	// a real client answers ping packets with data read from them, which the server checks against this cache before it updates the ping
+	Sent.bHasPingAckData = (OutPacketId % PING_ACK_PACKET_INTERVAL) == 0;
+	Sent.PingAckData = Sent.bHasPingAckData ? PingAckDataCache[(OutPacketId % MAX_PACKETID) / PING_ACK_PACKET_INTERVAL] : 0;
+	SentPackets.Add(Sent);
+}
+
+void UUTSimulatedNetConnection::Tick()
+{
+	Super::Tick();
+	if (State == USOCK_Closed || Driver == NULL)
+	{
+		return;
+	}
+
+	const double Now = Driver->Time;
+	if (MoveRate > 0.0f)
+	{
+		const float ClientDeltaTime = 1.0f / MoveRate;
+		// after a hitch the client would have sent one long move, not a burst of short ones
+		if (Now - NextClientPacketTime > 0.25)
+		{
+			NextClientPacketTime = Now;
+		}
+		while (NextClientPacketTime <= Now)
+		{
+			SendClientPacket(NextClientPacketTime, ClientDeltaTime);
+			NextClientPacketTime += ClientDeltaTime;
+		}
+	}
+
+	int32 NumArrived = 0;
+	while (NumArrived < ClientPackets.Num() && ClientPackets[NumArrived].ArrivalTime <= Now && State != USOCK_Closed)
+	{
+		DeliverClientPacket(ClientPackets[NumArrived]);
+		NumArrived++;
+	}
+	ClientPackets.RemoveAt(0, NumArrived);
+}
+
+void UUTSimulatedNetConnection::UpdateInput(double Now)
+{
+	APawn* Pawn = (PlayerController != NULL) ? PlayerController->GetPawn() : NULL;
+	bHadPawn = bHadPawn || (Pawn != NULL);
+	if (Pawn != MovePawn.Get())
+	{
+		// a client starts a new move sequence for each pawn it possesses
+		MovePawn = Pawn;
+		ClientTimeStamp = 0.0f;
+		NextInputChangeTime = Now;
+		InputYaw = (Pawn != NULL) ? Pawn->GetActorRotation().Yaw : 0.0f;
+	}
+
+	if (Pawn == NULL)
+	{
+		// press fire to respawn every now and then, ServerRestartPlayer() sorts out whether that is allowed yet
+		if (PlayerController != NULL && Now >= NextRestartTime)
+		{
+			NextRestartTime = Now + 1.0;
+			PlayerController->ServerRestartPlayer();
+		}
+	}
+	else if (Now >= NextInputChangeTime)
+	{
+		// run in a new direction every few seconds, and sometimes stop to look around
+		NextInputChangeTime = Now + RandomStream.FRandRange(0.5f, 3.0f);
+		InputYaw = FRotator::ClampAxis(InputYaw + RandomStream.FRandRange(-120.0f, 120.0f));
+		InputPitch = RandomStream.FRandRange(-20.0f, 20.0f);
+		bInputMoving = RandomStream.FRand() < 0.9f;
+	}
+}
+
+void UUTSimulatedNetConnection::SendClientPacket(double SendTime, float DeltaTime)
+{
+	FClientPacket Packet;
+	Packet.PacketId = ClientPacketId++;
+	Packet.ArrivalTime = SendTime + OneWayLatency;
+
+	// acknowledge everything from the server that has arrived by now
+	int32 NumArrived = 0;
+	while (NumArrived < SentPackets.Num() && SentPackets[NumArrived].ArrivalTime <= SendTime)
+	{
+		NumArrived++;
+	}
+	Packet.ResentAcks = LastAcks;
+	Packet.Acks.Append(SentPackets.GetData(), NumArrived);
+	SentPackets.RemoveAt(0, NumArrived, false);
+	LastAcks = Packet.Acks;
+
+	UpdateInput(SendTime);
+	AUTCharacter* UTChar = Cast<AUTCharacter>(MovePawn.Get());
+	Packet.bHasMove = (UTChar != NULL && UTChar->UTCharacterMovement != NULL);
+	if (Packet.bHasMove)
+	{
+		ClientTimeStamp += DeltaTime;
+		// same as FNetworkPredictionData_Client_Character::UpdateTimeStampAndDeltaTime()
+		if (ClientTimeStamp > UTChar->UTCharacterMovement->MinTimeBetweenTimeStampResets)
+		{
+			ClientTimeStamp = DeltaTime;
+		}
+		Packet.TimeStamp = ClientTimeStamp;
+		Packet.Accel = bInputMoving ? FRotator(0.0f, InputYaw, 0.0f).Vector() * UTChar->UTCharacterMovement->GetMaxAcceleration() : FVector::ZeroVector;
+		Packet.Yaw = InputYaw;
+		Packet.Pitch = InputPitch;
+		Packet.MoveFlags = (bInputMoving && RandomStream.FRand() < 0.02f) ? FSavedMove_Character::FLAG_JumpPressed : 0;
+	}
+
+	if (LossChance > 0.0f && RandomStream.FRand() < LossChance)
+	{
+		// lost on the way along with its acks; the next packet still resends them and later moves cover the time
+		return;
+	}
+	ClientPackets.Add(Packet);
+}
+
+void UUTSimulatedNetConnection::DeliverClientPacket(const FClientPacket& Packet)
+{
+	// the packet goes through the regular receive path, so acks, resends and ping are handled by UNetConnection
+	FBitWriter Writer(MaxPacket * 8, true);
+	Writer.WriteIntWrapped(Packet.PacketId, MAX_PACKETID);
+	for (int32 i = 0; i < Packet.ResentAcks.Num() + Packet.Acks.Num(); i++)
+	{
+		const bool bResent = i < Packet.ResentAcks.Num();
+		const FSentPacket& Ack = bResent ? Packet.ResentAcks[i] : Packet.Acks[i - Packet.ResentAcks.Num()];
+		Writer.WriteBit(1);
+		Writer.WriteIntWrapped(Ack.PacketId, MAX_PACKETID);
+		if ((Ack.PacketId % PING_ACK_PACKET_INTERVAL) == 0)
+		{
+			uint8 bHasPingAckData = (Ack.bHasPingAckData && !bResent) ? 1 : 0;
+			Writer.WriteBit(bHasPingAckData);
+			if (bHasPingAckData)
+			{
+				uint32 PingAckData = Ack.PingAckData;
+				Writer.Serialize(&PingAckData, sizeof(uint32));
+			}
+		}
+	}
+	Writer.WriteBit(1);
+	while (Writer.GetNumBits() & 7)
+	{
+		Writer.WriteBit(0);
+	}
+	ReceivedRawPacket(Writer.GetData(), Writer.GetNumBytes());
+
+	AUTCharacter* UTChar = Cast<AUTCharacter>(MovePawn.Get());
+	if (Packet.bHasMove && State != USOCK_Closed && UTChar != NULL && PlayerController != NULL && UTChar->Controller == PlayerController && UTChar->UTCharacterMovement != NULL)
+	{
+		// what the RPCs do once they are received; the client isn't simulated, so it claims to be where the server has it and corrections are rare
+		UPrimitiveComponent* MovementBase = UTChar->GetMovementBase();
+		const FVector ClientLoc = MovementBaseUtility::UseRelativeLocation(MovementBase) ? UTChar->GetBasedMovement().Location : UTChar->GetActorLocation();
+		UTChar->UTServerMove(Packet.TimeStamp, Packet.Accel, ClientLoc, Packet.MoveFlags, Packet.Yaw, Packet.Pitch, MovementBase, UTChar->GetBasedMovement().BoneName, UTChar->UTCharacterMovement->PackNetworkMovementMode());
+		const int32 CompressedRotation = (int32(FRotator::CompressAxisToShort(Packet.Yaw)) << 16) | FRotator::CompressAxisToShort(Packet.Pitch);
+		PlayerController->ServerUpdateCamera(UTChar->GetPawnViewLocation(), CompressedRotation);
+	}
+}
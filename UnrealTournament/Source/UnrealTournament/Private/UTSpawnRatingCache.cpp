@@ -0,0 +1,163 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTSpawnRatingCache.h"
+
+static TAutoConsoleVariable<int32> CVarSpawnRatingTraceBudget(
+	TEXT("ut.SpawnRatingTraceBudget"),
+	32,
+	TEXT("Visibility traces player start rating may make per frame, after that it goes by remembered visibility. 0 means no limit."));
+
+/** size of the regions start visibility is remembered for */
+static const float VisibilityCellSize = 512.0f;
+/** size of the cells pawns are bucketed into, about half the distance enemies are considered at */
+static const float PawnCellSize = 4096.0f;
+/** how many starts have their visibility to the other starts traced per update */
+static const int32 PrecomputeStartsPerUpdate = 4;
+
+FUTSpawnRatingCache::FUTSpawnRatingCache()
+	: PawnGridFrame(0)
+	, NextPrecomputeStart(0)
+	, bGatheredStarts(false)
+	, TraceBudgetFrame(0)
+	, TracesThisFrame(0)
+{
+}
+
+FIntVector FUTSpawnRatingCache::GetVisibilityCell(const FVector& Location)
+{
+	return FIntVector(FMath::FloorToInt(Location.X / VisibilityCellSize), FMath::FloorToInt(Location.Y / VisibilityCellSize), FMath::FloorToInt(Location.Z / VisibilityCellSize));
+}
+
+FIntVector FUTSpawnRatingCache::GetPawnCell(const FVector& Location)
+{
+	return FIntVector(FMath::FloorToInt(Location.X / PawnCellSize), FMath::FloorToInt(Location.Y / PawnCellSize), 0);
+}
+
+void FUTSpawnRatingCache::Update(UWorld* World)
+{
+	if (!bGatheredStarts)
+	{
+		bGatheredStarts = true;
+		for (TActorIterator<APlayerStart> It(World); It; ++It)
+		{
+			PlayerStarts.Add(*It);
+		}
+	}
+
+	for (int32 NumDone = 0; NumDone < PrecomputeStartsPerUpdate && NextPrecomputeStart < PlayerStarts.Num(); NumDone++, NextPrecomputeStart++)
+	{
+		APlayerStart* Start = PlayerStarts[NextPrecomputeStart].Get();
+		if (Start == NULL)
+		{
+			continue;
+		}
+		const FVector StartLoc = Start->GetActorLocation() + AUTCharacter::StaticClass()->GetDefaultObject<AUTCharacter>()->BaseEyeHeight;
+		for (const TWeakObjectPtr<APlayerStart>& OtherStart : PlayerStarts)
+		{
+			if (OtherStart.IsValid() && OtherStart.Get() != Start)
+			{
+				// where the head of someone who just spawned there would be
+				const FVector Target = OtherStart->GetActorLocation() + FVector(0.f, 0.f, OtherStart->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+				FVisibilityEntry& Entry = Visibility.FindOrAdd(FVisibilityKey(Start, GetVisibilityCell(Target)));
+				Entry.Target = Target;
+				Entry.Frame = 0;
+				Entry.bVisible = TraceVisibility(World, StartLoc, Target);
+			}
+		}
+	}
+}
+
+void FUTSpawnRatingCache::UpdatePawnGrid(UWorld* World)
+{
+	if (PawnGridFrame == GFrameCounter)
+	{
+		return;
+	}
+	PawnGridFrame = GFrameCounter;
+
+	for (TMap<FIntVector, TArray<ACharacter*>>::TIterator It(PawnGrid); It; ++It)
+	{
+		It.Value().Reset();
+	}
+	AllCharacters.Reset();
+	for (FConstControllerIterator It = World->GetControllerIterator(); It; ++It)
+	{
+		ACharacter* Character = Cast<ACharacter>((*It)->GetPawn());
+		if (Character != NULL && Character->PlayerState != NULL)
+		{
+			AllCharacters.Add(Character);
+			PawnGrid.FindOrAdd(GetPawnCell(Character->GetActorLocation())).Add(Character);
+		}
+	}
+}
+
+void FUTSpawnRatingCache::GetCharactersNear(UWorld* World, const FVector& Location, float Radius, TArray<ACharacter*>& OutCharacters)
+{
+	UpdatePawnGrid(World);
+
+	if (Radius <= 0.0f)
+	{
+		OutCharacters.Append(AllCharacters);
+		return;
+	}
+
+	const FIntVector MinCell = GetPawnCell(Location - FVector(Radius));
+	const FIntVector MaxCell = GetPawnCell(Location + FVector(Radius));
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			const TArray<ACharacter*>* Cell = PawnGrid.Find(FIntVector(X, Y, 0));
+			if (Cell != NULL)
+			{
+				for (ACharacter* Character : *Cell)
+				{
+					// may have died since the grid was built
+					if (Character->PlayerState != NULL)
+					{
+						OutCharacters.Add(Character);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool FUTSpawnRatingCache::TraceVisibility(UWorld* World, const FVector& StartLoc, const FVector& Target)
+{
+	static FName NAME_RatePlayerStart = FName(TEXT("RatePlayerStart"));
+	return !World->LineTraceTestByChannel(StartLoc, Target, ECC_Visibility, FCollisionQueryParams(NAME_RatePlayerStart, false));
+}
+
+bool FUTSpawnRatingCache::IsVisible(UWorld* World, APlayerStart* Start, const FVector& StartLoc, const FVector& Target)
+{
+	if (TraceBudgetFrame != GFrameCounter)
+	{
+		TraceBudgetFrame = GFrameCounter;
+		TracesThisFrame = 0;
+	}
+
+	FVisibilityEntry* Entry = Visibility.Find(FVisibilityKey(Start, GetVisibilityCell(Target)));
+	if (Entry != NULL && Entry->Frame == GFrameCounter && Entry->Target == Target)
+	{
+		// already traced this frame, e.g. the second respawn choice or another player rating the same start
+		return Entry->bVisible;
+	}
+
+	const int32 TraceBudget = CVarSpawnRatingTraceBudget.GetValueOnGameThread();
+	if (Entry != NULL && TraceBudget > 0 && TracesThisFrame >= TraceBudget)
+	{
+		return Entry->bVisible;
+	}
+
+	// nothing known about the region yet or there's budget left, trace
+	TracesThisFrame++;
+	if (Entry == NULL)
+	{
+		Entry = &Visibility.Add(FVisibilityKey(Start, GetVisibilityCell(Target)));
+	}
+	Entry->Target = Target;
+	Entry->Frame = GFrameCounter;
+	Entry->bVisible = TraceVisibility(World, StartLoc, Target);
+	return Entry->bVisible;
+}
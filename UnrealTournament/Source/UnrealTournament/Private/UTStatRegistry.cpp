@@ -0,0 +1,22 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTStatRegistry.h"
+
+FUTStatRegistry& FUTStatRegistry::Get()
+{
+	static FUTStatRegistry Registry;
+	return Registry;
+}
+
+int32 FUTStatRegistry::RegisterStat(FName StatName)
+{
+	FUTStatRegistry& Registry = Get();
+	const int32* Index = Registry.StatIndices.Find(StatName);
+	if (Index != NULL)
+	{
+		return *Index;
+	}
+	const int32 NewIndex = Registry.StatNames.Add(StatName);
+	Registry.StatIndices.Add(StatName, NewIndex);
+	return NewIndex;
+}
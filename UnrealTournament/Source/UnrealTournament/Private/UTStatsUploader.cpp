@@ -0,0 +1,356 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTStatsUploader.h"
+#include "Async.h"
+
+static TAutoConsoleVariable<int32> CVarStatsFileSink(
+	TEXT("ut.StatsFileSink"),
+	0,
+	TEXT("Write backend stats batches to Saved/Stats instead of sending them to the stats service."));
+
+/** first retry delay, doubled with every failed attempt */
+static const double StatsRetryBaseDelay = 15.0;
+static const double StatsRetryMaxDelay = 600.0;
+
+static FUTStatsUploader* StatsUploader = NULL;
+
+FUTStatsUploader& FUTStatsUploader::Get()
+{
+	if (StatsUploader == NULL)
+	{
+		StatsUploader = new FUTStatsUploader();
+	}
+	return *StatsUploader;
+}
+
+void FUTStatsUploader::Shutdown()
+{
+	delete StatsUploader;
+	StatsUploader = NULL;
+}
+
+FUTStatsUploader::FUTStatsUploader()
+{
+}
+
+FUTStatsUploader::~FUTStatsUploader()
+{
+	if (SpoolLoad.IsValid())
+	{
+		SpoolLoad.Wait();
+	}
+	for (TFuture<void>& Work : BackgroundWork)
+	{
+		Work.Wait();
+	}
+	for (FHttpRequestPtr& Request : ActiveRequests)
+	{
+		Request->OnProcessRequestComplete().Unbind();
+		Request->CancelRequest();
+	}
+	if (SpooledBatches.Num() > 0)
+	{
+		UE_LOG(LogGameStats, Log, TEXT("%i stats batches left in the spool to be sent later"), SpooledBatches.Num());
+	}
+}
+
+FString FUTStatsUploader::GetSpoolDir() const
+{
+	// one directory per process so several servers on a machine don't send each other's batches
+	return FPaths::Combine(*FPaths::GameSavedDir(), TEXT("StatsSpool"), *FString::Printf(TEXT("%u"), FPlatformProcess::GetCurrentProcessId()));
+}
+
+FString FUTStatsUploader::GetSpoolFilename(const FBatch& Batch) const
+{
+	return FPaths::Combine(*GetSpoolDir(), *Batch.BatchID) + TEXT(".json");
+}
+
+void FUTStatsUploader::AddPlayerStats(FUTBackendStatsEntry&& Entry)
+{
+	check(IsInGameThread());
+
+	if (!OpenBatch.IsValid())
+	{
+		OpenBatch = MakeShareable(new FBatch());
+		OpenBatch->BatchID = FGuid::NewGuid().ToString();
+	}
+	OpenBatch->Gathered.Add(MoveTemp(Entry));
+}
+
+bool FUTStatsUploader::Tick(float DeltaTime)
+{
+	if (!SpoolLoad.IsValid())
+	{
+		const FString SpoolDir = GetSpoolDir();
+		SpoolLoad = Async<void>(EAsyncExecution::ThreadPool, [this, SpoolDir]() { LoadSpool(SpoolDir); });
+	}
+
+	// everything gathered last frame goes out as one batch
+	if (OpenBatch.IsValid() && SpoolLoad.IsReady())
+	{
+		FBatchPtr Batch = OpenBatch;
+		OpenBatch.Reset();
+		BackgroundWork.Add(Async<void>(EAsyncExecution::ThreadPool, [this, Batch]() { SerializeBatch(Batch); }));
+	}
+	for (int32 i = BackgroundWork.Num() - 1; i >= 0; i--)
+	{
+		if (BackgroundWork[i].IsReady())
+		{
+			BackgroundWork.RemoveAt(i);
+		}
+	}
+
+	FBatchPtr ReadyBatch;
+	while (ReadyBatches.Dequeue(ReadyBatch))
+	{
+		SpooledBatches.Add(ReadyBatch);
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	TArray<FBatchPtr> DueBatches;
+	for (const FBatchPtr& Batch : SpooledBatches)
+	{
+		if (Batch->PendingRequests == 0 && Batch->NextAttemptTime <= Now)
+		{
+			DueBatches.Add(Batch);
+		}
+	}
+	// sending may finish and remove batches right away
+	for (const FBatchPtr& Batch : DueBatches)
+	{
+		SendBatch(Batch);
+	}
+
+	return true;
+}
+
+void FUTStatsUploader::SerializeBatch(FBatchPtr Batch)
+{
+	for (const FUTBackendStatsEntry& Entry : Batch->Gathered)
+	{
+		TSharedPtr<FJsonObject> StatsJson = MakeShareable(new FJsonObject);
+		for (int32 i = 0; i < Entry.StatNames.Num(); i++)
+		{
+			StatsJson->SetNumberField(Entry.StatNames[i].ToString(), Entry.StatValues[i]);
+		}
+		FString OutputJsonString;
+		TSharedRef< TJsonWriter< TCHAR, TCondensedJsonPrintPolicy<TCHAR> > > Writer = TJsonWriterFactory< TCHAR, TCondensedJsonPrintPolicy<TCHAR> >::Create(&OutputJsonString);
+		FJsonSerializer::Serialize(StatsJson.ToSharedRef(), Writer);
+
+		Batch->StatsIDs.Add(Entry.StatsID);
+		Batch->Payloads.Add(OutputJsonString);
+	}
+	Batch->Gathered.Empty();
+
+	if (!WriteSpoolFile(GetSpoolFilename(*Batch), *Batch))
+	{
+		UE_LOG(LogGameStats, Warning, TEXT("Failed to spool stats batch %s, it will be lost if it can't be sent"), *Batch->BatchID);
+	}
+	ReadyBatches.Enqueue(Batch);
+}
+
+bool FUTStatsUploader::WriteSpoolFile(const FString& Filename, const FBatch& Batch)
+{
+	TSharedPtr<FJsonObject> BatchJson = MakeShareable(new FJsonObject);
+	BatchJson->SetStringField(TEXT("BatchID"), Batch.BatchID);
+	TArray< TSharedPtr<FJsonValue> > EntriesJson;
+	for (int32 i = 0; i < Batch.StatsIDs.Num(); i++)
+	{
+		TSharedPtr<FJsonObject> EntryJson = MakeShareable(new FJsonObject);
+		EntryJson->SetStringField(TEXT("StatsID"), Batch.StatsIDs[i]);
+		EntryJson->SetStringField(TEXT("Payload"), Batch.Payloads[i]);
+		EntriesJson.Add(MakeShareable(new FJsonValueObject(EntryJson)));
+	}
+	BatchJson->SetArrayField(TEXT("Entries"), EntriesJson);
+
+	FString OutputJsonString;
+	TSharedRef< TJsonWriter< TCHAR, TCondensedJsonPrintPolicy<TCHAR> > > Writer = TJsonWriterFactory< TCHAR, TCondensedJsonPrintPolicy<TCHAR> >::Create(&OutputJsonString);
+	FJsonSerializer::Serialize(BatchJson.ToSharedRef(), Writer);
+	return FFileHelper::SaveStringToFile(OutputJsonString, *Filename);
+}
+
+bool FUTStatsUploader::ReadSpoolFile(const FString& Filename, FBatch& Batch)
+{
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *Filename))
+	{
+		return false;
+	}
+	TSharedPtr<FJsonObject> BatchJson;
+	TSharedRef< TJsonReader<> > Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, BatchJson) || !BatchJson.IsValid())
+	{
+		return false;
+	}
+	Batch.BatchID = BatchJson->GetStringField(TEXT("BatchID"));
+	const TArray< TSharedPtr<FJsonValue> >* EntriesJson = NULL;
+	if (Batch.BatchID.IsEmpty() || !BatchJson->TryGetArrayField(TEXT("Entries"), EntriesJson))
+	{
+		return false;
+	}
+	for (const TSharedPtr<FJsonValue>& EntryValue : *EntriesJson)
+	{
+		const TSharedPtr<FJsonObject>* EntryJson = NULL;
+		FString StatsID, Payload;
+		if (EntryValue->TryGetObject(EntryJson) && (*EntryJson)->TryGetStringField(TEXT("StatsID"), StatsID) && (*EntryJson)->TryGetStringField(TEXT("Payload"), Payload))
+		{
+			Batch.StatsIDs.Add(StatsID);
+			Batch.Payloads.Add(Payload);
+		}
+	}
+	return true;
+}
+
+void FUTStatsUploader::LoadSpool(const FString& SpoolDir)
+{
+	IFileManager& FileManager = IFileManager::Get();
+	const FString SpoolRoot = FPaths::GetPath(SpoolDir);
+	const FString OwnDirName = FPaths::GetCleanFilename(SpoolDir);
+
+	// adopt the spool of processes that exited before sending everything
+	TArray<FString> ProcessDirs;
+	FileManager.FindFiles(ProcessDirs, *(SpoolRoot / TEXT("*")), false, true);
+	for (const FString& ProcessDir : ProcessDirs)
+	{
+		const uint32 ProcessID = uint32(FCString::Atoi64(*ProcessDir));
+		if (ProcessDir != OwnDirName && (ProcessID == 0 || !FPlatformProcess::IsApplicationRunning(ProcessID)))
+		{
+			TArray<FString> OrphanFiles;
+			FileManager.FindFiles(OrphanFiles, *(SpoolRoot / ProcessDir / TEXT("*.json")), true, false);
+			for (const FString& OrphanFile : OrphanFiles)
+			{
+				// fails harmlessly if another starting process got to it first
+				FileManager.Move(*(SpoolDir / OrphanFile), *(SpoolRoot / ProcessDir / OrphanFile), false);
+			}
+			FileManager.DeleteDirectory(*(SpoolRoot / ProcessDir), false, false);
+		}
+	}
+
+	TArray<FString> SpoolFiles;
+	FileManager.FindFiles(SpoolFiles, *(SpoolDir / TEXT("*.json")), true, false);
+	for (const FString& SpoolFile : SpoolFiles)
+	{
+		FBatchPtr Batch = MakeShareable(new FBatch());
+		if (ReadSpoolFile(SpoolDir / SpoolFile, *Batch) && FPaths::GetBaseFilename(SpoolFile) == Batch->BatchID)
+		{
+			UE_LOG(LogGameStats, Log, TEXT("Loaded spooled stats batch %s with %i entries"), *Batch->BatchID, Batch->StatsIDs.Num());
+			ReadyBatches.Enqueue(Batch);
+		}
+		else
+		{
+			UE_LOG(LogGameStats, Warning, TEXT("Discarding unreadable stats spool file %s"), *SpoolFile);
+			FileManager.Delete(*(SpoolDir / SpoolFile));
+		}
+	}
+}
+
+void FUTStatsUploader::SendBatch(FBatchPtr Batch)
+{
+	Batch->Attempts++;
+
+	if (CVarStatsFileSink.GetValueOnGameThread() != 0)
+	{
+		const FString SinkFilename = FPaths::Combine(*FPaths::GameSavedDir(), TEXT("Stats"), *Batch->BatchID) + TEXT(".json");
+		if (WriteSpoolFile(SinkFilename, *Batch))
+		{
+			UE_LOG(LogGameStats, Log, TEXT("Wrote stats batch %s with %i entries to %s"), *Batch->BatchID, Batch->StatsIDs.Num(), *SinkFilename);
+			Batch->StatsIDs.Empty();
+			Batch->Payloads.Empty();
+		}
+		FinishAttempt(Batch);
+		return;
+	}
+
+	// the stats service takes one account per request, the batch is done when all of them are
+	FString AuthToken;
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+	if (OnlineSubsystem != NULL && OnlineSubsystem->GetIdentityInterface().IsValid())
+	{
+		AuthToken = OnlineSubsystem->GetIdentityInterface()->GetAuthToken(0);
+	}
+	for (int32 i = 0; i < Batch->StatsIDs.Num(); i++)
+	{
+		FHttpRequestPtr StatsWriteRequest = FHttpModule::Get().CreateRequest();
+		if (StatsWriteRequest.IsValid())
+		{
+			TArray<uint8> BackendStatsData;
+			{
+				FMemoryWriter MemoryWriter(BackendStatsData);
+				MemoryWriter.Serialize(TCHAR_TO_ANSI(*Batch->Payloads[i]), Batch->Payloads[i].Len() + 1);
+			}
+
+			StatsWriteRequest->SetURL(GetBackendStatsWriteURL(Batch->StatsIDs[i]));
+			StatsWriteRequest->OnProcessRequestComplete().BindRaw(this, &FUTStatsUploader::SendComplete, Batch, Batch->StatsIDs[i]);
+			StatsWriteRequest->SetVerb(TEXT("POST"));
+			StatsWriteRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+			if (!AuthToken.IsEmpty())
+			{
+				StatsWriteRequest->SetHeader(TEXT("Authorization"), FString(TEXT("bearer ")) + AuthToken);
+			}
+
+			UE_LOG(LogGameStats, VeryVerbose, TEXT("%s"), *Batch->Payloads[i]);
+
+			StatsWriteRequest->SetContent(BackendStatsData);
+			if (StatsWriteRequest->ProcessRequest())
+			{
+				Batch->PendingRequests++;
+				ActiveRequests.Add(StatsWriteRequest);
+			}
+		}
+	}
+	if (Batch->PendingRequests == 0)
+	{
+		FinishAttempt(Batch);
+	}
+}
+
+void FUTStatsUploader::SendComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FBatchPtr Batch, FString StatsID)
+{
+	ActiveRequests.Remove(HttpRequest);
+
+	const int32 ResponseCode = HttpResponse.IsValid() ? HttpResponse->GetResponseCode() : 0;
+	const bool bSent = bSucceeded && ResponseCode == 200;
+	// connection problems, server errors and throttling are worth trying again, anything else the service won't ever take
+	const bool bRetry = !bSent && (ResponseCode == 0 || ResponseCode == 429 || ResponseCode >= 500);
+	if (bSent)
+	{
+		UE_LOG(LogGameStats, Verbose, TEXT("Stats write succeeded %s %s"), *HttpRequest->GetURL(), *HttpResponse->GetContentAsString());
+	}
+	else
+	{
+		UE_LOG(LogGameStats, Warning, TEXT("Stats write failed %s %i %s%s"), *HttpRequest->GetURL(), ResponseCode, HttpResponse.IsValid() ? *HttpResponse->GetContentAsString() : TEXT(""), bRetry ? TEXT(", will retry") : TEXT(""));
+	}
+
+	if (!bRetry)
+	{
+		const int32 Index = Batch->StatsIDs.Find(StatsID);
+		if (Index != INDEX_NONE)
+		{
+			Batch->StatsIDs.RemoveAt(Index);
+			Batch->Payloads.RemoveAt(Index);
+		}
+	}
+
+	Batch->PendingRequests--;
+	if (Batch->PendingRequests == 0)
+	{
+		FinishAttempt(Batch);
+	}
+}
+
+void FUTStatsUploader::FinishAttempt(FBatchPtr Batch)
+{
+	const FString SpoolFilename = GetSpoolFilename(*Batch);
+	if (Batch->StatsIDs.Num() == 0)
+	{
+		IFileManager::Get().Delete(*SpoolFilename);
+		SpooledBatches.Remove(Batch);
+	}
+	else
+	{
+		// keep only what still needs sending so nothing is counted twice after a restart
+		WriteSpoolFile(SpoolFilename, *Batch);
+		Batch->NextAttemptTime = FPlatformTime::Seconds() + FMath::Min(StatsRetryBaseDelay * FMath::Pow(2.0f, FMath::Min(Batch->Attempts - 1, 10)), StatsRetryMaxDelay);
+		UE_LOG(LogGameStats, Log, TEXT("Stats batch %s has %i entries left, next attempt in %.0f seconds"), *Batch->BatchID, Batch->StatsIDs.Num(), Batch->NextAttemptTime - FPlatformTime::Seconds());
+	}
+}
@@ -0,0 +1,334 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#include "UnrealTournament.h"
+#include "UTTickAggregator.h"
+#include "TickTaskManagerInterface.h"
+#include "ParallelFor.h"
+
+static TAutoConsoleVariable<int32> CVarAggregateTicks(
+	TEXT("ut.AggregateTicks"),
+	1,
+	TEXT("If set, projectile movement, pickups and replicated emitters are ticked from one tick function per class instead of one each."));
+
+/** below this many members the parallel part of the members' ticks isn't spread over the workers */
+static const int32 MinParallelMembers = 16;
+
+struct FUTTickAggregatorKey
+{
+	ULevel* Level;
+	UClass* MemberClass;
+	ETickingGroup TickGroup;
+
+	FUTTickAggregatorKey(ULevel* InLevel, UClass* InMemberClass, ETickingGroup InTickGroup)
+		: Level(InLevel), MemberClass(InMemberClass), TickGroup(InTickGroup)
+	{}
+
+	bool operator==(const FUTTickAggregatorKey& Other) const
+	{
+		return Level == Other.Level && MemberClass == Other.MemberClass && TickGroup == Other.TickGroup;
+	}
+	friend uint32 GetTypeHash(const FUTTickAggregatorKey& Key)
+	{
+		return HashCombine(HashCombine(PointerHash(Key.Level), PointerHash(Key.MemberClass)), uint32(Key.TickGroup));
+	}
+};
+
+/** all aggregators, game thread only */
+static TMap<FUTTickAggregatorKey, FUTTickAggregator*> Aggregators;
+
+FUTTickAggregator::FUTTickAggregator(UClass* InMemberClass, ULevel* InLevel)
+	: MemberClass(InMemberClass)
+	, Level(InLevel)
+	, World(InLevel->OwningWorld)
+	, bTicking(false)
+	, bNeedsCompact(false)
+	, LastTickFrame(0)
+{
+	bCanEverTick = true;
+}
+
+bool FUTTickAggregator::Add(FTickFunction& TickFunction, UObject* Owner, ULevel* Level, FUTAggregatedTickHandle& Handle)
+{
+	check(IsInGameThread());
+
+	if (Handle.IsAggregated())
+	{
+		return true;
+	}
+	if (CVarAggregateTicks.GetValueOnGameThread() == 0 || Owner == NULL || Level == NULL || Level->OwningWorld == NULL ||
+		!TickFunction.IsTickFunctionRegistered() || TickFunction.bTickEvenWhenPaused || TickFunction.bRunOnAnyThread)
+	{
+		return false;
+	}
+	// members lose their prerequisites, so only take tick functions that don't depend on anything that still ticks
+	for (FTickPrerequisite& Prerequisite : TickFunction.GetPrerequisites())
+	{
+		FTickFunction* PrerequisiteFunction = Prerequisite.Get();
+		if (PrerequisiteFunction != NULL && PrerequisiteFunction->IsTickFunctionRegistered())
+		{
+			return false;
+		}
+	}
+
+	static bool bRegisteredDelegates = false;
+	if (!bRegisteredDelegates)
+	{
+		bRegisteredDelegates = true;
+		FWorldDelegates::LevelRemovedFromWorld.AddStatic(&FUTTickAggregator::OnLevelRemovedFromWorld);
+		FWorldDelegates::OnWorldCleanup.AddStatic(&FUTTickAggregator::OnWorldCleanup);
+	}
+
+	FUTTickAggregator*& Aggregator = Aggregators.FindOrAdd(FUTTickAggregatorKey(Level, Owner->GetClass(), TickFunction.TickGroup));
+	if (Aggregator == NULL)
+	{
+		Aggregator = new FUTTickAggregator(Owner->GetClass(), Level);
+		Aggregator->TickGroup = TickFunction.TickGroup;
+		Aggregator->RegisterTickFunction(Level);
+	}
+	Aggregator->bRunInParallelBatch = Aggregator->bRunInParallelBatch || TickFunction.bRunInParallelBatch;
+
+	TickFunction.UnRegisterTickFunction();
+	Handle.Aggregator = Aggregator;
+	FMember* Member;
+	if (Aggregator->bTicking)
+	{
+		Handle.Index = INDEX_NONE;
+		Member = &Aggregator->PendingMembers[Aggregator->PendingMembers.Add(FMember(&TickFunction, &Handle))];
+	}
+	else
+	{
+		Handle.Index = Aggregator->Members.Add(FMember(&TickFunction, &Handle));
+		Member = &Aggregator->Members[Handle.Index];
+	}
+	Aggregator->AddDependents(*Member, Owner);
+	return true;
+}
+
+void FUTTickAggregator::AddDependents(FMember& Member, UObject* Owner)
+{
+	// prerequisites on unregistered tick functions are skipped when the frame's ticks are queued, so anything waiting for the member would stop waiting
+	// only the owning actor and its components are looked at; that is where these dependencies are made (e.g. UMovementComponent::RegisterComponentTickFunctions())
+	AActor* Actor = Cast<AActor>(Owner);
+	if (Actor == NULL && Cast<UActorComponent>(Owner) != NULL)
+	{
+		Actor = ((UActorComponent*)Owner)->GetOwner();
+	}
+	if (Actor == NULL)
+	{
+		return;
+	}
+	auto CheckDependent = [&Member](UObject* Object, FTickFunction& Dependent)
+	{
+		if (&Dependent == Member.TickFunction)
+		{
+			return;
+		}
+		for (FTickPrerequisite& Prerequisite : Dependent.GetPrerequisites())
+		{
+			if (Prerequisite.PrerequisiteTickFunction == Member.TickFunction)
+			{
+				new(Member.Dependents) FDependent(Object, &Dependent, Prerequisite.PrerequisiteObject);
+				break;
+			}
+		}
+	};
+	CheckDependent(Actor, Actor->PrimaryActorTick);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component != NULL)
+		{
+			CheckDependent(Component, Component->PrimaryComponentTick);
+		}
+	}
+
+	for (const FDependent& Dependent : Member.Dependents)
+	{
+		Dependent.TickFunction->RemovePrerequisite(Dependent.PrerequisiteObject.Get(), *Member.TickFunction);
+		Dependent.TickFunction->AddPrerequisite(Level, *this);
+		DependentCounts.FindOrAdd(Dependent.TickFunction)++;
+	}
+}
+
+void FUTTickAggregator::RestoreDependents(FMember& Member)
+{
+	for (const FDependent& Dependent : Member.Dependents)
+	{
+		int32* Count = DependentCounts.Find(Dependent.TickFunction);
+		if (Count != NULL && --(*Count) <= 0)
+		{
+			DependentCounts.Remove(Dependent.TickFunction);
+			if (Dependent.Object.IsValid())
+			{
+				Dependent.TickFunction->RemovePrerequisite(Level, *this);
+			}
+		}
+		if (Dependent.Object.IsValid() && Dependent.PrerequisiteObject.IsValid())
+		{
+			Dependent.TickFunction->AddPrerequisite(Dependent.PrerequisiteObject.Get(), *Member.TickFunction);
+		}
+	}
+	Member.Dependents.Reset();
+}
+
+void FUTTickAggregator::Remove(FUTAggregatedTickHandle& Handle)
+{
+	check(IsInGameThread());
+
+	if (Handle.Aggregator != NULL)
+	{
+		Handle.Aggregator->RemoveMember(Handle);
+	}
+}
+
+void FUTTickAggregator::RemoveMember(FUTAggregatedTickHandle& Handle)
+{
+	if (Handle.Index == INDEX_NONE)
+	{
+		for (int32 i = 0; i < PendingMembers.Num(); i++)
+		{
+			if (PendingMembers[i].Handle == &Handle)
+			{
+				RestoreDependents(PendingMembers[i]);
+				PendingMembers.RemoveAt(i);
+				break;
+			}
+		}
+	}
+	else if (bTicking)
+	{
+		// don't move anything around while iterating
+		RestoreDependents(Members[Handle.Index]);
+		Members[Handle.Index] = FMember(NULL, NULL);
+		bNeedsCompact = true;
+	}
+	else
+	{
+		RestoreDependents(Members[Handle.Index]);
+		Members.RemoveAtSwap(Handle.Index);
+		if (Handle.Index < Members.Num())
+		{
+			Members[Handle.Index].Handle->Index = Handle.Index;
+		}
+	}
+	Handle.Aggregator = NULL;
+	Handle.Index = INDEX_NONE;
+}
+
+void FUTTickAggregator::FinishTicking()
+{
+	bTicking = false;
+	if (bNeedsCompact)
+	{
+		int32 NewNum = 0;
+		for (int32 i = 0; i < Members.Num(); i++)
+		{
+			if (Members[i].TickFunction != NULL)
+			{
+				Members[NewNum] = Members[i];
+				Members[NewNum].Handle->Index = NewNum;
+				NewNum++;
+			}
+		}
+		Members.SetNum(NewNum, false);
+		bNeedsCompact = false;
+	}
+	for (const FMember& Member : PendingMembers)
+	{
+		Member.Handle->Index = Members.Add(Member);
+	}
+	PendingMembers.Reset();
+}
+
+void FUTTickAggregator::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	bTicking = true;
+	for (int32 i = 0; i < Members.Num(); i++)
+	{
+		FTickFunction* TickFunction = Members[i].TickFunction;
+		if (TickFunction == NULL)
+		{
+			continue;
+		}
+		if (TickFunction->IsTickFunctionRegistered())
+		{
+			// registered again by someone else, so it ticks on its own now
+			RemoveMember(*Members[i].Handle);
+		}
+		else if (TickFunction->IsTickFunctionEnabled() && (TickFunction->EnableParent == NULL || TickFunction->EnableParent->IsTickFunctionEnabled()))
+		{
+			TickFunction->ExecuteNestedTick(DeltaTime, TickType, CurrentThread, MyCompletionGraphEvent);
+		}
+	}
+	LastTickFrame = GFrameCounter;
+	FinishTicking();
+}
+
+void FUTTickAggregator::ExecuteParallelTick(float DeltaTime, ELevelTick TickType)
+{
+	// the game thread is waiting for the batch, so the members can't change until we're done
+	MemberDeferredChanges.SetNum(Members.Num());
+	ParallelFor(Members.Num(), [this, DeltaTime, TickType](int32 Index)
+	{
+		FTickFunction* TickFunction = Members[Index].TickFunction;
+		if (TickFunction != NULL && TickFunction->bRunInParallelBatch && TickFunction->IsTickFunctionEnabled() && !TickFunction->IsTickFunctionRegistered())
+		{
+			FScopedDeferredTickChanges CollectChanges(MemberDeferredChanges[Index]);
+			TickFunction->ExecuteNestedParallelTick(DeltaTime, TickType);
+		}
+	}, Members.Num() < MinParallelMembers);
+
+	FTickTaskManagerInterface& TickTaskManager = FTickTaskManagerInterface::Get();
+	for (TArray<TFunction<void()>>& Changes : MemberDeferredChanges)
+	{
+		for (TFunction<void()>& Change : Changes)
+		{
+			TickTaskManager.DeferToGameThread(MoveTemp(Change));
+		}
+		Changes.Reset();
+	}
+}
+
+FString FUTTickAggregator::DiagnosticMessage()
+{
+	return FString::Printf(TEXT("%s[AggregatedTick x%d]"), *GetNameSafe(MemberClass), Members.Num());
+}
+
+void FUTTickAggregator::DestroyAggregators(UWorld* InWorld, ULevel* InLevel)
+{
+	for (TMap<FUTTickAggregatorKey, FUTTickAggregator*>::TIterator It(Aggregators); It; ++It)
+	{
+		FUTTickAggregator* Aggregator = It.Value();
+		if (Aggregator->World == InWorld && (InLevel == NULL || Aggregator->Level == InLevel))
+		{
+			// anything still in here is going away with the level
+			for (FMember& Member : Aggregator->Members)
+			{
+				if (Member.Handle != NULL)
+				{
+					Aggregator->RestoreDependents(Member);
+					Member.Handle->Aggregator = NULL;
+					Member.Handle->Index = INDEX_NONE;
+				}
+			}
+			for (FMember& Member : Aggregator->PendingMembers)
+			{
+				Aggregator->RestoreDependents(Member);
+				Member.Handle->Aggregator = NULL;
+				Member.Handle->Index = INDEX_NONE;
+			}
+			// unregisters the tick function
+			delete Aggregator;
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FUTTickAggregator::OnLevelRemovedFromWorld(ULevel* InLevel, UWorld* InWorld)
+{
+	// NULL level means all of them
+	DestroyAggregators(InWorld, InLevel);
+}
+
+void FUTTickAggregator::OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources)
+{
+	DestroyAggregators(InWorld, NULL);
+}
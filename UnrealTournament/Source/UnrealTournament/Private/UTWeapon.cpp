@@ -1360,10 +1360,14 @@ AUTProjectile* AUTWeapon::SpawnNetPredictedProjectile(TSubclassOf<AUTProjectile>
 	Params.Instigator = UTOwner;
 	Params.Owner = UTOwner;
 	Params.bNoCollisionFail = true; // we already checked this in GetFireStartLoc()
-	AUTProjectile* NewProjectile = 
-		((Role == ROLE_Authority) || (CatchupTickDelta > 0.f))
-		? GetWorld()->SpawnActor<AUTProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, Params)
-		: NULL;
+	AUTWorldSettings* Settings = Cast<AUTWorldSettings>(GetWorldSettings());
+	AUTProjectile* NewProjectile = NULL;
+	if ((Role == ROLE_Authority) || (CatchupTickDelta > 0.f))
+	{
+		NewProjectile = (Settings != NULL)
+			? Settings->SpawnProjectile(ProjectileClass, SpawnLocation, SpawnRotation, Params)
+			: GetWorld()->SpawnActor<AUTProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, Params);
+	}
 	if (NewProjectile)
 	{
 		if (Role == ROLE_Authority)
@@ -1401,7 +1405,10 @@ void AUTWeapon::SpawnDelayedFakeProjectile()
 		Params.Instigator = UTOwner;
 		Params.Owner = UTOwner;
 		Params.bNoCollisionFail = true; // we already checked this in GetFireStartLoc()
-		AUTProjectile* NewProjectile = GetWorld()->SpawnActor<AUTProjectile>(DelayedProjectile.ProjectileClass, DelayedProjectile.SpawnLocation, DelayedProjectile.SpawnRotation, Params);
+		AUTWorldSettings* Settings = Cast<AUTWorldSettings>(GetWorldSettings());
+		AUTProjectile* NewProjectile = (Settings != NULL)
+			? Settings->SpawnProjectile(DelayedProjectile.ProjectileClass, DelayedProjectile.SpawnLocation, DelayedProjectile.SpawnRotation, Params)
+			: GetWorld()->SpawnActor<AUTProjectile>(DelayedProjectile.ProjectileClass, DelayedProjectile.SpawnLocation, DelayedProjectile.SpawnRotation, Params);
 		if (NewProjectile)
 		{
 			NewProjectile->InitFakeProjectile(OwningPlayer);
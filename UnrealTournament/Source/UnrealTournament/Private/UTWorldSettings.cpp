@@ -5,6 +5,32 @@
 #include "Particles/ParticleSystemComponent.h"
 #include "UTGameEngine.h"
 #include "UTLevelSummary.h"
+#include "UTGib.h"
+#include "UTProjectile.h"
+
+DECLARE_STATS_GROUP(TEXT("UT Effects"), STATGROUP_UTEffects, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gibs spawned"), STAT_UTGibsSpawned, STATGROUP_UTEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gibs reused"), STAT_UTGibsReused, STATGROUP_UTEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gibs evicted"), STAT_UTGibsEvicted, STATGROUP_UTEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Decals created"), STAT_UTDecalsCreated, STATGROUP_UTEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Decals reused"), STAT_UTDecalsReused, STATGROUP_UTEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled gibs"), STAT_UTPooledGibs, STATGROUP_UTEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled decals"), STAT_UTPooledDecals, STATGROUP_UTEffects);
+DECLARE_CYCLE_STAT(TEXT("Gib spawn time"), STAT_UTGibSpawnTime, STATGROUP_UTEffects);
+DECLARE_CYCLE_STAT(TEXT("Gib reuse time"), STAT_UTGibReuseTime, STATGROUP_UTEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles spawned"), STAT_UTProjectilesSpawned, STATGROUP_UTEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles reused"), STAT_UTProjectilesReused, STATGROUP_UTEffects);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled projectiles"), STAT_UTPooledProjectiles, STATGROUP_UTEffects);
+DECLARE_CYCLE_STAT(TEXT("Projectile spawn time"), STAT_UTProjectileSpawnTime, STATGROUP_UTEffects);
+DECLARE_CYCLE_STAT(TEXT("Projectile reuse time"), STAT_UTProjectileReuseTime, STATGROUP_UTEffects);
+
+static TAutoConsoleVariable<int32> CVarEffectPooling(
+	TEXT("ut.EffectPooling"),
+	1,
+	TEXT("If set, gibs, blood decals and projectiles that allow it are hidden and reused instead of being destroyed and spawned again."));
+
+/** more hidden decals than this are destroyed instead of kept for reuse */
+static const int32 MAX_UNUSED_DECALS = 64;
 
 AUTWorldSettings::AUTWorldSettings(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -15,6 +41,12 @@ AUTWorldSettings::AUTWorldSettings(const FObjectInitializer& ObjectInitializer)
 	MaxImpactEffectInvisibleLifetime = 15.0f;
 	ImpactEffectFadeSpeed = 0.5f;
 	ImpactEffectFadeTime=1.0f;
+	MaxGibs = 64;
+	MaxPooledProjectiles = 128;
+	NumGibsSpawned = 0;
+	NumGibsReused = 0;
+	NumDecalsCreated = 0;
+	NumDecalsReused = 0;
 
 	PrimaryActorTick.bCanEverTick = true;
 	PrimaryActorTick.bStartWithTickEnabled = true;
@@ -159,8 +191,7 @@ void AUTWorldSettings::FadeImpactEffects(float DeltaTime)
 
 		if (TimeLived > DesiredTimeout)
 		{
-			FadingEffects[i].EffectComp->DetachFromParent();
-			FadingEffects[i].EffectComp->DestroyComponent();
+			RemoveImpactEffect(FadingEffects[i].EffectComp);
 			FadingEffects.RemoveAt(i--);
 		}
 	}
@@ -215,8 +246,7 @@ void AUTWorldSettings::ExpireImpactEffects()
 				float TimeLived = WorldTime - TimedEffects[i].CreationTime;
 				if (TimeLived > DesiredTimeout)
 				{
-					TimedEffects[i].EffectComp->DetachFromParent();
-					TimedEffects[i].EffectComp->DestroyComponent();
+					RemoveImpactEffect(TimedEffects[i].EffectComp);
 					TimedEffects.RemoveAt(i--);
 				}
 				else if (TimeLived > DesiredTimeout - ImpactEffectFadeTime)
@@ -235,6 +265,224 @@ void AUTWorldSettings::ExpireImpactEffects()
 	}
 }
 
+void AUTWorldSettings::RemoveImpactEffect(USceneComponent* EffectComp)
+{
+	EffectComp->DetachFromParent();
+	// only plain decals from NewDecal(), those made from an effect's template have its settings
+	UDecalComponent* Decal = Cast<UDecalComponent>(EffectComp);
+	if (Decal != NULL && Decal->GetArchetype() == GetDefault<UDecalComponent>() && Decal->GetOuter() == GetWorld() && UnusedDecals.Num() < MAX_UNUSED_DECALS && CVarEffectPooling.GetValueOnGameThread() != 0)
+	{
+		Decal->UnregisterComponent();
+		UnusedDecals.Add(Decal);
+	}
+	else
+	{
+		EffectComp->DestroyComponent();
+	}
+}
+
+UDecalComponent* AUTWorldSettings::NewDecal()
+{
+	SET_DWORD_STAT(STAT_UTPooledDecals, UnusedDecals.Num());
+	while (UnusedDecals.Num() > 0)
+	{
+		UDecalComponent* Decal = UnusedDecals.Pop(false);
+		if (Decal != NULL && !Decal->IsPendingKill())
+		{
+			INC_DWORD_STAT(STAT_UTDecalsReused);
+			NumDecalsReused++;
+			// undo the fade out
+			Decal->FadeScreenSize = GetDefault<UDecalComponent>()->FadeScreenSize;
+			return Decal;
+		}
+	}
+	INC_DWORD_STAT(STAT_UTDecalsCreated);
+	NumDecalsCreated++;
+	return NewObject<UDecalComponent>(GetWorld());
+}
+
+AUTGib* AUTWorldSettings::SpawnGib(TSubclassOf<AUTGib> GibClass, const FVector& Location, const FRotator& Rotation, APawn* InInstigator)
+{
+	if (GibClass == NULL)
+	{
+		return NULL;
+	}
+
+	const bool bPooling = CVarEffectPooling.GetValueOnGameThread() != 0;
+	if (bPooling)
+	{
+		// gibs can also be destroyed by other things, e.g. lifts they block
+		ActiveGibs.RemoveAll([](AUTGib* Gib) { return Gib == NULL || Gib->IsPendingKillPending(); });
+		if (MaxGibs > 0)
+		{
+			while (ActiveGibs.Num() >= MaxGibs)
+			{
+				INC_DWORD_STAT(STAT_UTGibsEvicted);
+				RecycleGib(FindGibToEvict());
+			}
+		}
+	}
+
+	AUTGib* Gib = NULL;
+	if (bPooling)
+	{
+		for (int32 i = UnusedGibs.Num() - 1; i >= 0; i--)
+		{
+			if (UnusedGibs[i] == NULL || UnusedGibs[i]->IsPendingKillPending())
+			{
+				UnusedGibs.RemoveAt(i);
+			}
+			else if (UnusedGibs[i]->GetClass() == GibClass)
+			{
+				Gib = UnusedGibs[i];
+				UnusedGibs.RemoveAt(i);
+				break;
+			}
+		}
+	}
+	if (Gib != NULL)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UTGibReuseTime);
+		INC_DWORD_STAT(STAT_UTGibsReused);
+		NumGibsReused++;
+		Gib->Instigator = InInstigator;
+		Gib->SetOwner(InInstigator);
+		Gib->Reactivate(Location, Rotation);
+	}
+	else
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UTGibSpawnTime);
+		INC_DWORD_STAT(STAT_UTGibsSpawned);
+		NumGibsSpawned++;
+		FActorSpawnParameters Params;
+		Params.bNoCollisionFail = true;
+		Params.Instigator = InInstigator;
+		Params.Owner = InInstigator;
+		Gib = GetWorld()->SpawnActor<AUTGib>(GibClass, Location, Rotation, Params);
+	}
+	if (Gib != NULL && bPooling)
+	{
+		ActiveGibs.Add(Gib);
+	}
+	SET_DWORD_STAT(STAT_UTPooledGibs, UnusedGibs.Num());
+	return Gib;
+}
+
+AUTGib* AUTWorldSettings::FindGibToEvict() const
+{
+	const float WorldTime = GetWorld()->TimeSeconds;
+	for (AUTGib* Gib : ActiveGibs)
+	{
+		if (WorldTime - Gib->GetLastRenderTime() > 1.0f)
+		{
+			return Gib;
+		}
+	}
+
+	TArray<FVector, TInlineAllocator<4> > ViewLocations;
+	for (ULocalPlayer* LocalPlayer : GEngine->GetGamePlayers(GetWorld()))
+	{
+		if (LocalPlayer->PlayerController != NULL)
+		{
+			FVector ViewLoc;
+			FRotator ViewRot;
+			LocalPlayer->PlayerController->GetPlayerViewPoint(ViewLoc, ViewRot);
+			ViewLocations.Add(ViewLoc);
+		}
+	}
+	AUTGib* Best = ActiveGibs[0];
+	float BestDistSq = -1.0f;
+	for (AUTGib* Gib : ActiveGibs)
+	{
+		float DistSq = BIG_NUMBER;
+		for (const FVector& ViewLoc : ViewLocations)
+		{
+			DistSq = FMath::Min<float>(DistSq, (Gib->GetActorLocation() - ViewLoc).SizeSquared());
+		}
+		if (DistSq > BestDistSq)
+		{
+			Best = Gib;
+			BestDistSq = DistSq;
+		}
+	}
+	return Best;
+}
+
+void AUTWorldSettings::RecycleGib(AUTGib* Gib)
+{
+	if (Gib != NULL && !Gib->IsPendingKillPending())
+	{
+		ActiveGibs.Remove(Gib);
+		if (CVarEffectPooling.GetValueOnGameThread() != 0 && (MaxGibs <= 0 || UnusedGibs.Num() < MaxGibs))
+		{
+			Gib->PutAway();
+			UnusedGibs.AddUnique(Gib);
+		}
+		else
+		{
+			Gib->Destroy();
+		}
+	}
+}
+
+AUTProjectile* AUTWorldSettings::SpawnProjectile(TSubclassOf<AUTProjectile> ProjClass, const FVector& Location, const FRotator& Rotation, const FActorSpawnParameters& SpawnParams)
+{
+	if (ProjClass == NULL)
+	{
+		return NULL;
+	}
+
+	AUTProjectile* Proj = NULL;
+	if (CVarEffectPooling.GetValueOnGameThread() != 0 && ProjClass.GetDefaultObject()->bAllowPooling)
+	{
+		for (int32 i = UnusedProjectiles.Num() - 1; i >= 0; i--)
+		{
+			if (UnusedProjectiles[i] == NULL || UnusedProjectiles[i]->IsPendingKillPending())
+			{
+				UnusedProjectiles.RemoveAt(i);
+			}
+			else if (UnusedProjectiles[i]->GetClass() == ProjClass)
+			{
+				Proj = UnusedProjectiles[i];
+				UnusedProjectiles.RemoveAt(i);
+				break;
+			}
+		}
+	}
+	if (Proj != NULL)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UTProjectileReuseTime);
+		INC_DWORD_STAT(STAT_UTProjectilesReused);
+		Proj->Instigator = SpawnParams.Instigator;
+		Proj->SetOwner(SpawnParams.Owner);
+		Proj->Reactivate(Location, Rotation);
+	}
+	else
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UTProjectileSpawnTime);
+		INC_DWORD_STAT(STAT_UTProjectilesSpawned);
+		Proj = GetWorld()->SpawnActor<AUTProjectile>(ProjClass, Location, Rotation, SpawnParams);
+	}
+	SET_DWORD_STAT(STAT_UTPooledProjectiles, UnusedProjectiles.Num());
+	return Proj;
+}
+
+void AUTWorldSettings::RecycleProjectile(AUTProjectile* Proj)
+{
+	if (Proj != NULL && !Proj->IsPendingKillPending())
+	{
+		if (CVarEffectPooling.GetValueOnGameThread() != 0 && Proj->CanBePooled() && UnusedProjectiles.Num() < MaxPooledProjectiles)
+		{
+			Proj->PutAway();
+			UnusedProjectiles.AddUnique(Proj);
+		}
+		else
+		{
+			Proj->Destroy();
+		}
+	}
+}
+
 void AUTWorldSettings::AddTimedMaterialParameter(UMaterialInstanceDynamic* InMI, FName InParamName, UCurveBase* InCurve, bool bInClearOnComplete)
 {
 	for (int32 i = 0; i < MaterialParamCurves.Num(); i++)
@@ -269,6 +517,11 @@ void AUTWorldSettings::Tick(float DeltaTime)
 	
 	FadeImpactEffects(DeltaTime);
 
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		AUTCharacter::UpdateAnimationBudget(GetWorld());
+	}
+
 	for (int32 i = 0; i < MaterialParamCurves.Num(); i++)
 	{
 		if (!MaterialParamCurves[i].MI.IsValid() || MaterialParamCurves[i].ParamCurve == NULL)
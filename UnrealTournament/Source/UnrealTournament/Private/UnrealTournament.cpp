@@ -561,6 +561,33 @@ FHttpRequestPtr ReadBackendStats(const FHttpRequestCompleteDelegate& ResultDeleg
 	return StatsReadRequest;
 }
 
+FString GetBackendStatsWriteURL(const FString& StatsID)
+{
+#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+	FString BaseURL = TEXT("https://ut-public-service-gamedev.ol.epicgames.net/ut/api/stats/accountId/");
+#else
+	FString BaseURL = TEXT("https://ut-public-service-prod10.ol.epicgames.com/ut/api/stats/accountId/");
+#endif
+
+	FString McpConfigOverride;
+	FParse::Value(FCommandLine::Get(), TEXT("MCPCONFIG="), McpConfigOverride);
+
+	if (McpConfigOverride == TEXT("prodnet"))
+	{
+		BaseURL = TEXT("https://ut-public-service-prod10.ol.epicgames.com/ut/api/stats/accountId/");
+	}
+	else if (McpConfigOverride == TEXT("localhost"))
+	{
+		BaseURL = TEXT("http://localhost:8080/ut/api/stats/accountId/");
+	}
+	else if (McpConfigOverride == TEXT("gamedev"))
+	{
+		BaseURL = TEXT("https://ut-public-service-gamedev.ol.epicgames.net/ut/api/stats/accountId/");
+	}
+
+	return BaseURL + StatsID + TEXT("/bulk?ownertype=1");
+}
+
 void ParseProfileItemJson(const FString& Data, TArray<FProfileItemEntry>& ItemList)
 {
 	TArray< TSharedPtr<FJsonValue> > StatsJson;
@@ -636,28 +663,7 @@ void GiveProfileItems(TSharedPtr<FUniqueNetId> UniqueId, const TArray<FProfileIt
 		}
 
 		FString StatsID = UniqueId->ToString();
-
-#if !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
-		FString BaseURL = TEXT("https://ut-public-service-gamedev.ol.epicgames.net/ut/api/stats/accountId/") + StatsID + TEXT("/bulk?ownertype=1");
-#else
-		FString BaseURL = TEXT("https://ut-public-service-prod10.ol.epicgames.com/ut/api/stats/accountId/") + StatsID + TEXT("/bulk?ownertype=1");
-#endif
-
-		FString McpConfigOverride;
-		FParse::Value(FCommandLine::Get(), TEXT("MCPCONFIG="), McpConfigOverride);
-
-		if (McpConfigOverride == TEXT("prodnet"))
-		{
-			BaseURL = TEXT("https://ut-public-service-prod10.ol.epicgames.com/ut/api/stats/accountId/") + StatsID + TEXT("/bulk?ownertype=1");
-		}
-		else if (McpConfigOverride == TEXT("localhost"))
-		{
-			BaseURL = TEXT("http://localhost:8080/ut/api/stats/accountId/") + StatsID + TEXT("/bulk?ownertype=1");
-		}
-		else if (McpConfigOverride == TEXT("gamedev"))
-		{
-			BaseURL = TEXT("https://ut-public-service-gamedev.ol.epicgames.net/ut/api/stats/accountId/") + StatsID + TEXT("/bulk?ownertype=1");
-		}
+		FString BaseURL = GetBackendStatsWriteURL(StatsID);
 
 		FHttpRequestPtr StatsWriteRequest = FHttpModule::Get().CreateRequest();
 		if (StatsWriteRequest.IsValid())
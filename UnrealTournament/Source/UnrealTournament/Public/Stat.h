@@ -74,6 +74,9 @@ public:
 	UPROPERTY()
 	FName StatName;
 
+	/** FUTStatRegistry index of StatName */
+	int32 StatIndex;
+
 	/** Highest period that is kept track of. */
 	UPROPERTY()
 	TEnumAsByte<EStatRecordingPeriod::Type> HighestPeriodToTrack;
@@ -49,7 +49,8 @@ class UNREALTOURNAMENT_API UStatManager : public UObject
 
 	AUTPlayerState* GetPlayerState() { return UTPS; }
 
-	virtual void PopulateJsonObjectForBackendStats(TSharedPtr<FJsonObject> JsonObject, AUTPlayerState* PS);
+	/** copies the player's values of the backend stats, to be serialized off the game thread */
+	virtual void GatherBackendStats(AUTPlayerState* PS, TArray<FName>& OutStatNames, TArray<float>& OutStatValues) const;
 	virtual void PopulateJsonObjectForNonBackendStats(TSharedPtr<FJsonObject> JsonObject);
 	virtual void InsertDataFromNonBackendJsonObject(const TSharedPtr<FJsonObject> JsonObject);
 
@@ -0,0 +1,72 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "UTTickAggregator.h"
+
+#include "UTAggregatedTickTest.generated.h"
+
+/**
+ * Checks that projectile actors still tick after their movement once the movement components are aggregated.
+ * Spawns a few projectiles, waits until their movement is ticked by an FUTTickAggregator, then checks that the actor tick
+ * waits for the aggregator and, for NumFrames frames, runs a probe tick function with the actor tick's tick group and
+ * prerequisites that fails if the aggregator hasn't ticked yet that frame. Spawned by the TestAggregatedTickOrder cheat.
+ */
+UCLASS(NotPlaceable, Transient)
+class UNREALTOURNAMENT_API AUTAggregatedTickTest : public AActor
+{
+	GENERATED_UCLASS_BODY()
+
+	/** projectile to spawn */
+	UPROPERTY()
+	TSubclassOf<AUTProjectile> ProjClass;
+
+	UPROPERTY()
+	int32 NumProjectiles;
+
+	/** frames checked by the probe */
+	UPROPERTY()
+	int32 NumFrames;
+
+	/** player to report to, if any */
+	UPROPERTY()
+	APlayerController* ReportTo;
+
+	/** spawns the projectiles; set the properties above first */
+	void StartTest();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+	/** ticks with the same tick group and prerequisites as a projectile's actor tick */
+	struct FProbeTickFunction : public FTickFunction
+	{
+		AUTAggregatedTickTest* Test;
+		FUTTickAggregator* Aggregator;
+
+		FProbeTickFunction()
+			: Test(NULL), Aggregator(NULL)
+		{}
+
+		virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+		virtual FString DiagnosticMessage() override
+		{
+			return TEXT("AggregatedTickTest probe");
+		}
+	};
+	FProbeTickFunction Probe;
+
+	UPROPERTY()
+	TArray<AUTProjectile*> Projectiles;
+
+	/** frames waited for the projectiles to be aggregated */
+	int32 NumWaitFrames;
+	int32 NumProbeTicks;
+	int32 NumProbeFailures;
+	bool bStarted;
+
+	/** checks the projectiles' actor ticks and starts the probe once all movement components are aggregated */
+	void CheckAggregated();
+	void Finish(bool bPassed, const FString& Message);
+	void Report(const FString& Line);
+};
@@ -158,6 +158,13 @@ public:
 	UFUNCTION(Server, Reliable, WithValidation)
 	virtual void ServerRconKick(const FString& NameOrUIDStr, bool bBan, const FString& Reason);
 
+	/** shows the server frame time percentiles of the last telemetry window */
+	UFUNCTION(Exec)
+	virtual void RconTelemetry();
+
+	UFUNCTION(Server, Reliable, WithValidation)
+	virtual void ServerRconTelemetry();
+
 	// Let the game's player controller know there was a network failure message.
 	virtual void HandleNetworkFailureMessage(enum ENetworkFailure::Type FailureType, const FString& ErrorString);
 
@@ -3,6 +3,7 @@
 
 #include "AIController.h"
 #include "UTRecastNavMesh.h"
+#include "UTBotDecisionScheduler.h"
 
 #include "UTBot.generated.h"
 
@@ -662,9 +663,16 @@ public:
 	UFUNCTION()
 	virtual void ApplyCrouch();
 
-	// causes the bot decision logic to be run within one frame
+	// causes the bot decision logic to be run within one frame, or a few when many bots want to decide (see FUTBotDecisionScheduler)
 	UFUNCTION()
 	virtual void WhatToDoNext();
+	/** return whether WhatToDoNext() was called and the decision logic hasn't run yet */
+	inline bool WantsToDecide() const
+	{
+		return bPendingWhatToDoNext && GetPawn() != NULL;
+	}
+	/** how urgently the bot should get to run its decision logic when many bots want to decide in the same frame */
+	virtual EBotDecisionPriority::Type GetDecisionPriority() const;
 
 	virtual bool CanSee(APawn* Other, bool bMaySkipChecks);
 	virtual bool LineOfSightTo(const class AActor* Other, FVector ViewPoint = FVector(ForceInit), bool bAlternateChecks = false) const override;
@@ -0,0 +1,82 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+class AUTBot;
+
+namespace EBotDecisionPriority
+{
+	enum Type
+	{
+		/** no enemy and nothing urgent going on */
+		Idle,
+		Normal,
+		CarryingFlag,
+		UnderAttack,
+	};
+}
+
+/**
+ * Spreads bot decisions (AUTBot::ExecuteWhatToDoNext(), which does squad orders, inventory searches and path finding) over frames
+ * so many bots asking at once don't cause a spike, used by AUTGameMode.
+ * A bot that wants to decide asks every tick until it is allowed to; the bots that were already waiting are ordered by priority
+ * and then by how long they waited at the start of each frame, and get to decide in that order until the frame's budget is used up.
+ * When nobody is left waiting, new requests go right away while there is budget left, so with few bots nothing is delayed.
+ * Only the decision is delayed, bots keep steering towards their current move target every frame in the meantime.
+ */
+class UNREALTOURNAMENT_API FUTBotDecisionScheduler
+{
+public:
+	FUTBotDecisionScheduler();
+
+	/** @return whether Bot may run its decision logic now; if not it is queued and should ask again next tick */
+	bool CanDecide(AUTBot* Bot);
+
+	/** call after Bot ran its decision logic, with the time it took */
+	void DecisionMade(AUTBot* Bot, uint32 Cycles);
+
+	/** totals since the last ResetTotals() */
+	struct FTotals
+	{
+		int32 NumDecisions;
+		/** decisions that went over budget because the bot had waited the longest allowed */
+		int32 NumForced;
+		/** in game seconds */
+		float TotalWait;
+		float MaxWait;
+		double TotalDecisionMs;
+		float StartTime;
+	};
+	const FTotals& GetTotals() const
+	{
+		return Totals;
+	}
+	void ResetTotals(UWorld* World);
+
+private:
+	struct FRequest
+	{
+		TWeakObjectPtr<AUTBot> Bot;
+		float RequestTime;
+		EBotDecisionPriority::Type Priority;
+		bool bGranted;
+		/** granted over budget because it waited too long */
+		bool bForced;
+	};
+	/** bots waiting to decide; ordered by priority at the start of each frame */
+	TArray<FRequest> Queue;
+
+	uint64 Frame;
+	/** decisions made this frame and the time they took */
+	int32 FrameDecisions;
+	uint32 FrameCycles;
+	float FrameMaxWait;
+	/** whether everyone who waited since before this frame has been allowed to go */
+	bool bQueueGranted;
+	/** running average of the time a decision takes, used to guess how many fit in the budget */
+	float AvgDecisionMs;
+
+	FTotals Totals;
+
+	void StartFrame(UWorld* World);
+	FRequest* FindRequest(AUTBot* Bot);
+};
@@ -0,0 +1,87 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "ServerFrameTelemetry.h"
+
+#include "UTBotMatchBenchmark.generated.h"
+
+/**
+ * Bot match benchmark, mainly for dedicated servers but it also runs in a standalone game. Started by the game mode when the command line has -UTBenchmarkSeconds=N:
+ * the match starts right away with the bots from the URL (BotFill/Bots) at the URL's Difficulty, never ends on its own,
+ * and after a warm up the server frame telemetry is gathered for N simulated seconds. The breakdown (bot AI, character movement,
+ * projectiles, replication, GC, tick groups) is then written as JSON and the server exits, so it can run unattended, e.g.
+ *
+ *   UE4Server UnrealTournament DM-Deck16?Game=DM?BotFill=12?Difficulty=4 -BENCHMARK -FPS=30 -UTBenchmarkSeconds=120
+ *
+ * -BENCHMARK gives the fixed time step (-FPS sets it) and runs frames back to back; it is turned on if missing.
+ * Optional: -UTBenchmarkWarmup=<seconds> (default 10), -UTBenchmarkSeed=<n> (default 0), -UTBenchmarkReport=<file>
+ * (default Saved/Benchmarks/BotMatch-<map>-<date>.json).
+ *
+ * -UTBenchmarkCompareAnim measures for another N seconds with ut.AnimUpdateRateOptimizations off and adds the game thread animation
+ * time of both runs to the report. The animation budget only applies where characters are rendered, so run that in a standalone game, e.g.
+ *
+ *   UE4Game UnrealTournament DM-Deck16?Game=DM?BotFill=32?Difficulty=4 -BENCHMARK -FPS=30 -UTBenchmarkSeconds=60 -UTBenchmarkCompareAnim
+ */
+UCLASS(NotPlaceable, Transient)
+class UNREALTOURNAMENT_API AUTBotMatchBenchmark : public AActor
+{
+	GENERATED_UCLASS_BODY()
+
+	/** simulated seconds measured once the warm up is over */
+	UPROPERTY()
+	float MeasureSeconds;
+
+	/** simulated seconds after the match starts that aren't measured, so spawning and first time loading don't count */
+	UPROPERTY()
+	float WarmupSeconds;
+
+	/** random seed set when the benchmark starts */
+	UPROPERTY()
+	int32 Seed;
+
+	/** where the JSON report goes */
+	UPROPERTY()
+	FString ReportFilename;
+
+	/** whether to measure again with ut.AnimUpdateRateOptimizations off */
+	UPROPERTY()
+	bool bCompareAnimUpdateRate;
+
+	/** @return whether the command line asks for a benchmark, and the seconds to measure */
+	static bool WantsBenchmark(float& OutMeasureSeconds);
+
+	/** reads the other command line options, forces the fixed time step and telemetry on and seeds the random numbers;
+	 * called by the game mode from InitGame() so everything spawned afterwards sees the same random sequence */
+	void StartBenchmark();
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	enum EPhase
+	{
+		PHASE_WaitingForMatch,
+		PHASE_WarmUp,
+		PHASE_Measure,
+		/** measures again with ut.AnimUpdateRateOptimizations off */
+		PHASE_MeasureAnimOff,
+		PHASE_Done,
+	};
+	EPhase Phase;
+	/** in simulated seconds */
+	float PhaseEndTime;
+	double MeasureStartRealTime;
+
+	/** the report of the main measurement, written when the benchmark is done */
+	TSharedPtr<FJsonObject> ReportJson;
+	/** from the main measurement, to compare with PHASE_MeasureAnimOff */
+	FServerFrameTelemetry::FHistogram AnimOnHistogram;
+	FServerFrameTelemetry::FHistogram AnimOnFrameHistogram;
+	int32 SavedAnimUpdateRateOptimizations;
+
+	/** closes the measured telemetry window and builds the report, then either starts PHASE_MeasureAnimOff or writes the report and exits */
+	void FinishMeasure(bool bComplete);
+	/** closes the PHASE_MeasureAnimOff telemetry window, adds the animation times to the report, writes it and exits */
+	void FinishAnimComparison();
+	void BuildReport(bool bComplete, double RealSeconds);
+	void WriteReport();
+};
@@ -820,6 +820,20 @@ public:
 
 	/** returns location of head (origin of headshot zone); will force a skeleton update if mesh hasn't been rendered (or dedicated server) so the provided position is accurate */
 	virtual FVector GetHeadLocation(float PredictionTime=0.f);
+protected:
+	/** frame the skeleton was last updated by GetHeadLocation(), so several traces in a frame only pay for it once
+	 * crouching and movement mode changes move the head, so they clear it
+	 */
+	uint64 LastOnDemandPoseFrame;
+	/** mesh transform and aim rotation the on demand pose was evaluated with; a ServerMove() or aim change later in the same frame moves the head, so the pose is redone when these differ */
+	FTransform LastOnDemandPoseTransform;
+	FRotator LastOnDemandPoseAim;
+public:
+
+	/** called once a frame on clients: turns on animation update rate optimizations for characters that don't need their pose every frame
+	 * and lets the ut.AnimFullRateBudget characters biggest on screen be evaluated every frame, the others are evaluated less often and interpolated
+	 */
+	static void UpdateAnimationBudget(UWorld* World);
 	/** checks for a head shot - called by weapons with head shot bonuses
 	* returns true if it's a head shot, false if a miss or if some armor effect prevents head shots
 	* if bConsumeArmor is true, the first item that prevents an otherwise valid head shot will be consumed
@@ -1514,6 +1528,8 @@ public:
 
 	virtual void OnStartCrouch(float HeightAdjust, float ScaledHeightAdjust) override;
 
+	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
+
 	virtual void Crouch(bool bClientSimulation = false) override;
 
 	virtual void UnCrouch(bool bClientSimulation = false) override;
@@ -42,5 +42,25 @@ class UNREALTOURNAMENT_API UUTCheatManager : public UCheatManager
 	UFUNCTION(exec)
 	virtual void Ann(int32 Switch);
 
+	/** keeps NumProjectiles (default 500) projectiles in flight around the player and reports the tick group times with and without parallel tick batches,
+	 * then in standalone games the spawn and garbage collection times with ut.EffectPooling off and on
+	 */
+	UFUNCTION(exec)
+	virtual void ProjectileTickBenchmark(int32 NumProjectiles, float PhaseSeconds);
+
+	/** spawns EffectsPerFrame (default 4) gibs and blood decals per frame around the player and reports the pool hit rates and the spawn and
+	 * garbage collection times with ut.EffectPooling off and on (standalone or listen server)
+	 */
+	UFUNCTION(exec)
+	virtual void EffectPoolBenchmark(int32 EffectsPerFrame, float PhaseSeconds);
+
+	/** checks that a bot item search from the player's position still finds a pickup when the nearest one of its type is turned down (server only) */
+	UFUNCTION(exec)
+	virtual void TestInventoryField();
+
+	/** checks that projectile actors still tick after their movement once their movement components are aggregated (standalone or listen server) */
+	UFUNCTION(exec)
+	virtual void TestAggregatedTickOrder();
+
 	virtual void BugItWorker(FVector TheLocation, FRotator TheRotation) override;
 };
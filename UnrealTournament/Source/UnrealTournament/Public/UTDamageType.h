@@ -196,6 +196,30 @@ class UNREALTOURNAMENT_API UUTDamageType : public UDamageType
 	/** icon for drawing kill messages */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = HUD)
 	FCanvasIcon HUDIcon;
+
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+
+	/** @return FUTStatRegistry index of the StatsName + "Kills" stat, INDEX_NONE if there is no StatsName */
+	int32 GetKillStatsIndex() const
+	{
+		UpdateStatsIndices();
+		return KillStatsIndex;
+	}
+	/** @return FUTStatRegistry index of the StatsName + "Deaths" stat, INDEX_NONE if there is no StatsName */
+	int32 GetDeathStatsIndex() const
+	{
+		UpdateStatsIndices();
+		return DeathStatsIndex;
+	}
+
+protected:
+	/** registered once per StatsName so the kill and death stats don't have to be looked up by a constructed name every frag */
+	mutable int32 KillStatsIndex;
+	mutable int32 DeathStatsIndex;
+	mutable FString StatsIndicesName;
+
+	void UpdateStatsIndices() const;
 };
 
 /** return the base momentum for the given damage event (before radial damage and any other modifiers) */
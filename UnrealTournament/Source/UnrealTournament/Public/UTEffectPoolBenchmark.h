@@ -0,0 +1,87 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "UTCharacter.h"
+
+#include "UTEffectPoolBenchmark.generated.h"
+
+/**
+ * Spawns gibs and blood decals around its location every frame through AUTWorldSettings, first with ut.EffectPooling off
+ * and then with it on, and reports how often the pools were hit, the time spent spawning and the time spent in garbage
+ * collection (a collection is forced at the end of each phase). Spawned by the EffectPoolBenchmark cheat.
+ */
+UCLASS(NotPlaceable, Transient)
+class UNREALTOURNAMENT_API AUTEffectPoolBenchmark : public AActor
+{
+	GENERATED_UCLASS_BODY()
+
+	/** gib to spawn */
+	UPROPERTY()
+	TSubclassOf<class AUTGib> GibClass;
+
+	/** decal to spawn, its material may be NULL */
+	UPROPERTY()
+	FBloodDecalInfo DecalInfo;
+
+	/** gibs and decals spawned each frame */
+	UPROPERTY()
+	int32 EffectsPerFrame;
+
+	/** seconds measured with each setting; a warm up phase of the same length runs first */
+	UPROPERTY()
+	float PhaseSeconds;
+
+	/** effects are spawned at random up to this far from the benchmark location */
+	UPROPERTY()
+	float SpawnRadius;
+
+	/** player to report to, if any */
+	UPROPERTY()
+	APlayerController* ReportTo;
+
+	/** saves and overrides the settings used by the benchmark and starts the warm up phase; set the properties above first */
+	void StartBenchmark();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+	enum EPhase
+	{
+		/** fills the pools */
+		PHASE_WarmUp,
+		PHASE_PoolingOff,
+		PHASE_PoolingOn,
+		PHASE_Done,
+	};
+	EPhase Phase;
+	float PhaseEndTime;
+	/** set when the phase is over and the forced garbage collection is yet to happen */
+	bool bWaitingForGC;
+
+	/** time spent spawning this phase */
+	double GibSeconds;
+	double DecalSeconds;
+	/** AUTWorldSettings pool counters when the phase started */
+	uint32 StartGibsSpawned;
+	uint32 StartGibsReused;
+	uint32 StartDecalsCreated;
+	uint32 StartDecalsReused;
+	/** spawn plus garbage collection time per frame with pooling off, to compare the pooling on phase against */
+	float PoolingOffCostMs;
+
+	/** cvar values to put back when done */
+	bool bSavedSettings;
+	int32 SavedTelemetryEnable;
+	float SavedTelemetryWindowSeconds;
+	int32 SavedEffectPooling;
+
+	void SpawnEffects();
+	void StartPhase(EPhase NewPhase);
+	/** ends the current phase, reporting what it measured, and starts the next one */
+	void EndPhase();
+	/** reports the pool hit rates and the spawn and garbage collection times from the telemetry window that was just closed */
+	void ReportPhase(const TCHAR* Title);
+	void Report(const FString& Line);
+	void RestoreSettings();
+};
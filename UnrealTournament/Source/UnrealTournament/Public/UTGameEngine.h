@@ -99,6 +99,16 @@ public:
 
 	virtual EBrowseReturnVal::Type Browse(FWorldContext& WorldContext, FURL URL, FString& Error) override;
 
+	/**
+	 * Starts another match in this process next to the main world, listening on Port.  The match gets its own game instance, world, net driver
+	 * and online session and is ticked along with the other worlds; the map is loaded at the start of the next frame.
+	 */
+	virtual void StartHostedMatch(const FString& MatchURL, int32 Port);
+	/** shuts down a match started with StartHostedMatch at the start of the next frame */
+	virtual void StopHostedMatch(UWorld* MatchWorld);
+	/** @return whether World was started with StartHostedMatch rather than being the process's main world */
+	bool IsHostedMatchWorld(UWorld* World);
+
 	FString MD5Sum(const TArray<uint8>& Data);
 	bool IsCloudAndLocalContentInSync();
 
@@ -160,6 +170,31 @@ public:
 	
 	}
 
+protected:
+	struct FPendingHostedMatch
+	{
+		FString URL;
+		int32 Port;
+
+		FPendingHostedMatch(const FString& InURL, int32 InPort)
+			: URL(InURL), Port(InPort)
+		{}
+	};
+	/** matches to start and stop at the start of the next frame, loading or destroying a world in the middle of ticking isn't safe */
+	TArray<FPendingHostedMatch> PendingHostedMatches;
+	TArray<FName> HostedMatchesToStop;
+
+	/** game instances of the running hosted matches */
+	UPROPERTY()
+	TArray<UGameInstance*> HostedMatchInstances;
+
+	/** used to give each hosted world its own map package names */
+	int32 NextHostedWorldIndex;
+
+	void UpdateHostedMatches();
+	void CreateHostedMatch(const FPendingHostedMatch& Match);
+	void DestroyHostedMatch(FWorldContext& Context);
+
 private:
 	FGuid UniqueAnalyticSessionGuid;
 
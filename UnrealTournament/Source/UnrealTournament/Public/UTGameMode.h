@@ -4,6 +4,8 @@
 #include "TAttributeProperty.h"
 #include "UTServerBeaconLobbyClient.h"
 #include "UTReplicatedLoadoutInfo.h"
+#include "UTSpawnRatingCache.h"
+#include "UTBotDecisionScheduler.h"
 #include "UTGameMode.generated.h"
 
 /** Defines the current state of the game. */
@@ -165,6 +167,21 @@ public:
 	UPROPERTY(config)
 	int32 BotFillCount;
 
+	/** simulated remote players to keep connected for replication load testing, they count as players for BotFillCount; see UUTSimulatedNetConnection */
+	UPROPERTY()
+	int32 SimulatedClientCount;
+
+	/** round trip time of the simulated players in milliseconds */
+	UPROPERTY()
+	int32 SimulatedClientLatency;
+
+	/** percentage of the simulated players' packets lost each way */
+	UPROPERTY()
+	int32 SimulatedClientLoss;
+
+	/** names and seeds the next simulated player */
+	int32 NextSimulatedClientIndex;
+
 	// How long a player must wait before respawning.  Set to 0 for no delay.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = Rules)
 	float RespawnWaitTime;
@@ -373,6 +390,14 @@ public:
 	virtual AActor* ChoosePlayerStart_Implementation(AController* Player) override;
 	virtual float RatePlayerStart(APlayerStart* P, AController* Player);
 
+protected:
+	/** pawn grid and remembered visibility used by RatePlayerStart() */
+	FUTSpawnRatingCache SpawnRatingCache;
+
+public:
+	/** decides which bots get to run their decision logic each frame */
+	FUTBotDecisionScheduler BotDecisionScheduler;
+
 	virtual bool ReadyToStartMatch_Implementation() override;
 
 	virtual bool HasMatchStarted() const override;
@@ -422,6 +447,8 @@ protected:
 	virtual class AUTBot* AddAssetBot(const FStringAssetReference& BotAssetPath, uint8 TeamNum = 255);
 	/** check for adding/removing bots to satisfy BotFillCount */
 	virtual void CheckBotCount();
+	/** check for adding/removing simulated players to satisfy SimulatedClientCount */
+	virtual void CheckSimulatedClients();
 	/** returns whether we should allow removing the given bot to satisfy the desired player/bot count settings
 	 * generally used to defer destruction of bots that currently are important to the current game state, like flag carriers
 	 */
@@ -444,6 +471,9 @@ public:
 	/** Remove all bots */
 	UFUNCTION(Exec, BlueprintCallable, Category = AI)
 	virtual void KillBots();
+	/** sets the number of simulated remote players */
+	UFUNCTION(Exec, BlueprintCallable, Category = AI)
+	virtual void SetSimulatedClients(int32 NewCount);
 
 	/** NOTE: return value is a workaround for blueprint bugs involving ref parameters and is not used */
 	UFUNCTION(BlueprintNativeEvent)
@@ -578,6 +608,17 @@ public:
 
 	bool bDedicatedInstance;
 
+	// True if this is an idle instance in a hub's pool, waiting on the idle map to be given a match
+	bool bPooledInstance;
+
+	/** bots get exactly GameDifficulty as their skill instead of their character's skill, set by the FixedBotSkill option */
+	UPROPERTY()
+	bool bFixedBotSkill;
+
+	/** set when running the headless bot match benchmark, see AUTBotMatchBenchmark */
+	UPROPERTY()
+	class AUTBotMatchBenchmark* BotMatchBenchmark;
+
 protected:
 
 	// The Address of the Hub this game wants to connect to.
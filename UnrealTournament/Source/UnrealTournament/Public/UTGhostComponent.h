@@ -47,7 +47,10 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FGhostPlayFinishedDelegate OnGhostPlayFinished;
 
+	/** playback positions in GhostData's tracks, which are merged by time */
 	int32 GhostEventIndex;
+	int32 GhostMoveIndex;
+	int32 GhostTrackEventIndex;
 
 	/** The asset to save the ghost data to. If this is null, the recording will be temporary for the lifetime of the character*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Ghost)
@@ -60,9 +63,17 @@ public:
 	virtual void GhostMovementEvent(const FMovementEventInfo& MovementEvent);
 	virtual void GhostJumpBoots(TSubclassOf<class AUTReplicatedEmitter> SuperJumpEffect, USoundBase* SuperJumpSound);
 
+	/** adds a custom event to the recording, the built in ones are recorded into GhostData's tracks */
 	UFUNCTION(BlueprintCallable, Category = Ghost)
 	class UUTGhostEvent* CreateAndAddEvent(TSubclassOf<class UUTGhostEvent> EventClass);
 
+	/** play back recorded state on UTOwner, used for the tracks and by the UUTGhostEvent classes */
+	virtual void ApplyMove(const FRepUTMovement& RepMovement, uint8 CompressedFlags, bool bIsCrouched, bool bApplyWallSlide);
+	virtual void ApplyFireFlags(uint8 FireFlags);
+	virtual void ApplyWeapon(TSubclassOf<AUTWeapon> WeaponClass);
+	virtual void ApplyMovementEvent(const FMovementEventInfo& MovementEvent);
+	virtual void ApplyJumpBoots(TSubclassOf<class AUTReplicatedEmitter> SuperJumpEffect, USoundBase* SuperJumpSound);
+
 	/** 1 bit for each firemode. 0 up 1 pressed*/
 	uint8 GhostFireFlags;
 
@@ -77,6 +88,10 @@ protected:
 
 	float GhostStartTime;
 
+	/** @return a new entry at the end of GhostData's event track, NULL if not recording */
+	struct FUTGhostTrackEvent* AddTrackEvent(uint8 Type);
+	void ApplyTrackMove(const struct FUTGhostMove& Move);
+	void ApplyTrackEvent(const struct FUTGhostTrackEvent& Event);
 
 	/**Save the old role since a Ghost always runs on ROLE_SimulatedProxy*/
 	TEnumAsByte<enum ENetRole> OldRole;
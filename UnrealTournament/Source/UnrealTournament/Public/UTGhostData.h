@@ -5,9 +5,58 @@
 #include "Object.h"
 #include "UTGhostData.generated.h"
 
+/** A recorded move, quantized the way FRepUTMovement is for replication */
+struct FUTGhostMove
+{
+	float Time;
+	/** location and velocity rounded like FVector_NetQuantize */
+	FIntVector Location;
+	FIntVector Velocity;
+	/** FRotator::CompressAxisToShort() of the control rotation, roll is never recorded */
+	uint16 Yaw;
+	uint16 Pitch;
+	/** FRepUTMovement::AccelDir in the lower 4 bits, then crouched and wall slide */
+	uint8 MoveFlags;
+	/** FSavedMove_UTCharacter compressed flags */
+	uint8 CompressedFlags;
+
+	enum
+	{
+		MOVEFLAG_AccelDir = 0x0F,
+		MOVEFLAG_Crouched = 0x10,
+		MOVEFLAG_WallSlide = 0x20,
+	};
+};
+
+namespace EGhostTrackEvent
+{
+	enum Type
+	{
+		/** Data is the fire flags */
+		Input,
+		/** Object is the weapon class */
+		Weapon,
+		/** Data is the EMovementEvent, Location where it happened */
+		MovementEvent,
+		/** Object is the effect class, Object2 the sound */
+		JumpBoots,
+	};
+}
+
+/** Any other recorded event, objects are indices into UUTGhostData::ReferencedObjects */
+struct FUTGhostTrackEvent
+{
+	float Time;
+	uint8 Type;
+	uint8 Data;
+	FIntVector Location;
+	int32 Object;
+	int32 Object2;
+};
 
 /**
- * 
+ * A ghost recording. Moves and the built in events are kept in flat arrays that the garbage collector doesn't look at,
+ * and are delta encoded into PackedTracks when saved. UUTGhostEvent objects in Events are only used for custom events and old recordings.
  */
 UCLASS(CustomConstructor, BlueprintType)
 class UNREALTOURNAMENT_API UUTGhostData : public UObject
@@ -23,4 +72,41 @@ class UNREALTOURNAMENT_API UUTGhostData : public UObject
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Ghost)
 	TArray<class UUTGhostEvent*> Events;
+
+	TArray<FUTGhostMove> Moves;
+	TArray<FUTGhostTrackEvent> TrackEvents;
+
+	/** classes and sounds the track events refer to */
+	UPROPERTY()
+	TArray<UObject*> ReferencedObjects;
+
+	/** Moves and TrackEvents as saved */
+	UPROPERTY()
+	TArray<uint8> PackedTracks;
+
+	virtual void PreSave() override;
+	virtual void PostLoad() override;
+
+	void ClearRecording();
+	bool HasRecording() const
+	{
+		return Moves.Num() > 0 || TrackEvents.Num() > 0 || Events.Num() > 0;
+	}
+
+	/** @return index of Obj in ReferencedObjects, INDEX_NONE for NULL */
+	int32 AddReferencedObject(UObject* Obj);
+	UObject* GetReferencedObject(int32 Index) const
+	{
+		return ReferencedObjects.IsValidIndex(Index) ? ReferencedObjects[Index] : NULL;
+	}
+
+	/** saves StartTransform and the tracks to a compressed file, custom events in Events aren't saved */
+	UFUNCTION(BlueprintCallable, Category = Ghost)
+	bool SaveToFile(const FString& Filename);
+	UFUNCTION(BlueprintCallable, Category = Ghost)
+	bool LoadFromFile(const FString& Filename);
+
+protected:
+	void PackTracks(TArray<uint8>& OutData) const;
+	bool UnpackTracks(const TArray<uint8>& InData);
 };
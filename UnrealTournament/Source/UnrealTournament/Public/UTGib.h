@@ -41,6 +41,22 @@ class UNREALTOURNAMENT_API AUTGib : public AActor
 	/** Destroy gib if not still visible - called after InvisibleLifeSpan seconds. */
 	virtual void CheckGibVisibility();
 
+	virtual void LifeSpanExpired() override;
+
+	/** hides the gib and stops physics, timers, etc so it can wait in the world settings' pool */
+	virtual void PutAway();
+
+	/** brings a gib that was put away back as if it was just spawned at the given location */
+	virtual void Reactivate(const FVector& NewLocation, const FRotator& NewRotation);
+
+protected:
+	/** picks a random mesh from MeshChoices */
+	virtual void ChooseMesh();
+
+	/** returns the gib to the world settings' pool, or destroys it if there's no room */
+	virtual void Recycle();
+public:
+
 	UFUNCTION()
 	virtual void OnPhysicsCollision(AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 };
@@ -299,6 +299,19 @@ protected:
 	/** Last time CalcStanding() was run. */
 	float CalcStandingTime;
 
+	/** the players and scores the leaderboard was last built from, CalcStanding() only builds it again when they change */
+	struct FStandingInput
+	{
+		const AUTPlayerState* PS;
+		float Score;
+	};
+	TArray<FStandingInput> StandingInputs;
+	const AUTPlayerState* StandingPS;
+	float StandingScore;
+
+	/** measured text for DrawString() */
+	FUTHUDTextLayoutCache TextLayouts;
+
 public:
 
 	// Calculates the currently viewed player's standing.  NOTE: Happens once per frame
@@ -311,7 +324,8 @@ public:
 	FText GetPlaceSuffix(int32 Value);
 
 	void DrawString(FText Text, float X, float Y, ETextHorzPos::Type HorzAlignment, ETextVertPos::Type VertAlignment, UFont* Font, FLinearColor Color, float Scale=1.0, bool bOutline=false);
-	void DrawNumber(int32 Number, float X, float Y, FLinearColor Color, float GlowOpacity, float Scale, int32 MinDigits=0, bool bRightAlign=false);
+	/** RetainedNumber keeps the formatted number between frames; each place a number is drawn needs its own, without one it is formatted on every call */
+	void DrawNumber(int32 Number, float X, float Y, FLinearColor Color, float GlowOpacity, float Scale, int32 MinDigits=0, bool bRightAlign=false, FUTRetainedText* RetainedNumber=NULL);
 
 	virtual float GetCrosshairScale();
 	virtual FLinearColor GetCrosshairColor(FLinearColor InColor) const;
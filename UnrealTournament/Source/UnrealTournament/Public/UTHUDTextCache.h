@@ -0,0 +1,110 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+class FCanvasWordWrapper;
+
+/**
+ * Text that a HUD widget builds from a few game values (score, clock seconds, ammo...).
+ * The widget passes the values the text depends on each frame and only formats it again when they changed:
+ *
+ *	if (AmmoText.NeedsUpdate(Ammo))
+ *	{
+ *		AmmoText.Text = FText::AsNumber(Ammo);
+ *	}
+ *	return AmmoText.Text;
+ */
+struct UNREALTOURNAMENT_API FUTRetainedText
+{
+	FText Text;
+
+	FUTRetainedText()
+		: Inputs(0), bValid(false)
+	{}
+
+	/** @return whether Text has to be built again because it was built from different inputs */
+	bool NeedsUpdate(int64 NewInputs);
+
+	inline void Invalidate()
+	{
+		bValid = false;
+	}
+
+private:
+	int64 Inputs;
+	bool bValid;
+};
+
+/**
+ * Measured and word wrapped text for the HUD, so text that doesn't change isn't measured and wrapped by the canvas again every frame.
+ * Layouts not used for a frame are thrown out once the cache gets big, so each widget/HUD should have its own.
+ */
+class UNREALTOURNAMENT_API FUTHUDTextLayoutCache
+{
+public:
+	/** @return the size UCanvas::StrLen() would give */
+	FVector2D StrLen(UCanvas* Canvas, const FString& Text, UFont* Font);
+	/** @return the size UCanvas::TextSize() would give */
+	FVector2D TextSize(UCanvas* Canvas, const FString& Text, UFont* Font, float Scale);
+	/** @return Text word wrapped to WrapWidth the way FUTCanvasTextItem does it */
+	const FText& WrapText(FCanvasWordWrapper& WordWrapper, const FText& Text, UFont* Font, float Scale, float WrapWidth, float WrapHeight);
+
+	void Empty();
+
+private:
+	/** lookups refer to the caller's string, only keys stored in the maps own a copy of it */
+	struct FLayoutKey
+	{
+		const UFont* Font;
+		float Scale;
+		int32 WrapWidth;
+		uint32 Hash;
+
+		FLayoutKey(const FString& InText, const UFont* InFont, float InScale, int32 InWrapWidth)
+			: Font(InFont), Scale(InScale), WrapWidth(InWrapWidth), TextView(&InText)
+		{
+			Hash = HashCombine(HashCombine(GetTypeHash(InText), PointerHash(InFont)), HashCombine(GetTypeHash(InScale), GetTypeHash(InWrapWidth)));
+		}
+		/** @return a key with its own copy of the text, to store in the map */
+		FLayoutKey MakeOwned() const
+		{
+			FLayoutKey Owned(*this);
+			Owned.OwnedText = GetText();
+			Owned.TextView = NULL;
+			return Owned;
+		}
+		inline const FString& GetText() const
+		{
+			return (TextView != NULL) ? *TextView : OwnedText;
+		}
+		bool operator==(const FLayoutKey& Other) const
+		{
+			return Hash == Other.Hash && Font == Other.Font && Scale == Other.Scale && WrapWidth == Other.WrapWidth && GetText() == Other.GetText();
+		}
+		friend uint32 GetTypeHash(const FLayoutKey& Key)
+		{
+			return Key.Hash;
+		}
+
+	private:
+		const FString* TextView;
+		FString OwnedText;
+	};
+	struct FSizeLayout
+	{
+		FVector2D Size;
+		uint64 LastUsedFrame;
+	};
+	struct FWrapLayout
+	{
+		FText WrappedText;
+		uint64 LastUsedFrame;
+	};
+	TMap<FLayoutKey, FSizeLayout> StrLenLayouts;
+	TMap<FLayoutKey, FSizeLayout> TextSizeLayouts;
+	TMap<FLayoutKey, FWrapLayout> WrapLayouts;
+
+	template<typename LayoutType>
+	static LayoutType* FindLayout(TMap<FLayoutKey, LayoutType>& Layouts, const FLayoutKey& Key);
+	template<typename LayoutType>
+	static LayoutType& AddLayout(TMap<FLayoutKey, LayoutType>& Layouts, const FLayoutKey& Key);
+};
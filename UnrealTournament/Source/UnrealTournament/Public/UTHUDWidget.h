@@ -13,6 +13,7 @@
 
 #include "UTATypes.h"
 #include "CanvasTypes.h"
+#include "UTHUDTextCache.h"
 #include "UTHUDWidget.generated.h"
 
 const float WIDGET_DEFAULT_Y_RESOLUTION = 1080;	// We design everything against 1080p
@@ -193,6 +194,9 @@ protected:
 
 	TSharedPtr<FCanvasWordWrapper> WordWrapper;
 
+	// Measured and wrapped text drawn by DrawText(), so unchanged text isn't laid out again every frame
+	FUTHUDTextLayoutCache TextLayouts;
+
 public:
 	/**
 	 * Draws text on the screen.  You can use the TextHorzPosition and TextVertPosition to justify the text that you are drawing.
@@ -21,4 +21,6 @@ public:
 protected:
 	int32 LastScore;
 	float ScoreFlashOpacity;
+	FUTRetainedText RetainedScoreText;
+	FUTRetainedText DeathsText;
 };
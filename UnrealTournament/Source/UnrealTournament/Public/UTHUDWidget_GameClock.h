@@ -71,6 +71,11 @@ protected:
 	FText GetNumPlayersText();
 
 private:
+	// only formatted again when the number they show changes
+	FUTRetainedText RetainedScoreText;
+	FUTRetainedText RetainedClockText;
+	FUTRetainedText RetainedRankText;
+	FUTRetainedText RetainedNumPlayersText;
 
 
 };
\ No newline at end of file
@@ -96,4 +96,7 @@ private:
 	int32 LastArmor;
 	float ArmorFlashTimer;
 
+	FUTRetainedText RetainedHealthText;
+	FUTRetainedText RetainedArmorText;
+
 };
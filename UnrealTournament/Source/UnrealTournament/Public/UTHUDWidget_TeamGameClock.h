@@ -69,6 +69,10 @@ protected:
 	FText GetClockText();
 
 private:
+	// only formatted again when the number they show changes
+	FUTRetainedText RetainedRedScoreText;
+	FUTRetainedText RetainedBlueScoreText;
+	FUTRetainedText RetainedClockText;
 
 
 };
\ No newline at end of file
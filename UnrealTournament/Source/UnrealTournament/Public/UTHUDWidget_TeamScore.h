@@ -36,10 +36,14 @@ class UNREALTOURNAMENT_API UUTHUDWidget_TeamScore : public UUTHUDWidget
 		if (GS != NULL && GS->Teams.Num() == 2 && GS->Teams[0] != NULL && GS->Teams[1] != NULL)
 		{
 			// Draw the Red Score...
-			UTHUDOwner->DrawNumber(GS->Teams[0]->Score, RenderPosition.X - (157 * RenderScale * RedScale), 10 * RenderScale * RedScale, GS->Teams[0]->TeamColor, 1.0, RenderScale * RedScale * 0.75);
+			UTHUDOwner->DrawNumber(GS->Teams[0]->Score, RenderPosition.X - (157 * RenderScale * RedScale), 10 * RenderScale * RedScale, GS->Teams[0]->TeamColor, 1.0, RenderScale * RedScale * 0.75, 0, false, &RetainedRedScoreText);
 	
 			// Draw the Blue Score...
-			UTHUDOwner->DrawNumber(GS->Teams[1]->Score, RenderPosition.X + (75 * RenderScale * BlueScale), 10 * RenderScale * BlueScale, GS->Teams[1]->TeamColor, 1.0, RenderScale * BlueScale * 0.75);
+			UTHUDOwner->DrawNumber(GS->Teams[1]->Score, RenderPosition.X + (75 * RenderScale * BlueScale), 10 * RenderScale * BlueScale, GS->Teams[1]->TeamColor, 1.0, RenderScale * BlueScale * 0.75, 0, false, &RetainedBlueScoreText);
 		}
 	}
+
+protected:
+	FUTRetainedText RetainedRedScoreText;
+	FUTRetainedText RetainedBlueScoreText;
 };
\ No newline at end of file
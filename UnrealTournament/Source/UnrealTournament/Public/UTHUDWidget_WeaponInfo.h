@@ -39,6 +39,7 @@ protected:
 private:
 	float FlashTimer;
 	int32 LastAmmoAmount;
+	FUTRetainedText RetainedAmmoText;
 
 	UPROPERTY()
 	AUTWeapon* LastWeapon;
@@ -0,0 +1,119 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "UTHubLaunchBenchmark.generated.h"
+
+/**
+ * Hub match launch benchmark. Started by the lobby game mode when the command line has -UTHubLaunchBenchmark=N:
+ * launches N matches one after another with the instance pool turned off, so every launch starts a new process,
+ * then N more with one idle pooled instance waiting for each. Every match is shut down as soon as its instance is ready.
+ *
+ * Then it measures the memory each additional match costs: M matches are kept running at once in separate processes,
+ * then M matches share one pooled process, using the memory the instances report to the hub once ready.
+ * The times and memory are written as JSON and the hub exits, e.g.
+ *
+ *   UE4Server UnrealTournament UT-Entry?Game=Lobby -UTHubLaunchBenchmark=5 -UTHubBenchmarkRuleset=Duel
+ *
+ * Optional: -UTHubBenchmarkRuleset=<tag> (default the first ruleset; sharing needs one with few players),
+ * -UTHubBenchmarkMemoryMatches=M (default 4, 0 skips the memory part), -UTBenchmarkReport=<file>
+ * (default Saved/Benchmarks/HubLaunch-<date>.json).
+ */
+UCLASS(NotPlaceable, Transient)
+class UNREALTOURNAMENT_API AUTHubLaunchBenchmark : public AActor
+{
+	GENERATED_UCLASS_BODY()
+
+	/** launches measured with each setting */
+	UPROPERTY()
+	int32 NumLaunches;
+
+	/** matches kept running at once for the memory comparison */
+	UPROPERTY()
+	int32 NumMemoryMatches;
+
+	/** launches that aren't ready after this many seconds count as failed */
+	UPROPERTY()
+	float LaunchTimeout;
+
+	/** ruleset the matches are launched with */
+	UPROPERTY()
+	FString RulesetTag;
+
+	/** where the JSON report goes */
+	UPROPERTY()
+	FString ReportFilename;
+
+	/** @return whether the command line asks for a benchmark, and the number of launches */
+	static bool WantsBenchmark(int32& OutNumLaunches);
+
+	/** reads the other command line options and saves the pool settings; called by the lobby game mode once the lobby beacons are up */
+	void StartBenchmark();
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	enum EPhase
+	{
+		/** waiting for the pool to be empty before the cold launches */
+		PHASE_ColdSetup,
+		PHASE_Cold,
+		/** waiting for an idle pooled instance before each pooled launch */
+		PHASE_PooledSetup,
+		PHASE_Pooled,
+		/** waiting for the pool to be empty again, then matches in one process each */
+		PHASE_SeparateSetup,
+		PHASE_Separate,
+		/** waiting for an idle pooled instance that reported its memory, then matches that all share it */
+		PHASE_SharedSetup,
+		PHASE_Shared,
+		PHASE_Done,
+	};
+	EPhase Phase;
+
+	/** the match being launched, not in the hub's match list so players never see it */
+	UPROPERTY()
+	AUTLobbyMatchInfo* MatchInfo;
+	double LaunchStartTime;
+
+	/** matches kept running in the memory phases */
+	UPROPERTY()
+	TArray<AUTLobbyMatchInfo*> RunningMatches;
+
+	/** time to ready of each launch, 0 for ones that timed out */
+	TArray<float> ColdTimes;
+	TArray<float> PooledTimes;
+
+	/** memory of each process in the separate phase, in KB */
+	TArray<int32> SeparateProcessKB;
+	/** memory of the shared process while idle, then after each match it took, in KB */
+	int32 SharedIdleKB;
+	TArray<int32> SharedProcessKB;
+	uint32 SharedHostInstanceID;
+
+	/** pool settings to put back when done */
+	int32 SavedMinIdleInstances;
+	int32 SavedMaxIdleInstances;
+	int32 SavedMaxMatchesPerInstance;
+	int32 SavedSharedInstanceMaxPlayers;
+
+	AUTLobbyGameState* GetLobbyGameState() const;
+	/** sets the pool size and how many matches a pooled process takes, killing pooled instances over the new size */
+	void SetPoolSize(int32 NumIdle, int32 MaxMatchesPerInstance = 1);
+	/** @return an idle pooled instance without matches, or NULL */
+	const struct FPooledGameInstance* FindFreePooledInstance() const;
+	/** @return the ruleset matches are launched with */
+	TWeakObjectPtr<AUTReplicatedGameRuleset> FindBenchmarkRuleset();
+	/** starts a match on the benchmark ruleset */
+	bool Launch();
+	/** shuts the match down and records its time, or 0 if bTimedOut */
+	void FinishLaunch(bool bTimedOut);
+	/** keeps the match running and records the memory of its process, or 0 if bTimedOut */
+	void FinishMemoryLaunch(bool bTimedOut);
+	/** shuts down the matches of a memory phase */
+	void StopRunningMatches();
+	void FinishBenchmark();
+	/** adds the times to the report and the log */
+	void ReportTimes(const TCHAR* Title, const TArray<float>& Times, TSharedRef<FJsonObject> ReportJson);
+	/** adds the memory per additional match in separate and shared processes to the report and the log */
+	void ReportMemory(TSharedRef<FJsonObject> ReportJson);
+};
@@ -0,0 +1,116 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+class AUTPickup;
+class AUTDroppedPickup;
+class UUTPathNode;
+class AUTRecastNavMesh;
+
+/**
+ * Path distance from every path node to the nearest available pickup of each pickup type (inventory class for weapon and
+ * other inventory pickups, the pickup class otherwise), stored in UUTPathNode::InventoryField. Owned by AUTRecastNavMesh on the server.
+ * The field is a Dijkstra search outwards from all available pickups over the reversed node graph, for a standard sized player.
+ * When a pickup is taken only the nodes that led to it are recomputed from their neighbors, when it respawns the search only
+ * continues from it as far as it is closer than what nodes had, so keeping it up to date costs little compared to bots
+ * searching the graph each time they want an item. Bots walk down the field to get to an item, see AUTRecastNavMesh::FindInventoryFieldPath().
+ */
+class UNREALTOURNAMENT_API FUTInventoryField
+{
+public:
+	FUTInventoryField();
+
+	/** a pickup the field may lead to */
+	struct FSource
+	{
+		TWeakObjectPtr<AUTPickup> Pickup;
+		/** index into the field's nodes */
+		int32 Node;
+		int32 Type;
+		/** distance from the node's location to the pickup */
+		int32 NodeDistance;
+		bool bAvailable;
+	};
+
+	/** called when a pickup is added to navigation on Node */
+	void AddPickup(AUTRecastNavMesh* NavMesh, const TArray<UUTPathNode*>& PathNodes, AUTPickup* Pickup, UUTPathNode* Node);
+	void RemovePickup(AUTPickup* Pickup);
+	/** updates the field when the pickup was taken or respawned */
+	void PickupStateChanged(AUTPickup* Pickup);
+
+	/** dropped pickups come and go too quickly to be worth a field, they're only remembered so bots can check whether one beats what the field has */
+	void AddDroppedPickup(AUTDroppedPickup* Pickup);
+	void RemoveDroppedPickup(AUTDroppedPickup* Pickup);
+
+	inline bool IsInitialized() const
+	{
+		return bInitialized;
+	}
+	inline int32 GetNumTypes() const
+	{
+		return Types.Num();
+	}
+	inline const FSource& GetSource(int32 Index) const
+	{
+		return Sources[Index];
+	}
+	inline const TArray<FSource>& GetSources() const
+	{
+		return Sources;
+	}
+	inline UUTPathNode* GetSourceNode(int32 Index) const
+	{
+		return Nodes[Sources[Index].Node];
+	}
+	inline const TArray< TWeakObjectPtr<AUTDroppedPickup> >& GetDroppedPickups() const
+	{
+		return DroppedPickups;
+	}
+
+private:
+	bool bInitialized;
+
+	/** all path nodes and the links between them usable by a standard player, with their costs */
+	TArray<UUTPathNode*> Nodes;
+	TMap<const UUTPathNode*, int32> NodeIndices;
+	struct FFieldLink
+	{
+		int32 Node;
+		int32 Cost;
+	};
+	TArray< TArray<FFieldLink> > OutLinks;
+	TArray< TArray<FFieldLink> > InLinks;
+
+	/** pickup types, indices into UUTPathNode::InventoryField */
+	TArray<UClass*> Types;
+
+	TArray<FSource> Sources;
+	TArray<int32> FreeSources;
+	TMap<const AUTPickup*, int32> PickupToSource;
+
+	TArray< TWeakObjectPtr<AUTDroppedPickup> > DroppedPickups;
+
+	/** nodes whose distance went down during an update, closest first */
+	struct FOpenNode
+	{
+		int32 Distance;
+		int32 Node;
+
+		FOpenNode(int32 InDistance, int32 InNode)
+			: Distance(InDistance), Node(InNode)
+		{}
+		bool operator<(const FOpenNode& Other) const
+		{
+			return Distance < Other.Distance;
+		}
+	};
+	TArray<FOpenNode> OpenNodes;
+
+	void Init(AUTRecastNavMesh* NavMesh, const TArray<UUTPathNode*>& PathNodes);
+	int32 FindOrAddType(UClass* TypeClass);
+	void SetSourceAvailable(int32 SourceIndex, bool bAvailable);
+	/** sets the node's entry if Distance is shorter and queues it */
+	void OfferDistance(int32 Node, int32 Type, int32 Distance, int32 SourceIndex);
+	/** continues the search from the queued nodes */
+	void Propagate(int32 Type);
+	static UClass* GetPickupType(AUTPickup* Pickup);
+};
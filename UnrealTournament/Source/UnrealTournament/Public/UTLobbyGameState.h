@@ -20,18 +20,93 @@ struct FGameInstanceData
 	UPROPERTY()
 	int32 InstancePort;
 
+	// How many matches the process has hosted including this one, pooled processes are reused for several
+	int32 NumMatchesHosted;
+
+	// When the match was launched, cleared once the instance is ready.  Used to report the time players spend waiting.
+	double LaunchTime;
+
+	// Seconds from launch until the instance was ready, 0 until then
+	float TimeToReady;
+
+	// Memory the instance's process used when it last reported it, in KB.  0 until the instance is ready.
+	int32 UsedPhysicalKB;
+
+	// True if the match was given to an idle instance from the pool instead of starting a new process
+	bool bPooledLaunch;
+
+	// If the match runs next to others inside a pooled instance's process, the id of that pooled instance.  0 if it has a process of its own.
+	uint32 HostInstanceID;
+
 	FGameInstanceData()
 		: MatchInfo(NULL)
 		, InstancePort(0)
+		, NumMatchesHosted(0)
+		, LaunchTime(0.0)
+		, TimeToReady(0.0f)
+		, UsedPhysicalKB(0)
+		, bPooledLaunch(false)
+		, HostInstanceID(0)
 	{};
 
-	FGameInstanceData(AUTLobbyMatchInfo* inMatchInfo, int32 inInstancePort)
+	FGameInstanceData(AUTLobbyMatchInfo* inMatchInfo, int32 inInstancePort, int32 inNumMatchesHosted, bool bInPooledLaunch)
 		: MatchInfo(inMatchInfo)
 		, InstancePort(inInstancePort)
+		, NumMatchesHosted(inNumMatchesHosted)
+		, LaunchTime(FPlatformTime::Seconds())
+		, TimeToReady(0.0f)
+		, UsedPhysicalKB(0)
+		, bPooledLaunch(bInPooledLaunch)
+		, HostInstanceID(0)
 	{};
 
 };
 
+/**
+ *	A game instance process that isn't running a match.  It is either starting up on the idle map or sitting there waiting
+ *  for the hub to give it a match, which is much quicker than starting a new process.
+ **/
+struct FPooledGameInstance
+{
+	uint32 InstanceID;
+	int32 InstancePort;
+	FProcHandle ProcessHandle;
+
+	// How many matches the process has hosted so far
+	int32 NumMatchesHosted;
+
+	// How many small matches are running next to the idle map right now
+	int32 NumSharedMatches;
+
+	// The hub side of the instance's lobby beacon.  Only valid while the instance is idle and connected.
+	TWeakObjectPtr<class AUTServerBeaconLobbyClient> Beacon;
+
+	// When the instance was launched or handed back, used to time how long it takes to become idle
+	double PoolTime;
+
+	// Last time the instance was known to be connected, instances that stay away too long are killed
+	double LastSeenTime;
+
+	// Memory the process used when it last reported it, in KB, including any shared matches
+	int32 UsedPhysicalKB;
+
+	FPooledGameInstance(uint32 InInstanceID, int32 InInstancePort, FProcHandle InProcessHandle, int32 InNumMatchesHosted)
+		: InstanceID(InInstanceID)
+		, InstancePort(InInstancePort)
+		, ProcessHandle(InProcessHandle)
+		, NumMatchesHosted(InNumMatchesHosted)
+		, NumSharedMatches(0)
+		, PoolTime(FPlatformTime::Seconds())
+		, LastSeenTime(PoolTime)
+		, UsedPhysicalKB(0)
+	{}
+
+	bool IsIdle() const
+	{
+		return Beacon.IsValid();
+	}
+};
+
 
 class AUTGameMode;
 
@@ -40,6 +115,8 @@ class UNREALTOURNAMENT_API AUTLobbyGameState : public AUTGameState
 {
 	GENERATED_UCLASS_BODY()
 
+	friend class AUTHubLaunchBenchmark;
+
 	virtual void PostInitializeComponents() override;
 
 	// Holds a list of running Game Instances.
@@ -62,6 +139,38 @@ class UNREALTOURNAMENT_API AUTLobbyGameState : public AUTGameState
 	UPROPERTY(Config)
 	TArray<FString> AccessKeys;
 
+	// The URL idle instances in the pool wait on.  It should be a small map that doesn't start a match on its own.
+	UPROPERTY(Config)
+	FString IdleInstanceURL;
+
+	// The pool always keeps at least this many idle instances around
+	UPROPERTY(Config)
+	int32 MinIdleInstances;
+
+	// and never more than this many
+	UPROPERTY(Config)
+	int32 MaxIdleInstances;
+
+	// Between the two, the pool keeps one idle instance for each match launched in the last InstancePoolDemandWindow seconds
+	UPROPERTY(Config)
+	float InstancePoolDemandWindow;
+
+	// Instances are shut down instead of going back to the pool after hosting this many matches
+	UPROPERTY(Config)
+	int32 MaxMatchesPerPooledInstance;
+
+	// Pooled instances that don't report in for this long are killed
+	UPROPERTY(Config)
+	float PooledInstanceTimeout;
+
+	// Small matches are run side by side inside one idle pooled instance, up to this many per process.  1 turns it off.
+	UPROPERTY(Config)
+	int32 MaxMatchesPerInstance;
+
+	// Matches for at most this many players count as small enough to share a process
+	UPROPERTY(Config)
+	int32 SharedInstanceMaxPlayers;
+
 	/** maintains a reference to gametypes that have been requested as the UI refs are weak pointers and won't prevent GC on their own */
 	UPROPERTY(Transient)
 	TArray<UClass*> LoadedGametypes;
@@ -126,6 +235,16 @@ class UNREALTOURNAMENT_API AUTLobbyGameState : public AUTGameState
 	 **/
 	void GameInstance_Ready(uint32 GameInstanceID, FGuid GameInstanceGUID);
 
+	/**
+	 *	Called when a pooled instance has finished loading the idle map and can be given a match.
+	 **/
+	void GameInstance_Idle(AUTServerBeaconLobbyClient* Beacon, uint32 GameInstanceID);
+
+	/**
+	 *	Called when an instance reports how much memory its process uses, after it becomes ready or idle.
+	 **/
+	void GameInstance_Memory(uint32 GameInstanceID, int32 UsedPhysicalKB);
+
 	/**
 	 *	Called when an instance needs to update it's match information
 	 **/
@@ -149,9 +268,9 @@ class UNREALTOURNAMENT_API AUTLobbyGameState : public AUTGameState
 	void GameInstance_EndGame(uint32 GameInstanceID, const FString& FinalDescription);
 
 	/**
-	 *	Called when the instance server is ready.  When it is called, the Lobby will kill the server instance.
+	 *	Called when the instance server is ready.  When it is called, the Lobby will send the instance back to the pool or kill it.
 	 **/
-	void GameInstance_Empty(uint32 GameInstanceID);
+	void GameInstance_Empty(AUTServerBeaconLobbyClient* Beacon, uint32 GameInstanceID);
 
 	void CheckForExistingMatch(AUTLobbyPlayerState* NewPlayer, bool bReturnedFromMatch);
 
@@ -178,6 +297,44 @@ protected:
 
 	void CheckInstanceHealth();
 
+	// Instances that are waiting for a match, or starting up to do so
+	TArray<FPooledGameInstance> InstancePool;
+
+	// When the matches in the demand window were launched, oldest first
+	TArray<double> RecentLaunchTimes;
+
+	// Time to ready totals since the hub started, for comparing pooled and cold launches
+	int32 NumColdLaunches;
+	double TotalColdLaunchTime;
+	int32 NumPooledLaunches;
+	double TotalPooledLaunchTime;
+
+	uint32 GetNextGameInstanceID();
+
+	// Returns the first instance port that no running or pooled instance is using
+	int32 FindFreeInstancePort();
+
+	FProcHandle CreateInstanceProcess(const FString& GameURL, int32 InstancePort);
+
+	FString GetIdleInstanceURL(uint32 InInstanceID);
+
+	// Returns how many idle instances the pool should hold right now
+	int32 GetTargetPoolSize();
+
+	// Starts pooled instances or shuts them down to match recent demand, and drops ones that died.  Runs on a timer.
+	void MaintainInstancePool();
+
+	void TerminatePooledInstance(int32 PoolIndex);
+
+	// Returns how many pooled instances are free to take a match of their own, ones that share their process with small matches don't count
+	int32 GetNumFreePooledInstances();
+
+	// Returns the pooled instance a small match can be added to, or INDEX_NONE
+	int32 FindSharedMatchHost(AUTLobbyMatchInfo* MatchOwner);
+
+	// Returns the game instance data of the given match, or NULL
+	FGameInstanceData* FindGameInstanceData(AUTLobbyMatchInfo* MatchOwner);
+
 	AUTLobbyMatchInfo* FindMatchPlayerIsIn(FString PlayerID);
 
 	// A list of GameRulesets to create.  These are just names that will be applied to the objects.  Per-Object-Config does the rest.
@@ -214,6 +214,18 @@ struct FUTPathLink
 	}
 };
 
+/** distance from a path node to the nearest available pickup of one type, see FUTInventoryField */
+struct FUTInventoryFieldEntry
+{
+	int32 Distance;
+	/** index of that pickup in the field, INDEX_NONE if none can be reached */
+	int32 Source;
+
+	FUTInventoryFieldEntry()
+		: Distance(BLOCKED_PATH_COST), Source(INDEX_NONE)
+	{}
+};
+
 UCLASS(NotPlaceable)
 class UNREALTOURNAMENT_API UUTPathNode : public UObject
 {
@@ -258,6 +270,9 @@ class UNREALTOURNAMENT_API UUTPathNode : public UObject
 	UPROPERTY(BlueprintReadWrite, SaveGame, Category = AIMapData)
 	float AvgHideDuration;
 
+	/** runtime only: path distance to the nearest available pickup of each of the inventory field's pickup types (server only) */
+	TArray<FUTInventoryFieldEntry> InventoryField;
+
 	/** returns index to best link in Paths for Asker to move from this node to Target, or INDEX_NONE if no link is found that can be used
 	 * note that there may be multiple links to the other node with different traversability properties; the one with shortest Distance is used
 	 */
@@ -4,6 +4,7 @@
 #include "UTResetInterface.h"
 #include "UTPathBuilderInterface.h"
 #include "UTPlayerState.h"
+#include "UTTickAggregator.h"
 #include "UTPickup.generated.h"
 
 extern FName NAME_Progress;
@@ -94,6 +95,7 @@ class UNREALTOURNAMENT_API AUTPickup : public AActor, public IUTResetInterface,
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void ParallelTick(float DeltaSeconds) override;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Effects)
 	bool bHasTacComView;
@@ -125,6 +127,15 @@ class UNREALTOURNAMENT_API AUTPickup : public AActor, public IUTResetInterface,
 
 	FTimerHandle WakeUpTimerHandle;
 
+	/** @return respawn progress (0-1) for TimerEffect, or a negative value if not waiting to respawn */
+	float GetRespawnProgress() const;
+	/** GetRespawnProgress() as computed by ParallelTick() this frame */
+	float ParallelRespawnProgress;
+	uint64 ParallelRespawnProgressFrame;
+
+	/** after the first tick, PrimaryActorTick is ticked together with the other pickups of the same class */
+	FUTAggregatedTickHandle AggregatedTick;
+
 	/** used for the timer-based call to WakeUp() so clients can perform different behavior to handle possible sync issues */
 	UFUNCTION()
 	void WakeUpTimer();
@@ -389,7 +389,6 @@ public:
 	virtual void ValidateEntitlements();
 
 	void WriteStatsToCloud();
-	void StatsWriteComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded);
 	virtual void AddMatchToStats(const FString& GameType, const TArray<class AUTTeamInfo*>* Teams, const TArray<APlayerState*>* ActivePlayerStates, const TArray<APlayerState*>* InactivePlayerStates);
 
 	virtual int32 GetSkillRating(FName SkillStatName);
@@ -435,8 +434,8 @@ private:
 	virtual void OnReadUserFileComplete(bool bWasSuccessful, const FUniqueNetId& InUserId, const FString& FileName);
 	virtual void OnWriteUserFileComplete(bool bWasSuccessful, const FUniqueNetId& InUserId, const FString& FileName);
 
-	/** map of additional stats used for scoring display. */
-	TMap< FName, float > StatsData;
+	/** additional stats used for scoring display, indexed by FUTStatRegistry index. */
+	TArray<float> StatsData;
 
 public:
 	/** Last time StatsData was updated - used when replicating the data. */
@@ -448,6 +447,14 @@ public:
 	void SetStatsValue(FName StatsName, float NewValue);
 	void ModifyStatsValue(FName StatsName, float Change);
 
+	/** Accessors for StatsData by FUTStatRegistry index, for stats that are updated often. */
+	float GetStatsValueByIndex(int32 StatIndex) const
+	{
+		return StatsData.IsValidIndex(StatIndex) ? StatsData[StatIndex] : 0.0f;
+	}
+	void SetStatsValueByIndex(int32 StatIndex, float NewValue);
+	void ModifyStatsValueByIndex(int32 StatIndex, float Change);
+
 	// Average ELO rank for this player.
 	UPROPERTY(Replicated)
 	int32 AverageRank;
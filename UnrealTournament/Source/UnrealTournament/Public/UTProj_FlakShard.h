@@ -92,6 +92,9 @@ class UNREALTOURNAMENT_API AUTProj_FlakShard : public AUTProjectile
 
 	virtual void RemoveSatelliteShards();
 
+	/** adds the extra visual shards around the projectile */
+	virtual void AddSatelliteShards();
+
 	virtual void PostInitializeComponents() override;
 
 	virtual void ProcessHit_Implementation(AActor* OtherActor, UPrimitiveComponent* OtherComp, const FVector& HitLocation, const FVector& HitNormal) override;
@@ -101,4 +104,5 @@ class UNREALTOURNAMENT_API AUTProj_FlakShard : public AUTProjectile
 	virtual void Tick(float DeltaTime) override;
 	virtual void CatchupTick(float CatchupTickDelta) override;
 	virtual void BeginPlay() override;
+	virtual void Reactivate(const FVector& NewLocation, const FRotator& NewRotation) override;
 };
@@ -38,5 +38,6 @@ class UNREALTOURNAMENT_API AUTProj_FlakShardMain : public AUTProj_FlakShard
 	virtual void DamageImpactedActor_Implementation(AActor* OtherActor, UPrimitiveComponent* OtherComp, const FVector& HitLocation, const FVector& HitNormal) override;
 	virtual FRadialDamageParams GetDamageParams_Implementation(AActor* OtherActor, const FVector& HitLocation, float& OutMomentum) const override;
 	virtual void OnBounce(const struct FHitResult& ImpactResult, const FVector& ImpactVelocity) override;
+	virtual void Reactivate(const FVector& NewLocation, const FRotator& NewRotation) override;
 
 };
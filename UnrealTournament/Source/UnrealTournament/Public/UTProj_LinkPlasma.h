@@ -28,4 +28,6 @@ public:
 	/** added to scale (visuals and collision) per link */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = LinkBolt)
 	float ExtraScalePerLink;
+
+	virtual void Reactivate(const FVector& NewLocation, const FRotator& NewRotation) override;
 };
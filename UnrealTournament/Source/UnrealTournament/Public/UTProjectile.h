@@ -208,6 +208,25 @@ class UNREALTOURNAMENT_API AUTProjectile : public AActor, public IUTResetInterfa
 	/** true if already exploded (to avoid recursion, etc) */
 	bool bExploded;
 
+	/** whether instances that are never replicated (fake client projectiles, standalone games) are hidden and reused instead of destroyed
+	 * subclasses that change their own state in flight must put it back in Reactivate()
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = Projectile)
+	bool bAllowPooling;
+
+	/** returns whether this projectile can be put in the world settings' pool instead of being destroyed */
+	virtual bool CanBePooled() const;
+
+	/** hides the projectile and stops movement, collision, effects and timers so it can wait in the world settings' pool */
+	virtual void PutAway();
+
+	/** brings a projectile that was put away back as if it was just spawned at the given location
+	 * Instigator and Owner must be set beforehand
+	 */
+	virtual void Reactivate(const FVector& NewLocation, const FRotator& NewRotation);
+
+	virtual void LifeSpanExpired() override;
+
 	virtual void PreInitializeComponents() override;
 	virtual void BeginPlay() override;
 	virtual void TornOff() override;
@@ -321,6 +340,12 @@ class UNREALTOURNAMENT_API AUTProjectile : public AActor, public IUTResetInterfa
 	float GetMaxDamageRadius() const;
 
 protected:
+	/** returns the projectile to the world settings' pool if allowed, otherwise destroys it */
+	virtual void Recycle();
+
+	/** tells the bot we're most likely aimed at that we're coming, if bInitiallyWarnTarget */
+	virtual void WarnTarget();
+
 	/** workaround to Instigator not exposed in blueprint spawn at engine level
 	 * ONLY USED IN SPAWN ACTOR NODE
 	 */
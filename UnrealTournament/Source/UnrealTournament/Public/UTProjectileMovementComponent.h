@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "UTTickAggregator.h"
+
 #include "UTProjectileMovementComponent.generated.h"
 
 UCLASS(ClassGroup = Movement, meta = (BlueprintSpawnableComponent))
@@ -45,6 +47,14 @@ class UNREALTOURNAMENT_API UUTProjectileMovementComponent : public UProjectileMo
 	}
 
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void OnUnregister() override;
+	/** where PrimaryComponentTick is ticked from once it has been aggregated */
+	const FUTAggregatedTickHandle& GetAggregatedTick() const
+	{
+		return AggregatedTick;
+	}
+	/** sweeps the first move of this frame's tick against static bodies ahead of time; if nothing is in the way the move in TickComponent() only sweeps dynamic bodies */
+	virtual void ParallelTickComponent(float DeltaTime) override;
 
 	UFUNCTION(Server, WithValidation, Reliable)
 	void ServerUpdateState(FVector InAcceleration);
@@ -58,5 +68,30 @@ class UNREALTOURNAMENT_API UUTProjectileMovementComponent : public UProjectileMo
 	virtual FVector ComputeHomingAcceleration(const FVector& InVelocity, float DeltaTime) const override;
 
 protected:
+	/** result of the sweep done in ParallelTickComponent(), only used if the move that is actually made matches it exactly */
+	struct FPredictedMove
+	{
+		bool bValid;
+		/** true if the sweeps didn't hit or touch any static body */
+		bool bClear;
+		FVector Delta;
+		FRotator Rotation;
+		/** location of UpdatedComponent and then each of AddlUpdatedComponents when swept */
+		TArray<FVector, TInlineAllocator<4>> StartLocations;
+
+		FPredictedMove()
+			: bValid(false), bClear(false)
+		{}
+	};
+	FPredictedMove PredictedMove;
+
+	/** after the first tick, PrimaryComponentTick is ticked together with the other projectiles of the same class */
+	FUTAggregatedTickHandle AggregatedTick;
+
+	/** @return whether the current locations of the updated components are the ones the predicted move was swept from */
+	bool MatchesPredictedStart() const;
+	/** @return whether no dynamic body is in the predicted path; ParallelTickComponent() only sweeps static bodies, this sweeps the rest right before the move */
+	bool IsPredictedPathStillClear() const;
+
 	virtual void HandleImpact(const FHitResult& Hit, float TimeSlice, const FVector& MoveDelta) override;
 };
\ No newline at end of file
@@ -0,0 +1,97 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "UTProjectileTickBenchmark.generated.h"
+
+/**
+ * Keeps a fixed number of projectiles flying around its location and measures the time spent in the tick groups
+ * and in projectile movement on the game thread, first with the parallel tick batches turned off and then with them turned on. The times come from the server frame
+ * telemetry, so they end up in its CSV file as well. Spawned by the ProjectileTickBenchmark cheat.
+ * In standalone games it then does the same with PoolingProjClass and ut.EffectPooling off and on, and reports the time spent
+ * spawning projectiles and in garbage collection (a collection is forced at the end of each of those phases).
+ */
+UCLASS(NotPlaceable, Transient)
+class UNREALTOURNAMENT_API AUTProjectileTickBenchmark : public AActor
+{
+	GENERATED_UCLASS_BODY()
+
+	/** projectile to spawn */
+	UPROPERTY()
+	TSubclassOf<AUTProjectile> ProjClass;
+
+	/** projectile to spawn in the effect pooling phases, needs bAllowPooling */
+	UPROPERTY()
+	TSubclassOf<AUTProjectile> PoolingProjClass;
+
+	/** number of live projectiles to keep */
+	UPROPERTY()
+	int32 NumProjectiles;
+
+	/** seconds measured with each setting; a warm up phase of the same length runs first */
+	UPROPERTY()
+	float PhaseSeconds;
+
+	/** projectiles are spawned at random up to this far from the benchmark location */
+	UPROPERTY()
+	float SpawnRadius;
+
+	/** player to report to, if any */
+	UPROPERTY()
+	APlayerController* ReportTo;
+
+	/** saves and overrides the settings used by the benchmark and starts the warm up phase; set the properties above first */
+	void StartBenchmark();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+	enum EPhase
+	{
+		PHASE_WarmUp,
+		PHASE_Serial,
+		PHASE_Parallel,
+		/** fills the pool */
+		PHASE_PoolingWarmUp,
+		PHASE_PoolingOff,
+		PHASE_PoolingOn,
+		PHASE_Done,
+	};
+	EPhase Phase;
+	float PhaseEndTime;
+	/** set when the phase is over and the forced garbage collection is yet to happen */
+	bool bWaitingForGC;
+
+	/** game thread projectile time per frame in PHASE_Serial, to compare PHASE_Parallel with */
+	float SerialProjectileMs;
+
+	/** projectiles spawned or reused this phase and the time it took */
+	int32 NumSpawned;
+	double SpawnSeconds;
+
+	UPROPERTY()
+	TArray<AUTProjectile*> Projectiles;
+
+	/** cvar values to put back when done */
+	bool bSavedSettings;
+	int32 SavedParallelBatchTicks;
+	int32 SavedTelemetryEnable;
+	float SavedTelemetryWindowSeconds;
+	int32 SavedEffectPooling;
+
+	inline bool IsPoolingPhase() const
+	{
+		return Phase == PHASE_PoolingWarmUp || Phase == PHASE_PoolingOff || Phase == PHASE_PoolingOn;
+	}
+
+	void SpawnProjectiles();
+	void StartPhase(EPhase NewPhase);
+	/** ends the current phase, reporting what it measured, and starts the next one */
+	void EndPhase();
+	/** reports the telemetry window that was just closed */
+	void ReportPhase(const TCHAR* Title);
+	/** reports spawn and garbage collection times from the telemetry window that was just closed */
+	void ReportPoolingPhase(const TCHAR* Title);
+	void Report(const FString& Line);
+	void RestoreSettings();
+};
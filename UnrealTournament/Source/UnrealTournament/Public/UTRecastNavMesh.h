@@ -9,6 +9,7 @@
 #include "UTReachSpec.h"
 #include "AI/Navigation/NavigationTypes.h"
 #include "UTPathNode.h"
+#include "UTInventoryField.h"
 
 #include "UTRecastNavMesh.generated.h"
 
@@ -324,6 +325,12 @@ class UNREALTOURNAMENT_API AUTRecastNavMesh : public ARecastNavMesh
 	// some pathfinding functions (inventory searches, for example) use this list to efficiently find possible endpoints
 	virtual void AddToNavigation(AActor* NewPOI);
 	virtual void RemoveFromNavigation(AActor* OldPOI);
+	/** updates the inventory field after the pickup was taken or respawned */
+	virtual void PickupStateChanged(AUTPickup* Pickup);
+	inline const FUTInventoryField& GetInventoryField() const
+	{
+		return InventoryField;
+	}
 
 	/** find pathnode corresponding to target's position on the navmesh (if any) */
 	virtual UUTPathNode* FindNearestNode(const FVector& TestLoc, const FVector& Extent) const;
@@ -365,6 +372,13 @@ class UNREALTOURNAMENT_API AUTRecastNavMesh : public ARecastNavMesh
 	 */
 	virtual bool FindBestPath(APawn* Asker, const FNavAgentProperties& AgentProps, FUTNodeEvaluator& NodeEval, const FVector& StartLoc, float& Weight, bool bAllowDetours, TArray<FRouteCacheItem>& NodeRoute);
 
+	/** inventory search that reads the inventory field instead of searching the node network: picks the best of the nearest available pickups
+	 * of each type with NodeEval's rules, then walks down the field to it, so the cost is about the length of the route
+	 * @param bNeedFullSearch - set if the field can't answer, e.g. a dropped pickup or one that will respawn soon might be better; use FindBestPath() then
+	 * other parameters and result are the same as FindBestPath() without detours
+	 */
+	virtual bool FindInventoryFieldPath(APawn* Asker, const FNavAgentProperties& AgentProps, struct FBestInventoryEval& NodeEval, const FVector& StartLoc, float& Weight, TArray<FRouteCacheItem>& NodeRoute, bool& bNeedFullSearch);
+
 	/** calculate effective traveling distance between two polys
 	 * returns direct distance if reachable by straight line or no navmesh path exists, otherwise does navmesh pathfinding and returns path distance
 	 * this function is designed for calculating UTPathLink distances between known accessible nodes during path building and isn't intended for gameplay
@@ -423,6 +437,11 @@ protected:
 	TArray<UUTReachSpec*> AllReachSpecs;
 	/** transient POI to Node table to optimize AddToNavigation()/RemoveFromNavigation() */
 	TMap<TWeakObjectPtr<AActor>, UUTPathNode*> POIToNode;
+	/** distance to the nearest available pickup of each type, for bot inventory searches (server only) */
+	FUTInventoryField InventoryField;
+
+	/** sets the ReachSpec move target Actors on a route from StartNode found on the node network */
+	void SetRouteSpecActors(const UUTPathNode* StartNode, NavNodeRef StartPoly, APawn* Asker, const FNavAgentProperties& AgentProps, TArray<FRouteCacheItem>& NodeRoute) const;
 
 	/** get size of poly edge link clamped to one of the SizeSteps
 	 * inputs are all assumed valid
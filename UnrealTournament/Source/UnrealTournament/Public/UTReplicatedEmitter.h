@@ -2,6 +2,7 @@
 #pragma once
 
 #include "UnrealNetwork.h"
+#include "UTTickAggregator.h"
 
 #include "UTReplicatedEmitter.generated.h"
 
@@ -100,4 +101,10 @@ class UNREALTOURNAMENT_API AUTReplicatedEmitter : public AActor
 		}
 	}
 
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+	/** PSC is ticked together with the particles of the other emitters of the same class */
+	FUTAggregatedTickHandle PSCAggregatedTick;
 };
\ No newline at end of file
@@ -32,6 +32,51 @@ class UNREALTOURNAMENT_API AUTServerBeaconLobbyClient : public AOnlineBeaconClie
 	UFUNCTION(server, reliable, WithValidation)
 	virtual void Lobby_NotifyInstanceIsReady(uint32 InstanceID, FGuid InstanceGUID);
 
+	/**
+	 *	Tells the lobby that this pooled instance has loaded the idle map and can be given a match
+	 **/
+	UFUNCTION(server, reliable, WithValidation)
+	virtual void Lobby_NotifyInstanceIdle(uint32 InstanceID);
+
+	/**
+	 *	Tells the lobby how much memory this instance's process uses, sent after the instance is ready or idle
+	 **/
+	UFUNCTION(server, reliable, WithValidation)
+	virtual void Lobby_ReportMemory(uint32 InstanceID, int32 UsedPhysicalKB);
+
+	/** sends the process's current memory use to the lobby */
+	virtual void ReportMemory(uint32 InstanceID);
+
+	/**
+	 *	Called from the hub on an idle pooled instance, travels to the match the hub wants it to host.
+	 **/
+	UFUNCTION(client, reliable)
+	virtual void Instance_AssignMatch(const FString& GameURL);
+
+	/**
+	 *	Called from the hub when a match is over and the instance should go back to the pool instead of shutting down.
+	 **/
+	UFUNCTION(client, reliable)
+	virtual void Instance_ReturnToPool(const FString& IdleURL);
+
+	/**
+	 *	Called from the hub when it doesn't know this pooled instance, shuts it down.
+	 **/
+	UFUNCTION(client, reliable)
+	virtual void Instance_LeavePool();
+
+	/**
+	 *	Called from the hub on an idle pooled instance, starts another match in the same process next to the idle map.
+	 **/
+	UFUNCTION(client, reliable)
+	virtual void Instance_HostMatch(const FString& GameURL, int32 Port);
+
+	/**
+	 *	Called from the hub on the instance that hosts the match with the given instance id, shuts that match down.
+	 **/
+	UFUNCTION(client, reliable)
+	virtual void Instance_StopHostedMatch(uint32 InstanceID);
+
 	/**
 	 * Tells the Lobby to update it's description on the stats
 	 **/
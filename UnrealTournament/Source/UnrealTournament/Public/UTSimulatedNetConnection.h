@@ -0,0 +1,101 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+#include "Engine/NetConnection.h"
+
+#include "UTSimulatedNetConnection.generated.h"
+
+/**
+ * In-process stand in for a remote player, for measuring replication and player movement load on a server without real clients.
+ * The server replicates to it like to any other connection; packets go nowhere but are acknowledged after the simulated
+ * round trip unless lost, so reliable resends, saturation and ping behave like on a real link. Its player wanders around
+ * with scripted input that reaches the server as ServerMove and camera updates, sent at the client move rate and delayed
+ * and dropped the same way. Nothing is loaded for it, so dozens can be attached to a dedicated server; see AUTGameMode's SimClients option.
+ */
+UCLASS(transient)
+class UNREALTOURNAMENT_API UUTSimulatedNetConnection : public UNetConnection
+{
+	GENERATED_UCLASS_BODY()
+
+	/** creates a simulated connection on the server's net driver and logs its player in
+	 * @param Index - names the player and seeds its random input, so runs can be repeated
+	 * @param LatencyMs - round trip time
+	 * @param PacketLoss - percentage of packets lost each way */
+	static APlayerController* AddSimulatedClient(UNetDriver* NetDriver, int32 Index, int32 LatencyMs, int32 PacketLoss);
+
+	// UNetConnection interface
+	virtual FString LowLevelGetRemoteAddress(bool bAppendPort = false) override;
+	virtual FString LowLevelDescribe() override;
+	virtual void LowLevelSend(void* Data, int32 Count) override;
+	virtual void Tick() override;
+	virtual bool ClientHasInitializedLevelFor(const UObject* TestObject) const override;
+
+	/** ServerMoves per second, like a client running at this frame rate */
+	UPROPERTY()
+	float MoveRate;
+
+	/** @return whether the player has had a pawn and actors other than its controller are replicated to it, i.e. the load test is loading the server */
+	bool IsInGame() const;
+	/** logs a warning once if the player still isn't in the game a while after joining */
+	void CheckInGame();
+
+protected:
+	int32 SimulatedIndex;
+	/** one way, in seconds */
+	float OneWayLatency;
+	/** 0-1 */
+	float LossChance;
+	/** own random numbers so the server's random sequence doesn't depend on what the connections do */
+	FRandomStream RandomStream;
+
+	/** server packets the client will have received at ArrivalTime, in send order */
+	struct FSentPacket
+	{
+		int32 PacketId;
+		double ArrivalTime;
+		bool bHasPingAckData;
+		uint32 PingAckData;
+	};
+	TArray<FSentPacket> SentPackets;
+
+	/** client packets on their way to the server, in send order */
+	struct FClientPacket
+	{
+		int32 PacketId;
+		double ArrivalTime;
+		/** the previous packet's acks are sent again like UNetConnection::PurgeAcks() does, without ping data */
+		TArray<FSentPacket> ResentAcks;
+		TArray<FSentPacket> Acks;
+		/** input that was current when the packet was sent */
+		bool bHasMove;
+		float TimeStamp;
+		FVector Accel;
+		float Yaw;
+		float Pitch;
+		uint8 MoveFlags;
+	};
+	TArray<FClientPacket> ClientPackets;
+	TArray<FSentPacket> LastAcks;
+	int32 ClientPacketId;
+	double NextClientPacketTime;
+
+	/** scripted input */
+	TWeakObjectPtr<APawn> MovePawn;
+	float ClientTimeStamp;
+	double NextInputChangeTime;
+	float InputYaw;
+	float InputPitch;
+	bool bInputMoving;
+	double NextRestartTime;
+
+	/** net driver time the connection was created */
+	double JoinTime;
+	bool bHadPawn;
+	bool bReportedNotInGame;
+
+	void InitSimulatedConnection(UNetDriver* InDriver, int32 InIndex, int32 LatencyMs, int32 PacketLoss);
+	/** sends what the client would send this client frame: acks for what arrived, the current input */
+	void SendClientPacket(double SendTime, float DeltaTime);
+	void DeliverClientPacket(const FClientPacket& Packet);
+	void UpdateInput(double Now);
+};
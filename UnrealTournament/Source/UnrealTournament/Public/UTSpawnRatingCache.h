@@ -0,0 +1,76 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+/**
+ * Keeps the cost of rating player starts about constant, used by AUTGameMode::RatePlayerStart().
+ * Pawns are bucketed into a coarse grid once per frame so a start only looks at the pawns near it.
+ * Visibility from a start to the region (grid cell) a target is in is remembered: every trace made for a rating is stored, and the cells
+ * of the other player starts, where respawned enemies show up, are traced ahead of time a few starts at a time.
+ * Only a limited number of new traces are made per frame, once they are used up ratings go by what is remembered for the region,
+ * so a burst of respawns (a team being wiped) costs about the same as a single one.
+ */
+class UNREALTOURNAMENT_API FUTSpawnRatingCache
+{
+public:
+	FUTSpawnRatingCache();
+
+	/** traces start to start visibility ahead of time for a few more starts, called regularly by the game */
+	void Update(UWorld* World);
+
+	/** the pawn grid is rebuilt on next use, call when pawns were spawned this frame */
+	void InvalidatePawns()
+	{
+		PawnGridFrame = 0;
+	}
+
+	/** adds the characters with a PlayerState that may be within Radius of Location; all of them if Radius <= 0 */
+	void GetCharactersNear(UWorld* World, const FVector& Location, float Radius, TArray<ACharacter*>& OutCharacters);
+
+	/** @return whether nothing blocks the visibility channel between the start's eye position StartLoc and Target */
+	bool IsVisible(UWorld* World, APlayerStart* Start, const FVector& StartLoc, const FVector& Target);
+
+private:
+	struct FVisibilityKey
+	{
+		const APlayerStart* Start;
+		FIntVector Cell;
+
+		FVisibilityKey(const APlayerStart* InStart, const FIntVector& InCell)
+			: Start(InStart), Cell(InCell)
+		{}
+
+		bool operator==(const FVisibilityKey& Other) const
+		{
+			return Start == Other.Start && Cell == Other.Cell;
+		}
+		friend uint32 GetTypeHash(const FVisibilityKey& Key)
+		{
+			return HashCombine(PointerHash(Key.Start), GetTypeHash(Key.Cell));
+		}
+	};
+	struct FVisibilityEntry
+	{
+		/** last exact trace into the cell, reused as is for the same target in the same frame */
+		FVector Target;
+		uint64 Frame;
+		bool bVisible;
+	};
+	TMap<FVisibilityKey, FVisibilityEntry> Visibility;
+
+	TMap<FIntVector, TArray<ACharacter*>> PawnGrid;
+	TArray<ACharacter*> AllCharacters;
+	uint64 PawnGridFrame;
+
+	/** starts still to be traced ahead of time, gathered on the first update */
+	TArray<TWeakObjectPtr<APlayerStart>> PlayerStarts;
+	int32 NextPrecomputeStart;
+	bool bGatheredStarts;
+
+	uint64 TraceBudgetFrame;
+	int32 TracesThisFrame;
+
+	void UpdatePawnGrid(UWorld* World);
+	bool TraceVisibility(UWorld* World, const FVector& StartLoc, const FVector& Target);
+	static FIntVector GetVisibilityCell(const FVector& Location);
+	static FIntVector GetPawnCell(const FVector& Location);
+};
@@ -0,0 +1,38 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+/**
+ * Assigns every stat name a dense index so per player stats can be kept in a flat array instead of a name keyed map.
+ * The stats the StatManager knows about are registered when it is constructed, damage types register their kill and death stats
+ * when their default object is set up, anything else is registered the first time it is set.
+ * Indices are only valid for the lifetime of the process, stats are always sent and saved by name. Game thread only.
+ */
+class UNREALTOURNAMENT_API FUTStatRegistry
+{
+public:
+	/** @return index of the stat, registering it if it wasn't known yet */
+	static int32 RegisterStat(FName StatName);
+
+	/** @return index of the stat or INDEX_NONE if nothing registered it */
+	static int32 FindStat(FName StatName)
+	{
+		const int32* Index = Get().StatIndices.Find(StatName);
+		return (Index != NULL) ? *Index : INDEX_NONE;
+	}
+
+	static FName GetStatName(int32 StatIndex)
+	{
+		return Get().StatNames.IsValidIndex(StatIndex) ? Get().StatNames[StatIndex] : NAME_None;
+	}
+
+	static int32 NumStats()
+	{
+		return Get().StatNames.Num();
+	}
+
+private:
+	TMap<FName, int32> StatIndices;
+	TArray<FName> StatNames;
+
+	static FUTStatRegistry& Get();
+};
@@ -0,0 +1,78 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+/** backend stats of one player at the end of a match, as gathered on the game thread */
+struct FUTBackendStatsEntry
+{
+	FString StatsID;
+	TArray<FName> StatNames;
+	TArray<float> StatValues;
+};
+
+/**
+ * Gets backend stats to the stats service without holding up the end of match frame and without losing them to backend hiccups.
+ * Players' stats added during a frame are batched and the batch is turned into JSON and written to a spool file off the game thread.
+ * Spooled batches are then sent; entries that fail with a server or connection error stay spooled and are retried with
+ * exponential backoff, also by the next process to start if this one exits first.
+ * With ut.StatsFileSink batches are written to Saved/Stats instead of being sent, for testing offline.
+ */
+class UNREALTOURNAMENT_API FUTStatsUploader : public FTickerObjectBase
+{
+public:
+	/** creates the uploader on first use; UUTGameEngine::Init() calls it so the spool is loaded and retried at startup */
+	static FUTStatsUploader& Get();
+	/** deletes the uploader, anything not sent yet stays spooled */
+	static void Shutdown();
+
+	/** adds the player's stats to this frame's batch; game thread only */
+	void AddPlayerStats(FUTBackendStatsEntry&& Entry);
+
+	virtual bool Tick(float DeltaTime) override;
+
+private:
+	FUTStatsUploader();
+	virtual ~FUTStatsUploader();
+
+	struct FBatch
+	{
+		FString BatchID;
+		/** as gathered, emptied once serialized */
+		TArray<FUTBackendStatsEntry> Gathered;
+		/** per player JSON payload, entries that were sent are removed */
+		TArray<FString> StatsIDs;
+		TArray<FString> Payloads;
+		int32 Attempts;
+		double NextAttemptTime;
+		int32 PendingRequests;
+
+		FBatch()
+			: Attempts(0), NextAttemptTime(0.0), PendingRequests(0)
+		{}
+	};
+	typedef TSharedPtr<FBatch, ESPMode::ThreadSafe> FBatchPtr;
+
+	/** batch players are being added to this frame */
+	FBatchPtr OpenBatch;
+	/** serialized and spooled batches waiting to be sent or being sent */
+	TArray<FBatchPtr> SpooledBatches;
+	/** batches handed back by background serialization and spool loading */
+	TQueue<FBatchPtr, EQueueMode::Mpsc> ReadyBatches;
+	/** background work that has to finish before the uploader goes away */
+	TArray< TFuture<void> > BackgroundWork;
+	TArray<FHttpRequestPtr> ActiveRequests;
+	/** loading what earlier processes left in the spool, new batches are only spooled once it's done */
+	TFuture<void> SpoolLoad;
+
+	FString GetSpoolDir() const;
+	FString GetSpoolFilename(const FBatch& Batch) const;
+
+	/** background thread functions */
+	void SerializeBatch(FBatchPtr Batch);
+	void LoadSpool(const FString& SpoolDir);
+	static bool WriteSpoolFile(const FString& Filename, const FBatch& Batch);
+	static bool ReadSpoolFile(const FString& Filename, FBatch& Batch);
+
+	void SendBatch(FBatchPtr Batch);
+	void SendComplete(FHttpRequestPtr HttpRequest, FHttpResponsePtr HttpResponse, bool bSucceeded, FBatchPtr Batch, FString StatsID);
+	void FinishAttempt(FBatchPtr Batch);
+};
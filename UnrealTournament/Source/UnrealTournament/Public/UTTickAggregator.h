@@ -0,0 +1,105 @@
+// Copyright 1998-2015 Epic Games, Inc. All Rights Reserved.
+#pragma once
+
+/** kept by an object whose tick function may be aggregated, tells where it is */
+struct FUTAggregatedTickHandle
+{
+	class FUTTickAggregator* Aggregator;
+	/** index in the aggregator's members, INDEX_NONE while waiting to be added */
+	int32 Index;
+
+	FUTAggregatedTickHandle()
+		: Aggregator(NULL), Index(INDEX_NONE)
+	{}
+
+	bool IsAggregated() const
+	{
+		return Aggregator != NULL;
+	}
+};
+
+/**
+ * Ticks the tick functions of many lightweight objects of the same class in one tick function, instead of each getting its own
+ * task, prerequisite checks and completion event every frame. One aggregator exists per level, class and tick group.
+ * Members keep their tick function and enabled state, it is just unregistered while aggregated; members lose their tick
+ * prerequisites, so Add() only takes tick functions that depend on nothing still registered. Tick functions of the owning actor
+ * and its components that wait for a member (e.g. the actor tick waits for its movement component) wait for the aggregator
+ * instead while the member is in it. When to join is up to the owner: projectiles and pickups join after their first regular tick,
+ * replicated emitters' particle components in BeginPlay.
+ */
+class UNREALTOURNAMENT_API FUTTickAggregator : public FTickFunction
+{
+public:
+	/**
+	 * Moves TickFunction into the aggregator for Owner's class, Level and the tick function's tick group, if allowed.
+	 * Safe to call from inside the tick itself.
+	 * @return whether the tick function is aggregated now
+	 */
+	static bool Add(FTickFunction& TickFunction, UObject* Owner, ULevel* Level, FUTAggregatedTickHandle& Handle);
+	/** takes the tick function out of its aggregator; it is not registered again, that is up to the caller */
+	static void Remove(FUTAggregatedTickHandle& Handle);
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual void ExecuteParallelTick(float DeltaTime, ELevelTick TickType) override;
+	virtual FString DiagnosticMessage() override;
+
+	/** GFrameCounter of the last frame the members were ticked */
+	uint64 GetLastTickFrame() const
+	{
+		return LastTickFrame;
+	}
+
+private:
+	FUTTickAggregator(UClass* InMemberClass, ULevel* InLevel);
+
+	/** a tick function that had a member's tick function as a prerequisite, and has the aggregator instead while the member is in it */
+	struct FDependent
+	{
+		TWeakObjectPtr<UObject> Object;
+		FTickFunction* TickFunction;
+		/** object of the prerequisite that was replaced, to put it back */
+		TWeakObjectPtr<UObject> PrerequisiteObject;
+
+		FDependent(UObject* InObject, FTickFunction* InTickFunction, const TWeakObjectPtr<UObject>& InPrerequisiteObject)
+			: Object(InObject), TickFunction(InTickFunction), PrerequisiteObject(InPrerequisiteObject)
+		{}
+	};
+
+	struct FMember
+	{
+		FTickFunction* TickFunction;
+		FUTAggregatedTickHandle* Handle;
+		TArray<FDependent, TInlineAllocator<1>> Dependents;
+
+		FMember(FTickFunction* InTickFunction, FUTAggregatedTickHandle* InHandle)
+			: TickFunction(InTickFunction), Handle(InHandle)
+		{}
+	};
+	/** members in tick order; members removed while ticking are cleared and compacted afterwards */
+	TArray<FMember> Members;
+	/** members added while ticking, appended afterwards */
+	TArray<FMember> PendingMembers;
+	/** how many members each dependent waits for through the aggregator */
+	TMap<FTickFunction*, int32> DependentCounts;
+	/** changes each member deferred to the game thread in the parallel tick, passed on in member order */
+	TArray<TArray<TFunction<void()>>> MemberDeferredChanges;
+
+	UClass* MemberClass;
+	ULevel* Level;
+	UWorld* World;
+	bool bTicking;
+	bool bNeedsCompact;
+	uint64 LastTickFrame;
+
+	void RemoveMember(FUTAggregatedTickHandle& Handle);
+	/** makes the tick functions of Owner's actor and its components that wait for the member wait for the aggregator instead */
+	void AddDependents(FMember& Member, UObject* Owner);
+	/** makes the member's dependents wait for the member's own tick function again */
+	void RestoreDependents(FMember& Member);
+	/** applies the membership changes made while ticking */
+	void FinishTicking();
+
+	static void DestroyAggregators(UWorld* InWorld, ULevel* InLevel);
+	static void OnLevelRemovedFromWorld(ULevel* InLevel, UWorld* InWorld);
+	static void OnWorldCleanup(UWorld* InWorld, bool bSessionEnded, bool bCleanupResources);
+};
@@ -171,6 +171,63 @@ public:
 	UPROPERTY()
 	float ImpactEffectFadeSpeed;
 
+	/** maximum number of gibs in the world at once, the least visible ones are recycled when more are needed
+	 * set to zero for no limit
+	 */
+	UPROPERTY(globalconfig)
+	int32 MaxGibs;
+
+	/** gibs in the world, oldest first */
+	UPROPERTY()
+	TArray<class AUTGib*> ActiveGibs;
+
+	/** hidden gibs waiting to be reused by SpawnGib() */
+	UPROPERTY()
+	TArray<class AUTGib*> UnusedGibs;
+
+	/** expired decals waiting to be reused by NewDecal() */
+	UPROPERTY()
+	TArray<UDecalComponent*> UnusedDecals;
+
+	/** gibs and decals made new or taken from the pools so far, for measuring how often the pools are hit */
+	uint32 NumGibsSpawned;
+	uint32 NumGibsReused;
+	uint32 NumDecalsCreated;
+	uint32 NumDecalsReused;
+
+	/** spawns a gib, reusing a hidden one of the same class if possible and recycling the least visible gib if there are already MaxGibs */
+	virtual class AUTGib* SpawnGib(TSubclassOf<class AUTGib> GibClass, const FVector& Location, const FRotator& Rotation, APawn* InInstigator);
+
+	/** removes the gib from the world, keeping it to be reused by SpawnGib() if there is room */
+	virtual void RecycleGib(class AUTGib* Gib);
+
+	/** maximum number of hidden projectiles kept to be reused by SpawnProjectile() */
+	UPROPERTY(globalconfig)
+	int32 MaxPooledProjectiles;
+
+	/** hidden projectiles waiting to be reused by SpawnProjectile() */
+	UPROPERTY()
+	TArray<class AUTProjectile*> UnusedProjectiles;
+
+	/** spawns a projectile, reusing a hidden one of the same class if there is one (see AUTProjectile::bAllowPooling) */
+	virtual class AUTProjectile* SpawnProjectile(TSubclassOf<class AUTProjectile> ProjClass, const FVector& Location, const FRotator& Rotation, const FActorSpawnParameters& SpawnParams);
+
+	/** removes the projectile from the world, keeping it to be reused by SpawnProjectile() if there is room */
+	virtual void RecycleProjectile(class AUTProjectile* Proj);
+
+	/** creates a decal component, reusing an expired one if possible
+	 * the caller sets it up, registers it and passes it to AddImpactEffect() as with a new one
+	 */
+	virtual UDecalComponent* NewDecal();
+
+protected:
+	/** @return the gib to recycle to make room for a new one: the oldest one that isn't being rendered, otherwise the farthest from local viewers */
+	virtual class AUTGib* FindGibToEvict() const;
+
+	/** removes an expired impact effect, decals made by NewDecal() are kept for reuse */
+	virtual void RemoveImpactEffect(USceneComponent* EffectComp);
+public:
+
 	UPROPERTY()
 	TArray<FTimedMaterialParameter> MaterialParamCurves;
 	UPROPERTY()
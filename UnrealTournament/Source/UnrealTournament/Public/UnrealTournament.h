@@ -110,6 +110,8 @@ extern UNREALTOURNAMENT_API void ClearTimerUFunc(UObject* Obj, FName FuncName);
  * @param QueryWindow - query time period (e.g. "monthly")
  */
 extern UNREALTOURNAMENT_API FHttpRequestPtr ReadBackendStats(const FHttpRequestCompleteDelegate& ResultDelegate, const FString& StatsId, const FString& QueryWindow = TEXT("alltime"));
+/** @return URL match stats for the user are posted to, depends on the build and -MCPCONFIG= */
+extern UNREALTOURNAMENT_API FString GetBackendStatsWriteURL(const FString& StatsId);
 
 /** reads profile item json and fills in the items array
  * array is emptied first